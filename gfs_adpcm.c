@@ -0,0 +1,225 @@
+/*
+ * FILE      gfs_adpcm.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_adpcm.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define ADPCM_CHANNEL_HEADER_SIZE 4 // Sample (i16), step index (u8), reserved (u8).
+#define ADPCM_GROUP_SIZE 4          // Bytes of one channel between the others' ones.
+#define ADPCM_GROUP_SAMPLES 8
+#define ADPCM_STEP_INDEX_MAX 88
+
+#define ADPCM_FRAME_INVALID ((u64)-1)
+
+global_var const i32 gADPCMStepTable[ADPCM_STEP_INDEX_MAX + 1] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,
+    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,
+    544,   598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,
+    9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+global_var const i32 gADPCMIndexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+/*
+ * Decodes one nibble. Difference is built from shifted steps, as the IMA reference does, so
+ * rounding is the same, which encoders expect.
+ */
+internal i32
+ADPCM_Expand(i32 predictor, i32 *stepIndex, u32 nibble) {
+    i32 step = gADPCMStepTable[*stepIndex];
+    i32 difference = step >> 3;
+
+    difference += step & -(i32)(nibble >> 2 & 1);
+    difference += (step >> 1) & -(i32)(nibble >> 1 & 1);
+    difference += (step >> 2) & -(i32)(nibble & 1);
+
+    predictor += nibble & 8 ? -difference : difference;
+    predictor = predictor < -32768 ? -32768 : (predictor > 32767 ? 32767 : predictor);
+
+    i32 nextIndex = *stepIndex + gADPCMIndexTable[nibble];
+    *stepIndex = nextIndex < 0 ? 0 : (nextIndex > ADPCM_STEP_INDEX_MAX ? ADPCM_STEP_INDEX_MAX : nextIndex);
+
+    return predictor;
+}
+
+internal u32
+ADPCM_ReadNibble(const byte *data, u32 groupStride, u32 sampleIndex) {
+    byte value = data[(sampleIndex / ADPCM_GROUP_SAMPLES) * groupStride + (sampleIndex % ADPCM_GROUP_SAMPLES) / 2];
+    return (sampleIndex & 1 ? value >> 4 : value) & 0xF;
+}
+
+/*
+ * Decodes `sampleCount` samples of one channel from `sampleIndex` (counting after the header
+ * sample) on. `data` points at the first group of the channel. Output is written with `stride`,
+ * which is zero, when samples are only skipped.
+ */
+internal void
+ADPCM_DecodeChannel(
+    const byte *data, u32 channelCount, u32 sampleIndex, u32 sampleCount, i32 *predictorInOut, i32 *stepIndexInOut,
+    i16 *destination, u32 stride) {
+    u32 groupStride = ADPCM_GROUP_SIZE * channelCount;
+    u32 sampleEnd = sampleIndex + sampleCount;
+    i32 predictor = *predictorInOut;
+    i32 stepIndex = *stepIndexInOut;
+
+    for (; sampleIndex < sampleEnd && sampleIndex % ADPCM_GROUP_SAMPLES != 0; ++sampleIndex) {
+        predictor = ADPCM_Expand(predictor, &stepIndex, ADPCM_ReadNibble(data, groupStride, sampleIndex));
+        *destination = (i16)predictor;
+        destination += stride;
+    }
+
+    // NOTE(ilya.a): Whole group is one little-endian word, lowest nibble first. [2026/10/18]
+    for (; sampleEnd - sampleIndex >= ADPCM_GROUP_SAMPLES; sampleIndex += ADPCM_GROUP_SAMPLES) {
+        const byte *group = data + (sampleIndex / ADPCM_GROUP_SAMPLES) * groupStride;
+        u32 word = (u32)group[0] | (u32)group[1] << 8 | (u32)group[2] << 16 | (u32)group[3] << 24;
+
+        for (u32 nibbleIndex = 0; nibbleIndex < ADPCM_GROUP_SAMPLES; ++nibbleIndex) {
+            predictor = ADPCM_Expand(predictor, &stepIndex, word & 0xF);
+            *destination = (i16)predictor;
+            destination += stride;
+            word >>= 4;
+        }
+    }
+
+    for (; sampleIndex < sampleEnd; ++sampleIndex) {
+        predictor = ADPCM_Expand(predictor, &stepIndex, ADPCM_ReadNibble(data, groupStride, sampleIndex));
+        *destination = (i16)predictor;
+        destination += stride;
+    }
+
+    *predictorInOut = predictor;
+    *stepIndexInOut = stepIndex;
+}
+
+internal void
+ADPCM_DecodeRun(ADPCMDecoder *decoder, const byte *block, u32 sampleIndex, u32 sampleCount, i16 *destination) {
+    const byte *groups = block + ADPCM_CHANNEL_HEADER_SIZE * decoder->ChannelCount;
+    i16 discarded = 0;
+
+    for (u32 channelIndex = 0; channelIndex < decoder->ChannelCount; ++channelIndex) {
+        ADPCM_DecodeChannel(
+            groups + channelIndex * ADPCM_GROUP_SIZE, decoder->ChannelCount, sampleIndex, sampleCount,
+            &decoder->Predictor[channelIndex], &decoder->StepIndex[channelIndex],
+            destination != NULL ? destination + channelIndex : &discarded,
+            destination != NULL ? decoder->ChannelCount : 0);
+    }
+}
+
+u32
+ADPCMGetFramesPerBlock(u32 blockSize, u32 channelCount) {
+    if (channelCount == 0 || channelCount > ADPCM_CHANNEL_COUNT_MAX) {
+        return 0;
+    }
+
+    u32 headerSize = ADPCM_CHANNEL_HEADER_SIZE * channelCount;
+    u32 groupSize = ADPCM_GROUP_SIZE * channelCount;
+
+    if (blockSize < headerSize || (blockSize - headerSize) % groupSize != 0) {
+        return 0;
+    }
+
+    return 1 + (blockSize - headerSize) / groupSize * ADPCM_GROUP_SAMPLES;
+}
+
+u64
+ADPCMGetFrameCount(usize dataSize, u32 blockSize, u32 channelCount) {
+    u32 framesPerBlock = ADPCMGetFramesPerBlock(blockSize, channelCount);
+
+    if (framesPerBlock == 0) {
+        return 0;
+    }
+
+    u32 headerSize = ADPCM_CHANNEL_HEADER_SIZE * channelCount;
+    u32 groupSize = ADPCM_GROUP_SIZE * channelCount;
+    usize lastBlockSize = dataSize % blockSize;
+    u64 frameCount = (u64)(dataSize / blockSize) * framesPerBlock;
+
+    if (lastBlockSize >= headerSize) {
+        frameCount += 1 + (lastBlockSize - headerSize) / groupSize * ADPCM_GROUP_SAMPLES;
+    }
+
+    return frameCount;
+}
+
+bool
+ADPCMDecoderInit(ADPCMDecoder *decoder, const void *blocks, u64 frameCount, u32 blockSize, u32 channelCount) {
+    if (decoder == NULL || blocks == NULL) {
+        return false;
+    }
+
+    u32 framesPerBlock = ADPCMGetFramesPerBlock(blockSize, channelCount);
+
+    if (framesPerBlock == 0) {
+        return false;
+    }
+
+    decoder->Blocks = blocks;
+    decoder->FrameCount = frameCount;
+    decoder->BlockSize = blockSize;
+    decoder->FramesPerBlock = framesPerBlock;
+    decoder->ChannelCount = channelCount;
+    decoder->Frame = ADPCM_FRAME_INVALID;
+
+    return true;
+}
+
+usize
+ADPCMDecode(ADPCMDecoder *decoder, u64 frame, i16 *destination, usize frameCount) {
+    u32 channelCount = decoder->ChannelCount;
+    usize framesDone = 0;
+
+    while (framesDone < frameCount && frame < decoder->FrameCount) {
+        u64 blockIndex = frame / decoder->FramesPerBlock;
+        u32 blockFrame = (u32)(frame % decoder->FramesPerBlock);
+        u64 blockFrameCount = decoder->FrameCount - blockIndex * decoder->FramesPerBlock;
+        const byte *block = decoder->Blocks + blockIndex * decoder->BlockSize;
+        i16 *output = destination + framesDone * channelCount;
+
+        if (blockFrameCount > decoder->FramesPerBlock) {
+            blockFrameCount = decoder->FramesPerBlock;
+        }
+
+        if (blockFrame == 0 || decoder->Frame != frame) {
+            for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+                const byte *header = block + channelIndex * ADPCM_CHANNEL_HEADER_SIZE;
+                decoder->Predictor[channelIndex] = (i16)(header[0] | header[1] << 8);
+                decoder->StepIndex[channelIndex] = header[2] > ADPCM_STEP_INDEX_MAX ? ADPCM_STEP_INDEX_MAX : header[2];
+            }
+
+            if (blockFrame == 0) {
+                for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+                    output[channelIndex] = (i16)decoder->Predictor[channelIndex];
+                }
+
+                output += channelCount;
+                ++framesDone;
+                ++frame;
+                blockFrame = 1;
+            } else {
+                // NOTE(ilya.a): Seek inside block. Every sample before it has to be decoded anyway. [2026/10/18]
+                ADPCM_DecodeRun(decoder, block, 0, blockFrame - 1, NULL);
+            }
+        }
+
+        u64 framesLeft = blockFrameCount - blockFrame;
+        usize framesToDecode = frameCount - framesDone;
+        framesToDecode = framesLeft < framesToDecode ? (usize)framesLeft : framesToDecode;
+
+        ADPCM_DecodeRun(decoder, block, blockFrame - 1, (u32)framesToDecode, output);
+
+        framesDone += framesToDecode;
+        frame += framesToDecode;
+        decoder->Frame = frame;
+    }
+
+    return framesDone;
+}
@@ -0,0 +1,58 @@
+/*
+ * GFS. IMA-ADPCM decoder.
+ *
+ * IMA-ADPCM wave files (format tag 0x11) store 4 bits per sample in independent blocks: every
+ * block starts with exact sample and step index per channel, then nibbles follow in groups of
+ * 8 samples per channel. That's about 4 times less than 16-bit PCM, so sounds are kept
+ * compressed in memory and decoded on demand.
+ *
+ * Decoder remembers where it stopped, so sequential reads decode every sample once. Read from
+ * other position restarts at the beginning of its block.
+ *
+ * FILE      gfs_adpcm.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_ADPCM_H_INCLUDED
+#define GFS_ADPCM_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define ADPCM_CHANNEL_COUNT_MAX 2
+
+typedef struct {
+    const byte *Blocks;
+    u64 FrameCount;
+    u32 BlockSize; // Bytes, `BytePerBloc` of wave file.
+    u32 FramesPerBlock;
+    u32 ChannelCount;
+
+    u64 Frame; // Next frame, which state below is valid for.
+    i32 Predictor[ADPCM_CHANNEL_COUNT_MAX];
+    i32 StepIndex[ADPCM_CHANNEL_COUNT_MAX];
+} ADPCMDecoder;
+
+/*
+ * Returns zero, if there is no valid block layout of such size.
+ */
+u32 ADPCMGetFramesPerBlock(u32 blockSize, u32 channelCount);
+
+/*
+ * Frames in `dataSize` bytes of blocks. Last block could be shorter than the others.
+ */
+u64 ADPCMGetFrameCount(usize dataSize, u32 blockSize, u32 channelCount);
+
+/*
+ * Returns false, if block layout is invalid. Blocks aren't copied.
+ */
+bool ADPCMDecoderInit(ADPCMDecoder *decoder, const void *blocks, u64 frameCount, u32 blockSize, u32 channelCount);
+
+/*
+ * Decodes up to `frameCount` interleaved i16 frames, starting at `frame`. Returns number of frames
+ * decoded, which is less than asked only at the end of samples.
+ */
+usize ADPCMDecode(ADPCMDecoder *decoder, u64 frame, i16 *destination, usize frameCount);
+
+#endif // GFS_ADPCM_H_INCLUDED
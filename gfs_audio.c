@@ -0,0 +1,371 @@
+/*
+ * FILE      gfs_audio.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_audio.h"
+
+#include <Windows.h>
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_spsc.h"
+#include "gfs_audio_device.h"
+#include "gfs_audio_telemetry.h"
+#include "gfs_mixer.h"
+#include "gfs_dsp.h"
+#include "gfs_osc.h"
+
+//
+// Null device.
+//
+
+internal u32
+AudioNull_GetFramesToWrite(AudioDevice *device) {
+    AudioNullDevice *nullDevice = (AudioNullDevice *)device;
+    AudioSimDevice *sim = &nullDevice->Sim;
+
+    if (sim->IsPlaying) {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        u64 ticks = (u64)(counter.QuadPart - nullDevice->StartCounter.QuadPart);
+        u64 framesPlayed = ticks * device->SampleRate / (u64)nullDevice->CounterFrequency.QuadPart;
+
+        AudioSimDeviceAdvance(sim, framesPlayed - sim->FramesPlayed);
+    }
+
+    return AudioSimDeviceGetFramesToWrite(device);
+}
+
+internal void
+AudioNull_Write(AudioDevice *device, const i16 *samples, u32 frameCount) {
+    AudioNullDevice *nullDevice = (AudioNullDevice *)device;
+
+    // NOTE(ilya.a): Like real device, playback starts with the first write. [2026/10/18]
+    if (!nullDevice->Sim.IsPlaying) {
+        QueryPerformanceCounter(&nullDevice->StartCounter);
+    }
+
+    AudioSimDeviceWrite(device, samples, frameCount);
+}
+
+internal void
+AudioNull_Wait(AudioDevice *device) {
+    UNUSED(device);
+    Sleep(1);
+}
+
+void
+AudioNullDeviceInit(AudioNullDevice *device, u32 sampleRate, u32 latencyFrames) {
+    MemoryZero(device, sizeof(*device));
+
+    // NOTE(ilya.a): Nothing is committed ahead of playback, so write cursor is play cursor. [2026/10/18]
+    AudioSimDeviceInit(&device->Sim, sampleRate, latencyFrames, sampleRate, 0, 0);
+
+    device->Sim.Device.GetFramesToWrite = AudioNull_GetFramesToWrite;
+    device->Sim.Device.Write = AudioNull_Write;
+    device->Sim.Device.Wait = AudioNull_Wait;
+
+    QueryPerformanceFrequency(&device->CounterFrequency);
+}
+
+//
+// Audio thread.
+//
+
+/*
+ * NOTE(ilya.a): Voice map is open addressing table. Mapping goes into the first slot from
+ * `voice & (AUDIO_VOICE_MAP_SIZE - 1)`, which mixer voice has finished. There are no more than
+ * `MIXER_VOICE_COUNT_MAX` playing voices, so mapping is never further than that from its home
+ * slot. Mappings of finished voices are just left to be overwritten. [2026/10/18]
+ */
+internal MixerVoiceID *
+Audio_FindVoice(AudioSystem *audio, AudioVoice voice) {
+    for (u32 probeIndex = 0; probeIndex < MIXER_VOICE_COUNT_MAX; ++probeIndex) {
+        AudioVoiceMapping *mapping = &audio->VoiceMap[(voice + probeIndex) & (AUDIO_VOICE_MAP_SIZE - 1)];
+
+        if (mapping->Voice == voice) {
+            return &mapping->ID;
+        }
+    }
+
+    return NULL;
+}
+
+internal void
+Audio_MapVoice(AudioSystem *audio, AudioVoice voice, MixerVoiceID id) {
+    for (u32 probeIndex = 0; probeIndex < MIXER_VOICE_COUNT_MAX; ++probeIndex) {
+        AudioVoiceMapping *mapping = &audio->VoiceMap[(voice + probeIndex) & (AUDIO_VOICE_MAP_SIZE - 1)];
+
+        if (mapping->Voice == AUDIO_VOICE_INVALID || !MixerIsPlaying(&audio->Mixer, mapping->ID)) {
+            mapping->Voice = voice;
+            mapping->ID = id;
+            return;
+        }
+    }
+}
+
+internal void
+Audio_ApplyCommand(AudioSystem *audio, const AudioCommand *command) {
+    switch (command->Type) {
+    case AUDIO_COMMAND_PLAY: {
+        MixerVoiceID id = MixerPlay(&audio->Mixer, &command->Desc);
+        if (id != MIXER_VOICE_INVALID) {
+            Audio_MapVoice(audio, command->Voice, id);
+        }
+    } break;
+    case AUDIO_COMMAND_STOP: {
+        MixerVoiceID *id = Audio_FindVoice(audio, command->Voice);
+        if (id != NULL) {
+            MixerStop(&audio->Mixer, *id);
+        }
+    } break;
+    case AUDIO_COMMAND_SET_VOLUME: {
+        MixerVoiceID *id = Audio_FindVoice(audio, command->Voice);
+        if (id != NULL) {
+            MixerSetVolume(&audio->Mixer, *id, command->Value);
+        }
+    } break;
+    case AUDIO_COMMAND_SET_PAN: {
+        MixerVoiceID *id = Audio_FindVoice(audio, command->Voice);
+        if (id != NULL) {
+            MixerSetPan(&audio->Mixer, *id, command->Value);
+        }
+    } break;
+    case AUDIO_COMMAND_SET_MASTER_VOLUME: {
+        audio->Mixer.MasterVolume = command->Value;
+    } break;
+    case AUDIO_COMMAND_SET_TONE_FREQUENCY: {
+        OscBankSetFrequency(&audio->Tones, command->Tone, command->Value);
+    } break;
+    case AUDIO_COMMAND_SET_TONE_AMPLITUDE: {
+        OscBankSetAmplitude(&audio->Tones, command->Tone, command->Value);
+    } break;
+    case AUDIO_COMMAND_SET_BUS_PARAMETER: {
+        DSPChainSetParameter(
+            MixerGetBus(&audio->Mixer, command->Effect.Bus), command->Effect.Node, command->Effect.Parameter,
+            command->Value);
+    } break;
+    default: {
+    } break;
+    }
+}
+
+void
+AudioSystemRender(AudioSystem *audio, i16 *destination, u32 frameCount) {
+    AudioCommand command;
+    while (SPSCRingPop(&audio->Commands, &command, 1) == 1) {
+        Audio_ApplyCommand(audio, &command);
+    }
+
+    for (u32 framesDone = 0; framesDone < frameCount;) {
+        u32 framesLeft = frameCount - framesDone;
+        u32 framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+
+        MemoryZero(audio->Accumulator, framesToMix * MIXER_CHANNEL_COUNT * sizeof(f32));
+        OscBankRender(&audio->Tones, audio->Accumulator, framesToMix);
+        MixerMix(&audio->Mixer, audio->Accumulator, framesToMix);
+        MixerConvertToI16(
+            &audio->Mixer, audio->Accumulator, destination + framesDone * MIXER_CHANNEL_COUNT,
+            framesToMix * MIXER_CHANNEL_COUNT);
+
+        framesDone += framesToMix;
+    }
+
+    audio->FramesRendered += frameCount;
+}
+
+void
+AudioSystemPump(AudioSystem *audio) {
+    AudioDevice *device = audio->Device;
+    u32 framesToWrite = device->GetFramesToWrite(device);
+
+    if (framesToWrite == 0) {
+        return;
+    }
+
+    // NOTE(ilya.a): Position is taken before the fill, so margin shows how close device came
+    // to running dry. [2026/10/18]
+    AudioDevicePosition position = device->Position;
+
+    // NOTE(ilya.a): Small blocks, so commands are picked up at most one block late. [2026/10/18]
+    for (u32 framesDone = 0; framesDone < framesToWrite;) {
+        u32 framesLeft = framesToWrite - framesDone;
+        u32 framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+
+        AudioSystemRender(audio, audio->Output, framesToMix);
+        device->Write(device, audio->Output, framesToMix);
+
+        framesDone += framesToMix;
+    }
+
+    AudioTelemetryRecordFill(&audio->Telemetry, &position, framesToWrite);
+}
+
+internal DWORD WINAPI
+Audio_ThreadProc(LPVOID parameter) {
+    AudioSystem *audio = (AudioSystem *)parameter;
+    AudioDevice *device = audio->Device;
+
+    // NOTE(ilya.a): Default scheduler tick is ~15ms, which is longer than the whole latency. [2026/10/18]
+    timeBeginPeriod(1);
+
+    // NOTE(ilya.a): Decaying filter and echo tails go denormal, which is very slow. Flush them to
+    // zero (FTZ and DAZ bits of MXCSR). [2026/10/18]
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+
+    while (!audio->ShouldStop) {
+        AudioSystemPump(audio);
+        device->Wait(device);
+    }
+
+    timeEndPeriod(1);
+
+    return 0;
+}
+
+AudioSystem *
+AudioSystemMake(AudioDevice *device, ResampleQuality quality) {
+    AudioSystem *audio = VirtualAlloc(NULL, sizeof(AudioSystem), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (audio == NULL) {
+        return NULL;
+    }
+
+    audio->Device = device;
+    audio->Mixer = MixerMake(device->SampleRate, quality);
+    audio->Tones = OscBankMake(device->SampleRate);
+    audio->NextVoice = 1;
+
+    AudioTelemetryInit(&audio->Telemetry, device->SampleRate, device->LatencyFrames / AUDIO_NEAR_MISS_DIVISOR);
+
+    SPSCRingInit(&audio->Commands, audio->CommandStorage, AUDIO_COMMAND_CAPACITY, sizeof(AudioCommand));
+
+    return audio;
+}
+
+void
+AudioSystemDestroy(AudioSystem *audio) {
+    if (audio == NULL) {
+        return;
+    }
+
+    if (audio->Thread != NULL) {
+        audio->ShouldStop = true;
+        WaitForSingleObject(audio->Thread, INFINITE);
+        CloseHandle(audio->Thread);
+    }
+
+    MixerDestroy(&audio->Mixer);
+    VirtualFree(audio, 0, MEM_RELEASE);
+}
+
+bool
+AudioSystemStart(AudioSystem *audio) {
+    if (audio == NULL || audio->Thread != NULL) {
+        return false;
+    }
+
+    audio->Thread = CreateThread(NULL, 0, Audio_ThreadProc, audio, 0, NULL);
+
+    if (audio->Thread == NULL) {
+        return false;
+    }
+
+    SetThreadPriority(audio->Thread, THREAD_PRIORITY_TIME_CRITICAL);
+    return true;
+}
+
+internal void
+Audio_PostCommand(AudioSystem *audio, const AudioCommand *command) {
+    if (SPSCRingPush(&audio->Commands, command, 1) == 0) {
+        audio->CommandsDropped += 1;
+    }
+}
+
+AudioVoice
+AudioSystemPlay(AudioSystem *audio, const MixerVoiceDesc *desc) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_PLAY;
+    command.Voice = audio->NextVoice;
+    command.Desc = *desc;
+
+    if (SPSCRingPush(&audio->Commands, &command, 1) == 0) {
+        audio->CommandsDropped += 1;
+        return AUDIO_VOICE_INVALID;
+    }
+
+    audio->NextVoice += 1;
+    if (audio->NextVoice == AUDIO_VOICE_INVALID) {
+        audio->NextVoice += 1;
+    }
+
+    return command.Voice;
+}
+
+void
+AudioSystemStop(AudioSystem *audio, AudioVoice voice) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_STOP;
+    command.Voice = voice;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetVolume(AudioSystem *audio, AudioVoice voice, f32 volume) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_VOLUME;
+    command.Voice = voice;
+    command.Value = volume;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetPan(AudioSystem *audio, AudioVoice voice, f32 pan) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_PAN;
+    command.Voice = voice;
+    command.Value = pan;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetMasterVolume(AudioSystem *audio, f32 volume) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_MASTER_VOLUME;
+    command.Value = volume;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetToneFrequency(AudioSystem *audio, OscID tone, f32 frequency) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_TONE_FREQUENCY;
+    command.Tone = tone;
+    command.Value = frequency;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetToneAmplitude(AudioSystem *audio, OscID tone, f32 amplitude) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_TONE_AMPLITUDE;
+    command.Tone = tone;
+    command.Value = amplitude;
+    Audio_PostCommand(audio, &command);
+}
+
+void
+AudioSystemSetBusParameter(AudioSystem *audio, u32 bus, DSPNodeID node, DSPParam parameter, f32 value) {
+    AudioCommand command = {0};
+    command.Type = AUDIO_COMMAND_SET_BUS_PARAMETER;
+    command.Effect.Bus = bus;
+    command.Effect.Node = node;
+    command.Effect.Parameter = parameter;
+    command.Value = value;
+    Audio_PostCommand(audio, &command);
+}
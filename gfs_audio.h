@@ -0,0 +1,159 @@
+/*
+ * GFS. Audio thread.
+ *
+ * Mixer and tone bank are owned by dedicated audio thread, which keeps device buffer filled
+ * only slightly ahead of playback, so latency doesn't depend on frame time. Game thread never
+ * touches mixer: it posts commands through lock-free SPSC ring, which audio thread drains
+ * before every mixed block.
+ *
+ * Devices are hidden behind `AudioDevice` interface. Null device consumes samples in real time
+ * and only counts underruns, so audio thread could run headless. Every fill is recorded into
+ * telemetry, so latency could be tuned by measurement.
+ *
+ * FILE      gfs_audio.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_AUDIO_H_INCLUDED
+#define GFS_AUDIO_H_INCLUDED
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_spsc.h"
+#include "gfs_audio_device.h"
+#include "gfs_audio_telemetry.h"
+#include "gfs_mixer.h"
+#include "gfs_dsp.h"
+#include "gfs_osc.h"
+
+#define AUDIO_COMMAND_CAPACITY 256 // Should be power of two.
+#define AUDIO_VOICE_MAP_SIZE 256   // Should be power of two and above `MIXER_VOICE_COUNT_MAX`.
+#define AUDIO_NEAR_MISS_DIVISOR 4  // Fill is near miss, if margin is below this part of latency.
+
+GFS_STATIC_ASSERT((AUDIO_COMMAND_CAPACITY & (AUDIO_COMMAND_CAPACITY - 1)) == 0);
+GFS_STATIC_ASSERT((AUDIO_VOICE_MAP_SIZE & (AUDIO_VOICE_MAP_SIZE - 1)) == 0);
+GFS_STATIC_ASSERT(AUDIO_VOICE_MAP_SIZE > MIXER_VOICE_COUNT_MAX);
+
+//
+// Null device.
+//
+
+/*
+ * Simulated device, which clock follows wall clock: queued frames drain in real time.
+ */
+typedef struct {
+    AudioSimDevice Sim;
+
+    LARGE_INTEGER CounterFrequency;
+    LARGE_INTEGER StartCounter;
+} AudioNullDevice;
+
+void AudioNullDeviceInit(AudioNullDevice *device, u32 sampleRate, u32 latencyFrames);
+
+//
+// Audio thread.
+//
+
+/*
+ * Identifies voice, started with `AudioSystemPlay`. Zero is never valid.
+ */
+typedef u32 AudioVoice;
+
+#define AUDIO_VOICE_INVALID 0
+
+typedef enum {
+    AUDIO_COMMAND_PLAY,
+    AUDIO_COMMAND_STOP,
+    AUDIO_COMMAND_SET_VOLUME,
+    AUDIO_COMMAND_SET_PAN,
+    AUDIO_COMMAND_SET_MASTER_VOLUME,
+    AUDIO_COMMAND_SET_TONE_FREQUENCY,
+    AUDIO_COMMAND_SET_TONE_AMPLITUDE,
+    AUDIO_COMMAND_SET_BUS_PARAMETER,
+} AudioCommandType;
+
+typedef struct {
+    AudioCommandType Type;
+    union {
+        AudioVoice Voice;
+        OscID Tone;
+        struct {
+            u32 Bus;
+            DSPNodeID Node;
+            DSPParam Parameter;
+        } Effect;
+    };
+    union {
+        MixerVoiceDesc Desc;
+        f32 Value;
+    };
+} AudioCommand;
+
+typedef struct {
+    AudioVoice Voice;
+    MixerVoiceID ID;
+} AudioVoiceMapping;
+
+typedef struct {
+    AudioDevice *Device;
+    Mixer Mixer;   // Add bus effects before `AudioSystemStart`. After that only through commands.
+    OscBank Tones; // Add tones before `AudioSystemStart`. After that only through commands.
+
+    SPSCRing Commands;
+    AudioCommand CommandStorage[AUDIO_COMMAND_CAPACITY];
+    u64 CommandsDropped; // Game thread only.
+
+    AudioVoice NextVoice;                             // Game thread only.
+    AudioVoiceMapping VoiceMap[AUDIO_VOICE_MAP_SIZE]; // Audio thread only.
+
+    f32 Accumulator[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    i16 Output[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+
+    AudioTelemetry Telemetry;
+
+    HANDLE Thread;
+    volatile bool ShouldStop;
+    volatile u64 FramesRendered;
+} AudioSystem;
+
+AudioSystem *AudioSystemMake(AudioDevice *device, ResampleQuality quality);
+
+/*
+ * Stops audio thread (if running) and releases mixer. Device is owned by caller.
+ */
+void AudioSystemDestroy(AudioSystem *audio);
+
+bool AudioSystemStart(AudioSystem *audio);
+
+/*
+ * Renders `frameCount` frames on calling thread, applying pending commands first. Used by audio
+ * thread and for rendering without one.
+ */
+void AudioSystemRender(AudioSystem *audio, i16 *destination, u32 frameCount);
+
+/*
+ * Tops up device buffer once and records the fill into telemetry. Audio thread calls it between
+ * device waits. Without thread, simulated device could be driven by calling it directly.
+ */
+void AudioSystemPump(AudioSystem *audio);
+
+//
+// Game thread side. Commands are dropped (and counted), if ring is full.
+//
+
+/*
+ * Voice's read proc and samples are used on audio thread from now on.
+ */
+AudioVoice AudioSystemPlay(AudioSystem *audio, const MixerVoiceDesc *desc);
+void AudioSystemStop(AudioSystem *audio, AudioVoice voice);
+void AudioSystemSetVolume(AudioSystem *audio, AudioVoice voice, f32 volume);
+void AudioSystemSetPan(AudioSystem *audio, AudioVoice voice, f32 pan);
+void AudioSystemSetMasterVolume(AudioSystem *audio, f32 volume);
+void AudioSystemSetToneFrequency(AudioSystem *audio, OscID tone, f32 frequency);
+void AudioSystemSetToneAmplitude(AudioSystem *audio, OscID tone, f32 amplitude);
+void AudioSystemSetBusParameter(AudioSystem *audio, u32 bus, DSPNodeID node, DSPParam parameter, f32 value);
+
+#endif // GFS_AUDIO_H_INCLUDED
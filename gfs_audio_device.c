@@ -0,0 +1,93 @@
+/*
+ * FILE      gfs_audio_device.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_audio_device.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+
+u32
+AudioSimDeviceGetFramesToWrite(AudioDevice *device) {
+    AudioSimDevice *sim = (AudioSimDevice *)device;
+
+    if (!sim->IsPlaying) {
+        MemoryZero(&device->Position, sizeof(device->Position));
+        device->Position.MarginFrames = (i32)device->LatencyFrames;
+        return device->LatencyFrames;
+    }
+
+    // NOTE(ilya.a): Same rule as DirectSound device has: region between play and write cursors is
+    // committed, so if queue doesn't reach past write cursor, device is playing stale data. Queue
+    // restarts right at write cursor. [2026/10/18]
+    i64 margin = (i64)sim->FramesQueued - (i64)sim->SafetyFrames - (i64)sim->FramesStarved;
+
+    if (margin < 0) {
+        device->Stats.UnderrunCount += 1;
+        device->Stats.UnderrunFrames += (u64)-margin;
+        sim->FramesQueued = sim->SafetyFrames;
+    }
+
+    sim->FramesStarved = 0;
+
+    device->Position.Clock = sim->FramesPlayed;
+    device->Position.PlayCursor = (u32)(sim->FramesPlayed % sim->BufferFrames) * AUDIO_DEVICE_FRAME_SIZE;
+    device->Position.WriteCursor =
+        (u32)((sim->FramesPlayed + sim->SafetyFrames) % sim->BufferFrames) * AUDIO_DEVICE_FRAME_SIZE;
+    device->Position.MarginFrames = (i32)margin;
+
+    u64 targetQueued = (u64)sim->SafetyFrames + device->LatencyFrames;
+    return sim->FramesQueued < targetQueued ? (u32)(targetQueued - sim->FramesQueued) : 0;
+}
+
+void
+AudioSimDeviceWrite(AudioDevice *device, const i16 *samples, u32 frameCount) {
+    UNUSED(samples);
+
+    AudioSimDevice *sim = (AudioSimDevice *)device;
+
+    sim->IsPlaying = true;
+    sim->FramesQueued += frameCount;
+    device->Stats.FramesWritten += frameCount;
+}
+
+internal void
+AudioSim_Wait(AudioDevice *device) {
+    AudioSimDevice *sim = (AudioSimDevice *)device;
+    AudioSimDeviceAdvance(sim, sim->WaitFrames);
+}
+
+void
+AudioSimDeviceInit(
+    AudioSimDevice *device, u32 sampleRate, u32 latencyFrames, u32 bufferFrames, u32 safetyFrames, u32 waitFrames) {
+    MemoryZero(device, sizeof(*device));
+
+    device->Device.SampleRate = sampleRate;
+    device->Device.LatencyFrames = latencyFrames;
+    device->Device.GetFramesToWrite = AudioSimDeviceGetFramesToWrite;
+    device->Device.Write = AudioSimDeviceWrite;
+    device->Device.Wait = AudioSim_Wait;
+
+    device->BufferFrames = bufferFrames != 0 ? bufferFrames : sampleRate;
+    device->SafetyFrames = safetyFrames;
+    device->WaitFrames = waitFrames;
+}
+
+void
+AudioSimDeviceAdvance(AudioSimDevice *device, u64 frameCount) {
+    if (!device->IsPlaying) {
+        return;
+    }
+
+    device->FramesPlayed += frameCount;
+
+    if (frameCount > device->FramesQueued) {
+        device->FramesStarved += frameCount - device->FramesQueued;
+        device->FramesQueued = 0;
+    } else {
+        device->FramesQueued -= frameCount;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * GFS. Audio device interface.
+ *
+ * Audio thread talks to platform audio only through `AudioDevice`: it asks how many frames
+ * should be written, writes them and waits. Every query also reports device position, which
+ * telemetry records (see `gfs_audio_telemetry.h`).
+ *
+ * Simulated device models ring buffer with play and write cursors, like DirectSound's one, but
+ * its clock is advanced explicitly. So latency and underrun behaviour could be reproduced
+ * deterministically, without sound card or even Windows.
+ *
+ * FILE      gfs_audio_device.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_AUDIO_DEVICE_H_INCLUDED
+#define GFS_AUDIO_DEVICE_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define AUDIO_DEVICE_CHANNEL_COUNT 2
+#define AUDIO_DEVICE_FRAME_SIZE (sizeof(i16) * AUDIO_DEVICE_CHANNEL_COUNT)
+
+typedef struct AudioDevice AudioDevice;
+
+/*
+ * Number of frames, which should be written right now to keep `LatencyFrames` queued. Updates
+ * device's `Position`.
+ */
+typedef u32 AudioDeviceGetFramesToWriteProc(AudioDevice *device);
+
+/*
+ * Queues interleaved stereo i16 frames for playback.
+ */
+typedef void AudioDeviceWriteProc(AudioDevice *device, const i16 *samples, u32 frameCount);
+
+/*
+ * Blocks for a short while, until device would want more frames.
+ */
+typedef void AudioDeviceWaitProc(AudioDevice *device);
+
+typedef struct {
+    u64 FramesWritten;
+    u64 UnderrunCount;
+    u64 UnderrunFrames; // Frames device played, while nothing was queued.
+} AudioDeviceStats;
+
+/*
+ * Where device was at the last `GetFramesToWrite`.
+ */
+typedef struct {
+    u64 Clock;        // Frames played since playback start, including underrun ones.
+    u32 PlayCursor;   // Bytes into device buffer. Zero for devices without one.
+    u32 WriteCursor;  // Bytes into device buffer. Everything before it is committed to hardware.
+    i32 MarginFrames; // Frames queued beyond write cursor. Negative, if device ran out of them.
+} AudioDevicePosition;
+
+struct AudioDevice {
+    u32 SampleRate;
+    u32 LatencyFrames;
+
+    AudioDeviceGetFramesToWriteProc *GetFramesToWrite;
+    AudioDeviceWriteProc *Write;
+    AudioDeviceWaitProc *Wait;
+
+    AudioDeviceStats Stats;       // Updated by audio thread only.
+    AudioDevicePosition Position; // Updated by audio thread only.
+};
+
+typedef struct {
+    AudioDevice Device;
+
+    u32 BufferFrames; // Size of simulated ring buffer.
+    u32 SafetyFrames; // How far write cursor runs ahead of play cursor.
+    u32 WaitFrames;   // How far `Wait` advances the clock. Could be changed between waits to model jitter.
+
+    bool IsPlaying;
+    u64 FramesPlayed;  // Including underrun ones.
+    u64 FramesQueued;  // Beyond play cursor.
+    u64 FramesStarved; // Played since the last query with nothing queued.
+} AudioSimDevice;
+
+/*
+ * Playback starts with the first write, like on real device.
+ */
+void AudioSimDeviceInit(
+    AudioSimDevice *device, u32 sampleRate, u32 latencyFrames, u32 bufferFrames, u32 safetyFrames, u32 waitFrames);
+
+/*
+ * Plays `frameCount` frames. Does nothing before playback starts.
+ */
+void AudioSimDeviceAdvance(AudioSimDevice *device, u64 frameCount);
+
+/*
+ * Procs of simulated device. Exposed, so devices built on top of it could wrap them.
+ */
+u32 AudioSimDeviceGetFramesToWrite(AudioDevice *device);
+void AudioSimDeviceWrite(AudioDevice *device, const i16 *samples, u32 frameCount);
+
+#endif // GFS_AUDIO_DEVICE_H_INCLUDED
@@ -0,0 +1,103 @@
+/*
+ * FILE      gfs_audio_telemetry.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_audio_telemetry.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_audio_device.h"
+
+internal u32
+AudioTelemetry_FramesToBucket(const AudioTelemetry *telemetry, u64 frameCount) {
+    u64 microseconds = frameCount * 1000000 / telemetry->SampleRate;
+    u64 bucket = microseconds / AUDIO_TELEMETRY_BUCKET_MICROSECONDS;
+    return bucket < AUDIO_TELEMETRY_BUCKET_COUNT - 1 ? (u32)bucket : AUDIO_TELEMETRY_BUCKET_COUNT - 1;
+}
+
+internal u32
+AudioTelemetry_GetMarginBucket(const AudioTelemetry *telemetry, i32 marginFrames) {
+    if (marginFrames < 0) {
+        return 0;
+    }
+
+    u32 bucket = AudioTelemetry_FramesToBucket(telemetry, (u64)marginFrames) + 1;
+    return bucket < AUDIO_TELEMETRY_BUCKET_COUNT ? bucket : AUDIO_TELEMETRY_BUCKET_COUNT - 1;
+}
+
+void
+AudioTelemetryInit(AudioTelemetry *telemetry, u32 sampleRate, u32 nearMissFrames) {
+    MemoryZero(telemetry, sizeof(*telemetry));
+    telemetry->SampleRate = sampleRate;
+    telemetry->NearMissFrames = nearMissFrames;
+}
+
+void
+AudioTelemetryRecordFill(AudioTelemetry *telemetry, const AudioDevicePosition *position, u32 framesWritten) {
+    AudioFillRecord *fill = &telemetry->Fills[telemetry->FillCount & (AUDIO_TELEMETRY_WINDOW - 1)];
+
+    // NOTE(ilya.a): Slot holds the oldest fill of the window, which leaves histograms now. [2026/10/18]
+    if (telemetry->FillCount >= AUDIO_TELEMETRY_WINDOW) {
+        telemetry->MarginHistogram[AudioTelemetry_GetMarginBucket(telemetry, fill->MarginFrames)] -= 1;
+        telemetry->IntervalHistogram[AudioTelemetry_FramesToBucket(telemetry, fill->IntervalFrames)] -= 1;
+    }
+
+    u64 previousClock = position->Clock;
+    if (telemetry->FillCount > 0) {
+        previousClock = telemetry->Fills[(telemetry->FillCount - 1) & (AUDIO_TELEMETRY_WINDOW - 1)].Clock;
+    }
+
+    fill->Clock = position->Clock;
+    fill->PlayCursor = position->PlayCursor;
+    fill->WriteCursor = position->WriteCursor;
+    fill->BytesWritten = framesWritten * (u32)AUDIO_DEVICE_FRAME_SIZE;
+    fill->MarginFrames = position->MarginFrames;
+    fill->IntervalFrames = (u32)(position->Clock - previousClock);
+
+    telemetry->MarginHistogram[AudioTelemetry_GetMarginBucket(telemetry, fill->MarginFrames)] += 1;
+    telemetry->IntervalHistogram[AudioTelemetry_FramesToBucket(telemetry, fill->IntervalFrames)] += 1;
+
+    if (fill->MarginFrames < 0) {
+        telemetry->UnderrunCount += 1;
+    } else if ((u32)fill->MarginFrames <= telemetry->NearMissFrames) {
+        telemetry->NearMissCount += 1;
+    }
+
+    if (telemetry->FillCount == 0 || fill->MarginFrames < telemetry->MarginMin) {
+        telemetry->MarginMin = fill->MarginFrames;
+    }
+
+    if (fill->IntervalFrames > telemetry->IntervalMax) {
+        telemetry->IntervalMax = fill->IntervalFrames;
+    }
+
+    telemetry->FillCount += 1;
+}
+
+u32
+AudioTelemetryGetMarginPercentile(const AudioTelemetry *telemetry, f32 percentile) {
+    u64 fillCount = telemetry->FillCount < AUDIO_TELEMETRY_WINDOW ? telemetry->FillCount : AUDIO_TELEMETRY_WINDOW;
+
+    if (fillCount == 0) {
+        return 0;
+    }
+
+    percentile = percentile < 0.0f ? 0.0f : (percentile > 1.0f ? 1.0f : percentile);
+    u64 target = (u64)(percentile * (f32)fillCount);
+    target = target > 0 ? target : 1;
+
+    u64 fillsBelow = 0;
+
+    for (u32 bucketIndex = 0; bucketIndex < AUDIO_TELEMETRY_BUCKET_COUNT; ++bucketIndex) {
+        fillsBelow += telemetry->MarginHistogram[bucketIndex];
+
+        if (fillsBelow >= target) {
+            return bucketIndex > 0 ? (bucketIndex - 1) * AUDIO_TELEMETRY_BUCKET_MICROSECONDS : 0;
+        }
+    }
+
+    return (AUDIO_TELEMETRY_BUCKET_COUNT - 2) * AUDIO_TELEMETRY_BUCKET_MICROSECONDS;
+}
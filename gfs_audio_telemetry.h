@@ -0,0 +1,73 @@
+/*
+ * GFS. Audio latency and underrun telemetry.
+ *
+ * Audio thread records every fill of device buffer: cursors, how much was written, safety
+ * margin (how far queued audio reached beyond write cursor, before the fill) and time since
+ * previous fill, measured by device clock. Underruns (negative margin) and near misses (margin
+ * below threshold) are counted for the whole run. Rolling histograms of margin and fill interval
+ * cover only the last `AUDIO_TELEMETRY_WINDOW` fills.
+ *
+ * Low percentile of margin is how much latency could be shrunk by: that much audio was still
+ * queued even in the worst fills.
+ *
+ * FILE      gfs_audio_telemetry.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_AUDIO_TELEMETRY_H_INCLUDED
+#define GFS_AUDIO_TELEMETRY_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_audio_device.h"
+
+#define AUDIO_TELEMETRY_WINDOW 1024     // Fills, which are kept. Should be power of two.
+#define AUDIO_TELEMETRY_BUCKET_COUNT 32 // Last bucket collects everything beyond.
+#define AUDIO_TELEMETRY_BUCKET_MICROSECONDS 500
+
+typedef struct {
+    u64 Clock; // Device clock, in frames.
+    u32 PlayCursor;
+    u32 WriteCursor;
+    u32 BytesWritten;
+    i32 MarginFrames;
+    u32 IntervalFrames; // Since previous fill.
+} AudioFillRecord;
+
+/*
+ * Written by audio thread only. Other threads could read it for display, but values could be
+ * from different fills.
+ */
+typedef struct {
+    u32 SampleRate;
+    u32 NearMissFrames;
+
+    u64 FillCount;
+    u64 UnderrunCount;
+    u64 NearMissCount;
+    i32 MarginMin;   // Over the whole run.
+    u32 IntervalMax; // Over the whole run.
+
+    AudioFillRecord Fills[AUDIO_TELEMETRY_WINDOW]; // Ring. The newest one is at `FillCount - 1`.
+
+    // NOTE(ilya.a): Buckets are `AUDIO_TELEMETRY_BUCKET_MICROSECONDS` wide. Margin bucket zero
+    // counts underruns, so the first non-negative margin bucket is the second one. [2026/10/18]
+    u32 MarginHistogram[AUDIO_TELEMETRY_BUCKET_COUNT];
+    u32 IntervalHistogram[AUDIO_TELEMETRY_BUCKET_COUNT];
+} AudioTelemetry;
+
+void AudioTelemetryInit(AudioTelemetry *telemetry, u32 sampleRate, u32 nearMissFrames);
+
+/*
+ * Records fill, which was made at `position` (as reported by device before the fill).
+ */
+void AudioTelemetryRecordFill(AudioTelemetry *telemetry, const AudioDevicePosition *position, u32 framesWritten);
+
+/*
+ * Margin, which `percentile` (from 0 to 1) of fills in window had at least, in microseconds.
+ * Rounded down to bucket. Zero, if that many fills underran or nothing was recorded yet.
+ */
+u32 AudioTelemetryGetMarginPercentile(const AudioTelemetry *telemetry, f32 percentile);
+
+#endif // GFS_AUDIO_TELEMETRY_H_INCLUDED
@@ -4,6 +4,9 @@
  * COPYRIGHT (c) 2024 Ilya Akkuzin
  * */
 
+#ifndef GFS_BMP_H_INCLUDED
+#define GFS_BMP_H_INCLUDED
+
 #include "gfs_types.h"
 
 typedef enum {
@@ -50,3 +53,5 @@ typedef struct {
     u32 colorImportant;
 } BmpHeader;
 #pragma pack(pop)
+
+#endif // GFS_BMP_H_INCLUDED
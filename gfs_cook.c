@@ -0,0 +1,642 @@
+/*
+ * GFS. Offline asset cooker.
+ *
+ * Usage: gfs_cook <output directory> <asset path>...
+ *
+ * Converts source assets into runtime formats (see `gfs_cooked.h`):
+ *
+ *   .wav, .wave -> 48 kHz stereo interleaved i16
+ *   .bmp        -> top-down BGRA
+ *
+ * Result is written to `<output directory>/<asset file name>.cooked`. Inputs are cooked in
+ * parallel, one worker per logical core. Inputs, which content hash matches hash stored in
+ * existing cooked file, are skipped. Nothing is cooked, if two inputs have the same file name.
+ *
+ * FILE      gfs_cook.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_string.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_io.h"
+#include "gfs_wave.h"
+#include "gfs_pcm.h"
+#include "gfs_resample.h"
+#include "gfs_adpcm.h"
+#include "gfs_bmp.h"
+#include "gfs_color.h"
+#include "gfs_cooked.h"
+#include "gfs_win32_misc.h"
+
+#define COOK_WORKER_COUNT_MAX 64
+#define COOK_PATH_CAPACITY KILOBYTES(1)
+
+typedef enum {
+    COOK_OK,
+    COOK_SKIPPED,
+    COOK_ERR_UNKNOWN_TYPE,
+    COOK_ERR_FAILED_TO_READ,
+    COOK_ERR_UNSUPPORTED_FORMAT,
+    COOK_ERR_FAILED_TO_ALLOC,
+    COOK_ERR_FAILED_TO_WRITE,
+} CookResult;
+
+typedef struct {
+    cstr8 OutputDirectory;
+    cstr8 *Inputs;
+    u32 InputCount;
+
+    LONG volatile NextInput;
+    LONG volatile CookedCount;
+    LONG volatile SkippedCount;
+    LONG volatile FailedCount;
+} CookContext;
+
+typedef struct {
+    CookedAssetHeader Header;
+    const void *Payload;
+} CookOutput;
+
+global_var byte gCookPadding[COOKED_PAYLOAD_ALIGNMENT];
+
+internal cstr8
+Cook_GetExtension(cstr8 path) {
+    cstr8 extension = path + CStr8GetLength(path);
+
+    while (extension > path && *extension != '.' && *extension != '/' && *extension != '\\') {
+        --extension;
+    }
+
+    return *extension == '.' ? extension : "";
+}
+
+internal cstr8
+Cook_GetFileName(cstr8 path) {
+    cstr8 fileName = path;
+
+    for (cstr8 cursor = path; *cursor != '\0'; ++cursor) {
+        if (*cursor == '/' || *cursor == '\\') {
+            fileName = cursor + 1;
+        }
+    }
+
+    return fileName;
+}
+
+/*
+ * Output names drop directories, so `a/music.wav` and `b/music.wav` would overwrite each other.
+ * Windows file names are case insensitive, so case is ignored too.
+ */
+internal bool
+Cook_IsFileNameCollision(cstr8 *inputs, u32 inputCount) {
+    char8 printBuffer[COOK_PATH_CAPACITY * 2 + 64];
+
+    for (u32 inputIndex = 0; inputIndex < inputCount; ++inputIndex) {
+        for (u32 otherIndex = inputIndex + 1; otherIndex < inputCount; ++otherIndex) {
+            if (lstrcmpiA(Cook_GetFileName(inputs[inputIndex]), Cook_GetFileName(inputs[otherIndex])) == 0) {
+                wsprintfA(
+                    printBuffer, "E: '%s' and '%s' would be cooked into the same file\n", inputs[inputIndex],
+                    inputs[otherIndex]);
+                Win32_Print(printBuffer);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Reads header of already cooked file and checks whether it was produced from the same source
+ * and whole payload is there (writing could have been interrupted after the header).
+ */
+internal bool
+Cook_IsUpToDate(cstr8 outputPath, u64 sourceHash) {
+    FileHandle output;
+
+    if (IOOpenFile(outputPath, &output, IO_READ) != IO_OK) {
+        return false;
+    }
+
+    CookedAssetHeader header;
+    usize fileSize = 0;
+    IOResult readResult = IOReadAt(&output, &header, sizeof(header), 0, NULL);
+    IOResult sizeResult = IOGetFileSize(&output, &fileSize);
+    IOCloseFile(&output);
+
+    return readResult == IO_OK && sizeResult == IO_OK && header.Magic == COOKED_MAGIC &&
+           header.Version == COOKED_VERSION && header.SourceHash == sourceHash && header.PayloadOffset <= fileSize &&
+           header.PayloadSize == fileSize - header.PayloadOffset;
+}
+
+//
+// Audio
+//
+
+#define COOK_AUDIO_BLOCK_FRAMES 1024 // Frames resampled at once, before quantization.
+#define COOK_AUDIO_SAMPLE_RATE_MAX (COOKED_AUDIO_SAMPLE_RATE * 16) // Keeps resampler input window reasonable.
+
+/*
+ * Converts stereo `source` to cooked sample rate with the same resampler, which mixer uses (at
+ * its highest quality), and quantizes it into `destination`.
+ */
+internal CookResult
+Cook_ResampleAudio(
+    BlockAllocator *allocator, const f32 *source, usize sourceFrameCount, u32 sourceRate, i16 *destination,
+    u64 destinationFrameCount, PCMDither *dither) {
+    ResampleFilter *filter = BlockAllocatorAlloc(allocator, sizeof(ResampleFilter));
+    ResampleState *state = BlockAllocatorAlloc(allocator, sizeof(ResampleState));
+
+    if (filter == NULL || state == NULL) {
+        return COOK_ERR_FAILED_TO_ALLOC;
+    }
+
+    ResampleFilterInit(filter, sourceRate, COOKED_AUDIO_SAMPLE_RATE, RESAMPLE_QUALITY_HIGH);
+    ResampleStateReset(state, filter, COOKED_AUDIO_CHANNEL_COUNT);
+
+    f32 block[COOK_AUDIO_BLOCK_FRAMES * COOKED_AUDIO_CHANNEL_COUNT];
+    usize sourceIndex = 0;
+    u64 framesDone = 0;
+
+    while (framesDone < destinationFrameCount) {
+        usize inputSpace = ResampleGetInputSpace(state);
+        usize sourceLeft = sourceFrameCount - sourceIndex;
+
+        // NOTE(ilya.a): Past the end filter sees silence, so the last frames ring out instead of
+        // being cut. [2026/10/18]
+        if (sourceLeft > 0) {
+            usize writeFrameCount = sourceLeft < inputSpace ? sourceLeft : inputSpace;
+            ResampleWriteF32(state, source + sourceIndex * COOKED_AUDIO_CHANNEL_COUNT, writeFrameCount);
+            sourceIndex += writeFrameCount;
+        } else {
+            ResampleWriteSilence(state, inputSpace);
+        }
+
+        u64 framesLeft = destinationFrameCount - framesDone;
+        usize blockFrameCount = (usize)(framesLeft < COOK_AUDIO_BLOCK_FRAMES ? framesLeft : COOK_AUDIO_BLOCK_FRAMES);
+        blockFrameCount = ResampleProcess(state, block, blockFrameCount);
+
+        // NOTE(ilya.a): Resampler works in i16 range (see `ResampleWriteF32`). [2026/10/18]
+        for (usize sampleIndex = 0; sampleIndex < blockFrameCount * COOKED_AUDIO_CHANNEL_COUNT; ++sampleIndex) {
+            block[sampleIndex] *= 1.0f / 32768.0f;
+        }
+
+        PCMConvertFromF32(
+            PCM_FORMAT_I16, block, destination + framesDone * COOKED_AUDIO_CHANNEL_COUNT,
+            blockFrameCount * COOKED_AUDIO_CHANNEL_COUNT, dither);
+        framesDone += blockFrameCount;
+    }
+
+    return COOK_OK;
+}
+
+internal CookResult
+Cook_Audio(BlockAllocator *allocator, const void *source, usize sourceSize, CookOutput *output) {
+    WaveAsset wave;
+
+    if (WaveAssetLoadFromMemory(source, sourceSize, &wave) != WAVEASSET_LOAD_OK) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    const WaveFileHeader *format = &wave.Header;
+    PCMFormat sampleFormat = PCM_FORMAT_I16;
+    bool isADPCM = format->AudioFormat == WAVEFILE_AUDIOFORMAT_IMA_ADPCM;
+
+    if ((!isADPCM && !PCMFormatFromWave(format->AudioFormat, format->BitsPerSample, &sampleFormat)) ||
+        format->NumberOfChannels == 0 || format->FreqHZ == 0 || format->FreqHZ > COOK_AUDIO_SAMPLE_RATE_MAX) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    u32 channelCount = format->NumberOfChannels;
+    usize sourceFrameCount = format->DataSize / (PCMFormatGetSize(sampleFormat) * channelCount);
+    const void *sourceSamples = wave.Data;
+
+    // NOTE(ilya.a): Compressed source is expanded into i16 first, then goes the same way. [2026/10/18]
+    if (isADPCM) {
+        ADPCMDecoder decoder;
+        sourceFrameCount = (usize)ADPCMGetFrameCount(format->DataSize, format->BytePerBloc, channelCount);
+        i16 *expanded = BlockAllocatorAlloc(allocator, sourceFrameCount * channelCount * sizeof(i16) + 1);
+
+        if (expanded == NULL) {
+            return COOK_ERR_FAILED_TO_ALLOC;
+        }
+
+        if (!ADPCMDecoderInit(&decoder, wave.Data, sourceFrameCount, format->BytePerBloc, channelCount)) {
+            return COOK_ERR_UNSUPPORTED_FORMAT;
+        }
+
+        ADPCMDecode(&decoder, 0, expanded, sourceFrameCount);
+        sourceSamples = expanded;
+    }
+
+    usize sourceSampleCount = sourceFrameCount * channelCount;
+
+    // NOTE(ilya.a): First pass decodes into f32 stereo. Mono is duplicated into both channels,
+    // extra channels are dropped. [2026/10/18]
+    f32 *decoded = BlockAllocatorAlloc(allocator, sourceSampleCount * sizeof(f32) + 1);
+    f32 *stereo = decoded;
+
+    if (decoded == NULL) {
+        return COOK_ERR_FAILED_TO_ALLOC;
+    }
+
+    PCMConvertToF32(sampleFormat, sourceSamples, decoded, sourceSampleCount);
+
+    if (channelCount != COOKED_AUDIO_CHANNEL_COUNT) {
+        stereo = BlockAllocatorAlloc(allocator, sourceFrameCount * 2 * sizeof(f32) + 1);
+
+        if (stereo == NULL) {
+            return COOK_ERR_FAILED_TO_ALLOC;
+        }
+    }
+
+    if (channelCount == 1) {
+        PCMMonoToStereoF32(decoded, stereo, sourceFrameCount);
+    } else if (channelCount > COOKED_AUDIO_CHANNEL_COUNT) {
+        f32 **planes = BlockAllocatorAlloc(allocator, channelCount * sizeof(f32 *));
+        f32 *planeData = BlockAllocatorAlloc(allocator, sourceSampleCount * sizeof(f32) + 1);
+
+        if (planes == NULL || planeData == NULL) {
+            return COOK_ERR_FAILED_TO_ALLOC;
+        }
+
+        for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+            planes[channelIndex] = planeData + channelIndex * sourceFrameCount;
+        }
+
+        PCMDeinterleaveF32(decoded, channelCount, planes, sourceFrameCount);
+        PCMInterleaveF32((const f32 *const *)planes, COOKED_AUDIO_CHANNEL_COUNT, stereo, sourceFrameCount);
+    }
+
+    u64 cookedFrameCount =
+        ((u64)sourceFrameCount * COOKED_AUDIO_SAMPLE_RATE + format->FreqHZ - 1) / format->FreqHZ;
+    usize payloadSize = cookedFrameCount * COOKED_AUDIO_CHANNEL_COUNT * sizeof(i16);
+    i16 *samples = BlockAllocatorAlloc(allocator, payloadSize + 1);
+
+    if (samples == NULL) {
+        return COOK_ERR_FAILED_TO_ALLOC;
+    }
+
+    // NOTE(ilya.a): Fixed seed, so cooking the same source always gives the same bytes. [2026/10/18]
+    PCMDither dither;
+    PCMDitherInit(&dither, 0);
+
+    if (format->FreqHZ == COOKED_AUDIO_SAMPLE_RATE) {
+        PCMConvertFromF32(PCM_FORMAT_I16, stereo, samples, cookedFrameCount * COOKED_AUDIO_CHANNEL_COUNT, &dither);
+    } else {
+        CookResult result =
+            Cook_ResampleAudio(allocator, stereo, sourceFrameCount, format->FreqHZ, samples, cookedFrameCount, &dither);
+
+        if (result != COOK_OK) {
+            return result;
+        }
+    }
+
+    output->Header.Type = COOKED_ASSET_TYPE_AUDIO;
+    output->Header.PayloadSize = payloadSize;
+    output->Header.Audio.SampleRate = COOKED_AUDIO_SAMPLE_RATE;
+    output->Header.Audio.ChannelCount = COOKED_AUDIO_CHANNEL_COUNT;
+    output->Header.Audio.FrameCount = cookedFrameCount;
+    output->Payload = samples;
+
+    return COOK_OK;
+}
+
+//
+// Image
+//
+
+typedef struct {
+    u32 Mask;
+    u32 Shift;
+    u32 Max;
+} CookChannelMask;
+
+internal CookChannelMask
+Cook_ChannelMaskMake(u32 mask) {
+    CookChannelMask result = {0};
+
+    if (mask == 0) {
+        return result;
+    }
+
+    result.Mask = mask;
+    while (((mask >> result.Shift) & 1) == 0) {
+        ++result.Shift;
+    }
+    result.Max = mask >> result.Shift;
+
+    return result;
+}
+
+internal u8
+Cook_ChannelExtract(CookChannelMask channel, u32 pixel, u8 fallback) {
+    if (channel.Mask == 0) {
+        return fallback;
+    }
+    u32 value = (pixel & channel.Mask) >> channel.Shift;
+    return (u8)((value * 255 + channel.Max / 2) / channel.Max);
+}
+
+internal u32
+Cook_ReadU32(const byte *data) {
+    return (u32)data[0] | (u32)data[1] << 8 | (u32)data[2] << 16 | (u32)data[3] << 24;
+}
+
+#define BMP_FILE_HEADER_SIZE 14
+
+internal CookResult
+Cook_Image(BlockAllocator *allocator, const void *source, usize sourceSize, CookOutput *output) {
+    if (sourceSize < sizeof(BmpHeader)) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    const byte *file = (const byte *)source;
+    BmpHeader header;
+    MemoryCopy(&header, source, sizeof(header));
+
+    if (header.type[0] != 'B' || header.type[1] != 'M' || header.dibHeaderSize < BI_BITMAPINFOHEADER) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    bool hasMasks = header.compression == BMPCOMPRESSION_BITFIELDS ||
+                    header.compression == BMPCOMPRESSION_ALPHABITFIELDS;
+
+    if (header.compression != BMPCOMPRESSION_RGB && !hasMasks) {
+        return COOK_ERR_UNSUPPORTED_FORMAT; // NOTE(ilya.a): RLE, JPEG and PNG payloads are not supported. [2026/10/18]
+    }
+
+    i32 signedHeight = (i32)header.height;
+    bool isTopDown = signedHeight < 0;
+    u32 width = header.width;
+    u32 height = (u32)(isTopDown ? -signedHeight : signedHeight);
+    u32 depth = header.depth;
+
+    if (width == 0 || height == 0 || (depth != 1 && depth != 4 && depth != 8 && depth != 16 && depth != 24 &&
+                                      depth != 32)) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    usize sourcePitch = (((usize)width * depth + 31) / 32) * 4;
+
+    if (header.dataOffset > sourceSize || sourcePitch * height > sourceSize - header.dataOffset) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    // NOTE(ilya.a): Masks are right after BITMAPINFOHEADER, or are part of V2+ headers,
+    // which ends up at the same offset. [2026/10/18]
+    usize masksOffset = BMP_FILE_HEADER_SIZE + BI_BITMAPINFOHEADER;
+    u32 redMask = 0, greenMask = 0, blueMask = 0, alphaMask = 0;
+
+    if (hasMasks && masksOffset + 12 <= sourceSize) {
+        redMask = Cook_ReadU32(file + masksOffset + 0);
+        greenMask = Cook_ReadU32(file + masksOffset + 4);
+        blueMask = Cook_ReadU32(file + masksOffset + 8);
+
+        bool hasAlphaMask =
+            header.compression == BMPCOMPRESSION_ALPHABITFIELDS || header.dibHeaderSize >= BI_BITMAPV3INFOHEADER;
+        if (hasAlphaMask && masksOffset + 16 <= sourceSize) {
+            alphaMask = Cook_ReadU32(file + masksOffset + 12);
+        }
+    } else if (depth == 16) {
+        redMask = 0x7C00, greenMask = 0x03E0, blueMask = 0x001F;
+    } else if (depth == 32) {
+        redMask = 0x00FF0000, greenMask = 0x0000FF00, blueMask = 0x000000FF;
+    }
+
+    CookChannelMask red = Cook_ChannelMaskMake(redMask);
+    CookChannelMask green = Cook_ChannelMaskMake(greenMask);
+    CookChannelMask blue = Cook_ChannelMaskMake(blueMask);
+    CookChannelMask alpha = Cook_ChannelMaskMake(alphaMask);
+
+    const byte *palette = file + BMP_FILE_HEADER_SIZE + header.dibHeaderSize;
+    u32 paletteCount = depth <= 8 ? (header.colorUsed != 0 ? header.colorUsed : (1u << depth)) : 0;
+
+    if (depth <= 8 && (usize)(palette - file) + paletteCount * 4 > sourceSize) {
+        return COOK_ERR_UNSUPPORTED_FORMAT;
+    }
+
+    usize pitch = (usize)width * COOKED_IMAGE_BPP;
+    Color4 *pixels = BlockAllocatorAlloc(allocator, pitch * height);
+
+    if (pixels == NULL) {
+        return COOK_ERR_FAILED_TO_ALLOC;
+    }
+
+    for (u32 y = 0; y < height; ++y) {
+        u32 sourceY = isTopDown ? y : height - 1 - y;
+        const byte *row = file + header.dataOffset + sourceY * sourcePitch;
+        Color4 *destination = pixels + (usize)y * width;
+
+        for (u32 x = 0; x < width; ++x) {
+            Color4 color = {0};
+
+            switch (depth) {
+            case 1:
+            case 4:
+            case 8: {
+                u32 bitOffset = x * depth;
+                u32 index = (row[bitOffset / 8] >> (8 - depth - bitOffset % 8)) & ((1u << depth) - 1);
+                if (index < paletteCount) {
+                    color.b = palette[index * 4 + 0];
+                    color.g = palette[index * 4 + 1];
+                    color.r = palette[index * 4 + 2];
+                }
+                color.a = U8_MAX;
+            } break;
+            case 24: {
+                color.b = row[x * 3 + 0];
+                color.g = row[x * 3 + 1];
+                color.r = row[x * 3 + 2];
+                color.a = U8_MAX;
+            } break;
+            case 16:
+            case 32: {
+                u32 pixel = depth == 16 ? (u32)(row[x * 2] | row[x * 2 + 1] << 8) : Cook_ReadU32(row + x * 4);
+                color.r = Cook_ChannelExtract(red, pixel, 0);
+                color.g = Cook_ChannelExtract(green, pixel, 0);
+                color.b = Cook_ChannelExtract(blue, pixel, 0);
+                color.a = Cook_ChannelExtract(alpha, pixel, U8_MAX);
+            } break;
+            }
+
+            destination[x] = color;
+        }
+    }
+
+    output->Header.Type = COOKED_ASSET_TYPE_IMAGE;
+    output->Header.PayloadSize = pitch * height;
+    output->Header.Image.Width = width;
+    output->Header.Image.Height = height;
+    output->Header.Image.Pitch = (u32)pitch;
+    output->Payload = pixels;
+
+    return COOK_OK;
+}
+
+//
+// Driver
+//
+
+internal CookResult
+Cook_WriteOutput(cstr8 outputPath, const CookOutput *output) {
+    FileHandle file;
+
+    if (IOCreateFile(outputPath, &file) != IO_OK) {
+        return COOK_ERR_FAILED_TO_WRITE;
+    }
+
+    usize paddingSize = output->Header.PayloadOffset - sizeof(output->Header);
+
+    bool isWritten = IOWriteBytesToFile(&file, &output->Header, sizeof(output->Header)) == IO_OK &&
+                     IOWriteBytesToFile(&file, gCookPadding, paddingSize) == IO_OK &&
+                     IOWriteBytesToFile(&file, output->Payload, output->Header.PayloadSize) == IO_OK;
+
+    IOCloseFile(&file);
+
+    return isWritten ? COOK_OK : COOK_ERR_FAILED_TO_WRITE;
+}
+
+internal CookResult
+Cook_Asset(cstr8 inputPath, cstr8 outputDirectory) {
+    cstr8 extension = Cook_GetExtension(inputPath);
+    bool isAudio = CStr8IsEqual(extension, ".wav") || CStr8IsEqual(extension, ".wave");
+    bool isImage = CStr8IsEqual(extension, ".bmp");
+
+    if (!isAudio && !isImage) {
+        return COOK_ERR_UNKNOWN_TYPE;
+    }
+
+    char8 outputPath[COOK_PATH_CAPACITY];
+    if (CStr8GetLength(outputDirectory) + CStr8GetLength(inputPath) + 16 > COOK_PATH_CAPACITY) {
+        return COOK_ERR_FAILED_TO_WRITE;
+    }
+    wsprintfA(outputPath, "%s/%s.cooked", outputDirectory, Cook_GetFileName(inputPath));
+
+    IOFileMapping source;
+
+    if (IOMapFile(inputPath, &source, IO_ACCESS_SEQUENTIAL | IO_ACCESS_WILLNEED) != IO_OK) {
+        return COOK_ERR_FAILED_TO_READ;
+    }
+
+    u64 sourceHash = BytesHash64(source.Data, source.Size);
+
+    if (Cook_IsUpToDate(outputPath, sourceHash)) {
+        IOUnmapFile(&source);
+        return COOK_SKIPPED;
+    }
+
+    BlockAllocator allocator = BlockAllocatorMake();
+
+    CookOutput output = {0};
+    output.Header.Magic = COOKED_MAGIC;
+    output.Header.Version = COOKED_VERSION;
+    output.Header.SourceHash = sourceHash;
+    output.Header.PayloadOffset = sizeof(CookedAssetHeader);
+
+    CookResult result = isAudio ? Cook_Audio(&allocator, source.Data, source.Size, &output)
+                                : Cook_Image(&allocator, source.Data, source.Size, &output);
+
+    if (result == COOK_OK) {
+        result = Cook_WriteOutput(outputPath, &output);
+    }
+
+    BlockAllocatorFree(&allocator);
+    IOUnmapFile(&source);
+
+    return result;
+}
+
+internal DWORD WINAPI
+Cook_WorkerProc(LPVOID parameter) {
+    CookContext *context = (CookContext *)parameter;
+
+    while (true) {
+        LONG inputIndex = InterlockedIncrement(&context->NextInput) - 1;
+
+        if (inputIndex >= (LONG)context->InputCount) {
+            break;
+        }
+
+        cstr8 inputPath = context->Inputs[inputIndex];
+        CookResult result = Cook_Asset(inputPath, context->OutputDirectory);
+
+        char8 printBuffer[COOK_PATH_CAPACITY + 64];
+
+        if (result == COOK_OK) {
+            InterlockedIncrement(&context->CookedCount);
+            wsprintfA(printBuffer, "I: Cooked '%s'\n", inputPath);
+        } else if (result == COOK_SKIPPED) {
+            InterlockedIncrement(&context->SkippedCount);
+            wsprintfA(printBuffer, "I: Up to date '%s'\n", inputPath);
+        } else {
+            InterlockedIncrement(&context->FailedCount);
+            wsprintfA(printBuffer, "E: Failed to cook '%s' (error %d)\n", inputPath, (int)result);
+        }
+
+        Win32_Print(printBuffer);
+    }
+
+    return 0;
+}
+
+int
+main(int argc, char **argv) {
+    if (argc < 3) {
+        Win32_Print("Usage: gfs_cook <output directory> <asset path>...\n");
+        return 1;
+    }
+
+    Sys_Init();
+
+    CookContext context = {0};
+    context.OutputDirectory = argv[1];
+    context.Inputs = (cstr8 *)(argv + 2);
+    context.InputCount = (u32)(argc - 2);
+
+    if (Cook_IsFileNameCollision(context.Inputs, context.InputCount)) {
+        return 1;
+    }
+
+    CreateDirectoryA(context.OutputDirectory, NULL); // NOTE(ilya.a): Fails if it already exists, which is fine.
+
+    u32 workerCount = Sys_GetInfo()->LogicalCoreCount;
+    if (workerCount > context.InputCount) {
+        workerCount = context.InputCount;
+    }
+    if (workerCount > COOK_WORKER_COUNT_MAX) {
+        workerCount = COOK_WORKER_COUNT_MAX;
+    }
+
+    HANDLE workers[COOK_WORKER_COUNT_MAX];
+    u32 spawnedCount = 0;
+
+    for (u32 workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+        HANDLE worker = CreateThread(NULL, 0, Cook_WorkerProc, &context, 0, NULL);
+        if (worker != NULL) {
+            workers[spawnedCount++] = worker;
+        }
+    }
+
+    // NOTE(ilya.a): Main thread is a worker too. [2026/10/18]
+    Cook_WorkerProc(&context);
+
+    for (u32 workerIndex = 0; workerIndex < spawnedCount; ++workerIndex) {
+        WaitForSingleObject(workers[workerIndex], INFINITE);
+        CloseHandle(workers[workerIndex]);
+    }
+
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I: %d cooked, %d up to date, %d failed\n", context.CookedCount, context.SkippedCount,
+        context.FailedCount);
+    Win32_Print(printBuffer);
+
+    return context.FailedCount == 0 ? 0 : 1;
+}
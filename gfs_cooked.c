@@ -0,0 +1,40 @@
+/*
+ * FILE      gfs_cooked.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_cooked.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+CookedAssetLoadResult
+CookedAssetLoadFromMemory(const void *buffer, usize bufferSize, CookedAsset *assetOut) {
+    if (buffer == NULL || assetOut == NULL) {
+        return COOKED_ASSET_LOAD_ERR_INVALID_ARGS;
+    }
+
+    if (bufferSize < sizeof(CookedAssetHeader)) {
+        return COOKED_ASSET_LOAD_ERR_TRUNCATED;
+    }
+
+    const CookedAssetHeader *header = (const CookedAssetHeader *)buffer;
+
+    if (header->Magic != COOKED_MAGIC) {
+        return COOKED_ASSET_LOAD_ERR_INVALID_MAGIC;
+    }
+
+    if (header->Version != COOKED_VERSION) {
+        return COOKED_ASSET_LOAD_ERR_UNSUPPORTED_VERSION;
+    }
+
+    if (header->PayloadOffset > bufferSize || header->PayloadSize > bufferSize - header->PayloadOffset) {
+        return COOKED_ASSET_LOAD_ERR_TRUNCATED;
+    }
+
+    assetOut->Header = header;
+    assetOut->Payload = (const byte *)buffer + header->PayloadOffset;
+
+    return COOKED_ASSET_LOAD_OK;
+}
@@ -0,0 +1,83 @@
+/*
+ * GFS. Cooked assets.
+ *
+ * Assets, which were converted offline by `gfs_cook` into exactly the layout runtime uses:
+ * audio is 48 kHz stereo interleaved i16, images are top-down BGRA. Payload is aligned, so
+ * cooked file (or pack entry) could be used in place, without copying or converting anything.
+ *
+ * FILE      gfs_cooked.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_COOKED_H_INCLUDED
+#define GFS_COOKED_H_INCLUDED
+
+#include "gfs_assert.h"
+#include "gfs_types.h"
+
+#define COOKED_MAGIC 0x4B4F4347 // "GCOK" in little endian.
+#define COOKED_VERSION 3 // 2: Audio is dithered. 3: Audio is resampled with band-limited filter.
+
+#define COOKED_PAYLOAD_ALIGNMENT 64
+
+#define COOKED_AUDIO_SAMPLE_RATE 48000
+#define COOKED_AUDIO_CHANNEL_COUNT 2
+#define COOKED_IMAGE_BPP 4
+
+typedef enum {
+    COOKED_ASSET_TYPE_AUDIO = 1,
+    COOKED_ASSET_TYPE_IMAGE = 2,
+} CookedAssetType;
+
+typedef struct {
+    u32 Magic;
+    u32 Version;
+    u32 Type; // CookedAssetType
+    u32 Reserved0;
+
+    u64 SourceHash; // Hash of source file content. Used to skip unchanged inputs.
+    u64 PayloadOffset;
+    u64 PayloadSize;
+
+    union {
+        struct {
+            u32 SampleRate;
+            u32 ChannelCount;
+            u64 FrameCount;
+        } Audio;
+
+        struct {
+            u32 Width;
+            u32 Height;
+            u32 Pitch; // Bytes per row.
+            u32 Reserved;
+        } Image;
+    };
+
+    u64 Reserved1;
+} CookedAssetHeader;
+
+GFS_EXPECT_TYPE_SIZE(CookedAssetHeader, 64);
+
+typedef struct {
+    const CookedAssetHeader *Header;
+    const void *Payload;
+} CookedAsset;
+
+typedef enum {
+    COOKED_ASSET_LOAD_OK,
+    COOKED_ASSET_LOAD_ERR_INVALID_ARGS,
+    COOKED_ASSET_LOAD_ERR_INVALID_MAGIC,
+    COOKED_ASSET_LOAD_ERR_UNSUPPORTED_VERSION,
+    COOKED_ASSET_LOAD_ERR_TRUNCATED,
+} CookedAssetLoadResult;
+
+/*
+ * Makes view of cooked asset, which is already in memory. Nothing is copied, so `buffer`
+ * should outlive the asset. Buffer is expected to be aligned to `COOKED_PAYLOAD_ALIGNMENT`
+ * (mappings and pack entries are).
+ */
+CookedAssetLoadResult CookedAssetLoadFromMemory(const void *buffer, usize bufferSize, CookedAsset *assetOut);
+
+#endif // GFS_COOKED_H_INCLUDED
@@ -0,0 +1,582 @@
+/*
+ * FILE      gfs_dsp.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_dsp.h"
+
+#include <math.h>
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+
+#define DSP_PI 3.14159265358979323846f
+
+#define DSP_FREQUENCY_MIN 10.0f
+#define DSP_NYQUIST_FRACTION_MAX 0.49f
+#define DSP_Q_MIN 0.1f
+#define DSP_FEEDBACK_MAX 0.99f
+
+internal f32
+DSP_Clamp(f32 value, f32 minimum, f32 maximum) {
+    return value < minimum ? minimum : (value > maximum ? maximum : value);
+}
+
+internal f32
+DSP_Max(f32 a, f32 b) {
+    return a > b ? a : b;
+}
+
+/*
+ * Clamps parameter into range, which node supports.
+ */
+internal f32
+DSP_ClampParameter(const DSPChain *chain, const DSPNode *node, DSPParam parameter, f32 value) {
+    switch (parameter) {
+    case DSP_PARAM_FREQUENCY: {
+        return DSP_Clamp(value, DSP_FREQUENCY_MIN, (f32)chain->SampleRate * DSP_NYQUIST_FRACTION_MAX);
+    } break;
+    case DSP_PARAM_Q: {
+        return value < DSP_Q_MIN ? DSP_Q_MIN : value;
+    } break;
+    case DSP_PARAM_DELAY: {
+        if (node->Type != DSP_NODE_DELAY) {
+            return value;
+        }
+
+        // NOTE(ilya.a): Delay is at least a frame, so it never reads frame, which isn't written yet. [2026/10/18]
+        f32 maximum = (f32)(node->Delay.FrameCount - 2) / (f32)chain->SampleRate;
+        return DSP_Clamp(value, 1.0f / (f32)chain->SampleRate, maximum);
+    } break;
+    case DSP_PARAM_FEEDBACK: {
+        return DSP_Clamp(value, 0.0f, DSP_FEEDBACK_MAX);
+    } break;
+    case DSP_PARAM_MIX: {
+        return DSP_Clamp(value, 0.0f, 1.0f);
+    } break;
+    default: {
+        return value;
+    } break;
+    }
+}
+
+/*
+ * Moves parameters towards their targets by one block. Values before the move are put into
+ * `startOut`, so they could be ramped within the block.
+ */
+internal void
+DSP_SmoothParameters(const DSPChain *chain, DSPNode *node, usize frameCount, f32 *startOut) {
+    f32 alpha = 1.0f - expf(-(f32)frameCount / (DSP_SMOOTHING_SECONDS * (f32)chain->SampleRate));
+
+    for (u32 parameterIndex = 0; parameterIndex < DSP_PARAM_COUNT; ++parameterIndex) {
+        f32 current = node->Parameters[parameterIndex];
+        f32 target = node->TargetParameters[parameterIndex];
+        f32 difference = target - current;
+
+        startOut[parameterIndex] = current;
+
+        // NOTE(ilya.a): Exponential approach never arrives, so it snaps once difference is inaudible. [2026/10/18]
+        if (fabsf(difference) <= 1e-4f * fabsf(target) + 1e-6f) {
+            node->Parameters[parameterIndex] = target;
+        } else {
+            node->Parameters[parameterIndex] = current + difference * alpha;
+        }
+    }
+}
+
+internal void
+DSP_SnapParameters(DSPNode *node) {
+    MemoryCopy(node->Parameters, node->TargetParameters, sizeof(node->Parameters));
+}
+
+internal f32
+DSP_GetPeak(const f32 *samples, usize sampleCount) {
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 peak = _mm_setzero_ps();
+    usize sampleIndex = 0;
+
+    for (; sampleIndex + 4 <= sampleCount; sampleIndex += 4) {
+        peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, _mm_loadu_ps(samples + sampleIndex)));
+    }
+
+    f32 lanes[4];
+    _mm_storeu_ps(lanes, peak);
+    f32 result = DSP_Max(DSP_Max(lanes[0], lanes[1]), DSP_Max(lanes[2], lanes[3]));
+
+    for (; sampleIndex < sampleCount; ++sampleIndex) {
+        result = DSP_Max(result, fabsf(samples[sampleIndex]));
+    }
+
+    return result;
+}
+
+//
+// Biquad.
+//
+
+/*
+ * Coefficients from Robert Bristow-Johnson's "Audio EQ Cookbook", same for every stage.
+ */
+internal void
+DSP_BiquadUpdate(DSPBiquad *biquad, u32 sampleRate, f32 frequency, f32 q) {
+    if (biquad->Frequency == frequency && biquad->Q == q) {
+        return;
+    }
+
+    f32 w0 = 2.0f * DSP_PI * frequency / (f32)sampleRate;
+    f32 cosW0 = cosf(w0);
+    f32 alpha = sinf(w0) / (2.0f * q);
+
+    f32 b0 = 0.0f;
+    f32 b1 = 0.0f;
+    f32 b2 = 0.0f;
+
+    switch (biquad->Type) {
+    case DSP_BIQUAD_LOWPASS: {
+        b0 = (1.0f - cosW0) * 0.5f;
+        b1 = 1.0f - cosW0;
+        b2 = b0;
+    } break;
+    case DSP_BIQUAD_HIGHPASS: {
+        b0 = (1.0f + cosW0) * 0.5f;
+        b1 = -(1.0f + cosW0);
+        b2 = b0;
+    } break;
+    case DSP_BIQUAD_BANDPASS: {
+        b0 = alpha;
+        b1 = 0.0f;
+        b2 = -alpha;
+    } break;
+    }
+
+    f32 a0 = 1.0f + alpha;
+    u32 laneCount = biquad->StageCount * DSP_CHANNEL_COUNT;
+
+    for (u32 laneIndex = 0; laneIndex < laneCount; ++laneIndex) {
+        biquad->B0[laneIndex] = b0 / a0;
+        biquad->B1[laneIndex] = b1 / a0;
+        biquad->B2[laneIndex] = b2 / a0;
+        biquad->A1[laneIndex] = 2.0f * cosW0 / a0;
+        biquad->A2[laneIndex] = -(1.0f - alpha) / a0;
+    }
+
+    biquad->Frequency = frequency;
+    biquad->Q = q;
+}
+
+/*
+ * Every step: stage inputs are shifted by one stage (two lanes), chain input goes into the first
+ * stage, all stages are computed at once. Output is taken from the last stage.
+ */
+internal void
+DSP_BiquadProcessAVX2(DSPBiquad *biquad, f32 *samples, usize frameCount) {
+    __m256 b0 = _mm256_loadu_ps(biquad->B0);
+    __m256 b1 = _mm256_loadu_ps(biquad->B1);
+    __m256 b2 = _mm256_loadu_ps(biquad->B2);
+    __m256 a1 = _mm256_loadu_ps(biquad->A1);
+    __m256 a2 = _mm256_loadu_ps(biquad->A2);
+
+    __m256 x1 = _mm256_loadu_ps(biquad->X1);
+    __m256 x2 = _mm256_loadu_ps(biquad->X2);
+    __m256 y1 = _mm256_loadu_ps(biquad->Y1);
+    __m256 y2 = _mm256_loadu_ps(biquad->Y2);
+
+    i32 outputLane = (i32)(biquad->StageCount - 1) * DSP_CHANNEL_COUNT;
+    __m256i shift = _mm256_setr_epi32(0, 1, 0, 1, 2, 3, 4, 5);
+    __m256i output = _mm256_setr_epi32(outputLane, outputLane + 1, 0, 0, 0, 0, 0, 0);
+
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        f32 *frame = samples + frameIndex * DSP_CHANNEL_COUNT;
+        __m128 input = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)frame);
+        __m256 inputs = _mm256_castpd_ps(_mm256_broadcastsd_pd(_mm_castps_pd(input)));
+        __m256 x = _mm256_blend_ps(_mm256_permutevar8x32_ps(y1, shift), inputs, 0x03);
+
+        __m256 y = _mm256_mul_ps(b0, x);
+        y = _mm256_fmadd_ps(b1, x1, y);
+        y = _mm256_fmadd_ps(b2, x2, y);
+        y = _mm256_fmadd_ps(a1, y1, y);
+        y = _mm256_fmadd_ps(a2, y2, y);
+
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+
+        _mm_storel_pi((__m64 *)frame, _mm256_castps256_ps128(_mm256_permutevar8x32_ps(y, output)));
+    }
+
+    _mm256_storeu_ps(biquad->X1, x1);
+    _mm256_storeu_ps(biquad->X2, x2);
+    _mm256_storeu_ps(biquad->Y1, y1);
+    _mm256_storeu_ps(biquad->Y2, y2);
+}
+
+/*
+ * Same as AVX2 version, but lanes are split into two vectors: stages 0-1 and 2-3.
+ */
+internal void
+DSP_BiquadProcessSSE2(DSPBiquad *biquad, f32 *samples, usize frameCount) {
+    __m128 b0[2] = {_mm_loadu_ps(biquad->B0), _mm_loadu_ps(biquad->B0 + 4)};
+    __m128 b1[2] = {_mm_loadu_ps(biquad->B1), _mm_loadu_ps(biquad->B1 + 4)};
+    __m128 b2[2] = {_mm_loadu_ps(biquad->B2), _mm_loadu_ps(biquad->B2 + 4)};
+    __m128 a1[2] = {_mm_loadu_ps(biquad->A1), _mm_loadu_ps(biquad->A1 + 4)};
+    __m128 a2[2] = {_mm_loadu_ps(biquad->A2), _mm_loadu_ps(biquad->A2 + 4)};
+
+    __m128 x1[2] = {_mm_loadu_ps(biquad->X1), _mm_loadu_ps(biquad->X1 + 4)};
+    __m128 x2[2] = {_mm_loadu_ps(biquad->X2), _mm_loadu_ps(biquad->X2 + 4)};
+    __m128 y1[2] = {_mm_loadu_ps(biquad->Y1), _mm_loadu_ps(biquad->Y1 + 4)};
+    __m128 y2[2] = {_mm_loadu_ps(biquad->Y2), _mm_loadu_ps(biquad->Y2 + 4)};
+
+    u32 vectorCount = biquad->StageCount > 2 ? 2 : 1;
+    u32 outputVector = (biquad->StageCount - 1) / 2;
+    bool isOutputHigh = (biquad->StageCount & 1) == 0;
+
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        f32 *frame = samples + frameIndex * DSP_CHANNEL_COUNT;
+        __m128 input = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)frame);
+
+        __m128 x[2];
+        x[0] = _mm_movelh_ps(input, y1[0]);
+        x[1] = _mm_shuffle_ps(y1[0], y1[1], _MM_SHUFFLE(1, 0, 3, 2));
+
+        for (u32 vectorIndex = 0; vectorIndex < vectorCount; ++vectorIndex) {
+            __m128 y = _mm_mul_ps(b0[vectorIndex], x[vectorIndex]);
+            y = _mm_add_ps(y, _mm_mul_ps(b1[vectorIndex], x1[vectorIndex]));
+            y = _mm_add_ps(y, _mm_mul_ps(b2[vectorIndex], x2[vectorIndex]));
+            y = _mm_add_ps(y, _mm_mul_ps(a1[vectorIndex], y1[vectorIndex]));
+            y = _mm_add_ps(y, _mm_mul_ps(a2[vectorIndex], y2[vectorIndex]));
+
+            x2[vectorIndex] = x1[vectorIndex];
+            x1[vectorIndex] = x[vectorIndex];
+            y2[vectorIndex] = y1[vectorIndex];
+            y1[vectorIndex] = y;
+        }
+
+        if (isOutputHigh) {
+            _mm_storeh_pi((__m64 *)frame, y1[outputVector]);
+        } else {
+            _mm_storel_pi((__m64 *)frame, y1[outputVector]);
+        }
+    }
+
+    for (u32 vectorIndex = 0; vectorIndex < 2; ++vectorIndex) {
+        _mm_storeu_ps(biquad->X1 + vectorIndex * 4, x1[vectorIndex]);
+        _mm_storeu_ps(biquad->X2 + vectorIndex * 4, x2[vectorIndex]);
+        _mm_storeu_ps(biquad->Y1 + vectorIndex * 4, y1[vectorIndex]);
+        _mm_storeu_ps(biquad->Y2 + vectorIndex * 4, y2[vectorIndex]);
+    }
+}
+
+internal void
+DSP_BiquadProcess(DSPChain *chain, DSPNode *node, f32 *samples, usize frameCount, bool isInputSilent) {
+    DSPBiquad *biquad = &node->Biquad;
+    f32 start[DSP_PARAM_COUNT];
+
+    DSP_SmoothParameters(chain, node, frameCount, start);
+    DSP_BiquadUpdate(biquad, chain->SampleRate, node->Parameters[DSP_PARAM_FREQUENCY], node->Parameters[DSP_PARAM_Q]);
+
+    if (chain->IsAVX2Enabled) {
+        DSP_BiquadProcessAVX2(biquad, samples, frameCount);
+    } else {
+        DSP_BiquadProcessSSE2(biquad, samples, frameCount);
+    }
+
+    node->IsIdle = false;
+
+    if (isInputSilent && DSP_GetPeak(samples, frameCount * DSP_CHANNEL_COUNT) < chain->SilenceThreshold) {
+        f32 statePeak = DSP_Max(
+            DSP_Max(DSP_GetPeak(biquad->X1, DSP_BIQUAD_LANE_COUNT), DSP_GetPeak(biquad->X2, DSP_BIQUAD_LANE_COUNT)),
+            DSP_Max(DSP_GetPeak(biquad->Y1, DSP_BIQUAD_LANE_COUNT), DSP_GetPeak(biquad->Y2, DSP_BIQUAD_LANE_COUNT)));
+
+        // NOTE(ilya.a): Zeroing the state, so decayed tail doesn't end up in denormals. [2026/10/18]
+        if (statePeak < chain->SilenceThreshold) {
+            MemoryZero(biquad->X1, sizeof(biquad->X1));
+            MemoryZero(biquad->X2, sizeof(biquad->X2));
+            MemoryZero(biquad->Y1, sizeof(biquad->Y1));
+            MemoryZero(biquad->Y2, sizeof(biquad->Y2));
+            node->IsIdle = true;
+        }
+    }
+}
+
+//
+// Gain.
+//
+
+internal void
+DSP_GainProcess(DSPChain *chain, DSPNode *node, f32 *samples, usize frameCount, bool isInputSilent) {
+    f32 start[DSP_PARAM_COUNT];
+    DSP_SmoothParameters(chain, node, frameCount, start);
+
+    // NOTE(ilya.a): Gain has no state, so silence stays silence. [2026/10/18]
+    node->IsIdle = isInputSilent;
+    if (isInputSilent) {
+        return;
+    }
+
+    f32 gain = start[DSP_PARAM_GAIN];
+    f32 step = (node->Parameters[DSP_PARAM_GAIN] - gain) / (f32)frameCount;
+
+    // NOTE(ilya.a): Two frames per vector, so both frames of the pair have their own gain. [2026/10/18]
+    __m128 gains = _mm_setr_ps(gain + step, gain + step, gain + step * 2.0f, gain + step * 2.0f);
+    __m128 gainStep = _mm_set1_ps(step * 2.0f);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 2 <= frameCount; frameIndex += 2) {
+        f32 *frames = samples + frameIndex * DSP_CHANNEL_COUNT;
+        _mm_storeu_ps(frames, _mm_mul_ps(_mm_loadu_ps(frames), gains));
+        gains = _mm_add_ps(gains, gainStep);
+    }
+
+    for (; frameIndex < frameCount; ++frameIndex) {
+        f32 frameGain = gain + step * (f32)(frameIndex + 1);
+        samples[frameIndex * DSP_CHANNEL_COUNT + 0] *= frameGain;
+        samples[frameIndex * DSP_CHANNEL_COUNT + 1] *= frameGain;
+    }
+}
+
+//
+// Delay.
+//
+
+internal void
+DSP_DelayProcess(DSPChain *chain, DSPNode *node, f32 *samples, usize frameCount, bool isInputSilent) {
+    DSPDelay *delay = &node->Delay;
+    f32 start[DSP_PARAM_COUNT];
+
+    DSP_SmoothParameters(chain, node, frameCount, start);
+
+    f32 sampleRate = (f32)chain->SampleRate;
+    f32 delayFrames = start[DSP_PARAM_DELAY] * sampleRate;
+    f32 delayStep = (node->Parameters[DSP_PARAM_DELAY] * sampleRate - delayFrames) / (f32)frameCount;
+    f32 feedback = start[DSP_PARAM_FEEDBACK];
+    f32 feedbackStep = (node->Parameters[DSP_PARAM_FEEDBACK] - feedback) / (f32)frameCount;
+    f32 mix = start[DSP_PARAM_MIX];
+    f32 mixStep = (node->Parameters[DSP_PARAM_MIX] - mix) / (f32)frameCount;
+
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 peak = _mm_setzero_ps();
+    f32 *buffer = delay->Buffer;
+    u32 writeFrame = delay->WriteFrame;
+
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        delayFrames += delayStep;
+        feedback += feedbackStep;
+        mix += mixStep;
+
+        // NOTE(ilya.a): Fractional delay: linear interpolation between two frames around it.
+        // Delay is at least one frame, so the newer one is always written already. [2026/10/18]
+        u32 wholeFrames = (u32)delayFrames;
+        __m128 fraction = _mm_set1_ps(delayFrames - (f32)wholeFrames);
+        u32 newerFrame = (writeFrame + delay->FrameCount - wholeFrames) % delay->FrameCount;
+        u32 olderFrame = newerFrame == 0 ? delay->FrameCount - 1 : newerFrame - 1;
+
+        __m128 newer = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(buffer + newerFrame * DSP_CHANNEL_COUNT));
+        __m128 older = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(buffer + olderFrame * DSP_CHANNEL_COUNT));
+        __m128 delayed = _mm_add_ps(newer, _mm_mul_ps(_mm_sub_ps(older, newer), fraction));
+
+        f32 *frame = samples + frameIndex * DSP_CHANNEL_COUNT;
+        __m128 input = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)frame);
+        __m128 written = _mm_add_ps(input, _mm_mul_ps(delayed, _mm_set1_ps(feedback)));
+        __m128 output = _mm_add_ps(input, _mm_mul_ps(_mm_sub_ps(delayed, input), _mm_set1_ps(mix)));
+
+        _mm_storel_pi((__m64 *)(buffer + writeFrame * DSP_CHANNEL_COUNT), written);
+        _mm_storel_pi((__m64 *)frame, output);
+        peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, delayed));
+
+        writeFrame = writeFrame + 1 == delay->FrameCount ? 0 : writeFrame + 1;
+    }
+
+    delay->WriteFrame = writeFrame;
+    node->IsIdle = false;
+
+    if (!isInputSilent) {
+        delay->SilentFrames = 0;
+        delay->SilentPeak = 0.0f;
+        return;
+    }
+
+    // NOTE(ilya.a): Every frame of the line is read once per delay time. So, if everything read
+    // during one delay time of silence is below threshold, the whole line is. [2026/10/18]
+    f32 lanes[4];
+    _mm_storeu_ps(lanes, peak);
+    delay->SilentPeak = DSP_Max(delay->SilentPeak, DSP_Max(lanes[0], lanes[1]));
+    delay->SilentFrames += (u32)frameCount;
+
+    if (delay->SilentFrames >= (u32)ceilf(delayFrames) + 1) {
+        if (delay->SilentPeak < chain->SilenceThreshold) {
+            MemoryZero(delay->Buffer, delay->FrameCount * DSP_CHANNEL_COUNT * sizeof(f32));
+            node->IsIdle = true;
+        }
+
+        delay->SilentFrames = 0;
+        delay->SilentPeak = 0.0f;
+    }
+}
+
+//
+// Chain.
+//
+
+void
+DSPChainInit(DSPChain *chain, u32 sampleRate, f32 silenceThreshold) {
+    MemoryZero(chain, sizeof(*chain));
+    chain->SampleRate = sampleRate;
+    chain->IsAVX2Enabled = SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA);
+    chain->SilenceThreshold = silenceThreshold;
+}
+
+void
+DSPChainDestroy(DSPChain *chain) {
+    if (chain == NULL) {
+        return;
+    }
+
+    for (u32 nodeIndex = 0; nodeIndex < chain->NodeCount; ++nodeIndex) {
+        if (chain->Nodes[nodeIndex].Type == DSP_NODE_DELAY) {
+            ScratchAllocatorFree(&chain->Nodes[nodeIndex].Delay.Memory);
+        }
+    }
+
+    MemoryZero(chain, sizeof(*chain));
+}
+
+internal DSPNode *
+DSP_AddNode(DSPChain *chain, DSPNodeType type) {
+    if (chain == NULL || chain->NodeCount >= DSP_CHAIN_NODE_COUNT_MAX) {
+        return NULL;
+    }
+
+    DSPNode *node = &chain->Nodes[chain->NodeCount];
+    MemoryZero(node, sizeof(*node));
+    node->Type = type;
+    node->IsIdle = true;
+
+    return node;
+}
+
+internal void
+DSP_InitParameter(DSPChain *chain, DSPNode *node, DSPParam parameter, f32 value) {
+    value = DSP_ClampParameter(chain, node, parameter, value);
+    node->Parameters[parameter] = value;
+    node->TargetParameters[parameter] = value;
+}
+
+DSPNodeID
+DSPChainAddBiquad(DSPChain *chain, DSPBiquadType type, u32 stageCount, f32 frequency, f32 q) {
+    if (stageCount == 0 || stageCount > DSP_BIQUAD_STAGE_COUNT_MAX) {
+        return DSP_NODE_INVALID;
+    }
+
+    DSPNode *node = DSP_AddNode(chain, DSP_NODE_BIQUAD);
+
+    if (node == NULL) {
+        return DSP_NODE_INVALID;
+    }
+
+    node->Biquad.Type = type;
+    node->Biquad.StageCount = stageCount;
+
+    DSP_InitParameter(chain, node, DSP_PARAM_FREQUENCY, frequency);
+    DSP_InitParameter(chain, node, DSP_PARAM_Q, q);
+    DSP_BiquadUpdate(
+        &node->Biquad, chain->SampleRate, node->Parameters[DSP_PARAM_FREQUENCY], node->Parameters[DSP_PARAM_Q]);
+
+    return ++chain->NodeCount;
+}
+
+DSPNodeID
+DSPChainAddGain(DSPChain *chain, f32 gain) {
+    DSPNode *node = DSP_AddNode(chain, DSP_NODE_GAIN);
+
+    if (node == NULL) {
+        return DSP_NODE_INVALID;
+    }
+
+    DSP_InitParameter(chain, node, DSP_PARAM_GAIN, gain);
+
+    return ++chain->NodeCount;
+}
+
+DSPNodeID
+DSPChainAddDelay(DSPChain *chain, f32 maxSeconds, f32 seconds, f32 feedback, f32 mix) {
+    if (chain == NULL || maxSeconds <= 0.0f) {
+        return DSP_NODE_INVALID;
+    }
+
+    DSPNode *node = DSP_AddNode(chain, DSP_NODE_DELAY);
+
+    if (node == NULL) {
+        return DSP_NODE_INVALID;
+    }
+
+    // NOTE(ilya.a): Two extra frames: one for the frame being written, one for interpolation. [2026/10/18]
+    u32 frameCount = (u32)ceilf(maxSeconds * (f32)chain->SampleRate) + 2;
+    usize bufferSize = (usize)frameCount * DSP_CHANNEL_COUNT * sizeof(f32);
+
+    node->Delay.Memory = ScratchAllocatorMake(bufferSize);
+    node->Delay.Buffer = ScratchAllocatorAlloc(&node->Delay.Memory, bufferSize);
+
+    if (node->Delay.Buffer == NULL) {
+        ScratchAllocatorFree(&node->Delay.Memory);
+        return DSP_NODE_INVALID;
+    }
+
+    MemoryZero(node->Delay.Buffer, bufferSize);
+    node->Delay.FrameCount = frameCount;
+
+    DSP_InitParameter(chain, node, DSP_PARAM_DELAY, seconds);
+    DSP_InitParameter(chain, node, DSP_PARAM_FEEDBACK, feedback);
+    DSP_InitParameter(chain, node, DSP_PARAM_MIX, mix);
+
+    return ++chain->NodeCount;
+}
+
+void
+DSPChainSetParameter(DSPChain *chain, DSPNodeID id, DSPParam parameter, f32 value) {
+    if (chain == NULL || id == DSP_NODE_INVALID || id > chain->NodeCount || parameter >= DSP_PARAM_COUNT) {
+        return;
+    }
+
+    DSPNode *node = &chain->Nodes[id - 1];
+    node->TargetParameters[parameter] = DSP_ClampParameter(chain, node, parameter, value);
+}
+
+bool
+DSPChainProcess(DSPChain *chain, f32 *samples, usize frameCount, bool isInputSilent) {
+    bool isSilent = isInputSilent;
+
+    if (frameCount == 0) {
+        return isSilent;
+    }
+
+    for (u32 nodeIndex = 0; nodeIndex < chain->NodeCount; ++nodeIndex) {
+        DSPNode *node = &chain->Nodes[nodeIndex];
+
+        // NOTE(ilya.a): Bypassed node has nothing to smooth towards, so parameters just jump. [2026/10/18]
+        if (isSilent && node->IsIdle) {
+            DSP_SnapParameters(node);
+            continue;
+        }
+
+        switch (node->Type) {
+        case DSP_NODE_BIQUAD: {
+            DSP_BiquadProcess(chain, node, samples, frameCount, isSilent);
+        } break;
+        case DSP_NODE_GAIN: {
+            DSP_GainProcess(chain, node, samples, frameCount, isSilent);
+        } break;
+        case DSP_NODE_DELAY: {
+            DSP_DelayProcess(chain, node, samples, frameCount, isSilent);
+        } break;
+        }
+
+        isSilent = node->IsIdle;
+    }
+
+    return isSilent;
+}
@@ -0,0 +1,142 @@
+/*
+ * GFS. Block-based DSP effects chain.
+ *
+ * Chain is a list of nodes (biquad filters, gain ramps, delay lines), which process interleaved
+ * stereo f32 block in place. Work is done per block, never per sample call: biquad cascade runs
+ * every channel of every stage in its own SIMD lane (stage N filters output, which stage N - 1
+ * produced one frame earlier), delay line processes both channels at once.
+ *
+ * Parameter changes are smoothed: target is approached exponentially block by block, and within
+ * block gain, feedback, mix and delay time are ramped linearly per frame. Filter coefficients are
+ * recomputed once per block. Nodes, which get silence and whose tail has already decayed below
+ * the silence threshold, are bypassed entirely.
+ *
+ * FILE      gfs_dsp.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_DSP_H_INCLUDED
+#define GFS_DSP_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+
+#define DSP_CHANNEL_COUNT 2
+#define DSP_CHAIN_NODE_COUNT_MAX 8
+#define DSP_BIQUAD_STAGE_COUNT_MAX 4
+#define DSP_BIQUAD_LANE_COUNT (DSP_BIQUAD_STAGE_COUNT_MAX * DSP_CHANNEL_COUNT)
+#define DSP_SMOOTHING_SECONDS 0.02f // Time constant of parameter smoothing.
+
+/*
+ * Index of node in the chain plus one. Zero is never valid.
+ */
+typedef u32 DSPNodeID;
+
+#define DSP_NODE_INVALID 0
+
+typedef enum {
+    DSP_NODE_BIQUAD,
+    DSP_NODE_GAIN,
+    DSP_NODE_DELAY,
+} DSPNodeType;
+
+typedef enum {
+    DSP_BIQUAD_LOWPASS,
+    DSP_BIQUAD_HIGHPASS,
+    DSP_BIQUAD_BANDPASS, // Zero gain at the center.
+} DSPBiquadType;
+
+typedef enum {
+    DSP_PARAM_GAIN,      // Gain node. Linear.
+    DSP_PARAM_FREQUENCY, // Biquad node. Hz.
+    DSP_PARAM_Q,         // Biquad node.
+    DSP_PARAM_DELAY,     // Delay node. Seconds, up to maximum given on creation.
+    DSP_PARAM_FEEDBACK,  // Delay node. From 0 to 1 (exclusive).
+    DSP_PARAM_MIX,       // Delay node. Zero is dry only, one is wet only.
+    DSP_PARAM_COUNT,
+} DSPParam;
+
+/*
+ * Coefficients and state per lane. Lane is `stage * DSP_CHANNEL_COUNT + channel`. Feedback
+ * coefficients are stored negated.
+ */
+typedef struct {
+    DSPBiquadType Type;
+    u32 StageCount;
+    f32 Frequency; // Coefficients were computed for.
+    f32 Q;
+
+    f32 B0[DSP_BIQUAD_LANE_COUNT];
+    f32 B1[DSP_BIQUAD_LANE_COUNT];
+    f32 B2[DSP_BIQUAD_LANE_COUNT];
+    f32 A1[DSP_BIQUAD_LANE_COUNT];
+    f32 A2[DSP_BIQUAD_LANE_COUNT];
+
+    f32 X1[DSP_BIQUAD_LANE_COUNT];
+    f32 X2[DSP_BIQUAD_LANE_COUNT];
+    f32 Y1[DSP_BIQUAD_LANE_COUNT];
+    f32 Y2[DSP_BIQUAD_LANE_COUNT];
+} DSPBiquad;
+
+typedef struct {
+    ScratchAllocator Memory;
+    f32 *Buffer; // Interleaved stereo ring.
+    u32 FrameCount;
+    u32 WriteFrame;
+
+    u32 SilentFrames; // Since input became silent.
+    f32 SilentPeak;   // Peak read from the line, since `SilentFrames` last crossed delay time.
+} DSPDelay;
+
+typedef struct {
+    DSPNodeType Type;
+    bool IsIdle; // Input is silent and tail has decayed, so node is bypassed.
+
+    f32 Parameters[DSP_PARAM_COUNT]; // Smoothed values.
+    f32 TargetParameters[DSP_PARAM_COUNT];
+
+    union {
+        DSPBiquad Biquad;
+        DSPDelay Delay;
+    };
+} DSPNode;
+
+typedef struct {
+    u32 SampleRate;
+    bool IsAVX2Enabled;
+    f32 SilenceThreshold; // In sample units of whoever feeds the chain.
+
+    u32 NodeCount;
+    DSPNode Nodes[DSP_CHAIN_NODE_COUNT_MAX];
+} DSPChain;
+
+void DSPChainInit(DSPChain *chain, u32 sampleRate, f32 silenceThreshold);
+
+/*
+ * Releases delay lines.
+ */
+void DSPChainDestroy(DSPChain *chain);
+
+/*
+ * Nodes are processed in the order they are added. Return `DSP_NODE_INVALID` if chain is full,
+ * arguments are out of range or delay line can't be allocated. Biquad with N stages delays
+ * signal by N - 1 frames.
+ */
+DSPNodeID DSPChainAddBiquad(DSPChain *chain, DSPBiquadType type, u32 stageCount, f32 frequency, f32 q);
+DSPNodeID DSPChainAddGain(DSPChain *chain, f32 gain);
+DSPNodeID DSPChainAddDelay(DSPChain *chain, f32 maxSeconds, f32 seconds, f32 feedback, f32 mix);
+
+/*
+ * Value is approached smoothly. Parameters, which node doesn't have, have no effect.
+ */
+void DSPChainSetParameter(DSPChain *chain, DSPNodeID id, DSPParam parameter, f32 value);
+
+/*
+ * Processes `frameCount` interleaved stereo frames in place. `isInputSilent` means, that samples
+ * are all zero. Returns true, if output is silent as well (every node is idle).
+ */
+bool DSPChainProcess(DSPChain *chain, f32 *samples, usize frameCount, bool isInputSilent);
+
+#endif // GFS_DSP_H_INCLUDED
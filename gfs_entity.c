@@ -0,0 +1,251 @@
+/*
+ * FILE      gfs_entity.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_entity.h"
+
+#include <Windows.h>
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_color.h"
+#include "gfs_assert.h"
+
+#define ENTITY_ARRAY_COUNT 10 // Every array has 4 bytes per entity or slot.
+
+GFS_STATIC_ASSERT(sizeof(f32) == 4 && sizeof(Color4) == 4 && sizeof(u32) == 4);
+
+internal usize
+Entity_AlignSize(usize size) {
+    return (size + ENTITY_ARRAY_ALIGNMENT - 1) & ~(usize)(ENTITY_ARRAY_ALIGNMENT - 1);
+}
+
+internal EntityID
+Entity_MakeID(u32 slot, u32 generation) {
+    return (generation << ENTITY_SLOT_BITS) | (slot + 1);
+}
+
+EntityStore *
+EntityStoreMake(u32 capacity) {
+    if (capacity == 0 || capacity > ENTITY_CAPACITY_MAX) {
+        return NULL;
+    }
+
+    usize headerSize = Entity_AlignSize(sizeof(EntityStore));
+    usize arraySize = Entity_AlignSize((usize)capacity * 4);
+    byte *memory = VirtualAlloc(
+        NULL, headerSize + arraySize * ENTITY_ARRAY_COUNT, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (memory == NULL) {
+        return NULL;
+    }
+
+    // NOTE(ilya.a): VirtualAlloc gives zeroed pages, so everything starts empty. [2026/10/18]
+    EntityStore *store = (EntityStore *)memory;
+    store->Capacity = capacity;
+
+    byte *array = memory + headerSize;
+    store->PositionX = (f32 *)array;
+    store->PositionY = (f32 *)(array += arraySize);
+    store->VelocityX = (f32 *)(array += arraySize);
+    store->VelocityY = (f32 *)(array += arraySize);
+    store->Width = (f32 *)(array += arraySize);
+    store->Height = (f32 *)(array += arraySize);
+    store->Colors = (Color4 *)(array += arraySize);
+    store->Slots = (u32 *)(array += arraySize);
+    store->Indices = (u32 *)(array += arraySize);
+    store->Generations = (u32 *)(array += arraySize);
+
+    return store;
+}
+
+void
+EntityStoreDestroy(EntityStore *store) {
+    if (store != NULL) {
+        VirtualFree(store, 0, MEM_RELEASE);
+    }
+}
+
+EntityID
+EntityStoreAdd(EntityStore *store, const EntityDesc *desc) {
+    u32 slot = 0;
+
+    if (store->FreeSlot != 0) {
+        slot = store->FreeSlot - 1;
+        store->FreeSlot = store->Indices[slot];
+    } else if (store->SlotCount < store->Capacity) {
+        slot = store->SlotCount++;
+    } else {
+        return ENTITY_ID_INVALID;
+    }
+
+    u32 index = store->Count++;
+    store->PositionX[index] = desc->X;
+    store->PositionY[index] = desc->Y;
+    store->VelocityX[index] = desc->VelocityX;
+    store->VelocityY[index] = desc->VelocityY;
+    store->Width[index] = desc->Width;
+    store->Height[index] = desc->Height;
+    store->Colors[index] = desc->Color;
+    store->Slots[index] = slot;
+    store->Indices[slot] = index;
+
+    return Entity_MakeID(slot, store->Generations[slot]);
+}
+
+bool
+EntityStoreFind(const EntityStore *store, EntityID entity, u32 *indexOut) {
+    u32 slot = (entity & ENTITY_SLOT_MASK) - 1;
+
+    // NOTE(ilya.a): Zero slot bits wrap `slot` around, so invalid ID fails the first check. [2026/10/18]
+    if (slot >= store->SlotCount || store->Generations[slot] != entity >> ENTITY_SLOT_BITS) {
+        return false;
+    }
+
+    *indexOut = store->Indices[slot];
+    return true;
+}
+
+bool
+EntityStoreRemove(EntityStore *store, EntityID entity) {
+    u32 index = 0;
+
+    if (!EntityStoreFind(store, entity, &index)) {
+        return false;
+    }
+
+    u32 slot = store->Slots[index];
+    u32 last = --store->Count;
+
+    store->PositionX[index] = store->PositionX[last];
+    store->PositionY[index] = store->PositionY[last];
+    store->VelocityX[index] = store->VelocityX[last];
+    store->VelocityY[index] = store->VelocityY[last];
+    store->Width[index] = store->Width[last];
+    store->Height[index] = store->Height[last];
+    store->Colors[index] = store->Colors[last];
+    store->Slots[index] = store->Slots[last];
+    store->Indices[store->Slots[index]] = index;
+
+    store->Generations[slot] = (store->Generations[slot] + 1) & (ENTITY_GENERATION_COUNT - 1);
+    store->Indices[slot] = store->FreeSlot;
+    store->FreeSlot = slot + 1;
+
+    return true;
+}
+
+//
+// Update.
+//
+// NOTE(ilya.a): Every path does the same operations in the same order, so they give the same
+// result bit for bit: position is moved, then clamped with max and min, velocity of entity,
+// which was out of bounds, is pointed back inside. [2026/10/18]
+//
+
+internal void
+Entity_MoveAxisScalar(f32 *positions, f32 *velocities, const f32 *sizes, u32 index, f32 delta, f32 bound) {
+    f32 velocity = velocities[index];
+    f32 position = positions[index] + velocity * delta;
+    f32 positionMax = bound - sizes[index];
+    f32 speed = velocity < 0.0f ? -velocity : velocity;
+
+    velocities[index] = position < 0.0f ? speed : position > positionMax ? -speed : velocity;
+
+    position = position > 0.0f ? position : 0.0f;
+    positions[index] = position < positionMax ? position : positionMax;
+}
+
+internal void
+Entity_MoveAxisSSE2(f32 *positions, f32 *velocities, const f32 *sizes, u32 index, __m128 delta, __m128 bound) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 signMask = _mm_set1_ps(-0.0f);
+
+    __m128 velocity = _mm_load_ps(velocities + index);
+    __m128 position = _mm_add_ps(_mm_load_ps(positions + index), _mm_mul_ps(velocity, delta));
+    __m128 positionMax = _mm_sub_ps(bound, _mm_load_ps(sizes + index));
+    __m128 speed = _mm_andnot_ps(signMask, velocity);
+
+    __m128 isBelow = _mm_cmplt_ps(position, zero);
+    __m128 isAbove = _mm_andnot_ps(isBelow, _mm_cmpgt_ps(position, positionMax));
+    __m128 isInside = _mm_andnot_ps(_mm_or_ps(isBelow, isAbove), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+    velocity = _mm_or_ps(
+        _mm_or_ps(_mm_and_ps(isBelow, speed), _mm_and_ps(isAbove, _mm_xor_ps(speed, signMask))),
+        _mm_and_ps(isInside, velocity));
+
+    _mm_store_ps(velocities + index, velocity);
+    _mm_store_ps(positions + index, _mm_min_ps(_mm_max_ps(position, zero), positionMax));
+}
+
+internal void
+Entity_MoveAxisAVX(f32 *positions, f32 *velocities, const f32 *sizes, u32 index, __m256 delta, __m256 bound) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    __m256 velocity = _mm256_load_ps(velocities + index);
+    __m256 position = _mm256_add_ps(_mm256_load_ps(positions + index), _mm256_mul_ps(velocity, delta));
+    __m256 positionMax = _mm256_sub_ps(bound, _mm256_load_ps(sizes + index));
+    __m256 speed = _mm256_andnot_ps(signMask, velocity);
+
+    // NOTE(ilya.a): Above is masked with below, so below wins, when both hold (size is bigger than
+    // bound), like in scalar path. Blends then never overlap and their order doesn't matter. [2026/10/18]
+    __m256 isBelow = _mm256_cmp_ps(position, zero, _CMP_LT_OQ);
+    __m256 isAbove = _mm256_andnot_ps(isBelow, _mm256_cmp_ps(position, positionMax, _CMP_GT_OQ));
+
+    velocity = _mm256_blendv_ps(velocity, speed, isBelow);
+    velocity = _mm256_blendv_ps(velocity, _mm256_xor_ps(speed, signMask), isAbove);
+
+    _mm256_store_ps(velocities + index, velocity);
+    _mm256_store_ps(positions + index, _mm256_min_ps(_mm256_max_ps(position, zero), positionMax));
+}
+
+internal u32
+Entity_UpdateSSE2(EntityStore *store, f32 deltaSeconds, f32 boundsWidth, f32 boundsHeight) {
+    __m128 delta = _mm_set1_ps(deltaSeconds);
+    __m128 boundX = _mm_set1_ps(boundsWidth);
+    __m128 boundY = _mm_set1_ps(boundsHeight);
+    u32 index = 0;
+
+    for (; index + 4 <= store->Count; index += 4) {
+        Entity_MoveAxisSSE2(store->PositionX, store->VelocityX, store->Width, index, delta, boundX);
+        Entity_MoveAxisSSE2(store->PositionY, store->VelocityY, store->Height, index, delta, boundY);
+    }
+
+    return index;
+}
+
+internal u32
+Entity_UpdateAVX(EntityStore *store, f32 deltaSeconds, f32 boundsWidth, f32 boundsHeight) {
+    __m256 delta = _mm256_set1_ps(deltaSeconds);
+    __m256 boundX = _mm256_set1_ps(boundsWidth);
+    __m256 boundY = _mm256_set1_ps(boundsHeight);
+    u32 index = 0;
+
+    for (; index + 8 <= store->Count; index += 8) {
+        Entity_MoveAxisAVX(store->PositionX, store->VelocityX, store->Width, index, delta, boundX);
+        Entity_MoveAxisAVX(store->PositionY, store->VelocityY, store->Height, index, delta, boundY);
+    }
+
+    return index;
+}
+
+void
+EntityStoreUpdate(EntityStore *store, f32 deltaSeconds, f32 boundsWidth, f32 boundsHeight) {
+    u32 index = 0;
+
+    if (SYS_HAS_CPU_FEATURE(SYS_CPU_AVX)) {
+        index = Entity_UpdateAVX(store, deltaSeconds, boundsWidth, boundsHeight);
+    } else {
+        index = Entity_UpdateSSE2(store, deltaSeconds, boundsWidth, boundsHeight);
+    }
+
+    for (; index < store->Count; ++index) {
+        Entity_MoveAxisScalar(store->PositionX, store->VelocityX, store->Width, index, deltaSeconds, boundsWidth);
+        Entity_MoveAxisScalar(store->PositionY, store->VelocityY, store->Height, index, deltaSeconds, boundsHeight);
+    }
+}
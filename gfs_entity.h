@@ -0,0 +1,97 @@
+/*
+ * GFS. Entity store.
+ *
+ * Entities are kept as struct of arrays: every component is its own packed array, so update
+ * walks only components it needs and moves 8 entities per AVX step. Live entities are always the
+ * first `Count` elements of every array: removal moves the last entity into the hole.
+ *
+ * Entity is referred by `EntityID`, which stays valid while entity is moved around: it holds
+ * slot, which tracks entity's current index, and slot's generation. Generation changes, when
+ * entity is removed, so stale ID is never mistaken for entity, which reused the slot (unless
+ * slot was reused `ENTITY_GENERATION_COUNT` times).
+ *
+ * FILE      gfs_entity.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_ENTITY_H_INCLUDED
+#define GFS_ENTITY_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_color.h"
+
+#define ENTITY_SLOT_BITS 20
+#define ENTITY_SLOT_MASK ((1 << ENTITY_SLOT_BITS) - 1)
+#define ENTITY_GENERATION_COUNT (1 << (32 - ENTITY_SLOT_BITS))
+#define ENTITY_CAPACITY_MAX ENTITY_SLOT_MASK
+#define ENTITY_ARRAY_ALIGNMENT 64
+
+/*
+ * Slot index plus one in low `ENTITY_SLOT_BITS`, generation in the rest. Zero is never valid.
+ */
+typedef u32 EntityID;
+
+#define ENTITY_ID_INVALID 0
+
+typedef struct {
+    f32 X;
+    f32 Y;
+    f32 VelocityX; // Per second.
+    f32 VelocityY; // Per second.
+    f32 Width;
+    f32 Height;
+    Color4 Color;
+} EntityDesc;
+
+typedef struct {
+    u32 Capacity;
+    u32 Count;
+
+    // NOTE(ilya.a): By entity index. Every array is aligned to `ENTITY_ARRAY_ALIGNMENT`. [2026/10/18]
+    f32 *PositionX;
+    f32 *PositionY;
+    f32 *VelocityX;
+    f32 *VelocityY;
+    f32 *Width;
+    f32 *Height;
+    Color4 *Colors;
+    u32 *Slots;
+
+    // NOTE(ilya.a): By slot. Free slot keeps the next free one plus one instead of index. [2026/10/18]
+    u32 *Indices;
+    u32 *Generations;
+    u32 FreeSlot; // Plus one, zero if there are none.
+    u32 SlotCount;
+} EntityStore;
+
+/*
+ * Allocates store with all its arrays at once. Returns NULL, if there is no memory or capacity
+ * is over `ENTITY_CAPACITY_MAX`.
+ */
+EntityStore *EntityStoreMake(u32 capacity);
+void EntityStoreDestroy(EntityStore *store);
+
+/*
+ * Returns `ENTITY_ID_INVALID`, if store is full.
+ */
+EntityID EntityStoreAdd(EntityStore *store, const EntityDesc *desc);
+
+/*
+ * Returns false, if entity was already removed. Index of the last entity changes.
+ */
+bool EntityStoreRemove(EntityStore *store, EntityID entity);
+
+/*
+ * Current index of entity in component arrays. Returns false, if entity was removed.
+ */
+bool EntityStoreFind(const EntityStore *store, EntityID entity, u32 *indexOut);
+
+/*
+ * Moves every entity by its velocity. Entities, which hit bounds of `[0, boundsWidth] x
+ * [0, boundsHeight]`, are clamped into them and bounce off.
+ */
+void EntityStoreUpdate(EntityStore *store, f32 deltaSeconds, f32 boundsWidth, f32 boundsHeight);
+
+#endif // GFS_ENTITY_H_INCLUDED
@@ -0,0 +1,136 @@
+/*
+ * FILE      gfs_game.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_game.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_string.h"
+#include "gfs_color.h"
+#include "gfs_input.h"
+#include "gfs_bmr.h"
+
+void
+GameInit(GameState *game) {
+    MemoryZero(game, sizeof(*game));
+
+    game->Player.Rect.X = GAME_PLAYER_INIT_X;
+    game->Player.Rect.Y = GAME_PLAYER_INIT_Y;
+    game->Player.Rect.Width = GAME_PLAYER_WIDTH;
+    game->Player.Rect.Height = GAME_PLAYER_HEIGHT;
+    game->Player.Color = Color4Add(COLOR_RED, COLOR_BLUE);
+
+    game->ToneFrequency = GAME_TONE_HZ;
+}
+
+void
+GameUpdate(GameState *game, const InputSnapshot *input) {
+    InputButtons buttons = 0;
+
+    for (u32 gamepadIndex = 0; gamepadIndex < INPUT_GAMEPAD_COUNT; ++gamepadIndex) {
+        const InputGamepad *pad = &input->Gamepads[gamepadIndex];
+
+        if (!pad->IsConnected) {
+            continue;
+        }
+
+        buttons |= pad->Buttons;
+
+        // TODO(ilya.a): Handle deadzone propery, using XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE and
+        // XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE [2024/08/11]
+        game->GradientX += pad->LeftStickX / 4096;
+        game->GradientY += pad->LeftStickY / 4096;
+
+        game->ToneFrequency = 256.0f * ((f32)pad->LeftStickY / 30000.0f) + 512.0f;
+        game->MusicMuffle = (f32)pad->LeftTrigger / 255.0f;
+        game->MusicEcho = (f32)pad->RightTrigger / 255.0f;
+    }
+
+    if (buttons & INPUT_BUTTON_DPAD_LEFT) {
+        game->Player.Rect.X -= GAME_PLAYER_SPEED;
+    }
+
+    if (buttons & INPUT_BUTTON_DPAD_RIGHT) {
+        game->Player.Rect.X += GAME_PLAYER_SPEED;
+    }
+
+    if (buttons & INPUT_BUTTON_DPAD_DOWN) {
+        game->Player.Rect.Y -= GAME_PLAYER_SPEED;
+    }
+
+    if (buttons & INPUT_BUTTON_DPAD_UP) {
+        game->Player.Rect.Y += GAME_PLAYER_SPEED;
+    }
+
+    game->GradientX++;
+    game->GradientY++;
+    game->Frame++;
+}
+
+// NOTE(ilya.a): Differences are taken signed, so values which wrapped around still move the
+// short way. [2026/10/18]
+
+internal u32
+Game_LerpU32(u32 previous, u32 current, f32 alpha) {
+    i32 difference = (i32)(current - previous);
+    return previous + (u32)(i32)((f32)difference * alpha);
+}
+
+internal u16
+Game_LerpU16(u16 previous, u16 current, f32 alpha) {
+    i16 difference = (i16)(current - previous);
+    return (u16)(previous + (i32)((f32)difference * alpha));
+}
+
+void
+GameInterpolate(const GameState *previous, const GameState *current, f32 alpha, GameState *stateOut) {
+    *stateOut = *current;
+
+    stateOut->Player.Rect.X = Game_LerpU16(previous->Player.Rect.X, current->Player.Rect.X, alpha);
+    stateOut->Player.Rect.Y = Game_LerpU16(previous->Player.Rect.Y, current->Player.Rect.Y, alpha);
+    stateOut->GradientX = Game_LerpU32(previous->GradientX, current->GradientX, alpha);
+    stateOut->GradientY = Game_LerpU32(previous->GradientY, current->GradientY, alpha);
+}
+
+void
+GameRender(const GameState *game, BMR_Renderer *renderer) {
+    BMR_Clear(renderer);
+    BMR_DrawGrad(renderer, game->GradientX, game->GradientY);
+    BMR_DrawRectR(renderer, game->Player.Rect, game->Player.Color);
+    BMR_DrawLine(renderer, 100, 200, 500, 600);
+}
+
+internal u32
+Game_GetBits(f32 value) {
+    u32 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+u64
+GameGetChecksum(const GameState *game) {
+    // NOTE(ilya.a): Field by field, so padding never gets into the hash. Floats go in as bits,
+    // so the slightest drift changes it. [2026/10/18]
+    u64 fields[] = {
+        game->Frame,
+        game->Player.Rect.X,
+        game->Player.Rect.Y,
+        game->Player.Rect.Width,
+        game->Player.Rect.Height,
+        game->Player.Color.b,
+        game->Player.Color.g,
+        game->Player.Color.r,
+        game->Player.Color.a,
+        game->GradientX,
+        game->GradientY,
+        Game_GetBits(game->ToneFrequency),
+        Game_GetBits(game->MusicMuffle),
+        Game_GetBits(game->MusicEcho),
+    };
+
+    return BytesHash64(fields, sizeof(fields));
+}
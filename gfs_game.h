@@ -0,0 +1,69 @@
+/*
+ * GFS. Game state and update.
+ *
+ * Update is a function of previous state and input snapshot only: it doesn't read clocks,
+ * controllers or globals. So the same recording always ends in the same state, which
+ * `GameGetChecksum` tells. Whatever game wants from audio is left in the state, and platform
+ * layer passes it on. Render only records draw commands of the state.
+ *
+ * Update is one tick of `GAME_TICKS_PER_SECOND`, speeds are per tick.
+ *
+ * FILE      gfs_game.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_GAME_H_INCLUDED
+#define GFS_GAME_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_geometry.h"
+#include "gfs_color.h"
+#include "gfs_input.h"
+#include "gfs_bmr.h"
+
+#define GAME_PLAYER_INIT_X 100
+#define GAME_PLAYER_INIT_Y 60
+#define GAME_PLAYER_WIDTH 160
+#define GAME_PLAYER_HEIGHT 80
+#define GAME_PLAYER_SPEED 10 // Per tick.
+
+#define GAME_TICKS_PER_SECOND 60
+
+#define GAME_TONE_HZ 256.0f
+
+typedef struct {
+    Rect Rect;
+    Color4 Color;
+} GamePlayer;
+
+typedef struct {
+    u64 Frame;
+    GamePlayer Player;
+    u32 GradientX;
+    u32 GradientY;
+
+    // NOTE(ilya.a): Left as they were, when no gamepad is connected. [2026/10/18]
+    f32 ToneFrequency;
+    f32 MusicMuffle; // From 0 to 1.
+    f32 MusicEcho;   // From 0 to 1.
+} GameState;
+
+void GameInit(GameState *game);
+void GameUpdate(GameState *game, const InputSnapshot *input);
+void GameRender(const GameState *game, BMR_Renderer *renderer);
+
+/*
+ * State to be rendered `alpha` of the way from `previous` tick to `current` one. Only what moves
+ * on screen is interpolated, the rest is taken from `current`.
+ */
+void GameInterpolate(const GameState *previous, const GameState *current, f32 alpha, GameState *stateOut);
+
+/*
+ * Hash of everything, what update depends on. Equal checksums after the same input mean
+ * update is deterministic.
+ */
+u64 GameGetChecksum(const GameState *game);
+
+#endif // GFS_GAME_H_INCLUDED
@@ -13,11 +13,11 @@ RectIsInside(Rect r, u16 x, u16 y) {
     return x >= r.X && x <= r.X + r.Width && y >= r.Y && y <= r.Y + r.Height;
 }
 
-// TODO(ilya.a): Fix bug when `r` is bigger than `this`.
 bool
-RectIsOverlapping(Rect r) {
-    return RectIsInside(r, r.X + 0, r.Y + 0) || RectIsInside(r, r.X + r.Width, r.Y + r.Height) ||
-           RectIsInside(r, r.X + r.Width, r.Y + 0) || RectIsInside(r, r.X + 0, r.Y + r.Height);
+RectIsOverlapping(Rect a, Rect b) {
+    // NOTE(ilya.a): Sums are done in u32, so rects near the end of u16 range don't wrap. [2026/10/18]
+    return (u32)a.X < (u32)b.X + b.Width && (u32)b.X < (u32)a.X + a.Width && (u32)a.Y < (u32)b.Y + b.Height &&
+           (u32)b.Y < (u32)a.Y + a.Height;
 }
 
 u64
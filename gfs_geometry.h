@@ -17,7 +17,11 @@ typedef struct {
 } Rect;
 
 bool RectIsInside(Rect r, u16 x, u16 y);
-bool RectIsOverlapping(Rect r);
+
+/*
+ * True, if rects share some area. Rects, which only touch by edge, don't overlap.
+ */
+bool RectIsOverlapping(Rect a, Rect b);
 
 u64 GetOffset(u64 width, u64 y, u64 x);
 
@@ -0,0 +1,251 @@
+/*
+ * FILE      gfs_grid.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_grid.h"
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_geometry.h"
+
+#define GRID_ARRAY_ALIGNMENT 64
+#define GRID_CELL_COUNT_MAX 0x10000 // Per axis, so cell index fits into `GridCellRange`.
+
+internal usize
+Grid_AlignSize(usize size) {
+    return (size + GRID_ARRAY_ALIGNMENT - 1) & ~(usize)(GRID_ARRAY_ALIGNMENT - 1);
+}
+
+Grid *
+GridMake(u32 width, u32 height, u32 cellSize, u32 objectCapacity) {
+    if (width == 0 || height == 0 || cellSize == 0 || objectCapacity == 0 ||
+        objectCapacity > 0xFFFFFFFFu / GRID_NODES_PER_OBJECT) {
+        return NULL;
+    }
+
+    u32 cellCountX = (width + cellSize - 1) / cellSize;
+    u32 cellCountY = (height + cellSize - 1) / cellSize;
+
+    if (cellCountX > GRID_CELL_COUNT_MAX || cellCountY > GRID_CELL_COUNT_MAX) {
+        return NULL;
+    }
+
+    usize cellCount = (usize)cellCountX * cellCountY;
+    usize nodeCapacity = (usize)objectCapacity * GRID_NODES_PER_OBJECT;
+
+    usize headerSize = Grid_AlignSize(sizeof(Grid));
+    usize cellHeadsSize = Grid_AlignSize(cellCount * sizeof(u32));
+    usize rectsSize = Grid_AlignSize(objectCapacity * sizeof(Rect));
+    usize rangesSize = Grid_AlignSize(objectCapacity * sizeof(GridCellRange));
+    usize isInsertedSize = Grid_AlignSize(objectCapacity * sizeof(bool));
+    usize nodesSize = Grid_AlignSize(nodeCapacity * sizeof(u32));
+
+    byte *memory = VirtualAlloc(
+        NULL, headerSize + cellHeadsSize + rectsSize + rangesSize + isInsertedSize + nodesSize * 2,
+        MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (memory == NULL) {
+        return NULL;
+    }
+
+    // NOTE(ilya.a): VirtualAlloc gives zeroed pages, so cells start empty. [2026/10/18]
+    Grid *grid = (Grid *)memory;
+    grid->CellSize = cellSize;
+    grid->CellCountX = cellCountX;
+    grid->CellCountY = cellCountY;
+    grid->ObjectCapacity = objectCapacity;
+    grid->NodeCapacity = (u32)nodeCapacity;
+
+    byte *array = memory + headerSize;
+    grid->CellHeads = (u32 *)array;
+    grid->Rects = (Rect *)(array += cellHeadsSize);
+    grid->Ranges = (GridCellRange *)(array += rectsSize);
+    grid->IsInserted = (bool *)(array += rangesSize);
+    grid->NodeObjects = (u32 *)(array += isInsertedSize);
+    grid->NodeNext = (u32 *)(array += nodesSize);
+
+    for (u32 node = 0; node + 1 < grid->NodeCapacity; ++node) {
+        grid->NodeNext[node] = node + 2;
+    }
+
+    grid->FreeNode = 1;
+
+    return grid;
+}
+
+void
+GridDestroy(Grid *grid) {
+    if (grid != NULL) {
+        VirtualFree(grid, 0, MEM_RELEASE);
+    }
+}
+
+internal u32
+Grid_ToCell(u32 coordinate, u32 cellSize, u32 cellCount) {
+    u32 cell = coordinate / cellSize;
+    return cell < cellCount ? cell : cellCount - 1;
+}
+
+internal GridCellRange
+Grid_GetCellRange(const Grid *grid, Rect rect) {
+    // NOTE(ilya.a): Rect covers `[X, X + Width)`, empty one still goes into cell of its corner. [2026/10/18]
+    u32 lastX = (u32)rect.X + (rect.Width > 0 ? rect.Width - 1 : 0);
+    u32 lastY = (u32)rect.Y + (rect.Height > 0 ? rect.Height - 1 : 0);
+
+    GridCellRange range;
+    range.MinX = (u16)Grid_ToCell(rect.X, grid->CellSize, grid->CellCountX);
+    range.MinY = (u16)Grid_ToCell(rect.Y, grid->CellSize, grid->CellCountY);
+    range.MaxX = (u16)Grid_ToCell(lastX, grid->CellSize, grid->CellCountX);
+    range.MaxY = (u16)Grid_ToCell(lastY, grid->CellSize, grid->CellCountY);
+    return range;
+}
+
+internal u32
+Grid_GetRangeCellCount(GridCellRange range) {
+    return ((u32)range.MaxX - range.MinX + 1) * ((u32)range.MaxY - range.MinY + 1);
+}
+
+internal void
+Grid_Link(Grid *grid, u32 object) {
+    GridCellRange range = grid->Ranges[object];
+
+    for (u32 cellY = range.MinY; cellY <= range.MaxY; ++cellY) {
+        for (u32 cellX = range.MinX; cellX <= range.MaxX; ++cellX) {
+            u32 *head = &grid->CellHeads[cellY * grid->CellCountX + cellX];
+            u32 node = grid->FreeNode - 1;
+
+            grid->FreeNode = grid->NodeNext[node];
+            grid->NodeObjects[node] = object;
+            grid->NodeNext[node] = *head;
+            *head = node + 1;
+        }
+    }
+
+    grid->NodeCount += Grid_GetRangeCellCount(range);
+}
+
+internal void
+Grid_Unlink(Grid *grid, u32 object) {
+    GridCellRange range = grid->Ranges[object];
+
+    for (u32 cellY = range.MinY; cellY <= range.MaxY; ++cellY) {
+        for (u32 cellX = range.MinX; cellX <= range.MaxX; ++cellX) {
+            u32 *link = &grid->CellHeads[cellY * grid->CellCountX + cellX];
+
+            while (grid->NodeObjects[*link - 1] != object) {
+                link = &grid->NodeNext[*link - 1];
+            }
+
+            u32 node = *link - 1;
+            *link = grid->NodeNext[node];
+            grid->NodeNext[node] = grid->FreeNode;
+            grid->FreeNode = node + 1;
+        }
+    }
+
+    grid->NodeCount -= Grid_GetRangeCellCount(range);
+}
+
+bool
+GridInsert(Grid *grid, u32 object, Rect rect) {
+    if (object >= grid->ObjectCapacity || grid->IsInserted[object]) {
+        return false;
+    }
+
+    GridCellRange range = Grid_GetCellRange(grid, rect);
+
+    if (grid->NodeCount + Grid_GetRangeCellCount(range) > grid->NodeCapacity) {
+        return false;
+    }
+
+    grid->Rects[object] = rect;
+    grid->Ranges[object] = range;
+    grid->IsInserted[object] = true;
+    Grid_Link(grid, object);
+
+    return true;
+}
+
+void
+GridRemove(Grid *grid, u32 object) {
+    if (object >= grid->ObjectCapacity || !grid->IsInserted[object]) {
+        return;
+    }
+
+    Grid_Unlink(grid, object);
+    grid->IsInserted[object] = false;
+}
+
+bool
+GridMove(Grid *grid, u32 object, Rect rect) {
+    if (object >= grid->ObjectCapacity || !grid->IsInserted[object]) {
+        return false;
+    }
+
+    ++grid->Stats.MoveCount;
+    grid->Rects[object] = rect;
+
+    GridCellRange range = Grid_GetCellRange(grid, rect);
+    GridCellRange *oldRange = &grid->Ranges[object];
+
+    if (range.MinX == oldRange->MinX && range.MinY == oldRange->MinY && range.MaxX == oldRange->MaxX &&
+        range.MaxY == oldRange->MaxY) {
+        return true;
+    }
+
+    ++grid->Stats.RelinkCount;
+    Grid_Unlink(grid, object);
+
+    if (grid->NodeCount + Grid_GetRangeCellCount(range) > grid->NodeCapacity) {
+        grid->IsInserted[object] = false;
+        return false;
+    }
+
+    *oldRange = range;
+    Grid_Link(grid, object);
+
+    return true;
+}
+
+u32
+GridQueryPairs(const Grid *grid, GridPair *pairsOut, u32 pairCapacity) {
+    u32 pairCount = 0;
+
+    for (u32 cellY = 0; cellY < grid->CellCountY; ++cellY) {
+        for (u32 cellX = 0; cellX < grid->CellCountX; ++cellX) {
+            u32 head = grid->CellHeads[cellY * grid->CellCountX + cellX];
+
+            for (u32 node = head; node != 0; node = grid->NodeNext[node - 1]) {
+                u32 a = grid->NodeObjects[node - 1];
+                GridCellRange rangeA = grid->Ranges[a];
+
+                for (u32 other = grid->NodeNext[node - 1]; other != 0; other = grid->NodeNext[other - 1]) {
+                    u32 b = grid->NodeObjects[other - 1];
+                    GridCellRange rangeB = grid->Ranges[b];
+
+                    // NOTE(ilya.a): Objects, which share several cells, are reported only in the
+                    // first one of them (top left corner of their common cells). [2026/10/18]
+                    u32 firstX = rangeA.MinX > rangeB.MinX ? rangeA.MinX : rangeB.MinX;
+                    u32 firstY = rangeA.MinY > rangeB.MinY ? rangeA.MinY : rangeB.MinY;
+
+                    if (firstX != cellX || firstY != cellY || !RectIsOverlapping(grid->Rects[a], grid->Rects[b])) {
+                        continue;
+                    }
+
+                    if (pairCount < pairCapacity) {
+                        pairsOut[pairCount].A = a < b ? a : b;
+                        pairsOut[pairCount].B = a < b ? b : a;
+                    }
+
+                    ++pairCount;
+                }
+            }
+        }
+    }
+
+    return pairCount;
+}
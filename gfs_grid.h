@@ -0,0 +1,100 @@
+/*
+ * GFS. Uniform grid broad phase.
+ *
+ * World `[0, width) x [0, height)` is split into square cells, and every object is linked into
+ * every cell its rect covers (rects outside the world go into edge cells). Pairs are looked for
+ * only between objects of the same cell, so cost grows with how crowded cells are, not with
+ * square of object count. Cell should be about as big as the biggest object: then every object
+ * is in at most 4 cells.
+ *
+ * Grid is kept up to date incrementally: object, which moved within the same cells, only gets
+ * new rect, and is relinked only when set of its cells changes.
+ *
+ * Objects are numbered by caller in `[0, objectCapacity)`, e.g. by entity slot (see
+ * `gfs_entity.h`), which stays the same while entity lives.
+ *
+ * FILE      gfs_grid.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_GRID_H_INCLUDED
+#define GFS_GRID_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_geometry.h"
+
+#define GRID_NODES_PER_OBJECT 4 // Cell links per object, which grid has memory for on average.
+
+typedef struct {
+    u32 A; // Always less than `B`.
+    u32 B;
+} GridPair;
+
+typedef struct {
+    u16 MinX;
+    u16 MinY;
+    u16 MaxX;
+    u16 MaxY;
+} GridCellRange;
+
+typedef struct {
+    u64 MoveCount;
+    u64 RelinkCount; // Moves, which changed object's cells.
+} GridStats;
+
+typedef struct {
+    u32 CellSize;
+    u32 CellCountX;
+    u32 CellCountY;
+    u32 ObjectCapacity;
+    u32 NodeCapacity;
+    u32 NodeCount; // In use.
+
+    u32 *CellHeads; // By cell. First node plus one, zero if cell is empty.
+
+    // NOTE(ilya.a): By object. [2026/10/18]
+    Rect *Rects;
+    GridCellRange *Ranges;
+    bool *IsInserted;
+
+    // NOTE(ilya.a): By node. Node is one link of object into a cell. [2026/10/18]
+    u32 *NodeObjects;
+    u32 *NodeNext; // Next node of the same cell (or next free one) plus one, zero if it's the last.
+    u32 FreeNode;  // Plus one, zero if there are none.
+
+    GridStats Stats;
+} Grid;
+
+/*
+ * Allocates grid with all its memory at once. Returns NULL, if there is no memory or world is
+ * too big for `cellSize`.
+ */
+Grid *GridMake(u32 width, u32 height, u32 cellSize, u32 objectCapacity);
+void GridDestroy(Grid *grid);
+
+/*
+ * Returns false, if object is out of range, already inserted or grid has no free nodes left for
+ * all its cells.
+ */
+bool GridInsert(Grid *grid, u32 object, Rect rect);
+
+/*
+ * Does nothing, if object is not inserted.
+ */
+void GridRemove(Grid *grid, u32 object);
+
+/*
+ * Updates rect of inserted object. Returns false, if object is not inserted or its new cells
+ * need more nodes than grid has left: then object is removed from grid.
+ */
+bool GridMove(Grid *grid, u32 object, Rect rect);
+
+/*
+ * Finds every pair of overlapping objects (see `RectIsOverlapping`), each pair once. Returns
+ * number of pairs found, but writes only first `pairCapacity` of them.
+ */
+u32 GridQueryPairs(const Grid *grid, GridPair *pairsOut, u32 pairCapacity);
+
+#endif // GFS_GRID_H_INCLUDED
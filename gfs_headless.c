@@ -0,0 +1,605 @@
+/*
+ * GFS. Headless simulation and render driver.
+ *
+ * Usage: gfs_headless [-frames <count>] [-runs <count>] [-entities <count>] [recording]
+ *        gfs_headless -bench <name|all>
+ *        gfs_headless -check <name|all>
+ *
+ * Runs the same frame as the game window does (see `gfs_platform.h`), but as fast as possible,
+ * one tick per frame and with no window, controller or sound card: picture is rasterized into
+ * memory framebuffer and audio is rendered on this thread for a null device. Input comes from
+ * recording (see `gfs_input.h`), which is looped, if more frames are asked, or is idle without
+ * one.
+ *
+ * With `-entities` every frame also moves that many entities of entity store (see
+ * `gfs_entity.h`), which start at the same pseudo-random places every run, updates their rects
+ * in broad phase grid (see `gfs_grid.h`) and finds all overlapping pairs. Entities' world grows
+ * with their count, so it is equally crowded for any count.
+ *
+ * Every run starts from the initial state and should end with the same checksums of state,
+ * picture, audio and entities. State's one is also the one game printed, when the recording was
+ * made.
+ *
+ * With `-bench` no frames are run, instead named benchmark (see `gBenchmarks`) or all of them
+ * measure subsystems on their own, on synthetic data, which is the same every run:
+ *
+ *   alloc    TLSF allocator against C runtime heap on asset load and unload churn
+ *   map      Load time and memory usage of mapped file against the one read into memory
+ *   queue    Streaming throughput of IO queue with 1 to 64 requests in flight
+ *   pack     Cold and warm load of many small assets from archive against loose files
+ *   lz       Compression ratio and speed of LZ codec on picture, tone and noise
+ *   stream   Syscalls and time of buffered reader and writer against a syscall per field
+ *   mixer    Voices mixed in 10 ms budget on SSE2 and AVX2 paths, at mixer's rate and resampled
+ *   resample Output frames per second of resampler per quality tier on SSE2 and AVX2 paths
+ *   osc      Accuracy and speed of oscillator bank's sine against `sinf`
+ *   pcm      Throughput of every PCM format into f32 and back, plain and dithered, on both paths
+ *   dsp      Cost per block of every DSP node kind, steady, smoothed and bypassed
+ *   adpcm    IMA-ADPCM decode speed of mono and stereo blocks and memory it saves against PCM
+ *
+ * With `-check` named check (see `gChecks`) or all of them run subsystems on inputs with known
+ * answers instead and print only what went wrong. Process exits with non-zero code, if any of
+ * them failed:
+ *
+ *   wave     Parsing of wave fixtures: extensible format, odd chunk padding, LIST and fact
+ *            chunks, truncated files
+ *   stream   Wave stream read in real time and as fast as it goes: streamed frames against the
+ *            file, underrun counters against silence produced
+ *   pcm      PCM conversions on SSE2 and AVX2 paths against scalar code, bit for bit, integer
+ *            round trips through f32, dither and layout helpers
+ *   voices   Voice handle, which is still playing, after more one-shots than voice map has slots
+ *   poller   Controller poller on stub device: empty slots probed once per interval, gamepad
+ *            plugged between probes picked up on the next one
+ *
+ * FILE      gfs_headless.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_string.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_wave.h"
+#include "gfs_color.h"
+#include "gfs_input.h"
+#include "gfs_game.h"
+#include "gfs_bmr.h"
+#include "gfs_mixer.h"
+#include "gfs_audio.h"
+#include "gfs_platform.h"
+#include "gfs_entity.h"
+#include "gfs_grid.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+#define HEADLESS_RUN_COUNT_DEFAULT 1
+#define HEADLESS_FRAME_COUNT_DEFAULT 1000
+#define HEADLESS_WIDTH 900
+#define HEADLESS_HEIGHT 600
+#define HEADLESS_FRAMES_PER_SECOND 60
+#define HEADLESS_AUDIO_FRAMES (HEADLESS_SAMPLES_PER_SECOND / HEADLESS_FRAMES_PER_SECOND) // Per game frame.
+
+#define HEADLESS_CHECKSUM_COUNT 4 // State, picture, audio, entities.
+#define HEADLESS_ENTITY_SIZE_MAX 16
+#define HEADLESS_ENTITY_SPEED_MAX 200 // Pixels per second.
+#define HEADLESS_ENTITY_AREA 1024     // World pixels per entity.
+#define HEADLESS_GRID_CELL_SIZE (HEADLESS_ENTITY_SIZE_MAX * 2)
+#define HEADLESS_PAIRS_PER_ENTITY 4 // Room for pairs found in one frame.
+
+typedef enum {
+    HEADLESS_ENTITY_STAGE_UPDATE,
+    HEADLESS_ENTITY_STAGE_GRID,
+    HEADLESS_ENTITY_STAGE_PAIRS,
+    HEADLESS_ENTITY_STAGE_COUNT,
+} Headless_EntityStage;
+
+typedef struct {
+    Platform Platform;
+
+    InputPlayback Playback;
+    bool HasRecording;
+
+    i16 AudioOutput[HEADLESS_AUDIO_FRAMES * MIXER_CHANNEL_COUNT];
+    u64 AudioChecksum;
+} Headless_Platform;
+
+global_var cstr8 gStageNames[PLATFORM_STAGE_COUNT] = {"input", "update", "render", "present", "audio"};
+global_var cstr8 gEntityStageNames[HEADLESS_ENTITY_STAGE_COUNT] = {"entities", "grid", "pairs"};
+global_var u64 gCounterFrequency;
+
+internal u64
+Headless_HashCombine(u64 hash, const void *data, usize size) {
+    return (hash ^ BytesHash64(data, size)) * 0x100000001B3ull;
+}
+
+u32
+Headless_NextRandom(u32 *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+f32
+Headless_RandomRange(u32 *state, f32 min, f32 max) {
+    return min + (max - min) * (f32)(Headless_NextRandom(state) >> 8) / (f32)(1 << 24);
+}
+
+/*
+ * Counter since `start`, which is moved to now, so the next stage is measured from here.
+ */
+internal u64
+Headless_GetElapsed(LARGE_INTEGER *start) {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    u64 elapsed = (u64)(now.QuadPart - start->QuadPart);
+    *start = now;
+    return elapsed;
+}
+
+internal u64
+Headless_CounterToNanoseconds(u64 counter, u64 frequency) {
+    return counter / frequency * 1000000000ull + counter % frequency * 1000000000ull / frequency;
+}
+
+/*
+ * Fills fresh store up to its capacity with entities of the same layout every run.
+ */
+internal void
+Headless_SpawnEntities(EntityStore *store, u32 worldWidth, u32 worldHeight) {
+    u32 random = HEADLESS_RANDOM_SEED;
+
+    while (store->Count < store->Capacity) {
+        EntityDesc desc = {0};
+        desc.Width = Headless_RandomRange(&random, 1, HEADLESS_ENTITY_SIZE_MAX);
+        desc.Height = Headless_RandomRange(&random, 1, HEADLESS_ENTITY_SIZE_MAX);
+        desc.X = Headless_RandomRange(&random, 0, (f32)worldWidth - desc.Width);
+        desc.Y = Headless_RandomRange(&random, 0, (f32)worldHeight - desc.Height);
+        desc.VelocityX = Headless_RandomRange(&random, -HEADLESS_ENTITY_SPEED_MAX, HEADLESS_ENTITY_SPEED_MAX);
+        desc.VelocityY = Headless_RandomRange(&random, -HEADLESS_ENTITY_SPEED_MAX, HEADLESS_ENTITY_SPEED_MAX);
+        desc.Color = COLOR_WHITE;
+        EntityStoreAdd(store, &desc);
+    }
+}
+
+internal Rect
+Headless_GetEntityRect(const EntityStore *store, u32 index) {
+    Rect rect;
+    rect.X = (u16)store->PositionX[index];
+    rect.Y = (u16)store->PositionY[index];
+    rect.Width = (u16)store->Width[index];
+    rect.Height = (u16)store->Height[index];
+    return rect;
+}
+
+internal bool
+Headless_GetInput(Platform *platform, u64 frame, InputSnapshot *snapshotOut) {
+    Headless_Platform *headless = (Headless_Platform *)platform;
+
+    if (headless->HasRecording && !InputPlaybackNext(&headless->Playback, snapshotOut)) {
+        headless->Playback.Position = 0;
+        InputPlaybackNext(&headless->Playback, snapshotOut);
+    }
+
+    snapshotOut->Frame = frame;
+    return true;
+}
+
+internal void
+Headless_MixAudio(Platform *platform) {
+    Headless_Platform *headless = (Headless_Platform *)platform;
+
+    AudioSystemRender(platform->Audio.System, headless->AudioOutput, HEADLESS_AUDIO_FRAMES);
+    headless->AudioChecksum =
+        Headless_HashCombine(headless->AudioChecksum, headless->AudioOutput, sizeof(headless->AudioOutput));
+}
+
+internal void
+Headless_SiftDown(u64 *values, u64 node, u64 count) {
+    for (u64 child = node * 2 + 1; child < count; child = node * 2 + 1) {
+        if (child + 1 < count && values[child + 1] > values[child]) {
+            ++child;
+        }
+
+        if (values[node] >= values[child]) {
+            return;
+        }
+
+        u64 swap = values[node];
+        values[node] = values[child];
+        values[child] = swap;
+        node = child;
+    }
+}
+
+/*
+ * Heap sort, so percentiles of long runs need neither recursion nor extra memory.
+ */
+internal void
+Headless_SortU64(u64 *values, u64 count) {
+    for (u64 node = count / 2; node > 0; --node) {
+        Headless_SiftDown(values, node - 1, count);
+    }
+
+    for (u64 end = count; end > 1; --end) {
+        u64 swap = values[0];
+        values[0] = values[end - 1];
+        values[end - 1] = swap;
+        Headless_SiftDown(values, 0, end - 1);
+    }
+}
+
+/*
+ * Sorts stage's frame times and prints their total and percentiles.
+ */
+internal void
+Headless_PrintStage(cstr8 name, u64 *ticks, u64 frameCount) {
+    u64 total = 0;
+
+    for (u64 frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        total += ticks[frameIndex];
+    }
+
+    Headless_SortU64(ticks, frameCount);
+
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I:   %-8s total %uus, p50 %uns, p99 %uns, max %uns\n", name,
+        (u32)(Headless_CounterToNanoseconds(total, gCounterFrequency) / 1000),
+        (u32)Headless_CounterToNanoseconds(ticks[frameCount / 2], gCounterFrequency),
+        (u32)Headless_CounterToNanoseconds(ticks[frameCount * 99 / 100], gCounterFrequency),
+        (u32)Headless_CounterToNanoseconds(ticks[frameCount - 1], gCounterFrequency));
+    Win32_Print(printBuffer);
+}
+
+u64
+Headless_GetNanoseconds(LARGE_INTEGER *start) {
+    return Headless_CounterToNanoseconds(Headless_GetElapsed(start), gCounterFrequency);
+}
+
+usize
+Headless_MakeWave(void *buffer, u16 channelCount, u32 frameCount, u32 seed) {
+    WaveFileHeader header;
+    MemoryCopy(header.FileTypeBlocID, WAVEFILE_FILETYPE, 4);
+    MemoryCopy(header.FileFormatID, WAVEFILE_FORMATID, 4);
+    MemoryCopy(header.FormatBlocID, WAVEFILE_FORMATBLOCID, 4);
+    MemoryCopy(header.DataBlocID, WAVEFILE_DATABLOCID, 4);
+    header.BlockSize = 16;
+    header.AudioFormat = WAVEFILE_AUDIOFORMAT_PCM;
+    header.NumberOfChannels = channelCount;
+    header.FreqHZ = HEADLESS_SAMPLES_PER_SECOND;
+    header.BytePerBloc = channelCount * sizeof(i16);
+    header.BytePerSec = header.FreqHZ * header.BytePerBloc;
+    header.BitsPerSample = 16;
+    header.DataSize = frameCount * header.BytePerBloc;
+    header.FileSize = WAVEFILE_HEADER_SIZE - 8 + header.DataSize;
+
+    MemoryCopy(buffer, &header, sizeof(header));
+
+    i16 *samples = (i16 *)((byte *)buffer + sizeof(header));
+    u32 random = seed;
+
+    for (u32 sampleIndex = 0; sampleIndex < frameCount * channelCount; ++sampleIndex) {
+        samples[sampleIndex] = (i16)Headless_NextRandom(&random);
+    }
+
+    return sizeof(header) + header.DataSize;
+}
+
+global_var Headless_Test gBenchmarks[] = {
+    {"alloc", Headless_BenchAllocator},
+    {"map", Headless_BenchMapping},
+    {"queue", Headless_BenchQueue},
+    {"pack", Headless_BenchPack},
+    {"lz", Headless_BenchCodec},
+    {"stream", Headless_BenchStream},
+    {"mixer", Headless_BenchMixer},
+    {"resample", Headless_BenchResample},
+    {"osc", Headless_BenchOscillator},
+    {"pcm", Headless_BenchPCM},
+    {"dsp", Headless_BenchDSP},
+    {"adpcm", Headless_BenchADPCM},
+};
+
+global_var Headless_Test gChecks[] = {
+    {"wave", Headless_CheckWaveCorpus},
+    {"stream", Headless_CheckWaveStream},
+    {"pcm", Headless_CheckPCM},
+    {"voices", Headless_CheckVoices},
+    {"poller", Headless_CheckPoller},
+};
+
+/*
+ * Runs every test of the table with matching name, or all of them for "all". Returns false, if
+ * any of them failed or none matched.
+ */
+internal bool
+Headless_RunTests(const Headless_Test *tests, u32 testCount, cstr8 name) {
+    char8 printBuffer[KILOBYTES(1)];
+    bool isPassed = true;
+    u32 runCount = 0;
+
+    for (u32 testIndex = 0; testIndex < testCount; ++testIndex) {
+        if (!CStr8IsEqual(name, "all") && !CStr8IsEqual(name, tests[testIndex].Name)) {
+            continue;
+        }
+
+        wsprintfA(printBuffer, "I: %s\n", tests[testIndex].Name);
+        Win32_Print(printBuffer);
+        ++runCount;
+
+        if (!tests[testIndex].Run()) {
+            wsprintfA(printBuffer, "E: '%s' failed!\n", tests[testIndex].Name);
+            Win32_Print(printBuffer);
+            isPassed = false;
+        }
+    }
+
+    if (runCount == 0) {
+        wsprintfA(printBuffer, "E: Unknown test '%s'!\n", name);
+        Win32_Print(printBuffer);
+    }
+
+    return isPassed && runCount > 0;
+}
+
+int
+main(int argc, char **argv) {
+    u32 runCount = HEADLESS_RUN_COUNT_DEFAULT;
+    u64 frameCount = 0;
+    u32 entityCount = 0;
+    cstr8 recordingPath = NULL;
+    cstr8 benchmarkName = NULL;
+    cstr8 checkName = NULL;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        if (CStr8IsEqual(argv[argIndex], "-frames") && argIndex + 1 < argc) {
+            frameCount = (u64)atoi(argv[++argIndex]);
+        } else if (CStr8IsEqual(argv[argIndex], "-runs") && argIndex + 1 < argc) {
+            runCount = (u32)atoi(argv[++argIndex]);
+        } else if (CStr8IsEqual(argv[argIndex], "-entities") && argIndex + 1 < argc) {
+            entityCount = (u32)atoi(argv[++argIndex]);
+        } else if (CStr8IsEqual(argv[argIndex], "-bench") && argIndex + 1 < argc) {
+            benchmarkName = argv[++argIndex];
+        } else if (CStr8IsEqual(argv[argIndex], "-check") && argIndex + 1 < argc) {
+            checkName = argv[++argIndex];
+        } else if (argv[argIndex][0] != '-') {
+            recordingPath = argv[argIndex];
+        } else {
+            Win32_Print("Usage: gfs_headless [-frames <count>] [-runs <count>] [-entities <count>] [recording]\n"
+                        "       gfs_headless -bench <name|all>\n"
+                        "       gfs_headless -check <name|all>\n");
+            return 1;
+        }
+    }
+
+    Sys_Init();
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    gCounterFrequency = (u64)frequency.QuadPart;
+
+    if (benchmarkName != NULL) {
+        return Headless_RunTests(gBenchmarks, sizeof(gBenchmarks) / sizeof(gBenchmarks[0]), benchmarkName) ? 0 : 1;
+    }
+
+    if (checkName != NULL) {
+        return Headless_RunTests(gChecks, sizeof(gChecks) / sizeof(gChecks[0]), checkName) ? 0 : 1;
+    }
+
+    runCount = runCount > 0 ? runCount : HEADLESS_RUN_COUNT_DEFAULT;
+
+    char8 printBuffer[KILOBYTES(1)];
+    Headless_Platform headless = {0};
+    headless.Platform.GetInput = Headless_GetInput;
+    headless.Platform.MixAudio = Headless_MixAudio;
+
+    if (recordingPath != NULL) {
+        InputResult openResult = InputPlaybackOpen(&headless.Playback, recordingPath);
+
+        if (openResult != INPUT_OK) {
+            wsprintfA(printBuffer, "E: Failed to open recording '%s' (error %d)\n", recordingPath, (int)openResult);
+            Win32_Print(printBuffer);
+            return 1;
+        }
+
+        headless.HasRecording = headless.Playback.SnapshotCount > 0;
+        frameCount = frameCount > 0 ? frameCount : headless.Playback.SnapshotCount;
+    }
+
+    frameCount = frameCount > 0 ? frameCount : HEADLESS_FRAME_COUNT_DEFAULT;
+
+    // NOTE(ilya.a): World keeps the screen's aspect and `HEADLESS_ENTITY_AREA` per entity, but
+    // is never smaller than the screen. [2026/10/18]
+    u32 worldWidth = (u32)sqrtf((f32)entityCount * HEADLESS_ENTITY_AREA * HEADLESS_WIDTH / HEADLESS_HEIGHT);
+    worldWidth = worldWidth > HEADLESS_WIDTH ? worldWidth : HEADLESS_WIDTH;
+    u32 worldHeight = worldWidth * HEADLESS_HEIGHT / HEADLESS_WIDTH;
+    u32 pairCapacity = entityCount * HEADLESS_PAIRS_PER_ENTITY;
+
+    // NOTE(ilya.a): Entity stage times go right after the platform ones. [2026/10/18]
+    usize timesSize = (PLATFORM_STAGE_COUNT + HEADLESS_ENTITY_STAGE_COUNT) * frameCount * sizeof(u64);
+    usize pairsSize = pairCapacity * sizeof(GridPair);
+    ScratchAllocator arena = ScratchAllocatorMake(timesSize + pairsSize);
+    u64 *stageTimes = ScratchAllocatorAlloc(&arena, timesSize);
+    u64 *entityTimes = stageTimes + PLATFORM_STAGE_COUNT * frameCount;
+    GridPair *pairs = ScratchAllocatorAlloc(&arena, pairsSize);
+
+    headless.Platform.Renderer = BMR_Init(COLOR_WHITE);
+    BMR_Resize(&headless.Platform.Renderer, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+
+    // NOTE(ilya.a): Null device is never pumped, it only tells the mixer sample rate. [2026/10/18]
+    AudioNullDevice audioDevice;
+    AudioNullDeviceInit(&audioDevice, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_AUDIO_FRAMES);
+
+    if (stageTimes == NULL || headless.Platform.Renderer.Pixels.Buffer == NULL) {
+        Win32_Print("E: Out of memory!\n");
+        return 1;
+    }
+
+    u64 firstChecksums[HEADLESS_CHECKSUM_COUNT] = {0};
+    bool isDeterministic = true;
+
+    for (u32 runIndex = 0; runIndex < runCount; ++runIndex) {
+        GameState game, previousGame;
+        GameInit(&game);
+        previousGame = game;
+
+        headless.Playback.Position = 0;
+        headless.AudioChecksum = 0;
+
+        // NOTE(ilya.a): Fresh mixer every run, so effect tails of the previous one don't get into
+        // audio checksum. [2026/10/18]
+        AudioSystem *audio = AudioSystemMake(&audioDevice.Sim.Device, RESAMPLE_QUALITY_MEDIUM);
+
+        if (audio == NULL) {
+            Win32_Print("E: Failed to create audio system!\n");
+            return 1;
+        }
+
+        PlatformAudioInit(&headless.Platform.Audio, audio);
+
+        EntityStore *entities = NULL;
+        Grid *grid = NULL;
+        u64 pairTotal = 0;
+
+        if (entityCount > 0) {
+            entities = EntityStoreMake(entityCount);
+            grid = GridMake(worldWidth, worldHeight, HEADLESS_GRID_CELL_SIZE, entityCount);
+
+            if (entities == NULL || grid == NULL) {
+                wsprintfA(printBuffer, "E: Failed to create store of %u entities!\n", entityCount);
+                Win32_Print(printBuffer);
+                return 1;
+            }
+
+            Headless_SpawnEntities(entities, worldWidth, worldHeight);
+
+            for (u32 entityIndex = 0; entityIndex < entities->Count; ++entityIndex) {
+                GridInsert(grid, entities->Slots[entityIndex], Headless_GetEntityRect(entities, entityIndex));
+            }
+        }
+
+        LARGE_INTEGER runStart;
+        QueryPerformanceCounter(&runStart);
+
+        for (u64 frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            PlatformFrameTimings timings;
+            PlatformRunFrame(&headless.Platform, &game, &previousGame, 1, 1.0f, &timings);
+
+            for (u32 stage = 0; stage < PLATFORM_STAGE_COUNT; ++stage) {
+                stageTimes[stage * frameCount + frameIndex] = timings.Elapsed[stage];
+            }
+
+            if (entities != NULL) {
+                LARGE_INTEGER stageStart;
+                QueryPerformanceCounter(&stageStart);
+
+                EntityStoreUpdate(entities, 1.0f / GAME_TICKS_PER_SECOND, (f32)worldWidth, (f32)worldHeight);
+                entityTimes[HEADLESS_ENTITY_STAGE_UPDATE * frameCount + frameIndex] = Headless_GetElapsed(&stageStart);
+
+                for (u32 entityIndex = 0; entityIndex < entities->Count; ++entityIndex) {
+                    GridMove(grid, entities->Slots[entityIndex], Headless_GetEntityRect(entities, entityIndex));
+                }
+
+                entityTimes[HEADLESS_ENTITY_STAGE_GRID * frameCount + frameIndex] = Headless_GetElapsed(&stageStart);
+
+                pairTotal += GridQueryPairs(grid, pairs, pairCapacity);
+                entityTimes[HEADLESS_ENTITY_STAGE_PAIRS * frameCount + frameIndex] = Headless_GetElapsed(&stageStart);
+            }
+        }
+
+        LARGE_INTEGER runEnd;
+        QueryPerformanceCounter(&runEnd);
+
+        AudioSystemDestroy(audio);
+
+        const BMR_Renderer *renderer = &headless.Platform.Renderer;
+        u64 checksums[HEADLESS_CHECKSUM_COUNT] = {
+            GameGetChecksum(&game),
+            BytesHash64(renderer->Pixels.Buffer, renderer->Pixels.Width * renderer->Pixels.Height * renderer->BPP),
+            headless.AudioChecksum,
+            0,
+        };
+
+        if (entities != NULL) {
+            checksums[3] = Headless_HashCombine(0, entities->PositionX, entities->Count * sizeof(f32));
+            checksums[3] = Headless_HashCombine(checksums[3], entities->PositionY, entities->Count * sizeof(f32));
+            checksums[3] = Headless_HashCombine(checksums[3], &pairTotal, sizeof(pairTotal));
+        }
+
+        for (u32 checksumIndex = 0; checksumIndex < HEADLESS_CHECKSUM_COUNT; ++checksumIndex) {
+            firstChecksums[checksumIndex] = runIndex == 0 ? checksums[checksumIndex] : firstChecksums[checksumIndex];
+            isDeterministic = isDeterministic && checksums[checksumIndex] == firstChecksums[checksumIndex];
+        }
+
+        u64 runCounter = (u64)(runEnd.QuadPart - runStart.QuadPart);
+        u64 runNanoseconds = Headless_CounterToNanoseconds(runCounter, gCounterFrequency);
+        u64 centiFramesPerSecond = runNanoseconds > 0 ? frameCount * 100000000000ull / runNanoseconds : 0;
+
+        wsprintfA(
+            printBuffer, "I: Run %u: %u frames in %uus, %u.%02u f/s\n", runIndex + 1, (u32)frameCount,
+            (u32)(runNanoseconds / 1000), (u32)(centiFramesPerSecond / 100), (u32)(centiFramesPerSecond % 100));
+        Win32_Print(printBuffer);
+
+        for (u32 stage = 0; stage < PLATFORM_STAGE_COUNT; ++stage) {
+            Headless_PrintStage(gStageNames[stage], stageTimes + stage * frameCount, frameCount);
+        }
+
+        if (entities != NULL) {
+            wsprintfA(
+                printBuffer, "I:   %u entities in %ux%u, %u pairs per frame, %u of %u grid moves relinked\n",
+                entities->Count, worldWidth, worldHeight, (u32)(pairTotal / frameCount), (u32)grid->Stats.RelinkCount,
+                (u32)grid->Stats.MoveCount);
+            Win32_Print(printBuffer);
+
+            u64 picoseconds[HEADLESS_ENTITY_STAGE_COUNT]; // Per entity per frame.
+
+            for (u32 stage = 0; stage < HEADLESS_ENTITY_STAGE_COUNT; ++stage) {
+                u64 *times = entityTimes + stage * frameCount;
+                u64 total = 0;
+
+                for (u64 frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+                    total += times[frameIndex];
+                }
+
+                picoseconds[stage] =
+                    Headless_CounterToNanoseconds(total, gCounterFrequency) * 1000 / (frameCount * entities->Count);
+                Headless_PrintStage(gEntityStageNames[stage], times, frameCount);
+            }
+
+            wsprintfA(
+                printBuffer, "I:   per entity: update %u.%03uns, grid %u.%03uns, pairs %u.%03uns\n",
+                (u32)(picoseconds[0] / 1000), (u32)(picoseconds[0] % 1000), (u32)(picoseconds[1] / 1000),
+                (u32)(picoseconds[1] % 1000), (u32)(picoseconds[2] / 1000), (u32)(picoseconds[2] % 1000));
+            Win32_Print(printBuffer);
+
+            GridDestroy(grid);
+            EntityStoreDestroy(entities);
+        }
+
+        wsprintfA(
+            printBuffer, "I:   checksums: state %08x%08x, picture %08x%08x, audio %08x%08x, entities %08x%08x\n",
+            (u32)(checksums[0] >> 32), (u32)checksums[0], (u32)(checksums[1] >> 32), (u32)checksums[1],
+            (u32)(checksums[2] >> 32), (u32)checksums[2], (u32)(checksums[3] >> 32), (u32)checksums[3]);
+        Win32_Print(printBuffer);
+    }
+
+    if (!isDeterministic) {
+        Win32_Print("E: Runs ended in different states!\n");
+    }
+
+    BMR_DeInit(&headless.Platform.Renderer);
+    ScratchAllocatorFree(&arena);
+
+    if (recordingPath != NULL) {
+        InputPlaybackClose(&headless.Playback);
+    }
+
+    return isDeterministic ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/*
+ * GFS. Shared parts of headless driver's benchmarks and checks.
+ *
+ * Benchmarks and checks of every module live in their own `gfs_headless_<module>.c` and are
+ * listed in driver's tables (see `gfs_headless.c`), which run them by name. Each one prints its
+ * own results and returns false, if something failed.
+ *
+ * FILE      gfs_headless.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_HEADLESS_H_INCLUDED
+#define GFS_HEADLESS_H_INCLUDED
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define HEADLESS_RANDOM_SEED 0x9E3779B9 // Every run gets the same data.
+#define HEADLESS_BENCH_FILE_PATH "gfs_headless_bench.tmp"
+#define HEADLESS_SAMPLES_PER_SECOND 48000
+#define HEADLESS_TWO_PI 6.28318530717958647692f
+
+typedef struct {
+    cstr8 Name;
+    bool (*Run)(void);
+} Headless_Test;
+
+u32 Headless_NextRandom(u32 *state);
+f32 Headless_RandomRange(u32 *state, f32 min, f32 max);
+
+/*
+ * Nanoseconds since `start`, which is moved to now, so the next step is measured from there.
+ */
+u64 Headless_GetNanoseconds(LARGE_INTEGER *start);
+
+/*
+ * Writes canonical 16-bit wave file with `frameCount` frames of noise into `buffer`. Returns
+ * its size.
+ */
+usize Headless_MakeWave(void *buffer, u16 channelCount, u32 frameCount, u32 seed);
+
+//
+// gfs_headless_memory.c
+//
+
+bool Headless_BenchAllocator(void);
+
+//
+// gfs_headless_io.c
+//
+
+bool Headless_BenchMapping(void);
+bool Headless_BenchQueue(void);
+bool Headless_BenchPack(void);
+bool Headless_BenchCodec(void);
+bool Headless_BenchStream(void);
+
+//
+// gfs_headless_audio.c
+//
+
+bool Headless_BenchMixer(void);
+bool Headless_BenchResample(void);
+bool Headless_BenchOscillator(void);
+bool Headless_BenchPCM(void);
+bool Headless_BenchDSP(void);
+bool Headless_BenchADPCM(void);
+bool Headless_CheckPCM(void);
+bool Headless_CheckVoices(void);
+
+//
+// gfs_headless_input.c
+//
+
+bool Headless_CheckPoller(void);
+
+//
+// gfs_headless_wave.c
+//
+
+bool Headless_CheckWaveCorpus(void);
+bool Headless_CheckWaveStream(void);
+
+#endif // GFS_HEADLESS_H_INCLUDED
@@ -0,0 +1,921 @@
+/*
+ * GFS. Headless benchmarks and checks of audio mixing, resampling, synthesis, sample formats,
+ * effects, compressed sounds and voice handles.
+ *
+ * FILE      gfs_headless_audio.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+#include <math.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_wave.h"
+#include "gfs_pcm.h"
+#include "gfs_resample.h"
+#include "gfs_mixer.h"
+#include "gfs_osc.h"
+#include "gfs_dsp.h"
+#include "gfs_adpcm.h"
+#include "gfs_audio.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+#define HEADLESS_MIXER_BUDGET_FRAMES (HEADLESS_SAMPLES_PER_SECOND / 100) // 10 ms.
+#define HEADLESS_MIXER_BUDGET_NANOSECONDS 10000000
+#define HEADLESS_MIXER_BLOCK_COUNT 1000 // Budgets mixed per measurement.
+#define HEADLESS_MIXER_RESAMPLED_RATE 44100
+
+/*
+ * Renders 10 ms blocks with every voice mixer has playing, on both accumulation paths, with voices
+ * at mixer's rate and resampled ones. Prints time per block and how many voices would fit into
+ * its 10 ms.
+ */
+bool
+Headless_BenchMixer(void) {
+    usize waveSize = WAVEFILE_HEADER_SIZE + HEADLESS_SAMPLES_PER_SECOND * MIXER_CHANNEL_COUNT * sizeof(i16);
+    byte *wave = VirtualAlloc(NULL, waveSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (wave == NULL) {
+        return false;
+    }
+
+    Headless_MakeWave(wave, MIXER_CHANNEL_COUNT, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_RANDOM_SEED);
+
+    u32 sampleRates[2] = {HEADLESS_SAMPLES_PER_SECOND, HEADLESS_MIXER_RESAMPLED_RATE};
+    i16 output[HEADLESS_MIXER_BUDGET_FRAMES * MIXER_CHANNEL_COUNT];
+    bool isPassed = true;
+
+    for (u32 runIndex = 0; runIndex < 4 && isPassed; ++runIndex) {
+        bool isAVX2 = runIndex >= 2;
+        u32 sampleRate = sampleRates[runIndex % 2];
+        Mixer mixer = MixerMake(HEADLESS_SAMPLES_PER_SECOND, RESAMPLE_QUALITY_MEDIUM);
+
+        if (isAVX2 && !mixer.IsAVX2Enabled) {
+            MixerDestroy(&mixer);
+            continue;
+        }
+
+        mixer.IsAVX2Enabled = isAVX2;
+        u32 random = HEADLESS_RANDOM_SEED;
+
+        for (u32 voiceIndex = 0; voiceIndex < MIXER_VOICE_COUNT_MAX; ++voiceIndex) {
+            MixerVoiceDesc desc = {0};
+            desc.Samples = wave + WAVEFILE_HEADER_SIZE;
+            desc.FrameCount = HEADLESS_SAMPLES_PER_SECOND;
+            desc.Format = PCM_FORMAT_I16;
+            desc.ChannelCount = MIXER_CHANNEL_COUNT;
+            desc.SampleRate = sampleRate;
+            desc.IsLooping = true;
+            desc.Volume = 1.0f / MIXER_VOICE_COUNT_MAX;
+            desc.Pan = Headless_RandomRange(&random, -1, 1);
+            isPassed = isPassed && MixerPlay(&mixer, &desc) != MIXER_VOICE_INVALID;
+        }
+
+        // NOTE(ilya.a): First block only warms caches and resampler history up. [2026/10/18]
+        MixerRender(&mixer, output, HEADLESS_MIXER_BUDGET_FRAMES);
+
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        for (u32 blockIndex = 0; blockIndex < HEADLESS_MIXER_BLOCK_COUNT; ++blockIndex) {
+            MixerRender(&mixer, output, HEADLESS_MIXER_BUDGET_FRAMES);
+        }
+
+        u64 blockNanoseconds = Headless_GetNanoseconds(&start) / HEADLESS_MIXER_BLOCK_COUNT;
+        u32 voiceCount = MixerGetPlayingCount(&mixer);
+        isPassed = isPassed && voiceCount == MIXER_VOICE_COUNT_MAX;
+
+        char8 printBuffer[KILOBYTES(1)];
+        wsprintfA(
+            printBuffer, "I:   %-4s %5u Hz  %u voices in %u ns per 10 ms, %u voices fit into 10 ms\n",
+            isAVX2 ? "avx2" : "sse2", sampleRate, voiceCount, (u32)blockNanoseconds,
+            (u32)((u64)voiceCount * HEADLESS_MIXER_BUDGET_NANOSECONDS / (blockNanoseconds + 1)));
+        Win32_Print(printBuffer);
+
+        MixerDestroy(&mixer);
+    }
+
+    VirtualFree(wave, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_RESAMPLE_OUTPUT_FRAMES (HEADLESS_SAMPLES_PER_SECOND * 10) // Per measurement.
+
+/*
+ * Converts 10 seconds of stereo noise from 44.1 and 22.05 kHz into 48 kHz in mixer-sized blocks,
+ * for every quality tier on both dot product paths. Prints output frames per second and how
+ * many times faster than real time that is.
+ */
+bool
+Headless_BenchResample(void) {
+    usize waveSize = WAVEFILE_HEADER_SIZE + HEADLESS_SAMPLES_PER_SECOND * MIXER_CHANNEL_COUNT * sizeof(i16);
+    byte *memory = VirtualAlloc(
+        NULL, waveSize + sizeof(ResampleFilter) + sizeof(ResampleState), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (memory == NULL) {
+        return false;
+    }
+
+    Headless_MakeWave(memory, MIXER_CHANNEL_COUNT, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_RANDOM_SEED);
+
+    const i16 *samples = (const i16 *)(memory + WAVEFILE_HEADER_SIZE);
+    ResampleFilter *filter = (ResampleFilter *)(memory + waveSize);
+    ResampleState *state = (ResampleState *)(filter + 1);
+
+    cstr8 qualityNames[3] = {"low", "medium", "high"};
+    u32 inputRates[2] = {44100, 22050};
+    f32 output[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    bool isPassed = true;
+
+    for (u32 runIndex = 0; runIndex < 12 && isPassed; ++runIndex) {
+        ResampleQuality quality = (ResampleQuality)(runIndex / 4);
+        u32 inputRate = inputRates[runIndex % 2];
+        bool isAVX2 = (runIndex / 2) % 2 == 1;
+
+        ResampleFilterInit(filter, inputRate, HEADLESS_SAMPLES_PER_SECOND, quality);
+
+        if (isAVX2 && !filter->IsAVX2Enabled) {
+            continue;
+        }
+
+        filter->IsAVX2Enabled = isAVX2;
+        ResampleStateReset(state, filter, MIXER_CHANNEL_COUNT);
+
+        u64 inputFrame = 0;
+        u64 outputFrameCount = 0;
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        while (outputFrameCount < HEADLESS_RESAMPLE_OUTPUT_FRAMES && isPassed) {
+            usize inputNeeded = ResampleGetInputNeeded(state, MIXER_BLOCK_FRAMES);
+
+            while (inputNeeded > 0) {
+                u64 sourceFrame = inputFrame % HEADLESS_SAMPLES_PER_SECOND;
+                usize frameCount = HEADLESS_SAMPLES_PER_SECOND - sourceFrame;
+                frameCount = frameCount < inputNeeded ? frameCount : inputNeeded;
+
+                ResampleWriteI16(state, samples + sourceFrame * MIXER_CHANNEL_COUNT, frameCount);
+                inputFrame += frameCount;
+                inputNeeded -= frameCount;
+            }
+
+            usize frameCount = ResampleProcess(state, output, MIXER_BLOCK_FRAMES);
+            outputFrameCount += frameCount;
+            isPassed = frameCount == MIXER_BLOCK_FRAMES;
+        }
+
+        u64 nanoseconds = Headless_GetNanoseconds(&start);
+        u64 framesPerSecond = outputFrameCount * 1000000000 / (nanoseconds + 1);
+
+        char8 printBuffer[KILOBYTES(1)];
+        wsprintfA(
+            printBuffer, "I:   %-6s %-4s %5u Hz  %u frames/s, %ux real time\n", qualityNames[quality],
+            isAVX2 ? "avx2" : "sse2", inputRate, (u32)framesPerSecond,
+            (u32)(framesPerSecond / HEADLESS_SAMPLES_PER_SECOND));
+        Win32_Print(printBuffer);
+    }
+
+    VirtualFree(memory, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_OSC_ACCURACY_FRAMES (1 << 24)  // Sine is compared with exact one at this many phases.
+#define HEADLESS_OSC_PHASE_STEP 0x9E3779B1      // Odd, so phases are spread over the whole period.
+#define HEADLESS_OSC_SPEED_FRAMES (HEADLESS_SAMPLES_PER_SECOND * 10)
+#define HEADLESS_OSC_FRAMES 1024 // Per render.
+
+/*
+ * Sine of phase, where full range of `u32` is one period, computed the way game did before
+ * oscillator bank: with `sinf` of float angle.
+ */
+internal f32
+Headless_SineSinf(u32 phase) {
+    return sinf((f32)phase * (HEADLESS_TWO_PI / 4294967296.0f));
+}
+
+/*
+ * Largest difference between `sinf`, scalar `OscSine` or oscillator bank on SSE2 or AVX2 path
+ * and exact sine, over phases spread across the whole period. Bank renders from `phase`, other
+ * ones are called per frame.
+ */
+internal f64
+Headless_GetSineError(u32 pathIndex, f32 *accumulator) {
+    OscBank bank = OscBankMake(HEADLESS_SAMPLES_PER_SECOND);
+    bool isBank = pathIndex >= 2;
+    bank.IsAVX2Enabled = pathIndex == 3;
+    OscBankAdd(&bank, 0, 1.0f);
+    bank.Increments[0] = HEADLESS_OSC_PHASE_STEP;
+
+    u32 phase = 0;
+    f64 errorMax = 0;
+
+    for (u32 frameIndex = 0; frameIndex < HEADLESS_OSC_ACCURACY_FRAMES; frameIndex += HEADLESS_OSC_FRAMES) {
+        if (isBank) {
+            MemoryZero(accumulator, HEADLESS_OSC_FRAMES * MIXER_CHANNEL_COUNT * sizeof(f32));
+            OscBankRender(&bank, accumulator, HEADLESS_OSC_FRAMES);
+        }
+
+        for (u32 blockFrame = 0; blockFrame < HEADLESS_OSC_FRAMES; ++blockFrame) {
+            f32 sample = 0;
+
+            if (isBank) {
+                sample = accumulator[blockFrame * MIXER_CHANNEL_COUNT];
+            } else if (pathIndex == 0) {
+                sample = Headless_SineSinf(phase);
+            } else {
+                sample = OscSine(phase);
+            }
+
+            f64 error = fabs((f64)sample - sin((f64)phase * (6.28318530717958647692 / 4294967296.0)));
+
+            errorMax = error > errorMax ? error : errorMax;
+            phase += HEADLESS_OSC_PHASE_STEP;
+        }
+    }
+
+    return errorMax;
+}
+
+/*
+ * Time of every oscillator bank can have rendering one second: with `sinf` per frame and per
+ * oscillator, and with bank itself on SSE2 or AVX2 path. Returns nanoseconds.
+ */
+internal u64
+Headless_GetSineTime(u32 pathIndex, f32 *accumulator) {
+    OscBank bank = OscBankMake(HEADLESS_SAMPLES_PER_SECOND);
+    bank.IsAVX2Enabled = pathIndex == 3;
+
+    for (u32 index = 0; index < OSC_COUNT_MAX; ++index) {
+        OscBankAdd(&bank, 110.0f * (f32)(index + 1), 1.0f / OSC_COUNT_MAX);
+    }
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    for (u32 frameIndex = 0; frameIndex < HEADLESS_OSC_SPEED_FRAMES; frameIndex += HEADLESS_OSC_FRAMES) {
+        if (pathIndex >= 2) {
+            OscBankRender(&bank, accumulator, HEADLESS_OSC_FRAMES);
+            continue;
+        }
+
+        for (u32 index = 0; index < bank.Count; ++index) {
+            for (u32 blockFrame = 0; blockFrame < HEADLESS_OSC_FRAMES; ++blockFrame) {
+                f32 sample = Headless_SineSinf(bank.Phases[index]) * bank.Amplitudes[index];
+                accumulator[blockFrame * MIXER_CHANNEL_COUNT + 0] += sample;
+                accumulator[blockFrame * MIXER_CHANNEL_COUNT + 1] += sample;
+                bank.Phases[index] += bank.Increments[index];
+            }
+        }
+    }
+
+    return Headless_GetNanoseconds(&start);
+}
+
+/*
+ * Accuracy and speed of `sinf`, scalar `OscSine` and both paths of oscillator bank. Fails, if any
+ * of the last ones is less accurate, than `OSC_SINE_ERROR_MAX` promises.
+ */
+bool
+Headless_BenchOscillator(void) {
+    cstr8 pathNames[4] = {"sinf", "scalar", "sse2", "avx2"};
+    f32 accumulator[HEADLESS_OSC_FRAMES * MIXER_CHANNEL_COUNT] = {0};
+    bool isPassed = true;
+
+    for (u32 pathIndex = 0; pathIndex < 4; ++pathIndex) {
+        if (pathIndex == 3 && !SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA)) {
+            continue;
+        }
+
+        f64 errorMax = Headless_GetSineError(pathIndex, accumulator);
+        isPassed = isPassed && (pathIndex == 0 || errorMax < OSC_SINE_ERROR_MAX);
+
+        char8 printBuffer[KILOBYTES(1)];
+        u32 errorNanos = (u32)(errorMax * 1e9 + 0.5);
+        wsprintfA(
+            printBuffer, "I:   %-6s max error %u.%03ue-6", pathNames[pathIndex], errorNanos / 1000, errorNanos % 1000);
+        Win32_Print(printBuffer);
+
+        // NOTE(ilya.a): Scalar `OscSine` is there only for the tail of a render, so only its
+        // accuracy matters. [2026/10/18]
+        if (pathIndex != 1) {
+            u64 picoseconds =
+                Headless_GetSineTime(pathIndex, accumulator) * 1000 / ((u64)HEADLESS_OSC_SPEED_FRAMES * OSC_COUNT_MAX);
+            wsprintfA(printBuffer, ", %u.%03u ns per sample", (u32)(picoseconds / 1000), (u32)(picoseconds % 1000));
+            Win32_Print(printBuffer);
+        }
+
+        Win32_Print("\n");
+    }
+
+    return isPassed;
+}
+
+#define HEADLESS_PCM_BENCH_SAMPLE_COUNT (HEADLESS_SAMPLES_PER_SECOND * MIXER_CHANNEL_COUNT) // One second of stereo.
+#define HEADLESS_PCM_BENCH_REPEAT_COUNT 100
+
+global_var cstr8 gPCMFormatNames[PCM_FORMAT_COUNT] = {"i16", "u8", "i24", "i32", "f32"};
+global_var cstr8 gPCMPathNames[2] = {"sse2", "avx2"};
+
+/*
+ * Switches PCM kernels to SSE2 (path zero) or AVX2 path. Returns false, if CPU has no AVX2.
+ */
+internal bool
+Headless_SetPCMPath(SysCPUFeatures features, u32 pathIndex) {
+    // NOTE(ilya.a): System info shouldn't change after `Sys_Init`, but kernels pick their path by
+    // it on every call, so this is the only way to run SSE2 path on AVX2 machine. [2026/10/18]
+    SysInfo *info = (SysInfo *)Sys_GetInfo();
+    info->CPUFeatures = pathIndex == 1 ? features : features & ~(SysCPUFeatures)SYS_CPU_AVX2;
+
+    return pathIndex == 0 || HASANYBIT(features, SYS_CPU_AVX2);
+}
+
+/*
+ * Converts one second of stereo from every format into f32 and back, plain and dithered, on
+ * both paths. Prints millions of samples per second and bytes of integer side per second.
+ */
+bool
+Headless_BenchPCM(void) {
+    usize bufferSize = HEADLESS_PCM_BENCH_SAMPLE_COUNT * sizeof(f32);
+    byte *samples = VirtualAlloc(NULL, bufferSize * 3, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (samples == NULL) {
+        return false;
+    }
+
+    f32 *values = (f32 *)(samples + bufferSize);
+    f32 *output = values + HEADLESS_PCM_BENCH_SAMPLE_COUNT;
+    u32 random = HEADLESS_RANDOM_SEED;
+
+    for (u32 sampleIndex = 0; sampleIndex < HEADLESS_PCM_BENCH_SAMPLE_COUNT; ++sampleIndex) {
+        values[sampleIndex] = Headless_RandomRange(&random, -1.0f, 1.0f);
+    }
+
+    SysCPUFeatures features = Sys_GetInfo()->CPUFeatures;
+    PCMDither dither;
+    PCMDitherInit(&dither, HEADLESS_RANDOM_SEED);
+
+    for (u32 pathIndex = 0; pathIndex < 2; ++pathIndex) {
+        if (!Headless_SetPCMPath(features, pathIndex)) {
+            continue;
+        }
+
+        for (u32 formatIndex = 0; formatIndex < PCM_FORMAT_COUNT; ++formatIndex) {
+            PCMFormat format = (PCMFormat)formatIndex;
+            u64 nanoseconds[3] = {0}; // To f32, from f32, from f32 with dither.
+
+            // NOTE(ilya.a): Warm-up, so pages are touched and caches are the same for every format. [2026/10/18]
+            PCMConvertFromF32(format, values, samples, HEADLESS_PCM_BENCH_SAMPLE_COUNT, NULL);
+            PCMConvertToF32(format, samples, output, HEADLESS_PCM_BENCH_SAMPLE_COUNT);
+
+            LARGE_INTEGER start;
+            QueryPerformanceCounter(&start);
+
+            for (u32 repeatIndex = 0; repeatIndex < HEADLESS_PCM_BENCH_REPEAT_COUNT; ++repeatIndex) {
+                PCMConvertFromF32(format, values, samples, HEADLESS_PCM_BENCH_SAMPLE_COUNT, NULL);
+            }
+
+            nanoseconds[1] = Headless_GetNanoseconds(&start);
+
+            for (u32 repeatIndex = 0; repeatIndex < HEADLESS_PCM_BENCH_REPEAT_COUNT; ++repeatIndex) {
+                PCMConvertFromF32(format, values, samples, HEADLESS_PCM_BENCH_SAMPLE_COUNT, &dither);
+            }
+
+            nanoseconds[2] = Headless_GetNanoseconds(&start);
+
+            for (u32 repeatIndex = 0; repeatIndex < HEADLESS_PCM_BENCH_REPEAT_COUNT; ++repeatIndex) {
+                PCMConvertToF32(format, samples, output, HEADLESS_PCM_BENCH_SAMPLE_COUNT);
+            }
+
+            nanoseconds[0] = Headless_GetNanoseconds(&start);
+
+            u64 sampleCount = (u64)HEADLESS_PCM_BENCH_SAMPLE_COUNT * HEADLESS_PCM_BENCH_REPEAT_COUNT;
+            u64 byteCount = sampleCount * PCMFormatGetSize(format);
+            char8 printBuffer[KILOBYTES(1)];
+            wsprintfA(printBuffer, "I:   %s %-3s", gPCMPathNames[pathIndex], gPCMFormatNames[formatIndex]);
+            Win32_Print(printBuffer);
+
+            cstr8 directionNames[3] = {"to f32", "from f32", "dithered"};
+
+            for (u32 directionIndex = 0; directionIndex < 3; ++directionIndex) {
+                u64 elapsed = nanoseconds[directionIndex] + 1;
+                wsprintfA(
+                    printBuffer, "  %s %4u Msamples/s %5u MB/s", directionNames[directionIndex],
+                    (u32)(sampleCount * 1000 / elapsed), (u32)(byteCount * 1000 / elapsed));
+                Win32_Print(printBuffer);
+            }
+
+            Win32_Print("\n");
+        }
+    }
+
+    Headless_SetPCMPath(features, 1); // Restores every feature.
+    VirtualFree(samples, 0, MEM_RELEASE);
+    return true;
+}
+
+#define HEADLESS_PCM_SAMPLE_COUNT 4099   // Odd, so every kernel has scalar tail.
+#define HEADLESS_PCM_SHORT_COUNT_MAX 40 // Every count up to it is checked too, from shifting start.
+#define HEADLESS_PCM_BUFFER_SIZE (HEADLESS_PCM_SAMPLE_COUNT * sizeof(f32))
+
+/*
+ * Integer value of sample, with u8 centered at zero.
+ */
+internal i32
+Headless_GetPCMSample(PCMFormat format, const void *samples, usize index) {
+    const byte *bytes = (const byte *)samples;
+
+    switch (format) {
+    case PCM_FORMAT_U8: {
+        return (i32)bytes[index] - 128;
+    } break;
+    case PCM_FORMAT_I16: {
+        return ((const i16 *)samples)[index];
+    } break;
+    case PCM_FORMAT_I24: {
+        const byte *sample = bytes + index * 3;
+        return (i32)((u32)sample[0] << 8 | (u32)sample[1] << 16 | (u32)sample[2] << 24) >> 8;
+    } break;
+    default: {
+        return ((const i32 *)samples)[index];
+    } break;
+    }
+}
+
+/*
+ * Returns index of the first byte, which differs, or `size`, if none.
+ */
+internal usize
+Headless_FindMismatch(const void *a, const void *b, usize size) {
+    usize index = 0;
+
+    while (index < size && ((const byte *)a)[index] == ((const byte *)b)[index]) {
+        ++index;
+    }
+
+    return index;
+}
+
+/*
+ * Runs conversion to f32 (or from it, without dither) over every short count from shifting start
+ * and over almost the whole input, comparing output with `reference`, which was converted sample
+ * by sample, so only by scalar code. Prints the first mismatch and returns false on it.
+ */
+internal bool
+Headless_CheckPCMKernel(PCMFormat format, bool isToF32, const byte *input, const byte *reference, byte *output) {
+    u32 formatSize = PCMFormatGetSize(format);
+    u32 inputSize = isToF32 ? formatSize : sizeof(f32);
+    u32 outputSize = isToF32 ? sizeof(f32) : formatSize;
+
+    for (usize countIndex = 1; countIndex <= HEADLESS_PCM_SHORT_COUNT_MAX + 1; ++countIndex) {
+        usize first = countIndex % 4;
+        usize count = countIndex <= HEADLESS_PCM_SHORT_COUNT_MAX ? countIndex : HEADLESS_PCM_SAMPLE_COUNT - first;
+
+        if (isToF32) {
+            PCMConvertToF32(format, input + first * inputSize, (f32 *)output, count);
+        } else {
+            PCMConvertFromF32(format, (const f32 *)(input + first * inputSize), output, count, NULL);
+        }
+
+        usize mismatch = Headless_FindMismatch(output, reference + first * outputSize, count * outputSize);
+
+        if (mismatch < count * outputSize) {
+            char8 printBuffer[KILOBYTES(1)];
+            wsprintfA(
+                printBuffer, "E:   %s %s f32: %u samples from %u differ from scalar at sample %u\n",
+                gPCMFormatNames[format], isToF32 ? "to" : "from", (u32)count, (u32)first, (u32)(mismatch / outputSize));
+            Win32_Print(printBuffer);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Dither is below one LSB, so dithered output should be within 1.5 LSB of exact value (plus
+ * rounding of f32, which matters for 24-bit), and differ from plain output somewhere.
+ */
+internal bool
+Headless_CheckPCMDither(PCMFormat format, const f32 *values, const byte *reference, byte *output) {
+    PCMDither dither;
+    PCMDitherInit(&dither, HEADLESS_RANDOM_SEED);
+    PCMConvertFromF32(format, values, output, HEADLESS_PCM_SAMPLE_COUNT, &dither);
+
+    f64 scale = (f64)(1u << (PCMFormatGetSize(format) * BYTE_BITS - 1));
+    u32 changedCount = 0;
+
+    for (usize sampleIndex = 0; sampleIndex < HEADLESS_PCM_SAMPLE_COUNT; ++sampleIndex) {
+        f64 exact = (f64)values[sampleIndex] * scale;
+        exact = exact < -scale ? -scale : (exact > scale - 1 ? scale - 1 : exact);
+
+        i32 sample = Headless_GetPCMSample(format, output, sampleIndex);
+        f64 error = fabs((f64)sample - exact);
+
+        // NOTE(ilya.a): Scaling and adding dither are rounded to f32, half an ulp each. [2026/10/18]
+        if (error > 1.5 + fabs(exact) / 4194304.0) {
+            char8 printBuffer[KILOBYTES(1)];
+            wsprintfA(
+                printBuffer, "E:   %s dithered: sample %u is %d, exact one is %d\n", gPCMFormatNames[format],
+                (u32)sampleIndex, sample, (i32)exact);
+            Win32_Print(printBuffer);
+            return false;
+        }
+
+        changedCount += sample != Headless_GetPCMSample(format, reference, sampleIndex) ? 1 : 0;
+    }
+
+    return changedCount > 0;
+}
+
+/*
+ * Runs every PCM conversion on SSE2 and AVX2 paths (AVX2 one includes i24 shuffle) against scalar
+ * code, then integer round trips through f32, dither, and layout helpers.
+ */
+bool
+Headless_CheckPCM(void) {
+    byte *memory = VirtualAlloc(NULL, HEADLESS_PCM_BUFFER_SIZE * 6, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (memory == NULL) {
+        return false;
+    }
+
+    byte *source = memory; // Random bytes, which every format takes as its samples.
+    f32 *values = (f32 *)(memory + HEADLESS_PCM_BUFFER_SIZE);
+    byte *reference = memory + HEADLESS_PCM_BUFFER_SIZE * 2;
+    f32 *roundTrip = (f32 *)(memory + HEADLESS_PCM_BUFFER_SIZE * 3);
+    byte *output = memory + HEADLESS_PCM_BUFFER_SIZE * 4; // Twice as big, for mono to stereo.
+
+    u32 random = HEADLESS_RANDOM_SEED;
+
+    for (usize byteIndex = 0; byteIndex < HEADLESS_PCM_BUFFER_SIZE; ++byteIndex) {
+        source[byteIndex] = (byte)(Headless_NextRandom(&random) >> 24);
+    }
+
+    // NOTE(ilya.a): Some values are out of range, to be clamped, and some are exactly halfway
+    // between two i16, to be rounded to even. [2026/10/18]
+    for (usize sampleIndex = 0; sampleIndex < HEADLESS_PCM_SAMPLE_COUNT; ++sampleIndex) {
+        f32 halfway = ((f32)(i16)Headless_NextRandom(&random) + 0.5f) / 32768.0f;
+        values[sampleIndex] = sampleIndex % 8 == 0 ? halfway : Headless_RandomRange(&random, -1.25f, 1.25f);
+    }
+
+    SysCPUFeatures features = Sys_GetInfo()->CPUFeatures;
+    u32 failCount = 0;
+    char8 printBuffer[KILOBYTES(1)];
+
+    for (u32 pathIndex = 0; pathIndex < 2; ++pathIndex) {
+        if (!Headless_SetPCMPath(features, pathIndex)) {
+            continue;
+        }
+
+        u32 pathFailCount = 0;
+
+        for (u32 formatIndex = 0; formatIndex < PCM_FORMAT_COUNT; ++formatIndex) {
+            PCMFormat format = (PCMFormat)formatIndex;
+            u32 formatSize = PCMFormatGetSize(format);
+
+            for (usize sampleIndex = 0; sampleIndex < HEADLESS_PCM_SAMPLE_COUNT; ++sampleIndex) {
+                PCMConvertToF32(format, source + sampleIndex * formatSize, (f32 *)reference + sampleIndex, 1);
+            }
+
+            pathFailCount += Headless_CheckPCMKernel(format, true, source, reference, output) ? 0 : 1;
+
+            for (usize sampleIndex = 0; sampleIndex < HEADLESS_PCM_SAMPLE_COUNT; ++sampleIndex) {
+                PCMConvertFromF32(format, values + sampleIndex, reference + sampleIndex * formatSize, 1, NULL);
+            }
+
+            pathFailCount += Headless_CheckPCMKernel(format, false, (const byte *)values, reference, output) ? 0 : 1;
+
+            if (format == PCM_FORMAT_I32 || format == PCM_FORMAT_F32) {
+                continue;
+            }
+
+            pathFailCount += Headless_CheckPCMDither(format, values, reference, output) ? 0 : 1;
+
+            PCMConvertToF32(format, source, roundTrip, HEADLESS_PCM_SAMPLE_COUNT);
+            PCMConvertFromF32(format, roundTrip, output, HEADLESS_PCM_SAMPLE_COUNT, NULL);
+
+            if (Headless_FindMismatch(source, output, HEADLESS_PCM_SAMPLE_COUNT * formatSize) <
+                HEADLESS_PCM_SAMPLE_COUNT * formatSize) {
+                wsprintfA(printBuffer, "E:   %s round trip through f32 isn't bit-exact\n", gPCMFormatNames[format]);
+                Win32_Print(printBuffer);
+                ++pathFailCount;
+            }
+        }
+
+        wsprintfA(
+            printBuffer, "%s   %s conversions of %u formats, %u failed\n", pathFailCount == 0 ? "I:" : "E:",
+            gPCMPathNames[pathIndex], PCM_FORMAT_COUNT, pathFailCount);
+        Win32_Print(printBuffer);
+
+        failCount += pathFailCount;
+    }
+
+    Headless_SetPCMPath(features, 1); // Restores every feature.
+
+    // NOTE(ilya.a): Layout helpers have only SSE2 path, so they are checked against plain copies
+    // once, for every short count and almost the whole input. [2026/10/18]
+    u32 layoutFailCount = 0;
+
+    for (usize countIndex = 1; countIndex <= HEADLESS_PCM_SHORT_COUNT_MAX + 1; ++countIndex) {
+        usize frameCount = countIndex <= HEADLESS_PCM_SHORT_COUNT_MAX ? countIndex : HEADLESS_PCM_SAMPLE_COUNT / 2;
+        f32 *stereo = (f32 *)output;
+        i16 *stereoI16 = (i16 *)output;
+        const i16 *monoI16 = (const i16 *)source;
+        const f32 *planes[2] = {values, values + frameCount};
+        f32 *roundTripPlanes[2] = {roundTrip, roundTrip + frameCount};
+        bool isMatching = true;
+
+        PCMMonoToStereoF32(values, stereo, frameCount);
+
+        for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            isMatching = isMatching && stereo[frameIndex * 2] == values[frameIndex] &&
+                         stereo[frameIndex * 2 + 1] == values[frameIndex];
+        }
+
+        PCMMonoToStereoI16(monoI16, stereoI16, frameCount);
+
+        for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            isMatching = isMatching && stereoI16[frameIndex * 2] == monoI16[frameIndex] &&
+                         stereoI16[frameIndex * 2 + 1] == monoI16[frameIndex];
+        }
+
+        PCMInterleaveF32(planes, 2, stereo, frameCount);
+
+        for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            isMatching = isMatching && stereo[frameIndex * 2] == planes[0][frameIndex] &&
+                         stereo[frameIndex * 2 + 1] == planes[1][frameIndex];
+        }
+
+        PCMDeinterleaveF32(stereo, 2, roundTripPlanes, frameCount);
+        isMatching = isMatching && Headless_FindMismatch(values, roundTrip, frameCount * 2 * sizeof(f32)) ==
+                                       frameCount * 2 * sizeof(f32);
+
+        if (!isMatching) {
+            wsprintfA(printBuffer, "E:   layout helpers differ from plain copy for %u frames\n", (u32)frameCount);
+            Win32_Print(printBuffer);
+            ++layoutFailCount;
+        }
+    }
+
+    wsprintfA(
+        printBuffer, "%s   layout helpers, %u counts failed\n", layoutFailCount == 0 ? "I:" : "E:", layoutFailCount);
+    Win32_Print(printBuffer);
+
+    VirtualFree(memory, 0, MEM_RELEASE);
+    return failCount == 0 && layoutFailCount == 0;
+}
+
+#define HEADLESS_DSP_FRAME_COUNT (HEADLESS_SAMPLES_PER_SECOND * 10) // Processed per measurement.
+#define HEADLESS_DSP_AMPLITUDE 8000.0f
+#define HEADLESS_DSP_SILENCE_THRESHOLD 1.0f // Below one LSB of i16 output.
+
+typedef struct {
+    cstr8 Name;
+    DSPNodeType Type;
+    u32 StageCount;
+    bool IsSweeping; // Parameter changes every block, so it's always smoothed.
+    bool IsSilent;   // Input is silence, so node is bypassed, once its tail decays.
+} Headless_DSPNodeCase;
+
+global_var const Headless_DSPNodeCase gDSPNodeCases[] = {
+    {"biquad x1", DSP_NODE_BIQUAD, 1, false, false},
+    {"biquad x4", DSP_NODE_BIQUAD, 4, false, false},
+    {"biquad x4 sweep", DSP_NODE_BIQUAD, 4, true, false},
+    {"gain", DSP_NODE_GAIN, 0, false, false},
+    {"gain ramp", DSP_NODE_GAIN, 0, true, false},
+    {"delay", DSP_NODE_DELAY, 0, false, false},
+    {"delay sweep", DSP_NODE_DELAY, 0, true, false},
+    {"delay idle", DSP_NODE_DELAY, 0, false, true},
+};
+
+/*
+ * Runs 10 seconds of noise (or silence) through chain of the single node of every kind in blocks
+ * of 64 and 256 frames, on both paths. Prints time per block.
+ */
+bool
+Headless_BenchDSP(void) {
+    f32 *samples = VirtualAlloc(
+        NULL, HEADLESS_DSP_FRAME_COUNT * DSP_CHANNEL_COUNT * sizeof(f32), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (samples == NULL) {
+        return false;
+    }
+
+    u32 caseCount = sizeof(gDSPNodeCases) / sizeof(gDSPNodeCases[0]);
+    u32 blockSizes[2] = {64, MIXER_BLOCK_FRAMES};
+    bool isPassed = true;
+
+    for (u32 pathIndex = 0; pathIndex < 2 && isPassed; ++pathIndex) {
+        if (pathIndex == 1 && !SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA)) {
+            continue;
+        }
+
+        for (u32 caseIndex = 0; caseIndex < caseCount && isPassed; ++caseIndex) {
+            const Headless_DSPNodeCase *nodeCase = &gDSPNodeCases[caseIndex];
+            char8 printBuffer[KILOBYTES(1)];
+            wsprintfA(printBuffer, "I:   %s %-15s", pathIndex == 0 ? "sse2" : "avx2", nodeCase->Name);
+            Win32_Print(printBuffer);
+
+            for (u32 sizeIndex = 0; sizeIndex < 2 && isPassed; ++sizeIndex) {
+                DSPChain chain;
+                DSPChainInit(&chain, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_DSP_SILENCE_THRESHOLD);
+                chain.IsAVX2Enabled = pathIndex == 1;
+                DSPNodeID node = DSP_NODE_INVALID;
+                DSPParam sweptParameter = DSP_PARAM_GAIN;
+                f32 sweptValues[2] = {0.5f, 1.0f};
+
+                if (nodeCase->Type == DSP_NODE_BIQUAD) {
+                    node = DSPChainAddBiquad(&chain, DSP_BIQUAD_LOWPASS, nodeCase->StageCount, 1000.0f, 0.707f);
+                    sweptParameter = DSP_PARAM_FREQUENCY;
+                    sweptValues[0] = 500.0f;
+                    sweptValues[1] = 2000.0f;
+                } else if (nodeCase->Type == DSP_NODE_GAIN) {
+                    node = DSPChainAddGain(&chain, 1.0f);
+                } else {
+                    node = DSPChainAddDelay(&chain, 0.5f, 0.25f, 0.5f, 0.5f);
+                    sweptParameter = DSP_PARAM_DELAY;
+                    sweptValues[0] = 0.2f;
+                    sweptValues[1] = 0.3f;
+                }
+
+                u32 random = HEADLESS_RANDOM_SEED;
+
+                for (u32 sampleIndex = 0; sampleIndex < HEADLESS_DSP_FRAME_COUNT * DSP_CHANNEL_COUNT; ++sampleIndex) {
+                    f32 noise = Headless_RandomRange(&random, -HEADLESS_DSP_AMPLITUDE, HEADLESS_DSP_AMPLITUDE);
+                    samples[sampleIndex] = nodeCase->IsSilent ? 0.0f : noise;
+                }
+
+                u32 blockSize = blockSizes[sizeIndex];
+                u32 blockCount = HEADLESS_DSP_FRAME_COUNT / blockSize;
+                LARGE_INTEGER start;
+                QueryPerformanceCounter(&start);
+
+                for (u32 blockIndex = 0; blockIndex < blockCount; ++blockIndex) {
+                    if (nodeCase->IsSweeping) {
+                        DSPChainSetParameter(&chain, node, sweptParameter, sweptValues[blockIndex % 2]);
+                    }
+
+                    DSPChainProcess(
+                        &chain, samples + (usize)blockIndex * blockSize * DSP_CHANNEL_COUNT, blockSize,
+                        nodeCase->IsSilent);
+                }
+
+                u64 blockNanoseconds = Headless_GetNanoseconds(&start) / blockCount;
+                isPassed = node != DSP_NODE_INVALID && chain.Nodes[0].IsIdle == nodeCase->IsSilent;
+                DSPChainDestroy(&chain);
+
+                wsprintfA(printBuffer, "  %3u frames %6u ns per block", blockSize, (u32)blockNanoseconds);
+                Win32_Print(printBuffer);
+            }
+
+            Win32_Print("\n");
+        }
+    }
+
+    VirtualFree(samples, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_ADPCM_DATA_SIZE MEGABYTES(4)
+#define HEADLESS_ADPCM_HEADER_SIZE 4 // Per channel: predictor, step index and reserved byte.
+#define HEADLESS_ADPCM_STEP_INDEX_COUNT 89
+
+/*
+ * Decodes 4MiB of mono and stereo IMA-ADPCM blocks the way mixer does: sequentially, by mixer
+ * block. Blocks are noise with valid headers. Prints decode speed in compressed and decoded bytes
+ * per second, voices it could feed in real time and how much memory compression saves.
+ */
+bool
+Headless_BenchADPCM(void) {
+    byte *blocks = VirtualAlloc(NULL, HEADLESS_ADPCM_DATA_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (blocks == NULL) {
+        return false;
+    }
+
+    u32 blockSizes[2] = {1024, 2048}; // Mono, stereo. Usual sizes for 44.1 and 48 kHz files.
+    i16 output[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    bool isPassed = true;
+
+    for (u32 channelCount = 1; channelCount <= MIXER_CHANNEL_COUNT && isPassed; ++channelCount) {
+        u32 blockSize = blockSizes[channelCount - 1];
+        u32 random = HEADLESS_RANDOM_SEED;
+
+        for (u32 byteIndex = 0; byteIndex < HEADLESS_ADPCM_DATA_SIZE; ++byteIndex) {
+            blocks[byteIndex] = (byte)(Headless_NextRandom(&random) >> 24);
+        }
+
+        for (u32 blockOffset = 0; blockOffset < HEADLESS_ADPCM_DATA_SIZE; blockOffset += blockSize) {
+            for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+                blocks[blockOffset + channelIndex * HEADLESS_ADPCM_HEADER_SIZE + 2] =
+                    (byte)(Headless_NextRandom(&random) % HEADLESS_ADPCM_STEP_INDEX_COUNT);
+            }
+        }
+
+        u64 frameCount = ADPCMGetFrameCount(HEADLESS_ADPCM_DATA_SIZE, blockSize, channelCount);
+        ADPCMDecoder decoder;
+        isPassed = ADPCMDecoderInit(&decoder, blocks, frameCount, blockSize, channelCount);
+
+        u64 framesDecoded = 0;
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        while (framesDecoded < frameCount && isPassed) {
+            usize framesRead = ADPCMDecode(&decoder, framesDecoded, output, MIXER_BLOCK_FRAMES);
+            framesDecoded += framesRead;
+            isPassed = framesRead > 0;
+        }
+
+        u64 nanoseconds = Headless_GetNanoseconds(&start) + 1;
+        u64 decodedSize = framesDecoded * channelCount * sizeof(i16);
+
+        char8 printBuffer[KILOBYTES(1)];
+        wsprintfA(
+            printBuffer,
+            "I:   %s %u-byte blocks  %u MB/s compressed, %u MB/s decoded, %u voices in real time, "
+            "%u%% of PCM size\n",
+            channelCount == 1 ? "mono  " : "stereo", blockSize,
+            (u32)((u64)HEADLESS_ADPCM_DATA_SIZE * 1000 / nanoseconds), (u32)(decodedSize * 1000 / nanoseconds),
+            (u32)(framesDecoded * 1000000000 / nanoseconds / HEADLESS_SAMPLES_PER_SECOND),
+            (u32)((u64)HEADLESS_ADPCM_DATA_SIZE * 100 / (decodedSize + 1)));
+        Win32_Print(printBuffer);
+    }
+
+    VirtualFree(blocks, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_VOICES_ONE_SHOT_COUNT (AUDIO_VOICE_MAP_SIZE + AUDIO_VOICE_MAP_SIZE / 2)
+#define HEADLESS_VOICES_ONE_SHOT_FRAMES 16
+#define HEADLESS_VOICES_BLOCK_FRAMES 256 // Rendered after every play, so one-shot is over by the next one.
+
+/*
+ * Starts looping voice, then plays more one-shots after it, than there are slots in voice map, and
+ * stops the first voice by its handle. Handle should still reach it, because it never finished.
+ */
+bool
+Headless_CheckVoices(void) {
+    usize waveSize = WAVEFILE_HEADER_SIZE + HEADLESS_SAMPLES_PER_SECOND * MIXER_CHANNEL_COUNT * sizeof(i16);
+    byte *wave = VirtualAlloc(NULL, waveSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    // NOTE(ilya.a): Device is never pumped, commands are applied by rendering by hand. [2026/10/18]
+    AudioNullDevice device;
+    AudioNullDeviceInit(&device, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_VOICES_BLOCK_FRAMES);
+    AudioSystem *audio = AudioSystemMake(&device.Sim.Device, RESAMPLE_QUALITY_MEDIUM);
+
+    if (wave == NULL || audio == NULL) {
+        if (wave != NULL) {
+            VirtualFree(wave, 0, MEM_RELEASE);
+        }
+        AudioSystemDestroy(audio);
+        return false;
+    }
+
+    Headless_MakeWave(wave, MIXER_CHANNEL_COUNT, HEADLESS_SAMPLES_PER_SECOND, HEADLESS_RANDOM_SEED);
+
+    MixerVoiceDesc desc = {0};
+    desc.Samples = wave + WAVEFILE_HEADER_SIZE;
+    desc.FrameCount = HEADLESS_SAMPLES_PER_SECOND;
+    desc.Format = PCM_FORMAT_I16;
+    desc.ChannelCount = MIXER_CHANNEL_COUNT;
+    desc.SampleRate = HEADLESS_SAMPLES_PER_SECOND;
+    desc.IsLooping = true;
+    desc.Volume = 1.0f;
+
+    i16 output[HEADLESS_VOICES_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    AudioVoice held = AudioSystemPlay(audio, &desc);
+    AudioSystemRender(audio, output, HEADLESS_VOICES_BLOCK_FRAMES);
+
+    desc.FrameCount = HEADLESS_VOICES_ONE_SHOT_FRAMES;
+    desc.IsLooping = false;
+
+    u32 failedPlayCount = 0;
+
+    for (u32 playIndex = 0; playIndex < HEADLESS_VOICES_ONE_SHOT_COUNT; ++playIndex) {
+        failedPlayCount += AudioSystemPlay(audio, &desc) == AUDIO_VOICE_INVALID;
+        AudioSystemRender(audio, output, HEADLESS_VOICES_BLOCK_FRAMES);
+    }
+
+    u32 playingBeforeStop = MixerGetPlayingCount(&audio->Mixer);
+    AudioSystemStop(audio, held);
+    AudioSystemRender(audio, output, HEADLESS_VOICES_BLOCK_FRAMES);
+    u32 playingAfterStop = MixerGetPlayingCount(&audio->Mixer);
+
+    bool isPassed = held != AUDIO_VOICE_INVALID && failedPlayCount == 0 && playingBeforeStop == 1 &&
+                    playingAfterStop == 0;
+
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I:   %u one-shots, %u failed, %u voices playing before stop of the first one, %u after\n",
+        HEADLESS_VOICES_ONE_SHOT_COUNT, failedPlayCount, playingBeforeStop, playingAfterStop);
+    Win32_Print(printBuffer);
+
+    AudioSystemDestroy(audio);
+    VirtualFree(wave, 0, MEM_RELEASE);
+    return isPassed;
+}
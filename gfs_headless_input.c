@@ -0,0 +1,116 @@
+/*
+ * GFS. Headless checks of controller polling.
+ *
+ * FILE      gfs_headless_input.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_input.h"
+#include "gfs_input_poller.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+#define HEADLESS_POLLER_HZ 10 // So empty slots are probed every 10 polls.
+#define HEADLESS_POLLER_POLL_COUNT 100
+#define HEADLESS_POLLER_PLUG_DELAY 5 // Polls from the last probe (including it), when gamepad is plugged.
+
+/*
+ * Device, which gamepads are plugged and unplugged by hand. Connected ones report their slot in
+ * triggers, so snapshot could be told from one of another slot.
+ */
+typedef struct {
+    InputDevice Device;
+    bool IsConnected[INPUT_GAMEPAD_COUNT];
+    u32 ReadCounts[INPUT_GAMEPAD_COUNT];
+} Headless_InputDevice;
+
+internal bool
+Headless_ReadGamepad(InputDevice *device, u32 gamepadIndex, InputGamepad *gamepadOut) {
+    Headless_InputDevice *stub = (Headless_InputDevice *)device;
+    ++stub->ReadCounts[gamepadIndex];
+
+    if (!stub->IsConnected[gamepadIndex]) {
+        return false;
+    }
+
+    gamepadOut->LeftTrigger = (u8)(gamepadIndex + 1);
+    return true;
+}
+
+/*
+ * Polls stub device directly, without poller thread. Connected slot should be read every poll
+ * and empty ones once per probe interval, gamepad plugged between probes should show up in
+ * snapshot on the next one and unplugged one on the very next poll.
+ */
+bool
+Headless_CheckPoller(void) {
+    Headless_InputDevice stub = {0};
+    stub.Device.Read = Headless_ReadGamepad;
+    stub.IsConnected[0] = true;
+
+    InputPoller poller;
+    InputPollerInit(&poller, &stub.Device, HEADLESS_POLLER_HZ);
+
+    for (u32 pollIndex = 0; pollIndex < HEADLESS_POLLER_POLL_COUNT; ++pollIndex) {
+        InputPollerPoll(&poller);
+    }
+
+    u32 probeInterval = poller.ProbeIntervalPolls;
+    u32 expectedProbeReads = (HEADLESS_POLLER_POLL_COUNT + probeInterval - 1) / probeInterval;
+    u32 emptyReadCount = stub.ReadCounts[1];
+    u32 failedCount = 0;
+
+    failedCount += probeInterval != HEADLESS_POLLER_HZ * INPUT_POLLER_PROBE_SECONDS;
+    failedCount += stub.ReadCounts[0] != HEADLESS_POLLER_POLL_COUNT;
+
+    for (u32 gamepadIndex = 1; gamepadIndex < INPUT_GAMEPAD_COUNT; ++gamepadIndex) {
+        failedCount += stub.ReadCounts[gamepadIndex] != expectedProbeReads;
+    }
+
+    // NOTE(ilya.a): Slot 0 is probed on the first poll too, before it is known to be connected. [2026/10/18]
+    failedCount += poller.Stats.ProbeCount != (INPUT_GAMEPAD_COUNT - 1) * expectedProbeReads + 1;
+
+    InputSnapshot snapshot;
+    InputPollerGetSnapshot(&poller, &snapshot);
+    failedCount += snapshot.Frame != HEADLESS_POLLER_POLL_COUNT;
+    failedCount += !snapshot.Gamepads[0].IsConnected || snapshot.Gamepads[0].LeftTrigger != 1;
+    failedCount += snapshot.Gamepads[1].IsConnected;
+
+    // NOTE(ilya.a): Poll count is multiple of probe interval, so the first of these polls is a probe
+    // and plugged gamepad has to wait for the next one. [2026/10/18]
+    for (u32 pollIndex = 0; pollIndex < HEADLESS_POLLER_PLUG_DELAY; ++pollIndex) {
+        InputPollerPoll(&poller);
+    }
+
+    stub.IsConnected[2] = true;
+
+    u32 pickupPollCount = 0;
+
+    do {
+        InputPollerPoll(&poller);
+        InputPollerGetSnapshot(&poller, &snapshot);
+        ++pickupPollCount;
+    } while (!snapshot.Gamepads[2].IsConnected && pickupPollCount <= probeInterval);
+
+    failedCount += pickupPollCount != probeInterval - HEADLESS_POLLER_PLUG_DELAY + 1;
+    failedCount += snapshot.Gamepads[2].LeftTrigger != 3;
+
+    stub.IsConnected[0] = false;
+    InputPollerPoll(&poller);
+    InputPollerGetSnapshot(&poller, &snapshot);
+    failedCount += snapshot.Gamepads[0].IsConnected || snapshot.Gamepads[0].LeftTrigger != 0;
+
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I:   %u polls, empty slots read %u times, plugged gamepad seen after %u polls, %u failed\n",
+        HEADLESS_POLLER_POLL_COUNT, emptyReadCount, pickupPollCount, failedCount);
+    Win32_Print(printBuffer);
+
+    return failedCount == 0;
+}
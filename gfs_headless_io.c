@@ -0,0 +1,689 @@
+/*
+ * GFS. Headless benchmarks of file IO and asset loading.
+ *
+ * FILE      gfs_headless_io.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+#include <psapi.h>
+#include <math.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_io_queue.h"
+#include "gfs_string.h"
+#include "gfs_wave.h"
+#include "gfs_pack.h"
+#include "gfs_lz.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+#define HEADLESS_BENCH_FILE_SIZE MEGABYTES(64)
+#define HEADLESS_BENCH_CHUNK_SIZE KILOBYTES(64)
+
+/*
+ * Writes file of `size` bytes of noise, which IO benchmarks read back.
+ */
+internal bool
+Headless_WriteBenchFile(cstr8 path, usize size) {
+    FileHandle file;
+
+    if (IOCreateFile(path, &file) != IO_OK) {
+        Win32_Print("E: Failed to create benchmark file!\n");
+        return false;
+    }
+
+    u32 chunk[HEADLESS_BENCH_CHUNK_SIZE / sizeof(u32)];
+    u32 random = HEADLESS_RANDOM_SEED;
+    bool isWritten = true;
+
+    for (usize offset = 0; offset < size && isWritten; offset += sizeof(chunk)) {
+        for (u32 index = 0; index < HEADLESS_BENCH_CHUNK_SIZE / sizeof(u32); ++index) {
+            chunk[index] = Headless_NextRandom(&random);
+        }
+
+        usize chunkSize = size - offset < sizeof(chunk) ? size - offset : sizeof(chunk);
+        isWritten = IOWriteBytesToFile(&file, chunk, chunkSize) == IO_OK;
+    }
+
+    IOCloseFile(&file);
+    return isWritten;
+}
+
+/*
+ * Reads every 64-bit word of `data`, the way asset would be used after load. Returns their sum,
+ * so reads can't be skipped and both ways of loading could be compared.
+ */
+internal u64
+Headless_ReadThrough(const void *data, usize size) {
+    const u64 *words = (const u64 *)data;
+    u64 sum = 0;
+
+    for (usize index = 0; index < size / sizeof(u64); ++index) {
+        sum += words[index];
+    }
+
+    return sum;
+}
+
+internal void
+Headless_GetMemoryUsage(usize *workingSetOut, usize *privateOut) {
+    PROCESS_MEMORY_COUNTERS_EX counters = {0};
+    GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS *)&counters, sizeof(counters));
+
+    *workingSetOut = counters.WorkingSetSize;
+    *privateOut = counters.PrivateUsage;
+}
+
+internal void
+Headless_PrintLoad(cstr8 name, u64 loadNanoseconds, u64 readNanoseconds, usize workingSets[2], usize privates[2]) {
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I:   %-8s load %uus, read through %uus, working set +%uKiB, private +%uKiB\n", name,
+        (u32)(loadNanoseconds / 1000), (u32)(readNanoseconds / 1000),
+        (u32)((workingSets[1] > workingSets[0] ? workingSets[1] - workingSets[0] : 0) / KILOBYTES(1)),
+        (u32)((privates[1] > privates[0] ? privates[1] - privates[0] : 0) / KILOBYTES(1)));
+    Win32_Print(printBuffer);
+}
+
+/*
+ * Whole file read into memory against mapping of it. Both are read through afterwards, like
+ * asset would be used. File was just written, so both read from page cache.
+ */
+bool
+Headless_BenchMapping(void) {
+    if (!Headless_WriteBenchFile(HEADLESS_BENCH_FILE_PATH, HEADLESS_BENCH_FILE_SIZE)) {
+        return false;
+    }
+
+    usize workingSets[2], privates[2];
+    LARGE_INTEGER start;
+    FileHandle file;
+    usize fileSize = 0;
+
+    Headless_GetMemoryUsage(&workingSets[0], &privates[0]);
+    QueryPerformanceCounter(&start);
+
+    if (IOOpenFile(HEADLESS_BENCH_FILE_PATH, &file, IO_READ) != IO_OK) {
+        DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+        return false;
+    }
+
+    IOGetFileSize(&file, &fileSize);
+    void *buffer = VirtualAlloc(NULL, fileSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    IOResult readResult = buffer != NULL ? IOLoadBytesFromFile(&file, buffer, fileSize) : IO_ERR_FAILED_TO_READ;
+    IOCloseFile(&file);
+
+    u64 loadNanoseconds = Headless_GetNanoseconds(&start);
+    u64 copySum = readResult == IO_OK ? Headless_ReadThrough(buffer, fileSize) : 0;
+    u64 readNanoseconds = Headless_GetNanoseconds(&start);
+
+    Headless_GetMemoryUsage(&workingSets[1], &privates[1]);
+    Headless_PrintLoad("copy", loadNanoseconds, readNanoseconds, workingSets, privates);
+
+    if (buffer != NULL) {
+        VirtualFree(buffer, 0, MEM_RELEASE);
+    }
+
+    IOFileMapping mapping;
+    Headless_GetMemoryUsage(&workingSets[0], &privates[0]);
+    QueryPerformanceCounter(&start);
+
+    IOResult mapResult = IOMapFile(HEADLESS_BENCH_FILE_PATH, &mapping, IO_ACCESS_SEQUENTIAL);
+
+    loadNanoseconds = Headless_GetNanoseconds(&start);
+    u64 mapSum = mapResult == IO_OK ? Headless_ReadThrough(mapping.Data, mapping.Size) : 0;
+    readNanoseconds = Headless_GetNanoseconds(&start);
+
+    Headless_GetMemoryUsage(&workingSets[1], &privates[1]);
+    Headless_PrintLoad("map", loadNanoseconds, readNanoseconds, workingSets, privates);
+
+    if (mapResult == IO_OK) {
+        IOUnmapFile(&mapping);
+    }
+
+    DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+    return readResult == IO_OK && mapResult == IO_OK && copySum == mapSum;
+}
+
+#define HEADLESS_QUEUE_REQUEST_SIZE KILOBYTES(64)
+#define HEADLESS_QUEUE_DEPTH_MAX 64
+
+/*
+ * Streams whole file through IO queue in fixed size requests, keeping 1 to
+ * `HEADLESS_QUEUE_DEPTH_MAX` of them in flight. File is read through synchronous handle and
+ * through `IO_OVERLAPPED` one, which workers can read at the same time.
+ */
+bool
+Headless_BenchQueue(void) {
+    if (!Headless_WriteBenchFile(HEADLESS_BENCH_FILE_PATH, HEADLESS_BENCH_FILE_SIZE)) {
+        return false;
+    }
+
+    IOQueue *queue = IOQueueMake(0);
+    byte *buffers = VirtualAlloc(
+        NULL, HEADLESS_QUEUE_DEPTH_MAX * HEADLESS_QUEUE_REQUEST_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    bool isPassed = queue != NULL && buffers != NULL;
+    u32 requestCount = HEADLESS_BENCH_FILE_SIZE / HEADLESS_QUEUE_REQUEST_SIZE;
+    char8 printBuffer[KILOBYTES(1)];
+
+    IOPermissions modes[2] = {IO_READ, IO_READ | IO_OVERLAPPED};
+    cstr8 modeNames[2] = {"sync", "overlapped"};
+
+    for (u32 modeIndex = 0; modeIndex < 2 && isPassed; ++modeIndex) {
+        FileHandle file;
+        bool isOpened = IOOpenFile(HEADLESS_BENCH_FILE_PATH, &file, modes[modeIndex]) == IO_OK;
+        isPassed = isOpened;
+
+        for (u32 depth = 1; depth <= HEADLESS_QUEUE_DEPTH_MAX && isPassed; depth *= 2) {
+            IOTicket tickets[HEADLESS_QUEUE_DEPTH_MAX];
+            LARGE_INTEGER start;
+            QueryPerformanceCounter(&start);
+
+            // NOTE(ilya.a): Request goes into the slot of the oldest one, as soon as it completes. [2026/10/18]
+            for (u32 requestIndex = 0; requestIndex < requestCount + depth && isPassed; ++requestIndex) {
+                u32 slot = requestIndex % depth;
+
+                if (requestIndex >= depth) {
+                    IOCompletion completion = IOQueueWait(queue, tickets[slot]);
+                    isPassed = completion.Result == IO_OK && completion.BytesRead == HEADLESS_QUEUE_REQUEST_SIZE;
+                }
+
+                if (requestIndex < requestCount) {
+                    IORequest request = {
+                        file, (u64)requestIndex * HEADLESS_QUEUE_REQUEST_SIZE, HEADLESS_QUEUE_REQUEST_SIZE,
+                        buffers + slot * HEADLESS_QUEUE_REQUEST_SIZE};
+                    tickets[slot] = IOQueueSubmit(queue, &request);
+                    isPassed = isPassed && tickets[slot] != IO_TICKET_INVALID;
+                }
+            }
+
+            u64 nanoseconds = Headless_GetNanoseconds(&start);
+            nanoseconds = nanoseconds > 0 ? nanoseconds : 1;
+
+            wsprintfA(
+                printBuffer, "I:   %-10s depth %2u  %u MB/s, %u requests/s\n", modeNames[modeIndex], depth,
+                (u32)((u64)HEADLESS_BENCH_FILE_SIZE * 1000 / nanoseconds),
+                (u32)((u64)requestCount * 1000000000ull / nanoseconds));
+            Win32_Print(printBuffer);
+        }
+
+        if (isOpened) {
+            IOCloseFile(&file);
+        }
+    }
+
+    if (queue != NULL) {
+        IOQueueDestroy(queue);
+    }
+
+    if (buffers != NULL) {
+        VirtualFree(buffers, 0, MEM_RELEASE);
+    }
+
+    DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+    return isPassed;
+}
+
+#define HEADLESS_PACK_DIRECTORY "gfs_headless_bench"
+#define HEADLESS_PACK_PATH HEADLESS_PACK_DIRECTORY "/assets.pack"
+#define HEADLESS_PACK_ASSET_COUNT 1000
+#define HEADLESS_PACK_ASSET_FRAMES 2048
+#define HEADLESS_PACK_ASSET_SIZE (WAVEFILE_HEADER_SIZE + HEADLESS_PACK_ASSET_FRAMES * 2 * sizeof(i16))
+#define HEADLESS_PACK_ASSET_STRIDE \
+    ((HEADLESS_PACK_ASSET_SIZE + PACK_ALIGNMENT_DEFAULT - 1) & ~(usize)(PACK_ALIGNMENT_DEFAULT - 1))
+#define HEADLESS_PACK_NAME_CAPACITY 32
+
+global_var char8 gPackAssetNames[HEADLESS_PACK_ASSET_COUNT][HEADLESS_PACK_NAME_CAPACITY];
+
+/*
+ * Writes every asset as loose file and builds archive of the same assets (the way `gfs_packer`
+ * lays it out) into `image`, which should be zeroed.
+ */
+internal bool
+Headless_WriteBenchAssets(byte *image, usize imageSize, u32 slotCount, u64 dataOffset) {
+    PackHeader *header = (PackHeader *)image;
+    header->Magic = PACK_MAGIC;
+    header->Version = PACK_VERSION;
+    header->EntryCount = HEADLESS_PACK_ASSET_COUNT;
+    header->SlotCount = slotCount;
+    header->TableOffset = sizeof(PackHeader);
+    header->DataOffset = dataOffset;
+
+    PackEntry *table = (PackEntry *)(image + header->TableOffset);
+    bool isWritten = true;
+
+    for (u32 assetIndex = 0; assetIndex < HEADLESS_PACK_ASSET_COUNT && isWritten; ++assetIndex) {
+        cstr8 name = gPackAssetNames[assetIndex];
+        wsprintfA(gPackAssetNames[assetIndex], HEADLESS_PACK_DIRECTORY "/%04u.wav", assetIndex);
+
+        u64 offset = dataOffset + (u64)assetIndex * HEADLESS_PACK_ASSET_STRIDE;
+        usize size = Headless_MakeWave(image + offset, 2, HEADLESS_PACK_ASSET_FRAMES, assetIndex + 1);
+
+        u64 nameHash = CStr8Hash64(name);
+        u32 slotIndex = (u32)nameHash & (slotCount - 1);
+
+        while (table[slotIndex].NameHash != 0) {
+            slotIndex = (slotIndex + 1) & (slotCount - 1);
+        }
+
+        PackEntry *entry = &table[slotIndex];
+        entry->NameHash = nameHash;
+        entry->Offset = offset;
+        entry->Size = size;
+        entry->UncompressedSize = size;
+        entry->Type = PACK_ASSET_TYPE_WAVE;
+        entry->Alignment = PACK_ALIGNMENT_DEFAULT;
+
+        FileHandle file;
+        isWritten = IOCreateFile(name, &file) == IO_OK;
+        isWritten = isWritten && IOWriteBytesToFile(&file, image + offset, size) == IO_OK;
+        IOCloseFile(&file);
+    }
+
+    FileHandle file;
+    isWritten = isWritten && IOCreateFile(HEADLESS_PACK_PATH, &file) == IO_OK;
+    isWritten = isWritten && IOWriteBytesToFile(&file, image, imageSize) == IO_OK;
+    IOCloseFile(&file);
+
+    return isWritten;
+}
+
+/*
+ * Loads every asset as loose file or, if `archive` isn't NULL, from archive. Returns sum of
+ * samples, so both ways could be compared.
+ */
+internal u64
+Headless_LoadBenchAssets(PackArchive *archive, ScratchAllocator *arena, u32 *failCountOut) {
+    u64 sampleSum = 0;
+    u32 failCount = 0;
+
+    for (u32 assetIndex = 0; assetIndex < HEADLESS_PACK_ASSET_COUNT; ++assetIndex) {
+        WaveAsset wave;
+        WaveAssetLoadResult loadResult = WAVEASSET_LOAD_ERR;
+
+        if (archive != NULL) {
+            const PackEntry *entry = PackFindByName(archive, gPackAssetNames[assetIndex]);
+            const void *data = NULL;
+
+            if (entry != NULL && PackLoadAsset(archive, entry, arena, &data) == PACK_OK) {
+                loadResult = WaveAssetLoadFromMemory(data, (usize)entry->UncompressedSize, &wave);
+            }
+        } else {
+            loadResult = WaveAssetLoadFromFile(arena, gPackAssetNames[assetIndex], &wave);
+        }
+
+        if (loadResult != WAVEASSET_LOAD_OK) {
+            ++failCount;
+            continue;
+        }
+
+        sampleSum += (u16)((i16 *)wave.Data)[0] + (u16)((i16 *)wave.Data)[wave.Header.DataSize / sizeof(i16) - 1];
+    }
+
+    *failCountOut += failCount;
+    return sampleSum;
+}
+
+/*
+ * Loads every asset as loose file against the same assets from archive, twice: cold is the first
+ * load in process (archive is opened as part of it), warm is the second one. Files were just
+ * written, so both are read from file cache.
+ */
+bool
+Headless_BenchPack(void) {
+    u32 slotCount = PackGetSlotCount(HEADLESS_PACK_ASSET_COUNT);
+    u64 dataOffset = sizeof(PackHeader) + (u64)slotCount * sizeof(PackEntry);
+    dataOffset = (dataOffset + PACK_ALIGNMENT_DEFAULT - 1) & ~(u64)(PACK_ALIGNMENT_DEFAULT - 1);
+    usize imageSize = (usize)dataOffset + HEADLESS_PACK_ASSET_COUNT * HEADLESS_PACK_ASSET_STRIDE;
+
+    byte *image = VirtualAlloc(NULL, imageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    ScratchAllocator arena = ScratchAllocatorMake(HEADLESS_PACK_ASSET_COUNT * HEADLESS_PACK_ASSET_STRIDE);
+
+    CreateDirectoryA(HEADLESS_PACK_DIRECTORY, NULL);
+
+    bool isPassed =
+        image != NULL && arena.Data != NULL && Headless_WriteBenchAssets(image, imageSize, slotCount, dataOffset);
+    u32 failCount = 0;
+    u64 nanoseconds[2][2] = {0}; // Loose and packed, cold and warm.
+    u64 sampleSums[2] = {0};
+
+    if (isPassed) {
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+
+        sampleSums[0] = Headless_LoadBenchAssets(NULL, &arena, &failCount);
+        nanoseconds[0][0] = Headless_GetNanoseconds(&start);
+
+        arena.Occupied = 0;
+        Headless_LoadBenchAssets(NULL, &arena, &failCount);
+        nanoseconds[0][1] = Headless_GetNanoseconds(&start);
+
+        PackArchive archive;
+        isPassed = PackOpen(HEADLESS_PACK_PATH, &archive) == PACK_OK;
+
+        if (isPassed) {
+            sampleSums[1] = Headless_LoadBenchAssets(&archive, &arena, &failCount);
+            nanoseconds[1][0] = Headless_GetNanoseconds(&start);
+
+            Headless_LoadBenchAssets(&archive, &arena, &failCount);
+            nanoseconds[1][1] = Headless_GetNanoseconds(&start);
+
+            PackClose(&archive);
+        }
+    }
+
+    if (isPassed) {
+        char8 printBuffer[KILOBYTES(1)];
+        cstr8 names[2] = {"loose", "pack"};
+
+        for (u32 index = 0; index < 2; ++index) {
+            wsprintfA(
+                printBuffer, "I:   %-8s %u assets, cold %uus, warm %uus (%uns per asset)\n", names[index],
+                HEADLESS_PACK_ASSET_COUNT, (u32)(nanoseconds[index][0] / 1000), (u32)(nanoseconds[index][1] / 1000),
+                (u32)(nanoseconds[index][1] / HEADLESS_PACK_ASSET_COUNT));
+            Win32_Print(printBuffer);
+        }
+    }
+
+    for (u32 assetIndex = 0; assetIndex < HEADLESS_PACK_ASSET_COUNT; ++assetIndex) {
+        DeleteFileA(gPackAssetNames[assetIndex]);
+    }
+
+    DeleteFileA(HEADLESS_PACK_PATH);
+    RemoveDirectoryA(HEADLESS_PACK_DIRECTORY);
+
+    if (image != NULL) {
+        VirtualFree(image, 0, MEM_RELEASE);
+    }
+
+    ScratchAllocatorFree(&arena);
+    return isPassed && failCount == 0 && sampleSums[0] == sampleSums[1];
+}
+
+
+#define HEADLESS_CODEC_TONE_FRAMES (HEADLESS_SAMPLES_PER_SECOND * 4)
+#define HEADLESS_CODEC_NOISE_SIZE MEGABYTES(1)
+#define HEADLESS_CODEC_REPEAT_COUNT 16 // Decompressions per sample, which time is averaged.
+
+/*
+ * Compresses `content` into LZ frame, decompresses it back and prints ratio and speed both ways.
+ */
+internal bool
+Headless_BenchCodecSample(cstr8 name, const void *content, usize contentSize) {
+    usize frameCapacity = LZFrameCompressBound(contentSize, LZ_FRAME_BLOCK_SIZE_DEFAULT);
+    byte *frame = VirtualAlloc(NULL, frameCapacity + contentSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (frame == NULL) {
+        return false;
+    }
+
+    byte *decompressed = frame + frameCapacity;
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    usize frameSize = LZFrameCompress(content, contentSize, frame, frameCapacity, LZ_FRAME_BLOCK_SIZE_DEFAULT);
+    u64 compressNanoseconds = Headless_GetNanoseconds(&start);
+    bool isPassed = frameSize > 0;
+
+    for (u32 repeatIndex = 0; repeatIndex < HEADLESS_CODEC_REPEAT_COUNT && isPassed; ++repeatIndex) {
+        isPassed = LZFrameDecompress(frame, frameSize, decompressed, contentSize) == LZ_OK;
+    }
+
+    u64 decompressNanoseconds = Headless_GetNanoseconds(&start) / HEADLESS_CODEC_REPEAT_COUNT;
+    isPassed = isPassed && BytesHash64(decompressed, contentSize) == BytesHash64(content, contentSize);
+
+    u32 permille = (u32)(frameSize * 1000 / contentSize);
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(
+        printBuffer, "I:   %-8s %uKiB -> %uKiB (%u.%u%%), compress %u MB/s, decompress %u MB/s\n", name,
+        (u32)(contentSize / KILOBYTES(1)), (u32)(frameSize / KILOBYTES(1)), permille / 10, permille % 10,
+        (u32)(contentSize * 1000 / (compressNanoseconds > 0 ? compressNanoseconds : 1)),
+        (u32)(contentSize * 1000 / (decompressNanoseconds > 0 ? decompressNanoseconds : 1)));
+    Win32_Print(printBuffer);
+
+    VirtualFree(frame, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_CODEC_PICTURE_WIDTH 900
+#define HEADLESS_CODEC_PICTURE_HEIGHT 600
+#define HEADLESS_CODEC_TILE_SIZE 30
+
+/*
+ * LZ codec on the kinds of payloads packs store: picture (BGRA), tone (PCM) and noise, which is
+ * the worst case. Picture is flat background with rows of tiles and shaded bar, like game's
+ * screen.
+ */
+bool
+Headless_BenchCodec(void) {
+    usize pictureSize = HEADLESS_CODEC_PICTURE_WIDTH * HEADLESS_CODEC_PICTURE_HEIGHT * sizeof(u32);
+    usize toneSize = HEADLESS_CODEC_TONE_FRAMES * 2 * sizeof(i16);
+    byte *samples = VirtualAlloc(
+        NULL, pictureSize + toneSize + HEADLESS_CODEC_NOISE_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (samples == NULL) {
+        return false;
+    }
+
+    u32 *picture = (u32 *)samples;
+
+    for (u32 y = 0; y < HEADLESS_CODEC_PICTURE_HEIGHT; ++y) {
+        for (u32 x = 0; x < HEADLESS_CODEC_PICTURE_WIDTH; ++x) {
+            u32 tileX = x / HEADLESS_CODEC_TILE_SIZE, tileY = y / HEADLESS_CODEC_TILE_SIZE;
+            u32 color = 0xFF202020;
+
+            if (y >= HEADLESS_CODEC_PICTURE_HEIGHT - HEADLESS_CODEC_TILE_SIZE) {
+                color = 0xFF000000 | (x * 255 / HEADLESS_CODEC_PICTURE_WIDTH) << 8;
+            } else if (tileY < 6 && (tileX + tileY) % 3 != 0 && x % HEADLESS_CODEC_TILE_SIZE != 0) {
+                color = 0xFF000000 | (tileY * 40 + 40) << 16 | (tileX * 8) << 8 | 0x80;
+            }
+
+            picture[y * HEADLESS_CODEC_PICTURE_WIDTH + x] = color;
+        }
+    }
+
+    i16 *tone = (i16 *)(samples + pictureSize);
+
+    for (u32 frameIndex = 0; frameIndex < HEADLESS_CODEC_TONE_FRAMES; ++frameIndex) {
+        f32 phase = HEADLESS_TWO_PI * (f32)frameIndex / HEADLESS_SAMPLES_PER_SECOND;
+        tone[frameIndex * 2 + 0] = (i16)(8000.0f * (sinf(phase * 220.0f) + 0.5f * sinf(phase * 330.0f)));
+        tone[frameIndex * 2 + 1] = (i16)(8000.0f * (sinf(phase * 220.0f + 1.0f) + 0.5f * sinf(phase * 440.0f)));
+    }
+
+    u32 *noise = (u32 *)(samples + pictureSize + toneSize);
+    u32 random = HEADLESS_RANDOM_SEED;
+
+    for (u32 index = 0; index < HEADLESS_CODEC_NOISE_SIZE / sizeof(u32); ++index) {
+        noise[index] = Headless_NextRandom(&random);
+    }
+
+    bool isPassed = Headless_BenchCodecSample("picture", picture, pictureSize);
+    isPassed = Headless_BenchCodecSample("tone", tone, toneSize) && isPassed;
+    isPassed = Headless_BenchCodecSample("noise", noise, HEADLESS_CODEC_NOISE_SIZE) && isPassed;
+
+    VirtualFree(samples, 0, MEM_RELEASE);
+    return isPassed;
+}
+
+#define HEADLESS_STREAM_RECORD_COUNT 100000
+#define HEADLESS_STREAM_BUFFER_SIZE_MAX KILOBYTES(64)
+
+typedef struct {
+    u64 Syscalls[2]; // Write and read.
+    u64 Nanoseconds[2];
+    u64 Checksum; // Of values read back.
+} Headless_StreamResult;
+
+/*
+ * Writes records of a few small fields (u32, varint and f32) field by field straight into file,
+ * then reads them back the same way, one syscall per field (per byte for varints).
+ */
+internal bool
+Headless_RunStreamUnbuffered(Headless_StreamResult *result) {
+    FileHandle file;
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    if (IOCreateFile(HEADLESS_BENCH_FILE_PATH, &file) != IO_OK) {
+        return false;
+    }
+
+    u32 random = HEADLESS_RANDOM_SEED;
+    bool isPassed = true;
+
+    for (u32 recordIndex = 0; recordIndex < HEADLESS_STREAM_RECORD_COUNT && isPassed; ++recordIndex) {
+        u32 value = Headless_NextRandom(&random);
+        u64 varValue = value >> (value & 31);
+        f32 weight = (f32)recordIndex * 0.5f;
+
+        byte varBytes[10];
+        usize varSize = 0;
+
+        do {
+            varBytes[varSize++] = (byte)(varValue & 0x7F) | (varValue > 0x7F ? 0x80 : 0);
+            varValue >>= 7;
+        } while (varValue > 0);
+
+        isPassed = IOWriteBytesToFile(&file, &recordIndex, sizeof(recordIndex)) == IO_OK &&
+                   IOWriteBytesToFile(&file, varBytes, varSize) == IO_OK &&
+                   IOWriteBytesToFile(&file, &weight, sizeof(weight)) == IO_OK;
+        result->Syscalls[0] += 3;
+    }
+
+    IOCloseFile(&file);
+    result->Nanoseconds[0] = Headless_GetNanoseconds(&start);
+
+    if (!isPassed || IOOpenFile(HEADLESS_BENCH_FILE_PATH, &file, IO_READ) != IO_OK) {
+        return false;
+    }
+
+    u64 offset = 0;
+
+    for (u32 recordIndex = 0; recordIndex < HEADLESS_STREAM_RECORD_COUNT && isPassed; ++recordIndex) {
+        u32 index = 0;
+        u64 varValue = 0;
+        f32 weight = 0;
+        byte varByte = 0x80;
+
+        isPassed = IOReadAt(&file, &index, sizeof(index), offset, NULL) == IO_OK;
+        offset += sizeof(index);
+        ++result->Syscalls[1];
+
+        for (u32 shift = 0; (varByte & 0x80) != 0 && isPassed; shift += 7) {
+            isPassed = IOReadAt(&file, &varByte, 1, offset++, NULL) == IO_OK;
+            varValue |= (u64)(varByte & 0x7F) << shift;
+            ++result->Syscalls[1];
+        }
+
+        isPassed = isPassed && IOReadAt(&file, &weight, sizeof(weight), offset, NULL) == IO_OK;
+        offset += sizeof(weight);
+        ++result->Syscalls[1];
+
+        result->Checksum += index + varValue + (u64)weight;
+    }
+
+    IOCloseFile(&file);
+    result->Nanoseconds[1] = Headless_GetNanoseconds(&start);
+
+    return isPassed;
+}
+
+/*
+ * Same records as `Headless_RunStreamUnbuffered`, through `IOWriter` and `IOReader` with
+ * `bufferSize` bytes of buffer.
+ */
+internal bool
+Headless_RunStreamBuffered(void *buffer, usize bufferSize, Headless_StreamResult *result) {
+    FileHandle file;
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    if (IOCreateFile(HEADLESS_BENCH_FILE_PATH, &file) != IO_OK) {
+        return false;
+    }
+
+    IOWriter writer = IOWriterMake(file, buffer, bufferSize);
+    u32 random = HEADLESS_RANDOM_SEED;
+    bool isPassed = true;
+
+    for (u32 recordIndex = 0; recordIndex < HEADLESS_STREAM_RECORD_COUNT && isPassed; ++recordIndex) {
+        u32 value = Headless_NextRandom(&random);
+
+        isPassed = IOWriterWriteU32(&writer, recordIndex) == IO_OK &&
+                   IOWriterWriteVarU64(&writer, value >> (value & 31)) == IO_OK &&
+                   IOWriterWriteF32(&writer, (f32)recordIndex * 0.5f) == IO_OK;
+    }
+
+    isPassed = IOWriterClose(&writer) == IO_OK && isPassed;
+    result->Syscalls[0] = writer.SyscallCount;
+    result->Nanoseconds[0] = Headless_GetNanoseconds(&start);
+
+    if (!isPassed || IOOpenFile(HEADLESS_BENCH_FILE_PATH, &file, IO_READ) != IO_OK) {
+        return false;
+    }
+
+    IOReader reader = IOReaderMake(file, 0, buffer, bufferSize);
+
+    for (u32 recordIndex = 0; recordIndex < HEADLESS_STREAM_RECORD_COUNT && isPassed; ++recordIndex) {
+        u32 index = 0;
+        u64 varValue = 0;
+        f32 weight = 0;
+
+        isPassed = IOReaderReadU32(&reader, &index) == IO_OK && IOReaderReadVarU64(&reader, &varValue) == IO_OK &&
+                   IOReaderReadF32(&reader, &weight) == IO_OK;
+        result->Checksum += index + varValue + (u64)weight;
+    }
+
+    IOCloseFile(&file);
+    result->Syscalls[1] = reader.SyscallCount;
+    result->Nanoseconds[1] = Headless_GetNanoseconds(&start);
+
+    return isPassed;
+}
+
+/*
+ * Small typed fields written and read back field by field with a syscall per field, against
+ * buffered writer and reader with small and big buffer.
+ */
+bool
+Headless_BenchStream(void) {
+    void *buffer = VirtualAlloc(NULL, HEADLESS_STREAM_BUFFER_SIZE_MAX, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (buffer == NULL) {
+        return false;
+    }
+
+    usize bufferSizes[3] = {0, KILOBYTES(4), HEADLESS_STREAM_BUFFER_SIZE_MAX}; // Zero is unbuffered.
+    u64 firstChecksum = 0;
+    bool isPassed = true;
+
+    for (u32 runIndex = 0; runIndex < 3 && isPassed; ++runIndex) {
+        Headless_StreamResult result = {0};
+
+        if (bufferSizes[runIndex] == 0) {
+            isPassed = Headless_RunStreamUnbuffered(&result);
+        } else {
+            isPassed = Headless_RunStreamBuffered(buffer, bufferSizes[runIndex], &result);
+        }
+
+        firstChecksum = runIndex == 0 ? result.Checksum : firstChecksum;
+        isPassed = isPassed && result.Checksum == firstChecksum;
+
+        char8 printBuffer[KILOBYTES(1)];
+        wsprintfA(
+            printBuffer, "I:   buffer %2uKiB  %u records, write %u syscalls in %uus, read %u syscalls in %uus\n",
+            (u32)(bufferSizes[runIndex] / KILOBYTES(1)), HEADLESS_STREAM_RECORD_COUNT, (u32)result.Syscalls[0],
+            (u32)(result.Nanoseconds[0] / 1000), (u32)result.Syscalls[1], (u32)(result.Nanoseconds[1] / 1000));
+        Win32_Print(printBuffer);
+    }
+
+    DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+    VirtualFree(buffer, 0, MEM_RELEASE);
+    return isPassed;
+}
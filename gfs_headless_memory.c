@@ -0,0 +1,126 @@
+/*
+ * GFS. Headless benchmarks of allocators.
+ *
+ * FILE      gfs_headless_memory.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+#include <stdlib.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+#define HEADLESS_CHURN_SLOT_COUNT 4096
+#define HEADLESS_CHURN_OP_COUNT 1000000
+#define HEADLESS_CHURN_POOL_SIZE MEGABYTES(256)
+
+/*
+ * Size of the next loaded asset: mostly sound effects and small images, every 16th is a big
+ * texture or music chunk.
+ */
+internal usize
+Headless_GetChurnSize(u32 *random) {
+    u32 value = Headless_NextRandom(random);
+    return value % 16 == 0 ? KILOBYTES(64) + value % MEGABYTES(1) : 64 + value % KILOBYTES(16);
+}
+
+/*
+ * Loads and unloads assets into random slots with TLSF allocator or, if it's NULL, with C
+ * runtime heap. Slots are left as they are after the last operation. Returns nanoseconds taken.
+ */
+internal u64
+Headless_RunChurn(TLSFAllocator *tlsf, void **slots, u32 *failCountOut) {
+    u32 random = HEADLESS_RANDOM_SEED;
+    u32 failCount = 0;
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    for (u32 opIndex = 0; opIndex < HEADLESS_CHURN_OP_COUNT; ++opIndex) {
+        u32 slot = Headless_NextRandom(&random) % HEADLESS_CHURN_SLOT_COUNT;
+
+        if (slots[slot] != NULL) {
+            if (tlsf != NULL) {
+                TLSFAllocatorFree(tlsf, slots[slot]);
+            } else {
+                free(slots[slot]);
+            }
+
+            slots[slot] = NULL;
+            continue;
+        }
+
+        usize size = Headless_GetChurnSize(&random);
+        slots[slot] = tlsf != NULL ? TLSFAllocatorAlloc(tlsf, size) : malloc(size);
+
+        if (slots[slot] == NULL) {
+            ++failCount;
+            continue;
+        }
+
+        // NOTE(ilya.a): Touching both ends, like loader would, so lazily committed pages are paid for. [2026/10/18]
+        ((byte *)slots[slot])[0] = 1;
+        ((byte *)slots[slot])[size - 1] = 1;
+    }
+
+    *failCountOut = failCount;
+    return Headless_GetNanoseconds(&start);
+}
+
+/*
+ * TLSF allocator against C runtime heap on asset churn.
+ */
+bool
+Headless_BenchAllocator(void) {
+    TLSFAllocator tlsf = TLSFAllocatorMake(HEADLESS_CHURN_POOL_SIZE);
+
+    if (tlsf.Data == NULL) {
+        Win32_Print("E: Failed to create TLSF allocator!\n");
+        return false;
+    }
+
+    void *slots[HEADLESS_CHURN_SLOT_COUNT] = {0};
+    char8 printBuffer[KILOBYTES(1)];
+    u32 failCounts[2];
+    u64 nanoseconds[2];
+
+    nanoseconds[0] = Headless_RunChurn(&tlsf, slots, &failCounts[0]);
+    TLSFAllocatorStats stats = TLSFAllocatorGetStats(&tlsf);
+
+    for (u32 slot = 0; slot < HEADLESS_CHURN_SLOT_COUNT; ++slot) {
+        TLSFAllocatorFree(&tlsf, slots[slot]);
+        slots[slot] = NULL;
+    }
+
+    nanoseconds[1] = Headless_RunChurn(NULL, slots, &failCounts[1]);
+
+    for (u32 slot = 0; slot < HEADLESS_CHURN_SLOT_COUNT; ++slot) {
+        free(slots[slot]);
+    }
+
+    cstr8 names[2] = {"tlsf", "malloc"};
+
+    for (u32 index = 0; index < 2; ++index) {
+        u64 picoseconds = nanoseconds[index] * 1000 / HEADLESS_CHURN_OP_COUNT;
+        wsprintfA(
+            printBuffer, "I:   %-8s %u ops in %uus, %u.%03uns per op, %u failed\n", names[index],
+            HEADLESS_CHURN_OP_COUNT, (u32)(nanoseconds[index] / 1000), (u32)(picoseconds / 1000),
+            (u32)(picoseconds % 1000), failCounts[index]);
+        Win32_Print(printBuffer);
+    }
+
+    u32 fragmentation = (u32)(stats.Fragmentation * 1000.0f);
+    wsprintfA(
+        printBuffer, "I:   tlsf at the end: %uKiB used in %u blocks, %uKiB free in %u blocks, %u.%u%% fragmented\n",
+        (u32)(stats.UsedBytes / KILOBYTES(1)), (u32)stats.UsedBlockCount, (u32)(stats.FreeBytes / KILOBYTES(1)),
+        (u32)stats.FreeBlockCount, fragmentation / 10, fragmentation % 10);
+    Win32_Print(printBuffer);
+
+    TLSFAllocatorDestroy(&tlsf);
+    return failCounts[0] == 0;
+}
@@ -0,0 +1,373 @@
+/*
+ * GFS. Headless checks of wave parsing, loading and streaming.
+ *
+ * FILE      gfs_headless_wave.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_string.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_io_queue.h"
+#include "gfs_wave.h"
+#include "gfs_wave_stream.h"
+#include "gfs_headless.h"
+#include "gfs_win32_misc.h"
+
+typedef enum {
+    HEADLESS_WAVE_JUNK_FIRST = MKFLAG(0), // Unknown chunk of odd size before everything else.
+    HEADLESS_WAVE_LIST_FACT = MKFLAG(1),  // `LIST` and `fact` chunks between `fmt ` and `data`.
+    HEADLESS_WAVE_DATA_FIRST = MKFLAG(2), // `data` goes before `fmt `.
+    HEADLESS_WAVE_NO_DATA = MKFLAG(3),
+    HEADLESS_WAVE_BAD_MAGIC = MKFLAG(4),
+    HEADLESS_WAVE_BAD_GUID = MKFLAG(5), // Extensible SubFormat isn't one of KSDATAFORMAT_SUBTYPE_*.
+} Headless_WaveLayout;
+
+typedef struct {
+    cstr8 Name;
+    WaveFileAudioFormatTag FormatTag; // Extensible one gets extension with `SubFormat`.
+    WaveFileAudioFormatTag SubFormat;
+    u16 ChannelCount;
+    u16 BitsPerSample;
+    u32 DataSize;
+    u32 Layout;  // Headless_WaveLayout
+    u32 CutSize; // Bytes cut from the end of file.
+
+    WaveAssetLoadResult ExpectedResult;
+    WaveFileAudioFormatTag ExpectedFormat;
+    u32 ExpectedDataSize;
+} Headless_WaveFixture;
+
+#define HEADLESS_WAVE_FIXTURE_CAPACITY KILOBYTES(4)
+#define HEADLESS_WAVE_LIST_SIZE 13
+
+// NOTE(ilya.a): Canonical 16-bit stereo file of 400 data bytes is 444 bytes long. [2026/10/18]
+global_var const Headless_WaveFixture gWaveFixtures[] = {
+    {"canonical", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, 0, 0, WAVEASSET_LOAD_OK, WAVEFILE_AUDIOFORMAT_PCM, 400},
+    {"extensible pcm", WAVEFILE_AUDIOFORMAT_EXTENSIBLE, WAVEFILE_AUDIOFORMAT_PCM, 2, 24, 600, 0, 0, WAVEASSET_LOAD_OK,
+     WAVEFILE_AUDIOFORMAT_PCM, 600},
+    {"extensible float", WAVEFILE_AUDIOFORMAT_EXTENSIBLE, WAVEFILE_AUDIOFORMAT_IIEE_FLT, 1, 32, 400, 0, 0,
+     WAVEASSET_LOAD_OK, WAVEFILE_AUDIOFORMAT_IIEE_FLT, 400},
+    {"extensible bad guid", WAVEFILE_AUDIOFORMAT_EXTENSIBLE, WAVEFILE_AUDIOFORMAT_PCM, 2, 16, 400,
+     HEADLESS_WAVE_BAD_GUID, 0, WAVEASSET_LOAD_ERR_INVALID_FORMAT, 0, 0},
+    {"odd padding", WAVEFILE_AUDIOFORMAT_PCM, 0, 1, 8, 301, HEADLESS_WAVE_JUNK_FIRST | HEADLESS_WAVE_DATA_FIRST, 0,
+     WAVEASSET_LOAD_OK, WAVEFILE_AUDIOFORMAT_PCM, 301},
+    {"list and fact", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, HEADLESS_WAVE_LIST_FACT, 0, WAVEASSET_LOAD_OK,
+     WAVEFILE_AUDIOFORMAT_PCM, 400},
+    {"truncated data", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, 0, 101, WAVEASSET_LOAD_OK, WAVEFILE_AUDIOFORMAT_PCM,
+     296},
+    {"truncated format", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, 0, 418, WAVEASSET_LOAD_ERR_TRUNCATED, 0, 0},
+    {"truncated riff", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, 0, 434, WAVEASSET_LOAD_ERR_TRUNCATED, 0, 0},
+    {"no data", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, HEADLESS_WAVE_NO_DATA, 0, WAVEASSET_LOAD_ERR_INVALID_FORMAT, 0,
+     0},
+    {"bad magic", WAVEFILE_AUDIOFORMAT_PCM, 0, 2, 16, 400, HEADLESS_WAVE_BAD_MAGIC, 0, WAVEASSET_LOAD_ERR_INVALID_MAGIC,
+     0, 0},
+};
+
+global_var byte gWaveFixture[HEADLESS_WAVE_FIXTURE_CAPACITY];
+
+internal void
+Headless_Put16(byte *destination, u16 value) {
+    destination[0] = (byte)value;
+    destination[1] = (byte)(value >> 8);
+}
+
+internal void
+Headless_Put32(byte *destination, u32 value) {
+    Headless_Put16(destination, (u16)value);
+    Headless_Put16(destination + 2, (u16)(value >> 16));
+}
+
+/*
+ * Writes RIFF chunk at `offset` with pad byte after odd sized body. Returns offset past it.
+ */
+internal usize
+Headless_PutChunk(byte *buffer, usize offset, cstr8 id, const void *body, u32 bodySize) {
+    MemoryCopy(buffer + offset, id, 4);
+    Headless_Put32(buffer + offset + 4, bodySize);
+    MemoryCopy(buffer + offset + WAVEFILE_CHUNK_HEADER_SIZE, body, bodySize);
+    offset += WAVEFILE_CHUNK_HEADER_SIZE + bodySize;
+
+    if (bodySize & 1) {
+        buffer[offset++] = 0;
+    }
+
+    return offset;
+}
+
+/*
+ * Builds fixture file into `gWaveFixture`. Returns its size and offset of samples in it.
+ */
+internal usize
+Headless_BuildWaveFixture(const Headless_WaveFixture *fixture, const byte *samples, usize *dataOffsetOut) {
+    byte *buffer = gWaveFixture;
+    byte format[40] = {0};
+    u32 formatSize = fixture->FormatTag == WAVEFILE_AUDIOFORMAT_EXTENSIBLE ? 40 : 16;
+    u16 blockSize = fixture->ChannelCount * fixture->BitsPerSample / BYTE_BITS;
+
+    Headless_Put16(format + 0, fixture->FormatTag);
+    Headless_Put16(format + 2, fixture->ChannelCount);
+    Headless_Put32(format + 4, HEADLESS_SAMPLES_PER_SECOND);
+    Headless_Put32(format + 8, HEADLESS_SAMPLES_PER_SECOND * blockSize);
+    Headless_Put16(format + 12, blockSize);
+    Headless_Put16(format + 14, fixture->BitsPerSample);
+
+    if (fixture->FormatTag == WAVEFILE_AUDIOFORMAT_EXTENSIBLE) {
+        byte subFormatTail[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        subFormatTail[13] ^= HASANYBIT(fixture->Layout, HEADLESS_WAVE_BAD_GUID) ? 0xFF : 0;
+
+        Headless_Put16(format + 16, 22);
+        Headless_Put16(format + 18, fixture->BitsPerSample);
+        Headless_Put32(format + 20, fixture->ChannelCount == 1 ? 0x4 : 0x3); // Center or front left and right.
+        Headless_Put16(format + 24, fixture->SubFormat);
+        MemoryCopy(format + 26, subFormatTail, sizeof(subFormatTail));
+    }
+
+    byte list[HEADLESS_WAVE_LIST_SIZE] = {'I', 'N', 'F', 'O', 'I', 'S', 'F', 'T', 1, 0, 0, 0, 'g'};
+    byte fact[4];
+    Headless_Put32(fact, fixture->DataSize / blockSize);
+
+    MemoryCopy(buffer, WAVEFILE_FILETYPE, 4);
+    MemoryCopy(buffer + 8, HASANYBIT(fixture->Layout, HEADLESS_WAVE_BAD_MAGIC) ? "WAVX" : WAVEFILE_FORMATID, 4);
+    usize offset = WAVEFILE_RIFF_HEADER_SIZE;
+
+    if (HASANYBIT(fixture->Layout, HEADLESS_WAVE_JUNK_FIRST)) {
+        offset = Headless_PutChunk(buffer, offset, "junk", "gfs", 3);
+    }
+
+    if (HASANYBIT(fixture->Layout, HEADLESS_WAVE_DATA_FIRST)) {
+        *dataOffsetOut = offset + WAVEFILE_CHUNK_HEADER_SIZE;
+        offset = Headless_PutChunk(buffer, offset, WAVEFILE_DATABLOCID, samples, fixture->DataSize);
+    }
+
+    offset = Headless_PutChunk(buffer, offset, WAVEFILE_FORMATBLOCID, format, formatSize);
+
+    if (HASANYBIT(fixture->Layout, HEADLESS_WAVE_LIST_FACT)) {
+        offset = Headless_PutChunk(buffer, offset, "LIST", list, sizeof(list));
+        offset = Headless_PutChunk(buffer, offset, "fact", fact, sizeof(fact));
+    }
+
+    if (!HASANYBIT(fixture->Layout, HEADLESS_WAVE_DATA_FIRST | HEADLESS_WAVE_NO_DATA)) {
+        *dataOffsetOut = offset + WAVEFILE_CHUNK_HEADER_SIZE;
+        offset = Headless_PutChunk(buffer, offset, WAVEFILE_DATABLOCID, samples, fixture->DataSize);
+    }
+
+    Headless_Put32(buffer + 4, (u32)offset - 8);
+    return offset - fixture->CutSize;
+}
+
+/*
+ * Parses every fixture from memory and from file, then loads the good ones from file, and
+ * compares everything with what fixture expects.
+ */
+bool
+Headless_CheckWaveCorpus(void) {
+    byte samples[KILOBYTES(1)];
+
+    for (u32 index = 0; index < sizeof(samples); ++index) {
+        samples[index] = (byte)(index * 7 + 1);
+    }
+
+    ScratchAllocator arena = ScratchAllocatorMake(HEADLESS_WAVE_FIXTURE_CAPACITY);
+    u32 fixtureCount = sizeof(gWaveFixtures) / sizeof(gWaveFixtures[0]);
+    u32 passCount = 0;
+    char8 printBuffer[KILOBYTES(1)];
+
+    for (u32 fixtureIndex = 0; fixtureIndex < fixtureCount; ++fixtureIndex) {
+        const Headless_WaveFixture *fixture = &gWaveFixtures[fixtureIndex];
+        usize expectedDataOffset = 0;
+        usize size = Headless_BuildWaveFixture(fixture, samples, &expectedDataOffset);
+
+        WaveFileHeader memoryHeader = {0}, fileHeader = {0};
+        usize memoryDataOffset = 0;
+        u64 fileDataOffset = 0;
+        WaveAssetLoadResult memoryResult = WaveFileParseHeader(gWaveFixture, size, &memoryHeader, &memoryDataOffset);
+        WaveAssetLoadResult fileResult = WAVEASSET_LOAD_ERR_FAILED_TO_OPEN;
+        WaveAssetLoadResult loadResult = WAVEASSET_LOAD_ERR_FAILED_TO_OPEN;
+        WaveAsset wave = {0};
+        FileHandle file;
+
+        if (IOCreateFile(HEADLESS_BENCH_FILE_PATH, &file) == IO_OK) {
+            IOWriteBytesToFile(&file, gWaveFixture, size);
+            IOCloseFile(&file);
+        }
+
+        if (IOOpenFile(HEADLESS_BENCH_FILE_PATH, &file, IO_READ) == IO_OK) {
+            fileResult = WaveFileParseHeaderFromFile(file, &fileHeader, &fileDataOffset);
+            IOCloseFile(&file);
+        }
+
+        arena.Occupied = 0;
+        loadResult = WaveAssetLoadFromFile(&arena, HEADLESS_BENCH_FILE_PATH, &wave);
+
+        bool isPassed = memoryResult == fixture->ExpectedResult && fileResult == fixture->ExpectedResult &&
+                        loadResult == fixture->ExpectedResult;
+
+        if (isPassed && fixture->ExpectedResult == WAVEASSET_LOAD_OK) {
+            u64 memoryHeaderHash = BytesHash64(&memoryHeader, sizeof(memoryHeader));
+            u64 samplesHash = BytesHash64(samples, fixture->ExpectedDataSize);
+
+            isPassed = memoryHeader.AudioFormat == fixture->ExpectedFormat &&
+                       memoryHeader.DataSize == fixture->ExpectedDataSize && memoryDataOffset == expectedDataOffset &&
+                       memoryHeaderHash == BytesHash64(&fileHeader, sizeof(fileHeader)) &&
+                       fileDataOffset == expectedDataOffset && wave.Header.DataSize == fixture->ExpectedDataSize &&
+                       samplesHash == BytesHash64(wave.Data, wave.Header.DataSize);
+        }
+
+        if (!isPassed) {
+            wsprintfA(
+                printBuffer,
+                "E:   '%s': expected %d, parsed %d from memory and %d from file, loaded %d, "
+                "format %u, data %u bytes at %u\n",
+                fixture->Name, (int)fixture->ExpectedResult, (int)memoryResult, (int)fileResult, (int)loadResult,
+                (u32)memoryHeader.AudioFormat, memoryHeader.DataSize, (u32)memoryDataOffset);
+            Win32_Print(printBuffer);
+        }
+
+        passCount += isPassed ? 1 : 0;
+    }
+
+    DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+    ScratchAllocatorFree(&arena);
+
+    wsprintfA(printBuffer, "I:   %u of %u wave fixtures passed\n", passCount, fixtureCount);
+    Win32_Print(printBuffer);
+
+    return passCount == fixtureCount;
+}
+
+#define HEADLESS_WAVE_STREAM_CHANNEL_COUNT 2
+#define HEADLESS_WAVE_STREAM_FRAMES HEADLESS_SAMPLES_PER_SECOND             // Six chunks, so ring wraps around.
+#define HEADLESS_WAVE_STREAM_BLOCK_FRAMES (HEADLESS_SAMPLES_PER_SECOND / 100) // Audio thread reads 10 ms at once.
+
+typedef struct {
+    u64 FileFrames;   // Frames, which came from the file.
+    u64 SilentFrames; // Frames of silence, read before stream finished.
+    bool IsMatching;
+    WaveStreamStats Stats;
+} Headless_WaveStreamPlayback;
+
+/*
+ * Reads wave file at `HEADLESS_BENCH_FILE_PATH` till its end in blocks, the way music voice
+ * does, and compares every frame, which came from the file, with `samples`. In real time every
+ * block is read only when the previous one would have been played, otherwise as fast as it goes,
+ * so stream is expected to run dry.
+ */
+internal bool
+Headless_PlayWaveStream(IOQueue *queue, const i16 *samples, bool isRealTime, Headless_WaveStreamPlayback *playbackOut) {
+    WaveStream stream;
+
+    if (WaveStreamOpen(queue, HEADLESS_BENCH_FILE_PATH, false, &stream) != WAVE_STREAM_OK) {
+        return false;
+    }
+
+    i16 block[HEADLESS_WAVE_STREAM_BLOCK_FRAMES * HEADLESS_WAVE_STREAM_CHANNEL_COUNT];
+    Headless_WaveStreamPlayback playback = {0};
+    playback.IsMatching = true;
+
+    u64 framesPlayed = 0;
+    u64 elapsedNanoseconds = 0;
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    // NOTE(ilya.a): Guard is there for stream, which never finishes. [2026/10/18]
+    while (!WaveStreamIsFinished(&stream) && framesPlayed < HEADLESS_WAVE_STREAM_FRAMES * 64) {
+        usize fileFrameCount = WaveStreamRead(&stream, block, HEADLESS_WAVE_STREAM_BLOCK_FRAMES);
+        const i16 *expected = samples + playback.FileFrames * HEADLESS_WAVE_STREAM_CHANNEL_COUNT;
+        u32 fileSampleCount = (u32)fileFrameCount * HEADLESS_WAVE_STREAM_CHANNEL_COUNT;
+
+        for (u32 sampleIndex = 0; sampleIndex < HEADLESS_WAVE_STREAM_BLOCK_FRAMES * HEADLESS_WAVE_STREAM_CHANNEL_COUNT;
+             ++sampleIndex) {
+            i16 expectedSample = sampleIndex < fileSampleCount ? expected[sampleIndex] : 0;
+            playback.IsMatching = playback.IsMatching && block[sampleIndex] == expectedSample;
+        }
+
+        playback.FileFrames += fileFrameCount;
+        framesPlayed += HEADLESS_WAVE_STREAM_BLOCK_FRAMES;
+
+        if (!WaveStreamIsFinished(&stream)) {
+            playback.SilentFrames += HEADLESS_WAVE_STREAM_BLOCK_FRAMES - fileFrameCount;
+        }
+
+        while (isRealTime && elapsedNanoseconds < framesPlayed * 1000000000ull / HEADLESS_SAMPLES_PER_SECOND) {
+            Sleep(1);
+            elapsedNanoseconds += Headless_GetNanoseconds(&start);
+        }
+    }
+
+    playback.IsMatching = playback.IsMatching && WaveStreamIsFinished(&stream) && !stream.IsFailed;
+    playback.Stats = stream.Stats;
+    WaveStreamClose(&stream);
+
+    *playbackOut = playback;
+    return true;
+}
+
+/*
+ * Streams noise file in real time, then as fast as it goes. Whatever stream had ready in time
+ * should be the file, bit for bit, and stream's underrun counters should account for every
+ * frame of silence. In real time there should be none.
+ */
+bool
+Headless_CheckWaveStream(void) {
+    usize waveSize =
+        WAVEFILE_HEADER_SIZE + HEADLESS_WAVE_STREAM_FRAMES * HEADLESS_WAVE_STREAM_CHANNEL_COUNT * sizeof(i16);
+    byte *wave = VirtualAlloc(NULL, waveSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    IOQueue *queue = IOQueueMake(0);
+    FileHandle file;
+
+    bool isPassed = wave != NULL && queue != NULL && IOCreateFile(HEADLESS_BENCH_FILE_PATH, &file) == IO_OK;
+
+    if (isPassed) {
+        Headless_MakeWave(wave, HEADLESS_WAVE_STREAM_CHANNEL_COUNT, HEADLESS_WAVE_STREAM_FRAMES, HEADLESS_RANDOM_SEED);
+        isPassed = IOWriteBytesToFile(&file, wave, waveSize) == IO_OK;
+        IOCloseFile(&file);
+    }
+
+    const i16 *samples = (const i16 *)(wave + WAVEFILE_HEADER_SIZE);
+    char8 printBuffer[KILOBYTES(1)];
+
+    struct {
+        cstr8 Name;
+        bool IsRealTime; // Stream has time to read ahead, so it never runs dry.
+    } runs[] = {
+        {"real", true},
+        {"fast", false},
+    };
+
+    for (u32 runIndex = 0; runIndex < sizeof(runs) / sizeof(runs[0]) && isPassed; ++runIndex) {
+        Headless_WaveStreamPlayback playback = {0};
+        isPassed = Headless_PlayWaveStream(queue, samples, runs[runIndex].IsRealTime, &playback);
+
+        bool isRunPassed = isPassed && playback.IsMatching && playback.FileFrames == HEADLESS_WAVE_STREAM_FRAMES &&
+                           playback.Stats.FramesRead == HEADLESS_WAVE_STREAM_FRAMES &&
+                           playback.Stats.UnderrunFrames == playback.SilentFrames &&
+                           (playback.Stats.UnderrunCount == 0 || !runs[runIndex].IsRealTime);
+
+        wsprintfA(
+            printBuffer, "%s   %-4s %u frames from file%s, %u chunks read, underruns %u (%u frames)\n",
+            isRunPassed ? "I:" : "E:", runs[runIndex].Name, (u32)playback.FileFrames,
+            playback.IsMatching ? "" : " NOT MATCHING", (u32)playback.Stats.ChunksRead,
+            (u32)playback.Stats.UnderrunCount, (u32)playback.Stats.UnderrunFrames);
+        Win32_Print(printBuffer);
+
+        isPassed = isRunPassed;
+    }
+
+    DeleteFileA(HEADLESS_BENCH_FILE_PATH);
+
+    if (queue != NULL) {
+        IOQueueDestroy(queue);
+    }
+
+    if (wave != NULL) {
+        VirtualFree(wave, 0, MEM_RELEASE);
+    }
+
+    return isPassed;
+}
@@ -0,0 +1,160 @@
+/*
+ * FILE      gfs_input.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_input.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+
+GFS_STATIC_ASSERT(INPUT_RECORDER_BATCH <= INPUT_RING_CAPACITY);
+
+void
+InputRingPush(InputRing *ring, const InputSnapshot *snapshot) {
+    ring->Snapshots[ring->Count % INPUT_RING_CAPACITY] = *snapshot;
+    ++ring->Count;
+}
+
+const InputSnapshot *
+InputRingGet(const InputRing *ring, u64 index) {
+    if (index >= ring->Count || ring->Count - index > INPUT_RING_CAPACITY) {
+        return NULL;
+    }
+
+    return &ring->Snapshots[index % INPUT_RING_CAPACITY];
+}
+
+InputResult
+InputRecorderOpen(InputRecorder *recorder, cstr8 path) {
+    if (recorder == NULL || path == NULL) {
+        return INPUT_ERR_INVALID_ARGS;
+    }
+
+    recorder->WrittenCount = 0;
+
+    if (IOCreateFile(path, &recorder->File) != IO_OK) {
+        return INPUT_ERR_FAILED_TO_OPEN;
+    }
+
+    InputRecordingHeader header = {0};
+    header.Magic = INPUT_RECORDING_MAGIC;
+    header.Version = INPUT_RECORDING_VERSION;
+    header.SnapshotSize = sizeof(InputSnapshot);
+    header.GamepadCount = INPUT_GAMEPAD_COUNT;
+
+    if (IOWriteBytesToFile(&recorder->File, &header, sizeof(header)) != IO_OK) {
+        IOCloseFile(&recorder->File);
+        return INPUT_ERR_FAILED_TO_WRITE;
+    }
+
+    return INPUT_OK;
+}
+
+/*
+ * Writes every snapshot, which is in ring, but not in file. Wrapped range goes in two writes.
+ */
+internal InputResult
+Input_RecorderWrite(InputRecorder *recorder, const InputRing *ring) {
+    if (ring->Count - recorder->WrittenCount > INPUT_RING_CAPACITY) {
+        return INPUT_ERR_OVERRUN;
+    }
+
+    while (recorder->WrittenCount < ring->Count) {
+        u64 first = recorder->WrittenCount % INPUT_RING_CAPACITY;
+        u64 count = ring->Count - recorder->WrittenCount;
+
+        if (count > INPUT_RING_CAPACITY - first) {
+            count = INPUT_RING_CAPACITY - first;
+        }
+
+        if (IOWriteBytesToFile(&recorder->File, &ring->Snapshots[first], count * sizeof(InputSnapshot)) != IO_OK) {
+            return INPUT_ERR_FAILED_TO_WRITE;
+        }
+
+        recorder->WrittenCount += count;
+    }
+
+    return INPUT_OK;
+}
+
+InputResult
+InputRecorderUpdate(InputRecorder *recorder, const InputRing *ring) {
+    if (recorder == NULL || ring == NULL) {
+        return INPUT_ERR_INVALID_ARGS;
+    }
+
+    if (ring->Count - recorder->WrittenCount < INPUT_RECORDER_BATCH) {
+        return INPUT_OK;
+    }
+
+    return Input_RecorderWrite(recorder, ring);
+}
+
+InputResult
+InputRecorderClose(InputRecorder *recorder, const InputRing *ring) {
+    if (recorder == NULL || ring == NULL) {
+        return INPUT_ERR_INVALID_ARGS;
+    }
+
+    InputResult result = Input_RecorderWrite(recorder, ring);
+    IOCloseFile(&recorder->File);
+
+    return result;
+}
+
+InputResult
+InputPlaybackOpen(InputPlayback *playback, cstr8 path) {
+    if (playback == NULL || path == NULL) {
+        return INPUT_ERR_INVALID_ARGS;
+    }
+
+    MemoryZero(playback, sizeof(*playback));
+
+    if (IOMapFile(path, &playback->Mapping, IO_ACCESS_SEQUENTIAL) != IO_OK) {
+        return INPUT_ERR_FAILED_TO_OPEN;
+    }
+
+    InputRecordingHeader header = {0};
+
+    if (playback->Mapping.Size >= sizeof(header)) {
+        MemoryCopy(&header, playback->Mapping.Data, sizeof(header));
+    }
+
+    if (header.Magic != INPUT_RECORDING_MAGIC || header.Version != INPUT_RECORDING_VERSION ||
+        header.SnapshotSize != sizeof(InputSnapshot) || header.GamepadCount != INPUT_GAMEPAD_COUNT) {
+        IOUnmapFile(&playback->Mapping);
+        return INPUT_ERR_INVALID_FILE;
+    }
+
+    // NOTE(ilya.a): Snapshot cut short by crash is dropped. [2026/10/18]
+    playback->Snapshots = (const byte *)playback->Mapping.Data + sizeof(header);
+    playback->SnapshotCount = (playback->Mapping.Size - sizeof(header)) / sizeof(InputSnapshot);
+
+    return INPUT_OK;
+}
+
+bool
+InputPlaybackNext(InputPlayback *playback, InputSnapshot *snapshotOut) {
+    if (playback->Position >= playback->SnapshotCount) {
+        return false;
+    }
+
+    MemoryCopy(snapshotOut, playback->Snapshots + playback->Position * sizeof(InputSnapshot), sizeof(InputSnapshot));
+    ++playback->Position;
+
+    return true;
+}
+
+void
+InputPlaybackClose(InputPlayback *playback) {
+    if (playback == NULL) {
+        return;
+    }
+
+    IOUnmapFile(&playback->Mapping);
+    MemoryZero(playback, sizeof(*playback));
+}
@@ -0,0 +1,136 @@
+/*
+ * GFS. Input snapshots, recording and replay.
+ *
+ * Platform layer normalizes whatever it reads from controllers into one `InputSnapshot` per
+ * frame, and game update sees nothing else. Snapshots are kept in a ring, which also serves
+ * as recording buffer: recorder writes them out in batches, not every frame.
+ *
+ * Recording is header followed by raw snapshots. Replaying it into the same game update
+ * reproduces session frame by frame, without controller or even window.
+ *
+ * FILE      gfs_input.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_INPUT_H_INCLUDED
+#define GFS_INPUT_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_assert.h"
+#include "gfs_io.h"
+
+#define INPUT_GAMEPAD_COUNT 4    // Same as XUSER_MAX_COUNT.
+#define INPUT_RING_CAPACITY 256  // Frames of history.
+#define INPUT_RECORDER_BATCH 128 // Snapshots written at once.
+
+#define INPUT_RECORDING_MAGIC 0x49534647 // "GFSI"
+#define INPUT_RECORDING_VERSION 1
+
+typedef u16 InputButtons;
+
+#define INPUT_BUTTON_DPAD_UP MKFLAG(0)
+#define INPUT_BUTTON_DPAD_DOWN MKFLAG(1)
+#define INPUT_BUTTON_DPAD_LEFT MKFLAG(2)
+#define INPUT_BUTTON_DPAD_RIGHT MKFLAG(3)
+#define INPUT_BUTTON_START MKFLAG(4)
+#define INPUT_BUTTON_BACK MKFLAG(5)
+#define INPUT_BUTTON_LEFT_THUMB MKFLAG(6)
+#define INPUT_BUTTON_RIGHT_THUMB MKFLAG(7)
+#define INPUT_BUTTON_LEFT_SHOULDER MKFLAG(8)
+#define INPUT_BUTTON_RIGHT_SHOULDER MKFLAG(9)
+#define INPUT_BUTTON_A MKFLAG(12)
+#define INPUT_BUTTON_B MKFLAG(13)
+#define INPUT_BUTTON_X MKFLAG(14)
+#define INPUT_BUTTON_Y MKFLAG(15)
+
+#define INPUT_GAMEPAD_SIZE 14
+#define INPUT_SNAPSHOT_SIZE 64
+
+/*
+ * Layout is part of recording format, so sizes are checked.
+ */
+typedef struct {
+    InputButtons Buttons;
+    u8 LeftTrigger;
+    u8 RightTrigger;
+    i16 LeftStickX;
+    i16 LeftStickY;
+    i16 RightStickX;
+    i16 RightStickY;
+    bool IsConnected;
+} InputGamepad;
+
+GFS_EXPECT_TYPE_SIZE(InputGamepad, INPUT_GAMEPAD_SIZE);
+
+typedef struct {
+    u64 Frame;
+    InputGamepad Gamepads[INPUT_GAMEPAD_COUNT];
+} InputSnapshot;
+
+GFS_EXPECT_TYPE_SIZE(InputSnapshot, INPUT_SNAPSHOT_SIZE);
+
+typedef struct {
+    u32 Magic;
+    u32 Version;
+    u32 SnapshotSize;
+    u32 GamepadCount;
+} InputRecordingHeader;
+
+typedef enum {
+    INPUT_OK,
+    INPUT_ERR_INVALID_ARGS,
+    INPUT_ERR_FAILED_TO_OPEN,
+    INPUT_ERR_FAILED_TO_WRITE,
+    INPUT_ERR_INVALID_FILE, // Not a recording or recorded by another version.
+    INPUT_ERR_OVERRUN,      // Snapshots left the ring before recorder wrote them.
+} InputResult;
+
+typedef struct {
+    InputSnapshot Snapshots[INPUT_RING_CAPACITY];
+    u64 Count; // Pushed since start. Only the last `INPUT_RING_CAPACITY` are kept.
+} InputRing;
+
+void InputRingPush(InputRing *ring, const InputSnapshot *snapshot);
+
+/*
+ * Returns snapshot with given push index, or NULL, if it wasn't pushed yet or is gone already.
+ */
+const InputSnapshot *InputRingGet(const InputRing *ring, u64 index);
+
+typedef struct {
+    FileHandle File;
+    u64 WrittenCount; // Snapshots of the ring, which are in file already.
+} InputRecorder;
+
+InputResult InputRecorderOpen(InputRecorder *recorder, cstr8 path);
+
+/*
+ * Writes snapshots pushed since the last write, once there are `INPUT_RECORDER_BATCH` of them.
+ * Should be called every frame.
+ */
+InputResult InputRecorderUpdate(InputRecorder *recorder, const InputRing *ring);
+
+/*
+ * Writes the rest of snapshots and closes the file.
+ */
+InputResult InputRecorderClose(InputRecorder *recorder, const InputRing *ring);
+
+typedef struct {
+    IOFileMapping Mapping;
+    const byte *Snapshots;
+    u64 SnapshotCount;
+    u64 Position;
+} InputPlayback;
+
+InputResult InputPlaybackOpen(InputPlayback *playback, cstr8 path);
+
+/*
+ * Returns false, once recording is over.
+ */
+bool InputPlaybackNext(InputPlayback *playback, InputSnapshot *snapshotOut);
+
+void InputPlaybackClose(InputPlayback *playback);
+
+#endif // GFS_INPUT_H_INCLUDED
@@ -0,0 +1,138 @@
+/*
+ * FILE      gfs_input_poller.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_input_poller.h"
+
+#include <Windows.h>
+#include <intrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_input.h"
+
+// NOTE(ilya.a): Same as in SPSC ring: x86 keeps stores and loads in order by themselves, so only
+// compiler has to be stopped. [2026/10/18]
+#define INPUT_POLLER_BARRIER() _ReadWriteBarrier()
+
+void
+InputPollerInit(InputPoller *poller, InputDevice *device, u32 pollHz) {
+    MemoryZero(poller, sizeof(*poller));
+
+    pollHz = pollHz > 0 ? pollHz : 1;
+
+    poller->Device = device;
+    poller->PollIntervalMs = 1000 / pollHz;
+    poller->ProbeIntervalPolls = pollHz * INPUT_POLLER_PROBE_SECONDS;
+}
+
+void
+InputPollerPoll(InputPoller *poller) {
+    LARGE_INTEGER pollStart, pollEnd;
+    QueryPerformanceCounter(&pollStart);
+
+    u64 pollIndex = poller->Stats.PollCount;
+
+    for (u32 gamepadIndex = 0; gamepadIndex < INPUT_GAMEPAD_COUNT; ++gamepadIndex) {
+        InputGamepad *gamepad = &poller->Current.Gamepads[gamepadIndex];
+
+        if (!poller->IsConnected[gamepadIndex]) {
+            if (pollIndex < poller->NextProbe[gamepadIndex]) {
+                continue;
+            }
+
+            poller->NextProbe[gamepadIndex] = pollIndex + poller->ProbeIntervalPolls;
+            ++poller->Stats.ProbeCount;
+        }
+
+        InputGamepad state = {0};
+        poller->IsConnected[gamepadIndex] = poller->Device->Read(poller->Device, gamepadIndex, &state);
+        state.IsConnected = poller->IsConnected[gamepadIndex];
+        *gamepad = state;
+    }
+
+    poller->Current.Frame = ++poller->Stats.PollCount;
+
+    poller->Sequence = poller->Sequence + 1;
+    INPUT_POLLER_BARRIER(); // Counter is odd before snapshot is touched.
+    poller->Published = poller->Current;
+    INPUT_POLLER_BARRIER(); // Snapshot is written before counter is even again.
+    poller->Sequence = poller->Sequence + 1;
+
+    QueryPerformanceCounter(&pollEnd);
+    u64 pollTicks = (u64)(pollEnd.QuadPart - pollStart.QuadPart);
+    poller->Stats.PollTicksMax = pollTicks > poller->Stats.PollTicksMax ? pollTicks : poller->Stats.PollTicksMax;
+}
+
+void
+InputPollerGetSnapshot(const InputPoller *poller, InputSnapshot *snapshotOut) {
+    for (;;) {
+        u64 sequence = poller->Sequence;
+        INPUT_POLLER_BARRIER(); // Snapshot is not read before counter.
+
+        if (sequence & 1) {
+            _mm_pause();
+            continue;
+        }
+
+        *snapshotOut = poller->Published;
+        INPUT_POLLER_BARRIER(); // Snapshot is read before counter is checked again.
+
+        if (poller->Sequence == sequence) {
+            return;
+        }
+    }
+}
+
+internal DWORD WINAPI
+InputPoller_ThreadProc(LPVOID parameter) {
+    InputPoller *poller = (InputPoller *)parameter;
+
+    // NOTE(ilya.a): Default scheduler tick is ~15ms, which is longer than poll interval. [2026/10/18]
+    timeBeginPeriod(1);
+
+    while (!poller->ShouldStop) {
+        InputPollerPoll(poller);
+        Sleep(poller->PollIntervalMs);
+    }
+
+    timeEndPeriod(1);
+
+    return 0;
+}
+
+bool
+InputPollerStart(InputPoller *poller) {
+    if (poller == NULL || poller->Device == NULL || poller->Thread != NULL) {
+        return false;
+    }
+
+    // NOTE(ilya.a): So the very first frame already sees controllers. [2026/10/18]
+    InputPollerPoll(poller);
+
+    poller->Thread = CreateThread(NULL, 0, InputPoller_ThreadProc, poller, 0, NULL);
+
+    if (poller->Thread == NULL) {
+        return false;
+    }
+
+    SetThreadPriority(poller->Thread, THREAD_PRIORITY_ABOVE_NORMAL);
+    return true;
+}
+
+void
+InputPollerStop(InputPoller *poller) {
+    if (poller == NULL || poller->Thread == NULL) {
+        return;
+    }
+
+    poller->ShouldStop = true;
+    WaitForSingleObject(poller->Thread, INFINITE);
+    CloseHandle(poller->Thread);
+
+    poller->Thread = NULL;
+    poller->ShouldStop = false;
+}
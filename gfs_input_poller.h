@@ -0,0 +1,88 @@
+/*
+ * GFS. Background controller polling.
+ *
+ * Poller thread reads controllers through `InputDevice` at fixed rate and publishes the latest
+ * snapshot, game thread just takes it once per frame. Reading empty slot could be slow (XInput
+ * stalls for milliseconds on every disconnected one), so only connected slots are read every
+ * poll, and empty ones are probed once per `INPUT_POLLER_PROBE_SECONDS`.
+ *
+ * Snapshot is published through a sequence counter, which is odd while poller writes: reader
+ * copies snapshot and retries, if counter was odd or changed meanwhile. Neither side waits.
+ *
+ * FILE      gfs_input_poller.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_INPUT_POLLER_H_INCLUDED
+#define GFS_INPUT_POLLER_H_INCLUDED
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_input.h"
+
+#define INPUT_POLLER_PROBE_SECONDS 1
+#define INPUT_POLLER_CACHE_LINE_SIZE 64
+
+typedef struct InputDevice InputDevice;
+
+/*
+ * Reads gamepad in slot `gamepadIndex`. Returns false, if nothing is connected there (or it
+ * couldn't be read).
+ */
+typedef bool InputDeviceReadProc(InputDevice *device, u32 gamepadIndex, InputGamepad *gamepadOut);
+
+struct InputDevice {
+    InputDeviceReadProc *Read;
+};
+
+typedef struct {
+    u64 PollCount;
+    u64 ProbeCount;   // Reads of slots, which weren't connected.
+    u64 PollTicksMax; // Longest poll in `QueryPerformanceCounter` ticks.
+} InputPollerStats;
+
+typedef struct {
+    InputDevice *Device;
+    u32 PollIntervalMs;
+    u32 ProbeIntervalPolls;
+
+    bool IsConnected[INPUT_GAMEPAD_COUNT]; // Poller thread only.
+    u64 NextProbe[INPUT_GAMEPAD_COUNT];    // Poll index. Poller thread only.
+    InputSnapshot Current;                 // Poller thread only.
+    InputPollerStats Stats;                // Poller thread only.
+
+    // NOTE(ilya.a): Game thread reads these all the time, so they don't share line with the
+    // poller's own state. [2026/10/18]
+    byte SequencePadding[INPUT_POLLER_CACHE_LINE_SIZE];
+    volatile u64 Sequence; // Odd while `Published` is being written.
+    InputSnapshot Published;
+
+    HANDLE Thread;
+    volatile bool ShouldStop;
+} InputPoller;
+
+void InputPollerInit(InputPoller *poller, InputDevice *device, u32 pollHz);
+
+bool InputPollerStart(InputPoller *poller);
+
+/*
+ * Stops poller thread, if it is running. Device is owned by caller.
+ */
+void InputPollerStop(InputPoller *poller);
+
+/*
+ * Reads device once and publishes snapshot. Poller thread calls it between sleeps. Without
+ * thread it could be called directly.
+ */
+void InputPollerPoll(InputPoller *poller);
+
+/*
+ * Copies the latest published snapshot. Could be called from any thread. `Frame` of snapshot is
+ * number of polls done.
+ */
+void InputPollerGetSnapshot(const InputPoller *poller, InputSnapshot *snapshotOut);
+
+#endif // GFS_INPUT_POLLER_H_INCLUDED
@@ -8,8 +8,10 @@
 
 #include <Windows.h>
 
+#include "gfs_types.h"
 #include "gfs_macros.h"
 #include "gfs_string.h"
+#include "gfs_memory.h"
 
 IOResult
 IOOpenFile(cstr8 filePath, FileHandle *handleOut, IOPermissions perms) {
@@ -30,8 +32,13 @@ IOOpenFile(cstr8 filePath, FileHandle *handleOut, IOPermissions perms) {
     // TODO(ilya.a): Expose sharing options [2024/05/26]
     // https://learn.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-createfilea
     DWORD shareMode = FILE_SHARE_WRITE | FILE_SHARE_READ | FILE_SHARE_DELETE;
+    DWORD flagsAndAttributes = FILE_ATTRIBUTE_NORMAL;
 
-    HANDLE handle = CreateFileA(filePath, desiredAccess, shareMode, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (HASANYBIT(perms, IO_OVERLAPPED)) {
+        flagsAndAttributes |= FILE_FLAG_OVERLAPPED;
+    }
+
+    HANDLE handle = CreateFileA(filePath, desiredAccess, shareMode, NULL, OPEN_EXISTING, flagsAndAttributes, NULL);
 
     if (handle == INVALID_HANDLE_VALUE) {
         return IO_ERR_FAILED_TO_OPEN;
@@ -50,43 +57,651 @@ IOLoadBytesFromFile(FileHandle *handle, void *buffer, usize numberOfBytes) {
 
 IOResult
 IOLoadBytesFromFileEx(FileHandle *handle, void *buffer, usize numberOfBytes, usize offset) {
+    return IOReadAt(handle, buffer, numberOfBytes, offset, NULL);
+}
+
+// NOTE(ilya.a): ReadFile and WriteFile take DWORD count, so bigger requests are split into chunks. [2026/10/18]
+#define IO_READ_CHUNK_SIZE_MAX ((usize)GIGABYTES(1))
+
+IOResult
+IOReadAt(FileHandle *handle, void *buffer, usize numberOfBytes, u64 offset, usize *bytesReadOut) {
+    return IOReadAtEx(handle, buffer, numberOfBytes, offset, NULL, bytesReadOut);
+}
+
+IOResult
+IOReadAtEx(FileHandle *handle, void *buffer, usize numberOfBytes, u64 offset, HANDLE event, usize *bytesReadOut) {
+    if (bytesReadOut != NULL) {
+        *bytesReadOut = 0;
+    }
+
     if (handle == NULL || buffer == NULL || IO_HANDLE_IS_VALID(*handle)) {
         return IO_ERR_INVALID_ARGS;
     }
 
-    if (numberOfBytes == 0) {
+    usize totalBytesRead = 0;
+
+    while (totalBytesRead < numberOfBytes) {
+        usize bytesLeft = numberOfBytes - totalBytesRead;
+        DWORD chunkSize = (DWORD)(bytesLeft < IO_READ_CHUNK_SIZE_MAX ? bytesLeft : IO_READ_CHUNK_SIZE_MAX);
+        u64 chunkOffset = offset + totalBytesRead;
+
+        // NOTE(ilya.a): Offset in OVERLAPPED makes ReadFile positional even for synchronous
+        // handles. Offset is not taken from file pointer, but synchronous ReadFile still moves
+        // the pointer past the bytes it read. [2026/10/18]
+        OVERLAPPED overlapped = {0};
+        overlapped.Offset = (DWORD)(chunkOffset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(chunkOffset >> 32);
+        overlapped.hEvent = event;
+
+        DWORD chunkBytesRead = 0;
+        BOOL readFileResult =
+            ReadFile(*handle, (byte *)buffer + totalBytesRead, chunkSize, &chunkBytesRead, &overlapped);
+
+        if (readFileResult != TRUE) {
+            DWORD error = GetLastError();
+
+            if (error == ERROR_IO_PENDING) {
+                // NOTE(ilya.a): Handle was opened with `IO_OVERLAPPED`, so read goes on in background. [2026/10/18]
+                if (!GetOverlappedResult(*handle, &overlapped, &chunkBytesRead, TRUE)) {
+                    error = GetLastError();
+                    if (error != ERROR_HANDLE_EOF) {
+                        return IO_ERR_FAILED_TO_READ;
+                    }
+                }
+            } else if (error != ERROR_HANDLE_EOF) {
+                return IO_ERR_FAILED_TO_READ;
+            }
+        }
+
+        if (chunkBytesRead == 0) {
+            break; // End of file.
+        }
+
+        totalBytesRead += chunkBytesRead;
+
+        if (bytesReadOut != NULL) {
+            *bytesReadOut = totalBytesRead;
+        }
+    }
+
+    if (totalBytesRead != numberOfBytes) {
+        return IO_ERR_READED_LESS_THAN_REQUIRED;
+    }
+
+    return IO_OK;
+}
+
+IOResult
+IOReadRanges(FileHandle *handle, IOReadRange *ranges, usize rangeCount) {
+    if (handle == NULL || ranges == NULL || IO_HANDLE_IS_VALID(*handle)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    IOResult result = IO_OK;
+    usize rangeIndex = 0;
+
+    while (rangeIndex < rangeCount) {
+        IOReadRange *first = &ranges[rangeIndex];
+        u64 spanOffset = first->Offset;
+        usize spanSize = first->Size;
+        usize spanEnd = rangeIndex + 1;
+
+        while (spanEnd < rangeCount) {
+            IOReadRange *next = &ranges[spanEnd];
+            bool isContiguousInFile = next->Offset == spanOffset + spanSize;
+            bool isContiguousInMemory = (byte *)next->Buffer == (byte *)first->Buffer + spanSize;
+
+            if (!isContiguousInFile || !isContiguousInMemory) {
+                break;
+            }
+
+            spanSize += next->Size;
+            ++spanEnd;
+        }
+
+        usize spanBytesRead = 0;
+        IOResult spanResult = IOReadAt(handle, first->Buffer, spanSize, spanOffset, &spanBytesRead);
+
+        for (usize index = rangeIndex; index < spanEnd; ++index) {
+            IOReadRange *range = &ranges[index];
+            usize rangeBegin = (usize)(range->Offset - spanOffset);
+
+            if (spanBytesRead >= rangeBegin + range->Size) {
+                range->BytesRead = range->Size;
+                range->Result = IO_OK;
+            } else {
+                range->BytesRead = spanBytesRead > rangeBegin ? spanBytesRead - rangeBegin : 0;
+                range->Result = spanResult == IO_OK ? IO_ERR_READED_LESS_THAN_REQUIRED : spanResult;
+                result = range->Result;
+            }
+        }
+
+        rangeIndex = spanEnd;
+    }
+
+    return result;
+}
+
+IOResult
+IOGetFileSize(FileHandle *handle, usize *sizeOut) {
+    if (handle == NULL || sizeOut == NULL || IO_HANDLE_IS_VALID(*handle)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(*handle, &fileSize)) {
+        return IO_ERR_FAILED_TO_GET_SIZE;
+    }
+
+    *sizeOut = (usize)fileSize.QuadPart;
+
+    return IO_OK;
+}
+
+IOResult
+IOCreateFile(cstr8 filePath, FileHandle *handleOut) {
+    if (filePath == NULL || handleOut == NULL || CStr8IsEmpty(filePath)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    HANDLE handle =
+        CreateFileA(filePath, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (handle == INVALID_HANDLE_VALUE) {
+        return IO_ERR_FAILED_TO_OPEN;
+    }
+
+    *handleOut = handle;
+
+    return IO_OK;
+}
+
+IOResult
+IOWriteBytesToFile(FileHandle *handle, const void *buffer, usize numberOfBytes) {
+    if (handle == NULL || (buffer == NULL && numberOfBytes > 0) || IO_HANDLE_IS_VALID(*handle)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    usize totalBytesWritten = 0;
+
+    while (totalBytesWritten < numberOfBytes) {
+        usize bytesLeft = numberOfBytes - totalBytesWritten;
+        DWORD chunkSize = (DWORD)(bytesLeft < IO_READ_CHUNK_SIZE_MAX ? bytesLeft : IO_READ_CHUNK_SIZE_MAX);
+        DWORD chunkBytesWritten = 0;
+
+        if (!WriteFile(*handle, (const byte *)buffer + totalBytesWritten, chunkSize, &chunkBytesWritten, NULL) ||
+            chunkBytesWritten == 0) {
+            return IO_ERR_FAILED_TO_WRITE;
+        }
+
+        totalBytesWritten += chunkBytesWritten;
+    }
+
+    return IO_OK;
+}
+
+IOResult
+IOCloseFile(FileHandle *handle) {
+    if (handle == NULL || IO_HANDLE_IS_VALID(*handle)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    if (!CloseHandle(*handle)) {
+        return IO_ERR_FAILED_TO_CLOSE;
+    }
+
+    *handle = INVALID_HANDLE_VALUE;
+
+    return IO_OK;
+}
+
+IOReader
+IOReaderMake(FileHandle file, u64 offset, void *buffer, usize bufferCapacity) {
+    IOReader reader = {0};
+    reader.File = file;
+    reader.FileOffset = offset;
+    reader.Buffer = (byte *)buffer;
+    reader.Capacity = bufferCapacity;
+    return reader;
+}
+
+/*
+ * Moves unread bytes to the front of the buffer and reads as much as fits after them.
+ */
+internal IOResult
+IO_ReaderRefill(IOReader *reader) {
+    usize bytesLeft = reader->Size - reader->Position;
+
+    if (bytesLeft > 0 && reader->Position > 0) {
+        MemoryCopy(reader->Buffer, reader->Buffer + reader->Position, bytesLeft);
+    }
+
+    reader->Position = 0;
+    reader->Size = bytesLeft;
+
+    usize bytesRead = 0;
+    IOResult result = IOReadAt(
+        &reader->File, reader->Buffer + bytesLeft, reader->Capacity - bytesLeft, reader->FileOffset, &bytesRead);
+    ++reader->SyscallCount;
+
+    reader->Size += bytesRead;
+    reader->FileOffset += bytesRead;
+
+    // NOTE(ilya.a): Hitting end of file while filling the buffer is fine, caller checks if it got enough. [2026/10/18]
+    if (result == IO_ERR_READED_LESS_THAN_REQUIRED) {
+        return IO_OK;
+    }
+
+    return result;
+}
+
+IOResult
+IOReaderRead(IOReader *reader, void *destination, usize numberOfBytes) {
+    if (reader == NULL || reader->Buffer == NULL || (destination == NULL && numberOfBytes > 0)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    byte *output = (byte *)destination;
+    usize buffered = reader->Size - reader->Position;
+
+    if (numberOfBytes <= buffered) {
+        MemoryCopy(output, reader->Buffer + reader->Position, numberOfBytes);
+        reader->Position += numberOfBytes;
         return IO_OK;
     }
 
-#if 0
-    // TODO(ilya.a): Check what was wrong about this piece of code.
-    // (Unable to offset and read properly). [2024/05/26]
+    MemoryCopy(output, reader->Buffer + reader->Position, buffered);
+    output += buffered;
+    numberOfBytes -= buffered;
+    reader->Position = reader->Size = 0;
 
-    LARGE_INTEGER offsetPair;
-    offsetPair.LowPart = ((U32 *)&offset)[1];
-    offsetPair.HighPart = ((U32 *)&offset)[0];
-#endif
+    if (numberOfBytes >= reader->Capacity) {
+        usize bytesRead = 0;
+        IOResult result = IOReadAt(&reader->File, output, numberOfBytes, reader->FileOffset, &bytesRead);
+        ++reader->SyscallCount;
+        reader->FileOffset += bytesRead;
+        return result;
+    }
 
-    DWORD setFilePointerResult = SetFilePointer(
-        *handle,
-        (u32)offset, // XXX(ilya.a): Hack [2024/05/26]
-        NULL, FILE_BEGIN);
+    IOResult result = IO_ReaderRefill(reader);
 
-    if (setFilePointerResult == INVALID_SET_FILE_POINTER) {
-        return IO_ERR_FAILED_TO_OFFSET_HANDLE;
+    if (result != IO_OK) {
+        return result;
     }
 
-    DWORD numberOfBytesRead = 0;
+    usize bytesToCopy = numberOfBytes < reader->Size ? numberOfBytes : reader->Size;
+    MemoryCopy(output, reader->Buffer, bytesToCopy);
+    reader->Position = bytesToCopy;
 
-    BOOL readFileResult = ReadFile(*handle, buffer, numberOfBytes, &numberOfBytesRead, NULL);
+    return bytesToCopy == numberOfBytes ? IO_OK : IO_ERR_READED_LESS_THAN_REQUIRED;
+}
 
-    if (readFileResult != TRUE) {
-        return IO_ERR_FAILED_TO_READ;
+IOResult
+IOReaderPeek(IOReader *reader, void *destination, usize numberOfBytes) {
+    if (reader == NULL || reader->Buffer == NULL || (destination == NULL && numberOfBytes > 0) ||
+        numberOfBytes > reader->Capacity) {
+        return IO_ERR_INVALID_ARGS;
     }
 
-    if (numberOfBytesRead != numberOfBytes) {
-        return IO_ERR_READED_LESS_THAN_REQUIRED;
+    if (reader->Size - reader->Position < numberOfBytes) {
+        IOResult result = IO_ReaderRefill(reader);
+
+        if (result != IO_OK) {
+            return result;
+        }
+
+        if (reader->Size < numberOfBytes) {
+            return IO_ERR_READED_LESS_THAN_REQUIRED;
+        }
     }
 
+    MemoryCopy(destination, reader->Buffer + reader->Position, numberOfBytes);
+
     return IO_OK;
 }
+
+IOResult
+IOReaderSkip(IOReader *reader, u64 numberOfBytes) {
+    if (reader == NULL) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    usize buffered = reader->Size - reader->Position;
+
+    if (numberOfBytes <= buffered) {
+        reader->Position += (usize)numberOfBytes;
+        return IO_OK;
+    }
+
+    reader->FileOffset += numberOfBytes - buffered;
+    reader->Position = reader->Size = 0;
+
+    return IO_OK;
+}
+
+u64
+IOReaderTell(const IOReader *reader) {
+    return reader->FileOffset - (reader->Size - reader->Position);
+}
+
+IOResult
+IOReaderReadU8(IOReader *reader, u8 *valueOut) {
+    return IOReaderRead(reader, valueOut, sizeof(*valueOut));
+}
+
+IOResult
+IOReaderReadU16(IOReader *reader, u16 *valueOut) {
+    byte bytes[2];
+    IOResult result = IOReaderRead(reader, bytes, sizeof(bytes));
+    *valueOut = (u16)(bytes[0] | bytes[1] << 8);
+    return result;
+}
+
+IOResult
+IOReaderReadU32(IOReader *reader, u32 *valueOut) {
+    byte bytes[4];
+    IOResult result = IOReaderRead(reader, bytes, sizeof(bytes));
+    *valueOut = (u32)bytes[0] | (u32)bytes[1] << 8 | (u32)bytes[2] << 16 | (u32)bytes[3] << 24;
+    return result;
+}
+
+IOResult
+IOReaderReadU64(IOReader *reader, u64 *valueOut) {
+    u32 low = 0, high = 0;
+    IOResult result = IOReaderReadU32(reader, &low);
+
+    if (result == IO_OK) {
+        result = IOReaderReadU32(reader, &high);
+    }
+
+    *valueOut = (u64)low | (u64)high << 32;
+    return result;
+}
+
+IOResult
+IOReaderReadF32(IOReader *reader, f32 *valueOut) {
+    u32 bits = 0;
+    IOResult result = IOReaderReadU32(reader, &bits);
+    MemoryCopy(valueOut, &bits, sizeof(bits));
+    return result;
+}
+
+IOResult
+IOReaderReadVarU64(IOReader *reader, u64 *valueOut) {
+    u64 value = 0;
+
+    for (u32 shift = 0; shift < 64; shift += 7) {
+        u8 group = 0;
+        IOResult result = IOReaderReadU8(reader, &group);
+
+        if (result != IO_OK) {
+            return result;
+        }
+
+        value |= (u64)(group & 0x7F) << shift;
+
+        if ((group & 0x80) == 0) {
+            *valueOut = value;
+            return IO_OK;
+        }
+    }
+
+    // NOTE(ilya.a): More than 10 groups can't come from IOWriterWriteVarU64. [2026/10/18]
+    return IO_ERR_FAILED_TO_READ;
+}
+
+IOWriter
+IOWriterMake(FileHandle file, void *buffer, usize bufferCapacity) {
+    IOWriter writer = {0};
+    writer.File = file;
+    writer.Buffer = (byte *)buffer;
+    writer.Capacity = bufferCapacity;
+    return writer;
+}
+
+IOResult
+IOWriterFlush(IOWriter *writer) {
+    if (writer == NULL) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    if (writer->Size == 0) {
+        return IO_OK;
+    }
+
+    IOResult result = IOWriteBytesToFile(&writer->File, writer->Buffer, writer->Size);
+    ++writer->SyscallCount;
+    writer->Size = 0;
+
+    return result;
+}
+
+IOResult
+IOWriterWrite(IOWriter *writer, const void *source, usize numberOfBytes) {
+    if (writer == NULL || writer->Buffer == NULL || (source == NULL && numberOfBytes > 0)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    writer->BytesWritten += numberOfBytes;
+
+    if (numberOfBytes <= writer->Capacity - writer->Size) {
+        MemoryCopy(writer->Buffer + writer->Size, source, numberOfBytes);
+        writer->Size += numberOfBytes;
+        return IO_OK;
+    }
+
+    IOResult result = IOWriterFlush(writer);
+
+    if (result != IO_OK) {
+        return result;
+    }
+
+    if (numberOfBytes >= writer->Capacity) {
+        ++writer->SyscallCount;
+        return IOWriteBytesToFile(&writer->File, source, numberOfBytes);
+    }
+
+    MemoryCopy(writer->Buffer, source, numberOfBytes);
+    writer->Size = numberOfBytes;
+
+    return IO_OK;
+}
+
+IOResult
+IOWriterWriteZeros(IOWriter *writer, usize numberOfBytes) {
+    if (writer == NULL || writer->Buffer == NULL) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    while (numberOfBytes > 0) {
+        if (writer->Size == writer->Capacity) {
+            IOResult result = IOWriterFlush(writer);
+
+            if (result != IO_OK) {
+                return result;
+            }
+        }
+
+        usize space = writer->Capacity - writer->Size;
+        usize bytesToZero = numberOfBytes < space ? numberOfBytes : space;
+
+        MemoryZero(writer->Buffer + writer->Size, bytesToZero);
+        writer->Size += bytesToZero;
+        writer->BytesWritten += bytesToZero;
+        numberOfBytes -= bytesToZero;
+    }
+
+    return IO_OK;
+}
+
+IOResult
+IOWriterWriteU8(IOWriter *writer, u8 value) {
+    return IOWriterWrite(writer, &value, sizeof(value));
+}
+
+IOResult
+IOWriterWriteU16(IOWriter *writer, u16 value) {
+    byte bytes[2] = {(byte)value, (byte)(value >> 8)};
+    return IOWriterWrite(writer, bytes, sizeof(bytes));
+}
+
+IOResult
+IOWriterWriteU32(IOWriter *writer, u32 value) {
+    byte bytes[4] = {(byte)value, (byte)(value >> 8), (byte)(value >> 16), (byte)(value >> 24)};
+    return IOWriterWrite(writer, bytes, sizeof(bytes));
+}
+
+IOResult
+IOWriterWriteU64(IOWriter *writer, u64 value) {
+    IOResult result = IOWriterWriteU32(writer, (u32)value);
+
+    if (result != IO_OK) {
+        return result;
+    }
+
+    return IOWriterWriteU32(writer, (u32)(value >> 32));
+}
+
+IOResult
+IOWriterWriteF32(IOWriter *writer, f32 value) {
+    u32 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    return IOWriterWriteU32(writer, bits);
+}
+
+IOResult
+IOWriterWriteVarU64(IOWriter *writer, u64 value) {
+    byte bytes[10];
+    usize size = 0;
+
+    do {
+        byte group = (byte)(value & 0x7F);
+        value >>= 7;
+        bytes[size++] = value != 0 ? (group | 0x80) : group;
+    } while (value != 0);
+
+    return IOWriterWrite(writer, bytes, size);
+}
+
+IOResult
+IOWriterClose(IOWriter *writer) {
+    if (writer == NULL) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    IOResult flushResult = IOWriterFlush(writer);
+    IOResult closeResult = IOCloseFile(&writer->File);
+
+    return flushResult != IO_OK ? flushResult : closeResult;
+}
+
+IOResult
+IOMapFile(cstr8 filePath, IOFileMapping *mappingOut, IOAccessHints hints) {
+    if (filePath == NULL || mappingOut == NULL || CStr8IsEmpty(filePath)) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    DWORD flagsAndAttributes = FILE_ATTRIBUTE_NORMAL;
+
+    if (HASANYBIT(hints, IO_ACCESS_SEQUENTIAL)) {
+        flagsAndAttributes |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (HASANYBIT(hints, IO_ACCESS_RANDOM)) {
+        flagsAndAttributes |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    HANDLE file = CreateFileA(
+        filePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, flagsAndAttributes, NULL);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return IO_ERR_FAILED_TO_OPEN;
+    }
+
+    IOFileMapping mapping = {0};
+    mapping.File = file;
+    mapping.Mapping = NULL;
+
+    IOResult getFileSizeResult = IOGetFileSize(&file, &mapping.Size);
+
+    if (getFileSizeResult != IO_OK) {
+        CloseHandle(file);
+        return getFileSizeResult;
+    }
+
+    // NOTE(ilya.a): Windows refuses to map empty files, so we are handing out empty view
+    // with no mapping behind it. [2026/10/18]
+    if (mapping.Size > 0) {
+        mapping.Mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (mapping.Mapping == NULL) {
+            CloseHandle(file);
+            return IO_ERR_FAILED_TO_MAP;
+        }
+
+        mapping.Data = MapViewOfFile(mapping.Mapping, FILE_MAP_READ, 0, 0, 0);
+
+        if (mapping.Data == NULL) {
+            CloseHandle(mapping.Mapping);
+            CloseHandle(file);
+            return IO_ERR_FAILED_TO_MAP;
+        }
+    }
+
+    *mappingOut = mapping;
+
+    if (HASANYBIT(hints, IO_ACCESS_WILLNEED)) {
+        IOAdviseMapping(mappingOut, 0, mapping.Size, IO_ACCESS_WILLNEED);
+    }
+
+    return IO_OK;
+}
+
+IOResult
+IOAdviseMapping(IOFileMapping *mapping, usize offset, usize size, IOAccessHints hints) {
+    if (mapping == NULL || offset > mapping->Size) {
+        return IO_ERR_INVALID_ARGS;
+    }
+
+    if (mapping->Data == NULL || size == 0) {
+        return IO_OK;
+    }
+
+    if (size > mapping->Size - offset) {
+        size = mapping->Size - offset;
+    }
+
+    if (HASANYBIT(hints, IO_ACCESS_WILLNEED)) {
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = (byte *)mapping->Data + offset;
+        range.NumberOfBytes = size;
+
+        // NOTE(ilya.a): It's only a hint. If prefetch fails, pages will be faulted in on access. [2026/10/18]
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    return IO_OK;
+}
+
+void
+IOUnmapFile(IOFileMapping *mapping) {
+    if (mapping == NULL) {
+        return;
+    }
+
+    if (mapping->Data != NULL) {
+        UnmapViewOfFile(mapping->Data);
+    }
+
+    if (mapping->Mapping != NULL) {
+        CloseHandle(mapping->Mapping);
+    }
+
+    if (mapping->File != NULL && mapping->File != INVALID_HANDLE_VALUE) {
+        CloseHandle(mapping->File);
+    }
+
+    mapping->Data = NULL;
+    mapping->Size = 0;
+    mapping->File = INVALID_HANDLE_VALUE;
+    mapping->Mapping = NULL;
+}
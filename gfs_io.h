@@ -26,6 +26,10 @@ typedef enum {
     IO_ERR_FAILED_TO_READ,
     IO_ERR_FAILED_TO_OFFSET_HANDLE,
     IO_ERR_READED_LESS_THAN_REQUIRED,
+    IO_ERR_FAILED_TO_GET_SIZE,
+    IO_ERR_FAILED_TO_MAP,
+    IO_ERR_FAILED_TO_CLOSE,
+    IO_ERR_FAILED_TO_WRITE,
 } IOResult;
 
 typedef u8 IOPermissions;
@@ -33,9 +37,183 @@ typedef u8 IOPermissions;
 #define IO_READ MKFLAG(1)
 #define IO_WRITE MKFLAG(2)
 #define IO_READ_WRITE IO_READ | IO_WRITE
+#define IO_OVERLAPPED MKFLAG(3) // Reads of several threads run in parallel (see `IOReadAtEx`).
 
 IOResult IOOpenFile(cstr8 filePath, FileHandle *handleOut, IOPermissions perms);
 IOResult IOLoadBytesFromFile(FileHandle *handle, void *buffer, usize numberOfBytes);
 IOResult IOLoadBytesFromFileEx(FileHandle *handle, void *buffer, usize numberOfBytes, usize offset);
 
+/*
+ * Positional read. Doesn't depend on the shared file pointer, so the same handle can be read
+ * from several threads at once. Keeps reading until `numberOfBytes` are read or end of file is
+ * reached. Returns `IO_ERR_READED_LESS_THAN_REQUIRED` in latter case, amount which was actually read
+ * is stored in `bytesReadOut` (optional).
+ *
+ * On handles opened without `IO_OVERLAPPED` Windows leaves the file pointer right after the bytes
+ * read and runs reads of several threads one at a time. Don't mix it with calls, which use the
+ * file pointer (`IOWriteBytesToFile`, `IOWriter`), on the same handle without seeking in between.
+ */
+IOResult IOReadAt(FileHandle *handle, void *buffer, usize numberOfBytes, u64 offset, usize *bytesReadOut);
+
+/*
+ * Same as `IOReadAt`, but waits for reads of `IO_OVERLAPPED` handle on manual-reset `event`, so
+ * other threads can read the same handle at the same time, each with its own event. With NULL
+ * `event` it waits on the handle itself, which is only right, if nothing else reads it meanwhile.
+ */
+IOResult IOReadAtEx(
+    FileHandle *handle, void *buffer, usize numberOfBytes, u64 offset, HANDLE event, usize *bytesReadOut);
+
+typedef struct {
+    u64 Offset;
+    usize Size;
+    void *Buffer;
+
+    usize BytesRead; // [out]
+    IOResult Result; // [out]
+} IOReadRange;
+
+/*
+ * Vectored positional read. Reads every range of `ranges` and reports result per range.
+ * Neighbour ranges, which are contiguous both in file and in memory, are merged into a single read.
+ * Returns `IO_OK` only if every range was read completely.
+ */
+IOResult IOReadRanges(FileHandle *handle, IOReadRange *ranges, usize rangeCount);
+IOResult IOGetFileSize(FileHandle *handle, usize *sizeOut);
+
+/*
+ * Creates new file for writing, truncates it if it already exists.
+ */
+IOResult IOCreateFile(cstr8 filePath, FileHandle *handleOut);
+
+/*
+ * Writes bytes at the current position of the file. Positional reads move that position too
+ * (see `IOReadAt`).
+ */
+IOResult IOWriteBytesToFile(FileHandle *handle, const void *buffer, usize numberOfBytes);
+
+IOResult IOCloseFile(FileHandle *handle);
+
+/*
+ * Buffered sequential reader. Small reads are served from caller provided buffer, so parsers
+ * can read chunk headers and fields one by one without going to the kernel for each of them.
+ * Reads are positional (see `IOReadAt`), but still move file pointer of synchronous handle.
+ * Callers, which read or write the handle through its file pointer after the reader, have to
+ * seek first. Reader doesn't own the file.
+ */
+typedef struct {
+    FileHandle File;
+    u64 FileOffset; // Offset of the byte right after buffered data.
+
+    byte *Buffer;
+    usize Capacity;
+    usize Position; // Next byte to be read from buffer.
+    usize Size;     // Bytes buffered.
+
+    u64 SyscallCount;
+} IOReader;
+
+IOReader IOReaderMake(FileHandle file, u64 offset, void *buffer, usize bufferCapacity);
+
+/*
+ * Returns `IO_ERR_READED_LESS_THAN_REQUIRED` if end of file was reached. Reads, which are larger
+ * than buffer, go straight into `destination`.
+ */
+IOResult IOReaderRead(IOReader *reader, void *destination, usize numberOfBytes);
+
+/*
+ * Same as `IOReaderRead`, but doesn't advance reader. `numberOfBytes` can't exceed buffer capacity.
+ */
+IOResult IOReaderPeek(IOReader *reader, void *destination, usize numberOfBytes);
+
+/*
+ * Skipping past end of file is not an error, following reads will fail instead.
+ */
+IOResult IOReaderSkip(IOReader *reader, u64 numberOfBytes);
+
+/*
+ * Offset in file of the next byte to be read.
+ */
+u64 IOReaderTell(const IOReader *reader);
+
+IOResult IOReaderReadU8(IOReader *reader, u8 *valueOut);
+IOResult IOReaderReadU16(IOReader *reader, u16 *valueOut);
+IOResult IOReaderReadU32(IOReader *reader, u32 *valueOut);
+IOResult IOReaderReadU64(IOReader *reader, u64 *valueOut);
+IOResult IOReaderReadF32(IOReader *reader, f32 *valueOut);
+
+/*
+ * LEB128: 7 bits per byte, least significant group first, high bit set on every byte but last.
+ */
+IOResult IOReaderReadVarU64(IOReader *reader, u64 *valueOut);
+
+/*
+ * Buffered writer. Writes at the current position of the file. Writer owns the file: it is
+ * flushed and closed with `IOWriterClose`.
+ */
+typedef struct {
+    FileHandle File;
+
+    byte *Buffer;
+    usize Capacity;
+    usize Size;
+
+    u64 BytesWritten; // Including those, which are still buffered.
+    u64 SyscallCount;
+} IOWriter;
+
+IOWriter IOWriterMake(FileHandle file, void *buffer, usize bufferCapacity);
+
+IOResult IOWriterWrite(IOWriter *writer, const void *source, usize numberOfBytes);
+
+/*
+ * Writes `numberOfBytes` of zeros. Handy for padding.
+ */
+IOResult IOWriterWriteZeros(IOWriter *writer, usize numberOfBytes);
+
+IOResult IOWriterWriteU8(IOWriter *writer, u8 value);
+IOResult IOWriterWriteU16(IOWriter *writer, u16 value);
+IOResult IOWriterWriteU32(IOWriter *writer, u32 value);
+IOResult IOWriterWriteU64(IOWriter *writer, u64 value);
+IOResult IOWriterWriteF32(IOWriter *writer, f32 value);
+IOResult IOWriterWriteVarU64(IOWriter *writer, u64 value);
+
+IOResult IOWriterFlush(IOWriter *writer);
+
+/*
+ * Flushes buffered data and closes the file. File is closed even if flush fails.
+ */
+IOResult IOWriterClose(IOWriter *writer);
+
+/*
+ * Access pattern hints for mapped files.
+ */
+typedef u8 IOAccessHints;
+
+#define IO_ACCESS_NORMAL 0
+#define IO_ACCESS_SEQUENTIAL MKFLAG(0) // Pages will be touched front to back.
+#define IO_ACCESS_RANDOM MKFLAG(1)     // Pages will be touched in no particular order.
+#define IO_ACCESS_WILLNEED MKFLAG(2)   // Pages will be needed soon, so start reading them now.
+
+/*
+ * Read-only view of the whole file. Lets assets be used in place, without copying
+ * them from page cache into user buffers.
+ */
+typedef struct {
+    const void *Data;
+    usize Size;
+
+    FileHandle File;
+    HANDLE Mapping;
+} IOFileMapping;
+
+IOResult IOMapFile(cstr8 filePath, IOFileMapping *mappingOut, IOAccessHints hints);
+
+/*
+ * Hints how [offset, offset + size) range of mapping will be accessed. Only `IO_ACCESS_WILLNEED`
+ * has effect after mapping is created, because other hints are applied when file is opened.
+ */
+IOResult IOAdviseMapping(IOFileMapping *mapping, usize offset, usize size, IOAccessHints hints);
+
+void IOUnmapFile(IOFileMapping *mapping);
+
 #endif // GFS_IO_H_INCLUDED
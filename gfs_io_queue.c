@@ -0,0 +1,320 @@
+/*
+ * FILE      gfs_io_queue.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_io_queue.h"
+
+#include <Windows.h>
+#include <intrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_io.h"
+
+#define IO_TICKET_MAKE(INDEX, GENERATION) ((((u64)(GENERATION)) << 32) | ((u64)(INDEX) + 1))
+#define IO_TICKET_GET_INDEX(TICKET) ((u32)((TICKET) & 0xFFFFFFFF) - 1)
+#define IO_TICKET_GET_GENERATION(TICKET) ((u32)((TICKET) >> 32))
+
+// NOTE(ilya.a): Same as in `gfs_spsc.c`: x86 keeps order of stores and of loads, only compiler
+// has to be stopped. [2026/10/18]
+#define IO_QUEUE_BARRIER() _ReadWriteBarrier()
+
+internal DWORD WINAPI
+IOQueue_WorkerProc(LPVOID parameter) {
+    IOQueue *queue = (IOQueue *)parameter;
+
+    // NOTE(ilya.a): Own event per worker, so workers can read the same `IO_OVERLAPPED` file at
+    // once. If it can't be created, worker waits on the file itself, which is still correct for
+    // synchronous handles. [2026/10/18]
+    HANDLE event = CreateEventA(NULL, TRUE, FALSE, NULL);
+
+    EnterCriticalSection(&queue->Lock);
+
+    while (true) {
+        while (queue->PendingCount == 0 && !queue->ShouldStop) {
+            SleepConditionVariableCS(&queue->HasWork, &queue->Lock, INFINITE);
+        }
+
+        if (queue->ShouldStop) {
+            break;
+        }
+
+        u32 slotIndex = queue->Pending[queue->PendingHead];
+        queue->PendingHead = (queue->PendingHead + 1) & (IO_QUEUE_CAPACITY - 1);
+        queue->PendingCount -= 1;
+
+        IOQueueSlot *slot = &queue->Slots[slotIndex];
+        slot->State = IO_REQUEST_STATE_RUNNING;
+        IORequest request = slot->Request;
+
+        LeaveCriticalSection(&queue->Lock);
+
+        IOCompletion completion = {0};
+        completion.Result = IOReadAtEx(
+            &request.File, request.Destination, request.Size, request.Offset, event, &completion.BytesRead);
+
+        EnterCriticalSection(&queue->Lock);
+
+        slot->Completion = completion;
+        slot->State = IO_REQUEST_STATE_DONE;
+        IO_QUEUE_BARRIER(); // Completion is written before it is published to `IOQueueIsDone`.
+        slot->DoneGeneration = slot->Generation;
+        WakeAllConditionVariable(&queue->HasCompletion);
+    }
+
+    LeaveCriticalSection(&queue->Lock);
+
+    if (event != NULL) {
+        CloseHandle(event);
+    }
+
+    return 0;
+}
+
+IOQueue *
+IOQueueMake(u32 workerCount) {
+    IOQueue *queue = VirtualAlloc(NULL, sizeof(IOQueue), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    if (workerCount == 0) {
+        workerCount = Sys_GetInfo()->LogicalCoreCount;
+    }
+
+    if (workerCount > IO_QUEUE_WORKER_COUNT_MAX) {
+        workerCount = IO_QUEUE_WORKER_COUNT_MAX;
+    }
+
+    InitializeCriticalSection(&queue->Lock);
+    InitializeConditionVariable(&queue->HasWork);
+    InitializeConditionVariable(&queue->HasCompletion);
+
+    for (u32 slotIndex = 0; slotIndex < IO_QUEUE_CAPACITY; ++slotIndex) {
+        queue->Slots[slotIndex].State = IO_REQUEST_STATE_FREE;
+        queue->Slots[slotIndex].Generation = 1;
+        queue->FreeSlots[slotIndex] = IO_QUEUE_CAPACITY - 1 - slotIndex;
+    }
+
+    queue->FreeSlotCount = IO_QUEUE_CAPACITY;
+
+    for (u32 workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+        HANDLE worker = CreateThread(NULL, 0, IOQueue_WorkerProc, queue, 0, NULL);
+
+        if (worker == NULL) {
+            break;
+        }
+
+        queue->Workers[queue->WorkerCount++] = worker;
+    }
+
+    if (queue->WorkerCount == 0) {
+        IOQueueDestroy(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+void
+IOQueueDestroy(IOQueue *queue) {
+    if (queue == NULL) {
+        return;
+    }
+
+    EnterCriticalSection(&queue->Lock);
+    queue->ShouldStop = true;
+    WakeAllConditionVariable(&queue->HasWork);
+    LeaveCriticalSection(&queue->Lock);
+
+    for (u32 workerIndex = 0; workerIndex < queue->WorkerCount; ++workerIndex) {
+        WaitForSingleObject(queue->Workers[workerIndex], INFINITE);
+        CloseHandle(queue->Workers[workerIndex]);
+    }
+
+    DeleteCriticalSection(&queue->Lock);
+    VirtualFree(queue, 0, MEM_RELEASE);
+}
+
+/*
+ * NOTE(ilya.a): Should be called with lock held. [2026/10/18]
+ */
+internal IOTicket
+IOQueue_PushLocked(IOQueue *queue, const IORequest *request) {
+    if (queue->FreeSlotCount == 0) {
+        return IO_TICKET_INVALID;
+    }
+
+    u32 slotIndex = queue->FreeSlots[--queue->FreeSlotCount];
+    IOQueueSlot *slot = &queue->Slots[slotIndex];
+
+    slot->Request = *request;
+    slot->State = IO_REQUEST_STATE_QUEUED;
+    slot->Completion = (IOCompletion){0};
+
+    u32 tail = (queue->PendingHead + queue->PendingCount) & (IO_QUEUE_CAPACITY - 1);
+    queue->Pending[tail] = slotIndex;
+    queue->PendingCount += 1;
+    queue->InFlightCount += 1;
+
+    return IO_TICKET_MAKE(slotIndex, slot->Generation);
+}
+
+IOTicket
+IOQueueSubmit(IOQueue *queue, const IORequest *request) {
+    IOTicket ticket = IO_TICKET_INVALID;
+    IOQueueSubmitBatch(queue, request, 1, &ticket);
+    return ticket;
+}
+
+usize
+IOQueueSubmitBatch(IOQueue *queue, const IORequest *requests, usize count, IOTicket *ticketsOut) {
+    if (queue == NULL || requests == NULL || ticketsOut == NULL) {
+        return 0;
+    }
+
+    usize submittedCount = 0;
+
+    EnterCriticalSection(&queue->Lock);
+
+    while (submittedCount < count) {
+        IOTicket ticket = IOQueue_PushLocked(queue, &requests[submittedCount]);
+
+        if (ticket == IO_TICKET_INVALID) {
+            break;
+        }
+
+        ticketsOut[submittedCount++] = ticket;
+    }
+
+    if (submittedCount == 1) {
+        WakeConditionVariable(&queue->HasWork);
+    } else if (submittedCount > 1) {
+        WakeAllConditionVariable(&queue->HasWork);
+    }
+
+    LeaveCriticalSection(&queue->Lock);
+
+    return submittedCount;
+}
+
+/*
+ * NOTE(ilya.a): Should be called with lock held. Returns NULL for stale or invalid tickets. [2026/10/18]
+ */
+internal IOQueueSlot *
+IOQueue_GetSlotLocked(IOQueue *queue, IOTicket ticket) {
+    if (ticket == IO_TICKET_INVALID) {
+        return NULL;
+    }
+
+    u32 slotIndex = IO_TICKET_GET_INDEX(ticket);
+
+    if (slotIndex >= IO_QUEUE_CAPACITY) {
+        return NULL;
+    }
+
+    IOQueueSlot *slot = &queue->Slots[slotIndex];
+
+    if (slot->Generation != IO_TICKET_GET_GENERATION(ticket) || slot->State == IO_REQUEST_STATE_FREE) {
+        return NULL;
+    }
+
+    return slot;
+}
+
+internal void
+IOQueue_RetireLocked(IOQueue *queue, IOQueueSlot *slot) {
+    slot->State = IO_REQUEST_STATE_FREE;
+    slot->Generation += 1;
+
+    queue->FreeSlots[queue->FreeSlotCount++] = (u32)(slot - queue->Slots);
+    queue->InFlightCount -= 1;
+}
+
+bool
+IOQueueIsDone(IOQueue *queue, IOTicket ticket) {
+    if (queue == NULL) {
+        return false;
+    }
+
+    u32 slotIndex = IO_TICKET_GET_INDEX(ticket);
+
+    if (ticket == IO_TICKET_INVALID || slotIndex >= IO_QUEUE_CAPACITY) {
+        return true;
+    }
+
+    // NOTE(ilya.a): Generation of slot is bumped on retire, so done generation left by previous
+    // request is behind the ticket, and stale ticket is behind done generation. [2026/10/18]
+    return (i32)(queue->Slots[slotIndex].DoneGeneration - IO_TICKET_GET_GENERATION(ticket)) >= 0;
+}
+
+bool
+IOQueuePoll(IOQueue *queue, IOTicket ticket, IOCompletion *completionOut) {
+    if (queue == NULL || completionOut == NULL) {
+        return false;
+    }
+
+    bool isDone = false;
+
+    EnterCriticalSection(&queue->Lock);
+
+    IOQueueSlot *slot = IOQueue_GetSlotLocked(queue, ticket);
+
+    if (slot == NULL) {
+        completionOut->Result = IO_ERR_INVALID_ARGS;
+        completionOut->BytesRead = 0;
+        isDone = true;
+    } else if (slot->State == IO_REQUEST_STATE_DONE) {
+        *completionOut = slot->Completion;
+        IOQueue_RetireLocked(queue, slot);
+        isDone = true;
+    }
+
+    LeaveCriticalSection(&queue->Lock);
+
+    return isDone;
+}
+
+IOCompletion
+IOQueueWait(IOQueue *queue, IOTicket ticket) {
+    IOCompletion completion = {.Result = IO_ERR_INVALID_ARGS, .BytesRead = 0};
+
+    if (queue == NULL) {
+        return completion;
+    }
+
+    EnterCriticalSection(&queue->Lock);
+
+    IOQueueSlot *slot = IOQueue_GetSlotLocked(queue, ticket);
+
+    if (slot != NULL) {
+        while (slot->State != IO_REQUEST_STATE_DONE) {
+            SleepConditionVariableCS(&queue->HasCompletion, &queue->Lock, INFINITE);
+        }
+
+        completion = slot->Completion;
+        IOQueue_RetireLocked(queue, slot);
+    }
+
+    LeaveCriticalSection(&queue->Lock);
+
+    return completion;
+}
+
+u32
+IOQueueGetInFlightCount(IOQueue *queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    EnterCriticalSection(&queue->Lock);
+    u32 inFlightCount = queue->InFlightCount;
+    LeaveCriticalSection(&queue->Lock);
+
+    return inFlightCount;
+}
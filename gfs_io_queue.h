@@ -0,0 +1,122 @@
+/*
+ * GFS. Asynchronous IO request queue.
+ *
+ * Read requests are pushed into the queue and serviced by pool of worker threads,
+ * which are doing positional reads (see `IOReadAtEx`). Caller gets a ticket per request
+ * and polls or waits for it later, so many reads could be in flight at once.
+ *
+ * Files should be opened with `IO_OVERLAPPED`. Windows runs reads of synchronous handle
+ * one at a time, so workers reading the same one would just wait for each other.
+ *
+ * FILE      gfs_io_queue.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_IO_QUEUE_H_INCLUDED
+#define GFS_IO_QUEUE_H_INCLUDED
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_io.h"
+
+#define IO_QUEUE_CAPACITY 256 // Max number of requests in flight. Should be power of two.
+#define IO_QUEUE_WORKER_COUNT_MAX 16
+
+GFS_STATIC_ASSERT((IO_QUEUE_CAPACITY & (IO_QUEUE_CAPACITY - 1)) == 0);
+
+typedef struct {
+    FileHandle File;
+    u64 Offset;
+    usize Size;
+    void *Destination;
+} IORequest;
+
+/*
+ * Identifies submitted request. Zero is never a valid ticket.
+ */
+typedef u64 IOTicket;
+
+#define IO_TICKET_INVALID 0
+
+typedef struct {
+    IOResult Result;
+    usize BytesRead;
+} IOCompletion;
+
+typedef enum {
+    IO_REQUEST_STATE_FREE,
+    IO_REQUEST_STATE_QUEUED,
+    IO_REQUEST_STATE_RUNNING,
+    IO_REQUEST_STATE_DONE,
+} IORequestState;
+
+typedef struct {
+    IORequest Request;
+    IORequestState State;
+    IOCompletion Completion;
+    u32 Generation;
+    volatile u32 DoneGeneration; // Generation of the last completed request. Read without lock.
+} IOQueueSlot;
+
+typedef struct {
+    CRITICAL_SECTION Lock;
+    CONDITION_VARIABLE HasWork;
+    CONDITION_VARIABLE HasCompletion;
+
+    IOQueueSlot Slots[IO_QUEUE_CAPACITY];
+
+    u32 FreeSlots[IO_QUEUE_CAPACITY];
+    u32 FreeSlotCount;
+
+    u32 Pending[IO_QUEUE_CAPACITY]; // Ring of slot indices, waiting for worker.
+    u32 PendingHead;
+    u32 PendingCount;
+
+    u32 InFlightCount; // Submitted, but not yet retired with poll/wait.
+
+    HANDLE Workers[IO_QUEUE_WORKER_COUNT_MAX];
+    u32 WorkerCount;
+    bool ShouldStop;
+} IOQueue;
+
+/*
+ * Creates queue and spawns `workerCount` worker threads. If `workerCount` is zero,
+ * one worker per logical core is used.
+ */
+IOQueue *IOQueueMake(u32 workerCount);
+void IOQueueDestroy(IOQueue *queue);
+
+/*
+ * Returns `IO_TICKET_INVALID` if queue is full.
+ */
+IOTicket IOQueueSubmit(IOQueue *queue, const IORequest *request);
+
+/*
+ * Submits up to `count` requests under single lock. Returns number of requests
+ * accepted, tickets are written to `ticketsOut`.
+ */
+usize IOQueueSubmitBatch(IOQueue *queue, const IORequest *requests, usize count, IOTicket *ticketsOut);
+
+/*
+ * Non-blocking. If request is completed, writes completion, retires ticket and returns true.
+ */
+bool IOQueuePoll(IOQueue *queue, IOTicket ticket, IOCompletion *completionOut);
+
+/*
+ * Lock-free check, so real-time threads can poll without contending with workers. Doesn't retire
+ * ticket, `IOQueuePoll` or `IOQueueWait` still has to be called once it returns true. Returns true
+ * for stale tickets as well, so they are retired with an error.
+ */
+bool IOQueueIsDone(IOQueue *queue, IOTicket ticket);
+
+/*
+ * Blocks until request is completed, then retires ticket.
+ */
+IOCompletion IOQueueWait(IOQueue *queue, IOTicket ticket);
+
+u32 IOQueueGetInFlightCount(IOQueue *queue);
+
+#endif // GFS_IO_QUEUE_H_INCLUDED
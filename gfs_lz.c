@@ -0,0 +1,467 @@
+/*
+ * FILE      gfs_lz.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_lz.h"
+
+#include <emmintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5 // Block always ends with at least that much literals.
+#define LZ_MF_LIMIT 12     // Last match should start at least that far from the end.
+#define LZ_MAX_DISTANCE 65535
+#define LZ_RUN_MASK 15
+#define LZ_HASH_LOG 14
+#define LZ_SKIP_TRIGGER 6 // Step grows after every 2^LZ_SKIP_TRIGGER misses.
+#define LZ_WILDCOPY_SIZE 16
+
+internal u32
+LZ_Read32(const byte *p) {
+    // NOTE(ilya.a): Compiles down to single unaligned load on x64. [2026/10/18]
+    return (u32)p[0] | (u32)p[1] << 8 | (u32)p[2] << 16 | (u32)p[3] << 24;
+}
+
+internal u64
+LZ_Read64LE(const byte *p) {
+    return (u64)p[0] | (u64)p[1] << 8 | (u64)p[2] << 16 | (u64)p[3] << 24 | (u64)p[4] << 32 | (u64)p[5] << 40 |
+           (u64)p[6] << 48 | (u64)p[7] << 56;
+}
+
+internal void
+LZ_Write64LE(byte *p, u64 value) {
+    for (u32 i = 0; i < 8; ++i) {
+        p[i] = (byte)(value >> (i * 8));
+    }
+}
+
+internal u32
+LZ_Hash(u32 sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_LOG);
+}
+
+/*
+ * Copies 16 bytes at a time. Might write up to 15 bytes past `destination + size`.
+ */
+internal void
+LZ_WildCopy(byte *destination, const byte *source, usize size) {
+    byte *end = destination + size;
+    do {
+        _mm_storeu_si128((__m128i *)destination, _mm_loadu_si128((const __m128i *)source));
+        destination += LZ_WILDCOPY_SIZE;
+        source += LZ_WILDCOPY_SIZE;
+    } while (destination < end);
+}
+
+internal void
+LZ_Copy(byte *destination, const byte *source, usize size) {
+    while (size >= LZ_WILDCOPY_SIZE) {
+        _mm_storeu_si128((__m128i *)destination, _mm_loadu_si128((const __m128i *)source));
+        destination += LZ_WILDCOPY_SIZE;
+        source += LZ_WILDCOPY_SIZE;
+        size -= LZ_WILDCOPY_SIZE;
+    }
+    while (size-- > 0) {
+        *destination++ = *source++;
+    }
+}
+
+usize
+LZCompressBound(usize size) {
+    return size + size / 255 + 16;
+}
+
+internal byte *
+LZ_WriteLength(byte *op, usize length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (byte)length;
+    return op;
+}
+
+/*
+ * Writes one sequence: literals, then optional match. Returns NULL if output doesn't fit.
+ */
+internal byte *
+LZ_WriteSequence(byte *op, byte *oend, const byte *literals, usize literalLength, usize offset, usize matchLength) {
+    usize worstSize = 1 + literalLength + literalLength / 255 + 1 + 2 + matchLength / 255 + 1;
+
+    if ((usize)(oend - op) < worstSize) {
+        return NULL;
+    }
+
+    byte *token = op++;
+    usize matchCode = matchLength > 0 ? matchLength - LZ_MIN_MATCH : 0;
+
+    *token = (byte)((literalLength >= LZ_RUN_MASK ? LZ_RUN_MASK : literalLength) << 4);
+    if (literalLength >= LZ_RUN_MASK) {
+        op = LZ_WriteLength(op, literalLength - LZ_RUN_MASK);
+    }
+
+    LZ_Copy(op, literals, literalLength);
+    op += literalLength;
+
+    if (matchLength == 0) {
+        return op;
+    }
+
+    *op++ = (byte)(offset & 0xFF);
+    *op++ = (byte)(offset >> 8);
+
+    *token |= (byte)(matchCode >= LZ_RUN_MASK ? LZ_RUN_MASK : matchCode);
+    if (matchCode >= LZ_RUN_MASK) {
+        op = LZ_WriteLength(op, matchCode - LZ_RUN_MASK);
+    }
+
+    return op;
+}
+
+usize
+LZCompressBlock(const void *source, usize sourceSize, void *destination, usize destinationCapacity) {
+    if (source == NULL || destination == NULL || sourceSize > LZ_BLOCK_SIZE_MAX) {
+        return 0;
+    }
+
+    // NOTE(ilya.a): Positions are relative to `source`, so 32 bits are enough for LZ_BLOCK_SIZE_MAX. [2026/10/18]
+    u32 table[1 << LZ_HASH_LOG];
+    MemoryZero(table, sizeof(table));
+
+    const byte *base = (const byte *)source;
+    const byte *ip = base;
+    const byte *anchor = base;
+    const byte *iend = base + sourceSize;
+    const byte *mflimit = sourceSize > LZ_MF_LIMIT ? iend - LZ_MF_LIMIT : base;
+    const byte *matchlimit = sourceSize > LZ_LAST_LITERALS ? iend - LZ_LAST_LITERALS : base;
+
+    byte *op = (byte *)destination;
+    byte *oend = op + destinationCapacity;
+
+    if (sourceSize > LZ_MF_LIMIT) {
+        table[LZ_Hash(LZ_Read32(ip))] = 0;
+        ++ip;
+
+        u32 missCount = 1 << LZ_SKIP_TRIGGER;
+
+        while (ip < mflimit) {
+            u32 sequence = LZ_Read32(ip);
+            u32 hash = LZ_Hash(sequence);
+            const byte *candidate = base + table[hash];
+            table[hash] = (u32)(ip - base);
+
+            if (candidate >= ip || (usize)(ip - candidate) > LZ_MAX_DISTANCE || LZ_Read32(candidate) != sequence) {
+                ip += missCount++ >> LZ_SKIP_TRIGGER;
+                continue;
+            }
+
+            missCount = 1 << LZ_SKIP_TRIGGER;
+
+            while (ip > anchor && candidate > base && ip[-1] == candidate[-1]) {
+                --ip;
+                --candidate;
+            }
+
+            usize matchLength = LZ_MIN_MATCH;
+            while (ip + matchLength < matchlimit && ip[matchLength] == candidate[matchLength]) {
+                ++matchLength;
+            }
+
+            op = LZ_WriteSequence(op, oend, anchor, (usize)(ip - anchor), (usize)(ip - candidate), matchLength);
+
+            if (op == NULL) {
+                return 0;
+            }
+
+            ip += matchLength;
+            anchor = ip;
+
+            if (ip < mflimit) {
+                table[LZ_Hash(LZ_Read32(ip - 2))] = (u32)(ip - 2 - base);
+            }
+        }
+    }
+
+    op = LZ_WriteSequence(op, oend, anchor, (usize)(iend - anchor), 0, 0);
+
+    if (op == NULL) {
+        return 0;
+    }
+
+    return (usize)(op - (byte *)destination);
+}
+
+LZResult
+LZDecompressBlock(
+    const void *source, usize sourceSize, void *destination, usize destinationCapacity, usize *decompressedSizeOut) {
+    if (source == NULL || destination == NULL || sourceSize == 0) {
+        return LZ_ERR_INVALID_ARGS;
+    }
+
+    const byte *ip = (const byte *)source;
+    const byte *iend = ip + sourceSize;
+    byte *op = (byte *)destination;
+    byte *ostart = op;
+    byte *oend = op + destinationCapacity;
+
+    while (true) {
+        if (ip >= iend) {
+            return LZ_ERR_CORRUPTED;
+        }
+
+        u32 token = *ip++;
+
+        usize literalLength = token >> 4;
+        if (literalLength == LZ_RUN_MASK) {
+            byte extra;
+            do {
+                if (ip >= iend) {
+                    return LZ_ERR_CORRUPTED;
+                }
+                extra = *ip++;
+                literalLength += extra;
+            } while (extra == 255);
+        }
+
+        if (literalLength > (usize)(iend - ip)) {
+            return LZ_ERR_CORRUPTED;
+        }
+
+        if (literalLength > (usize)(oend - op)) {
+            return LZ_ERR_DESTINATION_TOO_SMALL;
+        }
+
+        if ((usize)(oend - op) >= literalLength + LZ_WILDCOPY_SIZE &&
+            (usize)(iend - ip) >= literalLength + LZ_WILDCOPY_SIZE) {
+            LZ_WildCopy(op, ip, literalLength);
+        } else {
+            LZ_Copy(op, ip, literalLength);
+        }
+
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == iend) {
+            break; // NOTE(ilya.a): Last sequence has literals only. [2026/10/18]
+        }
+
+        if (iend - ip < 2) {
+            return LZ_ERR_CORRUPTED;
+        }
+
+        usize offset = (usize)ip[0] | (usize)ip[1] << 8;
+        ip += 2;
+
+        if (offset == 0 || offset > (usize)(op - ostart)) {
+            return LZ_ERR_CORRUPTED;
+        }
+
+        usize matchLength = token & LZ_RUN_MASK;
+        if (matchLength == LZ_RUN_MASK) {
+            byte extra;
+            do {
+                if (ip >= iend) {
+                    return LZ_ERR_CORRUPTED;
+                }
+                extra = *ip++;
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += LZ_MIN_MATCH;
+
+        if (matchLength > (usize)(oend - op)) {
+            return LZ_ERR_DESTINATION_TOO_SMALL;
+        }
+
+        const byte *match = op - offset;
+
+        if (offset >= LZ_WILDCOPY_SIZE && (usize)(oend - op) >= matchLength + LZ_WILDCOPY_SIZE) {
+            LZ_WildCopy(op, match, matchLength);
+        } else {
+            // NOTE(ilya.a): Overlapping match (e.g. run of the same byte) should be copied byte by byte. [2026/10/18]
+            for (usize i = 0; i < matchLength; ++i) {
+                op[i] = match[i];
+            }
+        }
+
+        op += matchLength;
+    }
+
+    if (decompressedSizeOut != NULL) {
+        *decompressedSizeOut = (usize)(op - ostart);
+    }
+
+    return LZ_OK;
+}
+
+//
+// Frame
+//
+
+internal u32
+LZ_GetBlockCount(usize size, u32 blockSize) {
+    return (u32)((size + blockSize - 1) / blockSize);
+}
+
+usize
+LZFrameCompressBound(usize size, u32 blockSize) {
+    if (blockSize == 0) {
+        blockSize = LZ_FRAME_BLOCK_SIZE_DEFAULT;
+    }
+
+    // NOTE(ilya.a): Incompressible blocks are stored as is, so frame never grows more than its tables. [2026/10/18]
+    return sizeof(LZFrameHeader) + (usize)LZ_GetBlockCount(size, blockSize) * sizeof(u64) + size;
+}
+
+usize
+LZFrameCompress(const void *source, usize sourceSize, void *destination, usize destinationCapacity, u32 blockSize) {
+    if (source == NULL || destination == NULL) {
+        return 0;
+    }
+
+    if (blockSize == 0) {
+        blockSize = LZ_FRAME_BLOCK_SIZE_DEFAULT;
+    }
+
+    if (blockSize > LZ_BLOCK_SIZE_MAX) {
+        return 0;
+    }
+
+    u32 blockCount = LZ_GetBlockCount(sourceSize, blockSize);
+    usize tablesSize = sizeof(LZFrameHeader) + (usize)blockCount * sizeof(u64);
+
+    if (destinationCapacity < tablesSize) {
+        return 0;
+    }
+
+    LZFrameHeader header = {0};
+    header.Magic = LZ_FRAME_MAGIC;
+    header.BlockSize = blockSize;
+    header.ContentSize = sourceSize;
+    header.BlockCount = blockCount;
+    MemoryCopy(destination, &header, sizeof(header));
+
+    byte *blockEnds = (byte *)destination + sizeof(LZFrameHeader);
+    byte *blocks = (byte *)destination + tablesSize;
+    usize blocksCapacity = destinationCapacity - tablesSize;
+    usize blocksSize = 0;
+
+    for (u32 blockIndex = 0; blockIndex < blockCount; ++blockIndex) {
+        const byte *block = (const byte *)source + (usize)blockIndex * blockSize;
+        usize blockSourceSize = sourceSize - (usize)blockIndex * blockSize;
+        if (blockSourceSize > blockSize) {
+            blockSourceSize = blockSize;
+        }
+
+        usize compressedSize =
+            LZCompressBlock(block, blockSourceSize, blocks + blocksSize, blocksCapacity - blocksSize);
+
+        // NOTE(ilya.a): Stored size equal to decompressed size marks raw block. [2026/10/18]
+        if (compressedSize == 0 || compressedSize >= blockSourceSize) {
+            if (blocksCapacity - blocksSize < blockSourceSize) {
+                return 0;
+            }
+            LZ_Copy(blocks + blocksSize, block, blockSourceSize);
+            compressedSize = blockSourceSize;
+        }
+
+        blocksSize += compressedSize;
+        LZ_Write64LE(blockEnds + (usize)blockIndex * sizeof(u64), blocksSize);
+    }
+
+    return tablesSize + blocksSize;
+}
+
+LZResult
+LZFrameDecoderMake(const void *frame, usize frameSize, LZFrameDecoder *decoderOut) {
+    if (frame == NULL || decoderOut == NULL) {
+        return LZ_ERR_INVALID_ARGS;
+    }
+
+    if (frameSize < sizeof(LZFrameHeader)) {
+        return LZ_ERR_CORRUPTED;
+    }
+
+    LZFrameHeader header;
+    MemoryCopy(&header, frame, sizeof(header));
+
+    if (header.Magic != LZ_FRAME_MAGIC || header.BlockSize == 0 || header.BlockSize > LZ_BLOCK_SIZE_MAX ||
+        header.BlockCount != LZ_GetBlockCount(header.ContentSize, header.BlockSize)) {
+        return LZ_ERR_CORRUPTED;
+    }
+
+    usize tablesSize = sizeof(LZFrameHeader) + (usize)header.BlockCount * sizeof(u64);
+
+    if (frameSize < tablesSize) {
+        return LZ_ERR_CORRUPTED;
+    }
+
+    decoderOut->Header = header;
+    decoderOut->BlockEnds = (const byte *)frame + sizeof(LZFrameHeader);
+    decoderOut->Blocks = (const byte *)frame + tablesSize;
+    decoderOut->BlocksSize = frameSize - tablesSize;
+
+    return LZ_OK;
+}
+
+LZResult
+LZFrameDecompressBlock(const LZFrameDecoder *decoder, u32 blockIndex, void *destination) {
+    if (decoder == NULL || destination == NULL || blockIndex >= decoder->Header.BlockCount) {
+        return LZ_ERR_INVALID_ARGS;
+    }
+
+    u64 blockBegin = blockIndex > 0 ? LZ_Read64LE(decoder->BlockEnds + (usize)(blockIndex - 1) * sizeof(u64)) : 0;
+    u64 blockEnd = LZ_Read64LE(decoder->BlockEnds + (usize)blockIndex * sizeof(u64));
+
+    if (blockBegin > blockEnd || blockEnd > decoder->BlocksSize) {
+        return LZ_ERR_CORRUPTED;
+    }
+
+    usize blockContentSize = decoder->Header.ContentSize - (u64)blockIndex * decoder->Header.BlockSize;
+    if (blockContentSize > decoder->Header.BlockSize) {
+        blockContentSize = decoder->Header.BlockSize;
+    }
+
+    const byte *block = decoder->Blocks + blockBegin;
+    usize blockSize = (usize)(blockEnd - blockBegin);
+
+    if (blockSize == blockContentSize) {
+        LZ_Copy(destination, block, blockSize);
+        return LZ_OK;
+    }
+
+    usize decompressedSize = 0;
+    LZResult result = LZDecompressBlock(block, blockSize, destination, blockContentSize, &decompressedSize);
+
+    if (result == LZ_OK && decompressedSize != blockContentSize) {
+        return LZ_ERR_CORRUPTED;
+    }
+
+    return result;
+}
+
+LZResult
+LZFrameDecompress(const void *frame, usize frameSize, void *destination, usize destinationCapacity) {
+    LZFrameDecoder decoder;
+    LZResult result = LZFrameDecoderMake(frame, frameSize, &decoder);
+
+    if (result != LZ_OK) {
+        return result;
+    }
+
+    if (destination == NULL || destinationCapacity < decoder.Header.ContentSize) {
+        return LZ_ERR_DESTINATION_TOO_SMALL;
+    }
+
+    for (u32 blockIndex = 0; blockIndex < decoder.Header.BlockCount && result == LZ_OK; ++blockIndex) {
+        byte *block = (byte *)destination + (usize)blockIndex * decoder.Header.BlockSize;
+        result = LZFrameDecompressBlock(&decoder, blockIndex, block);
+    }
+
+    return result;
+}
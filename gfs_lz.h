@@ -0,0 +1,89 @@
+/*
+ * GFS. Fast block compression.
+ *
+ * LZ77 codec with LZ4 block layout: greedy hash-chain-less matcher for compression and
+ * branch-light decoder, which copies 16 bytes at a time. Targeted at asset payloads, where
+ * decompression speed matters much more than ratio.
+ *
+ * Frame is a sequence of independently compressed blocks with offset table in front, so
+ * blocks could be decompressed one by one as they arrive (streaming), or all at once on
+ * several threads.
+ *
+ *     LZFrameHeader | u64 BlockEnds[BlockCount] | block 0 | block 1 | ...
+ *
+ * FILE      gfs_lz.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_LZ_H_INCLUDED
+#define GFS_LZ_H_INCLUDED
+
+#include "gfs_assert.h"
+#include "gfs_types.h"
+#include "gfs_memory.h"
+
+#define LZ_FRAME_MAGIC 0x5A4C4647 // "GFLZ" in little endian.
+#define LZ_FRAME_BLOCK_SIZE_DEFAULT KILOBYTES(256)
+#define LZ_BLOCK_SIZE_MAX MEGABYTES(64)
+
+typedef enum {
+    LZ_OK,
+    LZ_ERR_INVALID_ARGS,
+    LZ_ERR_DESTINATION_TOO_SMALL,
+    LZ_ERR_CORRUPTED,
+} LZResult;
+
+/*
+ * Worst case size of compressed block for `size` bytes of input.
+ */
+usize LZCompressBound(usize size);
+
+/*
+ * Returns compressed size, or zero if `destinationCapacity` is not enough.
+ */
+usize LZCompressBlock(const void *source, usize sourceSize, void *destination, usize destinationCapacity);
+
+LZResult LZDecompressBlock(
+    const void *source, usize sourceSize, void *destination, usize destinationCapacity, usize *decompressedSizeOut);
+
+typedef struct {
+    u32 Magic;
+    u32 BlockSize; // Decompressed size of every block, except the last one.
+    u64 ContentSize;
+    u32 BlockCount;
+    u32 Reserved;
+} LZFrameHeader;
+
+GFS_EXPECT_TYPE_SIZE(LZFrameHeader, 24);
+
+usize LZFrameCompressBound(usize size, u32 blockSize);
+
+/*
+ * Returns frame size, or zero if `destinationCapacity` is not enough. Blocks, which don't
+ * shrink, are stored as is.
+ */
+usize LZFrameCompress(const void *source, usize sourceSize, void *destination, usize destinationCapacity, u32 blockSize);
+
+typedef struct {
+    LZFrameHeader Header;
+    const byte *BlockEnds; // u64 per block, relative to `Blocks`. Might be unaligned.
+    const byte *Blocks;
+    usize BlocksSize;
+} LZFrameDecoder;
+
+LZResult LZFrameDecoderMake(const void *frame, usize frameSize, LZFrameDecoder *decoderOut);
+
+/*
+ * Decompresses single block into `destination`, which should have room for `Header.BlockSize` bytes
+ * (or less for the last block). Doesn't modify decoder, so different blocks could be decompressed
+ * from different threads. Block `N` of the content starts at `N * Header.BlockSize`.
+ */
+LZResult LZFrameDecompressBlock(const LZFrameDecoder *decoder, u32 blockIndex, void *destination);
+
+/*
+ * Decompresses whole frame. `destinationCapacity` should be at least `Header.ContentSize`.
+ */
+LZResult LZFrameDecompress(const void *frame, usize frameSize, void *destination, usize destinationCapacity);
+
+#endif // GFS_LZ_H_INCLUDED
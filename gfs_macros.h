@@ -18,6 +18,6 @@
 #endif // NULL
 
 #define MKFLAG(BITINDEX) (1 << (BITINDEX))
-#define HASANYBIT(MASK, FLAG) ((MASK) | (FLAG))
+#define HASANYBIT(MASK, FLAG) (((MASK) & (FLAG)) != 0)
 
 #endif // GFS_MACROS_H_INCLUDED
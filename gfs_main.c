@@ -14,10 +14,6 @@
  * */
 
 #include <Windows.h>
-#include <xinput.h>
-#include <dsound.h>
-
-#include <math.h> // TODO(ilya.a): Replace with custom code [2024/06/08]
 
 #include "gfs_types.h"
 #include "gfs_macros.h"
@@ -25,231 +21,217 @@
 #include "gfs_linalg.h"
 #include "gfs_fs.h"
 #include "gfs_wave.h"
+#include "gfs_wave_stream.h"
+#include "gfs_io_queue.h"
+#include "gfs_pcm.h"
+#include "gfs_adpcm.h"
+#include "gfs_mixer.h"
+#include "gfs_dsp.h"
+#include "gfs_osc.h"
+#include "gfs_audio.h"
+#include "gfs_audio_telemetry.h"
+#include "gfs_input.h"
+#include "gfs_input_poller.h"
+#include "gfs_game.h"
+#include "gfs_platform.h"
+#include "gfs_scheduler.h"
 #include "gfs_color.h"
 #include "gfs_memory.h"
+#include "gfs_sys.h"
 #include "gfs_geometry.h"
+#include "gfs_bmr.h"
 #include "gfs_win32_bmr.h"
 #include "gfs_win32_keys.h"
 #include "gfs_win32_misc.h"
+#include "gfs_win32_dsound.h"
+#include "gfs_win32_xinput.h"
 #include "gfs_assert.h"
 
-#define VCALL(S, M, ...) (S)->lpVtbl->M((S), __VA_ARGS__)
-#define PI32 3.14159265358979323846f
-
 #define ASSERT_VCALL(S, M, ...) GFS_ASSERT(SUCCEEDED((S)->lpVtbl->M((S), __VA_ARGS__)))
 #define ASSERT_ISZERO(EXPR) GFS_ASSERT((EXPR) == 0)
 #define ASSERT_NONZERO(EXPR) GFS_ASSERT((EXPR) != 0)
 #define ASSERT_EQ(EXPR, VAL) GFS_ASSERT((EXPR) == (VAL))
 #define ASSERT_NONNULL(EXPR) GFS_ASSERT((EXPR) != NULL)
 
-typedef DWORD Win32_XInputGetStateType(DWORD dwUserIndex, XINPUT_STATE *pState);
-typedef DWORD Win32_XInputSetStateType(DWORD dwUserIndex, XINPUT_VIBRATION *pVibration);
-
-typedef HRESULT Win32_DirectSoundCreateType(LPCGUID pcGuidDevice, LPDIRECTSOUND *ppDS, LPUNKNOWN pUnkOuter);
-
-global_var Win32_XInputGetStateType *Win32_xInputGetStatePtr;
-global_var Win32_XInputSetStateType *Win32_xInputSetStatePtr;
-
-global_var Win32_DirectSoundCreateType *Win32_DirectSoundCreatePtr;
-
-global_var LPDIRECTSOUNDBUFFER g_Win32_AudioBuffer;
-
-global_var BMR_Renderer gRenderer;
+/*
+ * Window, controllers and input recording.
+ */
+typedef struct {
+    Platform Platform;
+    Win32_BMRWindow Window;
+
+    InputPoller Poller;
+    InputRing History;
+    InputRecorder Recorder;
+    InputPlayback Playback;
+    bool IsRecording;
+    bool IsReplaying;
+} Win32_Platform;
+
+global_var Win32_Platform gPlatform;
+global_var AudioSystem *gAudio;
 global_var bool gShouldStop = false;
 global_var bool gIsSoundPlaying = false;
 
-global_var struct {
-    Rect Rect;
-    Color4 Color;
-
-    struct {
-        bool LeftPressed;
-        bool RightPressed;
-        bool UpPressed;
-        bool DownPressed;
-    } Input;
-} gPlayer;
+global_var GameState gGame;
+global_var GameState gPreviousGame; // Before the last tick.
 
-#define PLAYER_INIT_X 100
-#define PLAYER_INIT_Y 60
-#define PLAYER_WIDTH 160
-#define PLAYER_HEIGHT 80
-#define PLAYER_SPEED 10
+#define SOUND_SAMPLES_PER_SECOND 48000
+#define SOUND_LATENCY_FRAMES (SOUND_SAMPLES_PER_SECOND / 200) // 5ms past device's safe write cursor.
 
-#define WIN32_XINPUTGETSTATE_PROCNAME "XInputGetState"
-#define WIN32_XINPUTSETSTATE_PROCNAME "XInputSetState"
+#define CONTROLLER_POLL_HZ 500
 
-#define WIN32_XINPUT_DLL XINPUT_DLL
+#define FRAMES_PER_SECOND_TARGET 60
+#define TICKS_PER_FRAME_MAX 4 // Catch-up after stall. Time beyond it is dropped.
 
-typedef enum { WIN32_LOADXINPUT_OK, WIN32_LOADXINPUT_ERR } Win32_LoadXInputResult;
+internal bool
+Win32_ReadWaveStream(void *stream, void *destination, usize frameCount) {
+    WaveStreamRead((WaveStream *)stream, destination, frameCount);
+    return !WaveStreamIsFinished((WaveStream *)stream);
+}
 
-internal Win32_LoadXInputResult
-Win32_LoadXInput(void) {
-    // TODO(ilya.a): Handle different versions of xinput. Check for newer. If
-    // fails, use older one. [2024/05/24]
-    HMODULE library = LoadLibrary(WIN32_XINPUT_DLL);
+/*
+ * IMA-ADPCM file is small enough to be kept whole, so it's mapped instead of streamed and stays
+ * compressed: mixer decodes it as it plays.
+ */
+internal bool
+Win32_PlayCompressedMusic(cstr8 path, IOFileMapping *mappingOut) {
+    WaveAsset wave;
 
-    if (library == NULL) {
-        return WIN32_LOADXINPUT_ERR;
+    if (IOMapFile(path, mappingOut, IO_ACCESS_SEQUENTIAL | IO_ACCESS_WILLNEED) != IO_OK) {
+        return false;
     }
 
-    Win32_xInputGetStatePtr = (Win32_XInputGetStateType *)GetProcAddress(library, WIN32_XINPUTGETSTATE_PROCNAME);
-
-    Win32_xInputSetStatePtr = (Win32_XInputSetStateType *)GetProcAddress(library, WIN32_XINPUTSETSTATE_PROCNAME);
+    if (WaveAssetLoadFromMemory(mappingOut->Data, mappingOut->Size, &wave) != WAVEASSET_LOAD_OK) {
+        IOUnmapFile(mappingOut);
+        return false;
+    }
 
-    if (Win32_xInputSetStatePtr == NULL || Win32_xInputGetStatePtr == NULL) {
-        return WIN32_LOADXINPUT_ERR;
+    const WaveFileHeader *format = &wave.Header;
+
+    MixerVoiceDesc voice = {0};
+    voice.Samples = wave.Data;
+    voice.FrameCount = ADPCMGetFrameCount(format->DataSize, format->BytePerBloc, format->NumberOfChannels);
+    voice.ADPCMBlockSize = format->BytePerBloc;
+    voice.ChannelCount = format->NumberOfChannels;
+    voice.SampleRate = format->FreqHZ;
+    voice.IsLooping = true;
+    voice.Volume = 1.0f;
+    voice.Bus = PLATFORM_AUDIO_MUSIC_BUS;
+
+    if (AudioSystemPlay(gAudio, &voice) == AUDIO_VOICE_INVALID) {
+        IOUnmapFile(mappingOut);
+        return false;
     }
 
-    return WIN32_LOADXINPUT_OK;
+    return true;
 }
 
-#define WIN32_DSOUND_DLL "dsound.dll"
-#define WIN32_DIRECTSOUNDCREATE_PROCNAME "DirectSoundCreate"
-
-typedef enum { WIN32_INITDSOUND_OK, WIN32_INITDSOUND_ERR, WIN32_INITDSOUND_DLL_LOAD } Win32_InitDSoundResult;
-
 /*
- * Loads DirectrSound library and initializes it.
- *
- * NOTE(ilya.a): They say, that DirectSound is superseeded by WASAPI. [2024/05/25]
- * TODO(ilya.a): Check this out. [2024/05/25]
+ * Starts looping playback of wave file. File's sample format and rate are converted by the mixer.
  */
-internal Win32_InitDSoundResult
-Win32_InitDSound(HWND window, i32 samplesPerSecond, usize bufferSize) {
-    HMODULE library = LoadLibrary(WIN32_DSOUND_DLL);
-
-    if (library == NULL) {
-        return WIN32_INITDSOUND_DLL_LOAD;
+internal bool
+Win32_PlayMusic(IOQueue *queue, cstr8 path, WaveStream *musicOut, IOFileMapping *mappingOut) {
+    if (CStr8IsEmpty(path) || WaveStreamOpen(queue, path, true, musicOut) != WAVE_STREAM_OK) {
+        return false;
     }
 
-    Win32_DirectSoundCreatePtr =
-        (Win32_DirectSoundCreateType *)GetProcAddress(library, WIN32_DIRECTSOUNDCREATE_PROCNAME);
+    const WaveFileHeader *format = &musicOut->Header;
+    PCMFormat sampleFormat = PCM_FORMAT_I16;
 
-    if (Win32_DirectSoundCreatePtr == NULL) {
-        return WIN32_INITDSOUND_DLL_LOAD;
+    if (format->AudioFormat == WAVEFILE_AUDIOFORMAT_IMA_ADPCM) {
+        WaveStreamClose(musicOut);
+        return Win32_PlayCompressedMusic(path, mappingOut);
     }
 
-    LPDIRECTSOUND directSound;
-    if (!SUCCEEDED(Win32_DirectSoundCreatePtr(0, &directSound, NULL))) {
-        return WIN32_INITDSOUND_ERR;
+    if (!PCMFormatFromWave(format->AudioFormat, format->BitsPerSample, &sampleFormat) ||
+        format->NumberOfChannels > MIXER_CHANNEL_COUNT) {
+        WaveStreamClose(musicOut);
+        return false;
     }
 
-    if (!SUCCEEDED(VCALL(directSound, SetCooperativeLevel, window, DSSCL_PRIORITY))) {
-        return WIN32_INITDSOUND_ERR;
-    }
+    MixerVoiceDesc voice = {0};
+    voice.Format = sampleFormat;
+    voice.ChannelCount = format->NumberOfChannels;
+    voice.SampleRate = format->FreqHZ;
+    voice.Read = Win32_ReadWaveStream;
+    voice.ReadData = musicOut;
+    voice.Volume = 1.0f;
+    voice.Bus = PLATFORM_AUDIO_MUSIC_BUS;
+
+    return AudioSystemPlay(gAudio, &voice) != AUDIO_VOICE_INVALID;
+}
+
+/*
+ * Cuts the next argument out of command line in place. Argument with spaces comes in quotes.
+ * Returns empty string, once arguments are over.
+ */
+internal cstr8
+Win32_NextArgument(LPSTR *commandLine) {
+    char8 *cursor = *commandLine;
 
-    // NOTE(ilya.a): Primary buffer -- buffer which is only holds handle to
-    // sound card. Windows has strange API. [2024/05/25]
-    DSBUFFERDESC primaryBufferDesc;
-    MemoryZero(&primaryBufferDesc, sizeof(primaryBufferDesc)); // TODO(ilya.a): Checkout if we really need
-                                                               // to zero buffer description. [2024/05/25]
+    while (*cursor == ' ' || *cursor == '\t') {
+        ++cursor;
+    }
 
-    primaryBufferDesc.dwSize = sizeof(primaryBufferDesc);
-    primaryBufferDesc.dwFlags = DSBCAPS_PRIMARYBUFFER;
-    primaryBufferDesc.dwBufferBytes = 0;  // NOTE(ilya.a): Primary buffer size should be zero. [2024/05/25]
-    primaryBufferDesc.lpwfxFormat = NULL; // NOTE(ilya.a): Primary buffer wfx format should be NULL. [2024/05/25]
+    char8 *argument = cursor;
+    bool isQuoted = *cursor == '"';
 
-    LPDIRECTSOUNDBUFFER primaryBuffer;
-    if (!SUCCEEDED(VCALL(directSound, CreateSoundBuffer, &primaryBufferDesc, &primaryBuffer, NULL))) {
-        return WIN32_INITDSOUND_ERR;
+    if (isQuoted) {
+        argument = ++cursor;
     }
 
-    WAVEFORMATEX waveFormat;
-    waveFormat.wFormatTag = WAVE_FORMAT_PCM;
-    waveFormat.nChannels = 2;
-    waveFormat.nSamplesPerSec = samplesPerSecond;
-    waveFormat.wBitsPerSample = 16;
-    waveFormat.nBlockAlign = (waveFormat.nChannels * waveFormat.wBitsPerSample) / BYTE_BITS;
-    waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign; // NOTE(ilya.a): Redundant. Lol.
-    waveFormat.cbSize = 0;
-
-    if (!SUCCEEDED(VCALL(primaryBuffer, SetFormat, &waveFormat))) {
-        return WIN32_INITDSOUND_ERR;
+    while (*cursor != '\0' && (isQuoted ? *cursor != '"' : *cursor != ' ' && *cursor != '\t')) {
+        ++cursor;
     }
 
-    // NOTE(ilya.a): Actual sound buffer in which we will write data. [2024/05/25]
-    DSBUFFERDESC secondaryBufferDesc;
-    MemoryZero(&secondaryBufferDesc, sizeof(secondaryBufferDesc)); // TODO(ilya.a): Checkout if we really need
-                                                                   // to zero buffer description. [2024/05/25]
-    secondaryBufferDesc.dwSize = sizeof(secondaryBufferDesc);
-    secondaryBufferDesc.dwFlags = 0;
-    secondaryBufferDesc.dwBufferBytes = bufferSize;
-    secondaryBufferDesc.lpwfxFormat = &waveFormat;
-
-    if (!SUCCEEDED(VCALL(directSound, CreateSoundBuffer, &secondaryBufferDesc, &g_Win32_AudioBuffer, NULL))) {
-        return WIN32_INITDSOUND_ERR;
+    if (*cursor != '\0') {
+        *cursor++ = '\0';
     }
 
-    return WIN32_INITDSOUND_OK;
+    *commandLine = cursor;
+    return argument;
 }
 
-typedef struct {
-    u32 runningSampleIndex;
-    u32 toneHZ;
-    i32 samplesPerSecond;
-    i32 toneVolume;
-    i32 wavePeriod;
-    usize bytesPerSample;
-    usize audioBufferSize;
-
-    i32 latencySampleCount;
-} Win32_SoundOutput;
-
-internal Win32_SoundOutput
-Win32_SoundOutputMake(void) {
-    Win32_SoundOutput ret = {0};
-    ret.samplesPerSecond = 48000;
-    ret.runningSampleIndex = 0;
-    ret.toneHZ = 256;
-    ret.toneVolume = 1000;
-
-    ret.wavePeriod = ret.samplesPerSecond / ret.toneHZ;
-    ret.bytesPerSample = sizeof(i16) * 2;
-    ret.audioBufferSize = ret.samplesPerSecond * ret.bytesPerSample;
-
-    ret.latencySampleCount = ret.samplesPerSecond / 15;
-    return ret;
-}
+internal void
+Win32_PrintChecksum(cstr8 message, const GameState *game) {
+    u64 checksum = GameGetChecksum(game);
 
-internal procedure
-Win32_SoundOutputSetTone(Win32_SoundOutput *soundOutput, i32 toneHZ) {
-    soundOutput->toneHZ = toneHZ;
-    soundOutput->wavePeriod = soundOutput->samplesPerSecond / soundOutput->toneHZ;
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintf(
+        printBuffer, "I: %s after %u frames, checksum %08x%08x\n", message, (u32)game->Frame, (u32)(checksum >> 32),
+        (u32)checksum);
+    OutputDebugString(printBuffer);
 }
 
-internal procedure
-Win32_FillSoundBuffer(Win32_SoundOutput *soundOutput, DWORD byteToLock, DWORD bytesToWrite) {
-    VOID *region1, *region2;
-    usize region1Size, region2Size;
-
-    // TODO(ilya.a): Check why it's failed to lock buffer. Sound is nice, but lock are failing [2024/07/28]
-    VCALL(g_Win32_AudioBuffer, Lock, byteToLock, bytesToWrite, &region1, &region1Size, &region2, &region2Size, 0);
-
-    DWORD region1SampleCount = region1Size / soundOutput->bytesPerSample;
-    i16 *sampleOut = (i16 *)region1;
-    for (u32 sampleIndex = 0; sampleIndex < region1SampleCount; ++sampleIndex) {
-        f32 sinePosition = 2.0f * PI32 * (f32)soundOutput->runningSampleIndex / (f32)soundOutput->wavePeriod;
-        f32 sineValue = sinf(sinePosition);
-        i16 sampleValue = (i16)(sineValue * soundOutput->toneVolume);
-        *sampleOut++ = sampleValue;
-        *sampleOut++ = sampleValue;
-        ++soundOutput->runningSampleIndex;
+internal bool
+Win32_GetInput(Platform *platform, u64 frame, InputSnapshot *snapshotOut) {
+    Win32_Platform *win32 = (Win32_Platform *)platform;
+
+    if (win32->IsReplaying) {
+        if (!InputPlaybackNext(&win32->Playback, snapshotOut)) {
+            return false;
+        }
+    } else {
+        InputPollerGetSnapshot(&win32->Poller, snapshotOut);
     }
 
-    DWORD region2SampleCount = region2Size / soundOutput->bytesPerSample;
-    sampleOut = (i16 *)region2;
-    for (u32 sampleIndex = 0; sampleIndex < region2SampleCount; ++sampleIndex) {
-        f32 sinePosition = 2.0f * PI32 * (f32)soundOutput->runningSampleIndex / (f32)soundOutput->wavePeriod;
-        f32 sineValue = sinf(sinePosition);
-        i16 sampleValue = (i16)(sineValue * soundOutput->toneVolume);
-        *sampleOut++ = sampleValue;
-        *sampleOut++ = sampleValue;
-        ++soundOutput->runningSampleIndex;
+    snapshotOut->Frame = frame;
+    InputRingPush(&win32->History, snapshotOut);
+
+    if (win32->IsRecording && InputRecorderUpdate(&win32->Recorder, &win32->History) != INPUT_OK) {
+        OutputDebugString("E: Failed to write input recording, recording is stopped!\n");
+        InputRecorderClose(&win32->Recorder, &win32->History);
+        win32->IsRecording = false;
     }
 
-    // TODO(ilya.a): Check for succeed. [2024/05/25]
-    ASSERT_VCALL(g_Win32_AudioBuffer, Unlock, region1, region1Size, region2, region2Size);
+    return true;
+}
+
+internal void
+Win32_Present(Platform *platform) {
+    Win32_Platform *win32 = (Win32_Platform *)platform;
+    Win32_BMRWindowPresent(&win32->Window, &platform->Renderer);
 }
 
 LRESULT CALLBACK
@@ -309,14 +291,47 @@ Win32_MainWindowProc(HWND window, UINT message, WPARAM wParam, LPARAM lParam) {
 
 int WINAPI
 WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR commandLine, _In_ int showMode) {
-    UNUSED(commandLine);
     UNUSED(showMode);
     UNUSED(prevInstance);
 
-    switch (Win32_LoadXInput()) {
-    case (WIN32_LOADXINPUT_OK): {
+    Sys_Init();
+
+    // NOTE(ilya.a): gfs [-record <path> | -replay <path>] [music.wav] [2026/10/18]
+    cstr8 recordPath = NULL;
+    cstr8 replayPath = NULL;
+    cstr8 musicPath = "";
+
+    for (cstr8 argument = Win32_NextArgument(&commandLine); !CStr8IsEmpty(argument);
+         argument = Win32_NextArgument(&commandLine)) {
+        if (CStr8IsEqual(argument, "-record")) {
+            recordPath = Win32_NextArgument(&commandLine);
+        } else if (CStr8IsEqual(argument, "-replay")) {
+            replayPath = Win32_NextArgument(&commandLine);
+        } else {
+            musicPath = argument;
+        }
+    }
+
+    Win32_Platform *platform = &gPlatform;
+    platform->Platform.GetInput = Win32_GetInput;
+    platform->Platform.Present = Win32_Present;
+    platform->IsRecording = recordPath != NULL && InputRecorderOpen(&platform->Recorder, recordPath) == INPUT_OK;
+    platform->IsReplaying = replayPath != NULL && InputPlaybackOpen(&platform->Playback, replayPath) == INPUT_OK;
+
+    if ((recordPath != NULL && !platform->IsRecording) || (replayPath != NULL && !platform->IsReplaying)) {
+        OutputDebugString("E: Failed to open input recording!\n");
+        return 0;
+    }
+
+    GameInit(&gGame);
+    gPreviousGame = gGame;
+
+    Win32_XInputDevice controllerDevice;
+
+    switch (Win32_XInputDeviceInit(&controllerDevice)) {
+    case (WIN32_INITXINPUT_OK): {
     } break;
-    case (WIN32_LOADXINPUT_ERR): {
+    case (WIN32_INITXINPUT_DLL_LOAD): {
         OutputDebugString("E: Failed to load XInput functions!\n");
         return 0;
     } break;
@@ -324,6 +339,12 @@ WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR com
     } break;
     }
 
+    InputPollerInit(&platform->Poller, &controllerDevice.Device, CONTROLLER_POLL_HZ);
+
+    if (!platform->IsReplaying) {
+        ASSERT_NONZERO(InputPollerStart(&platform->Poller));
+    }
+
     persist_var LPCSTR CLASS_NAME = "GFS";
     persist_var LPCSTR WINDOW_TITLE = "GFS";
 
@@ -347,28 +368,35 @@ WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR com
 
     ShowWindow(window, showMode);
 
-    gRenderer = BMR_Init(COLOR_WHITE, window);
-    BMR_Resize(&gRenderer, 900, 600);
+    platform->Platform.Renderer = BMR_Init(COLOR_WHITE);
+    platform->Window = Win32_BMRWindowInit(window);
+    Win32_BMRWindowResize(&platform->Window, &platform->Platform.Renderer, 900, 600);
+
+    Win32_DSoundDevice soundDevice;
+    AudioNullDevice nullSoundDevice;
+    AudioDevice *audioDevice = &soundDevice.Device;
+
+    if (Win32_DSoundDeviceInit(&soundDevice, window, SOUND_SAMPLES_PER_SECOND, SOUND_LATENCY_FRAMES) !=
+        WIN32_INITDSOUND_OK) {
+        OutputDebugString("W: Failed to initialize DirectSound, playing into nowhere.\n");
+        AudioNullDeviceInit(&nullSoundDevice, SOUND_SAMPLES_PER_SECOND, SOUND_LATENCY_FRAMES);
+        audioDevice = &nullSoundDevice.Sim.Device;
+    }
 
-    Win32_SoundOutput soundOutput = Win32_SoundOutputMake();
-    Win32_InitDSoundResult initDSoundResult =
-        Win32_InitDSound(window, soundOutput.samplesPerSecond, soundOutput.audioBufferSize);
-    ASSERT_EQ(initDSoundResult, WIN32_INITDSOUND_OK);
+    gAudio = AudioSystemMake(audioDevice, RESAMPLE_QUALITY_MEDIUM);
+    ASSERT_NONNULL(gAudio);
+    PlatformAudioInit(&platform->Platform.Audio, gAudio);
 
-    Win32_FillSoundBuffer(
-        &soundOutput, 0, soundOutput.latencySampleCount * soundOutput.bytesPerSample /* soundOutput.audioBufferSize */);
-    ASSERT_VCALL(g_Win32_AudioBuffer, Play, 0, 0, DSBPLAY_LOOPING);
+    IOQueue *ioQueue = IOQueueMake(1);
+    ASSERT_NONNULL(ioQueue);
 
-    u32 xOffset = 0;
-    u32 yOffset = 0;
+    WaveStream music = {0};
+    IOFileMapping musicMapping = {0};
+    bool isMusicPlaying = Win32_PlayMusic(ioQueue, musicPath, &music, &musicMapping);
 
-    gPlayer.Rect.X = PLAYER_INIT_X;
-    gPlayer.Rect.Y = PLAYER_INIT_Y;
-    gPlayer.Rect.Width = PLAYER_WIDTH;
-    gPlayer.Rect.Height = PLAYER_HEIGHT;
-    gPlayer.Color = Color4Add(COLOR_RED, COLOR_BLUE);
+    ASSERT_NONZERO(AudioSystemStart(gAudio));
 
-    gRenderer.ClearColor = COLOR_WHITE;
+    platform->Platform.Renderer.ClearColor = COLOR_WHITE;
 
     LARGE_INTEGER performanceCounterFrequency = {0};
     ASSERT_NONZERO(QueryPerformanceFrequency(&performanceCounterFrequency));
@@ -378,6 +406,9 @@ WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR com
 
     u64 lastCycleCount = __rdtsc();
 
+    Scheduler scheduler;
+    SchedulerInit(&scheduler, GAME_TICKS_PER_SECOND, FRAMES_PER_SECOND_TARGET, TICKS_PER_FRAME_MAX);
+
     /// BEGIN(MAINLOOP)
     while (!gShouldStop) {
         MSG message = {};
@@ -391,113 +422,15 @@ WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR com
             DispatchMessageA(&message);
         }
 
-        // TODO(ilya.a): Should we pool more frequently? [2024/05/19]
-        for (DWORD xControllerIndex = 0; xControllerIndex < XUSER_MAX_COUNT; ++xControllerIndex) {
-            XINPUT_STATE xInputState = {0};
-            DWORD result = Win32_xInputGetStatePtr(xControllerIndex, &xInputState);
-
-            if (result == ERROR_SUCCESS) {
-                XINPUT_GAMEPAD *pad = &xInputState.Gamepad;
-
-                bool aButton = pad->wButtons & XINPUT_GAMEPAD_A;
-                bool bButton = pad->wButtons & XINPUT_GAMEPAD_B;
-                bool xButton = pad->wButtons & XINPUT_GAMEPAD_X;
-                bool yButton = pad->wButtons & XINPUT_GAMEPAD_Y;
-
-                bool dPadUp = pad->wButtons & XINPUT_GAMEPAD_DPAD_UP;
-                bool dPadDown = pad->wButtons & XINPUT_GAMEPAD_DPAD_DOWN;
-                bool dPadLeft = pad->wButtons & XINPUT_GAMEPAD_DPAD_LEFT;
-                bool dPadRight = pad->wButtons & XINPUT_GAMEPAD_DPAD_RIGHT;
-
-                i16 leftStickX = pad->sThumbLX;
-                i16 leftStickY = pad->sThumbLY;
-                i16 rightStickX = pad->sThumbRX;
-                i16 rightStickY = pad->sThumbRY;
-
-                // TODO(ilya.a): Handle deadzone propery, using XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE and
-                // XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE [2024/08/11]
-                xOffset += leftStickX / 4096;
-                yOffset += leftStickY / 4096;
-
-                gPlayer.Input.RightPressed = dPadRight;
-                gPlayer.Input.LeftPressed = dPadLeft;
-
-                gPlayer.Input.UpPressed = dPadUp;
-                gPlayer.Input.DownPressed = dPadDown;
-
-                Win32_SoundOutputSetTone(&soundOutput, (i32)(256.0f * ((f32)leftStickY / 30000.0f)) + 512);
-
-                XINPUT_VIBRATION vibrationState = {0};
-
-                if (gPlayer.Input.RightPressed || gPlayer.Input.LeftPressed || gPlayer.Input.UpPressed ||
-                    gPlayer.Input.DownPressed) {
-#if 0
-                    vibrationState.wLeftMotorSpeed = 60000;
-                    vibrationState.wRightMotorSpeed = 60000;
-#endif
-                } else {
-                    vibrationState.wLeftMotorSpeed = 0;
-                    vibrationState.wRightMotorSpeed = 0;
-                }
-
-                Win32_xInputSetStatePtr(xControllerIndex, &vibrationState);
-            } else if (result == ERROR_DEVICE_NOT_CONNECTED) {
-                // NOTE(ilya.a): Do nothing. I thought to log that.
-                // But it will be too frequent log, cause we have no plans on multiple controllers.
-            } else {
-                OutputDebugString("E: Some of xInput's device are not connected!\n");
-                return 0;
-            }
-        }
-
-        if (gPlayer.Input.LeftPressed) {
-            gPlayer.Rect.X -= PLAYER_SPEED;
-        }
-
-        if (gPlayer.Input.RightPressed) {
-            gPlayer.Rect.X += PLAYER_SPEED;
-        }
-
-        if (gPlayer.Input.DownPressed) {
-            gPlayer.Rect.Y -= PLAYER_SPEED;
-        }
-
-        if (gPlayer.Input.UpPressed) {
-            gPlayer.Rect.Y += PLAYER_SPEED;
-        }
-
-        BMR_BeginDrawing(&gRenderer);
+        PlatformFrameTimings timings;
+        u32 tickCount = SchedulerBeginFrame(&scheduler);
+        f32 alpha = SchedulerGetAlpha(&scheduler);
 
-        BMR_Clear(&gRenderer);
-        BMR_DrawGrad(&gRenderer, xOffset, yOffset);
-        BMR_DrawRectR(&gRenderer, gPlayer.Rect, gPlayer.Color);
-        BMR_DrawLine(&gRenderer, 100, 200, 500, 600);
-
-        DWORD playCursor;
-        DWORD writeCursor;
-
-        if (SUCCEEDED(VCALL(g_Win32_AudioBuffer, GetCurrentPosition, &playCursor, &writeCursor))) {
-            DWORD byteToLock =
-                (soundOutput.runningSampleIndex * soundOutput.bytesPerSample) % soundOutput.audioBufferSize;
-            DWORD targetCursor = (playCursor + (soundOutput.latencySampleCount * soundOutput.bytesPerSample)) %
-                                 soundOutput.audioBufferSize;
-            DWORD bytesToWrite = 0;
-
-            if (byteToLock > targetCursor) {
-                bytesToWrite = soundOutput.audioBufferSize - byteToLock;
-                bytesToWrite += targetCursor;
-            } else {
-                bytesToWrite = targetCursor - byteToLock;
-            }
-
-            Win32_FillSoundBuffer(&soundOutput, byteToLock, bytesToWrite);
+        if (!PlatformRunFrame(&platform->Platform, &gGame, &gPreviousGame, tickCount, alpha, &timings)) {
+            Win32_PrintChecksum("Replay is over", &gGame);
+            break;
         }
 
-        BMR_EndDrawing(&gRenderer);
-
-        xOffset++;
-        yOffset++;
-
         {
             u64 endCycleCount = __rdtsc();
 
@@ -511,18 +444,77 @@ WinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPSTR com
             u64 msPerFrame = (1000 * counterElapsed) / performanceCounterFrequency.QuadPart;
             u64 framesPerSeconds = performanceCounterFrequency.QuadPart / counterElapsed;
             u64 megaCyclesPerFrame = cyclesElapsed / (1000 * 1000);
+            u64 counterFrequency = (u64)performanceCounterFrequency.QuadPart;
+            u64 updateMicroseconds = timings.Elapsed[PLATFORM_STAGE_UPDATE] * 1000000 / counterFrequency;
+            u64 renderMicroseconds = timings.Elapsed[PLATFORM_STAGE_RENDER] * 1000000 / counterFrequency;
+
+            // NOTE(ilya.a): Telemetry is read while audio thread writes it, but it's only for display. [2026/10/18]
+            const AudioTelemetry *audioTelemetry = &gAudio->Telemetry;
+            u32 audioMarginP1 = AudioTelemetryGetMarginPercentile(audioTelemetry, 0.01f);
 
             char8 printBuffer[KILOBYTES(1)];
-            wsprintf(printBuffer, "%ums/f | %uf/s | %umc/f\n", msPerFrame, framesPerSeconds, megaCyclesPerFrame);
+            wsprintf(
+                printBuffer,
+                "%ums/f | %uf/s | %umc/f | update %uus, render %uus | audio p1 %uus, %u underruns, %u near misses\n",
+                (u32)msPerFrame, (u32)framesPerSeconds, (u32)megaCyclesPerFrame, (u32)updateMicroseconds,
+                (u32)renderMicroseconds, audioMarginP1, (u32)audioTelemetry->UnderrunCount,
+                (u32)audioTelemetry->NearMissCount);
             OutputDebugString(printBuffer);
             lastCounter = endCounter;
             lastCycleCount = endCycleCount;
         }
+
+        // NOTE(ilya.a): Jitter is summed up once a second, per frame it would be just noise. [2026/10/18]
+        if (scheduler.Stats.FrameJitter.Count >= FRAMES_PER_SECOND_TARGET) {
+            const SchedulerStats *stats = &scheduler.Stats;
+            u64 tickCountTotal = stats->TickLateness.Count;
+            u64 tickLatenessMean = tickCountTotal > 0 ? stats->TickLateness.Sum / tickCountTotal : 0;
+            u64 frameJitterMean = stats->FrameJitter.Sum / stats->FrameJitter.Count;
+
+            char8 printBuffer[KILOBYTES(1)];
+            wsprintf(
+                printBuffer, "I: tick lateness mean %uus, max %uus | frame jitter mean %uus, max %uus | %u dropped\n",
+                (u32)SchedulerGetMicroseconds(&scheduler, tickLatenessMean),
+                (u32)SchedulerGetMicroseconds(&scheduler, stats->TickLateness.Max),
+                (u32)SchedulerGetMicroseconds(&scheduler, frameJitterMean),
+                (u32)SchedulerGetMicroseconds(&scheduler, stats->FrameJitter.Max), (u32)stats->DroppedTicks);
+            OutputDebugString(printBuffer);
+            SchedulerResetStats(&scheduler);
+        }
+
+        SchedulerWaitForFrame(&scheduler);
     }
 
     /// END(MAINLOOP)
 
-    BMR_DeInit(&gRenderer);
+    SchedulerDeInit(&scheduler);
+
+    InputPollerStop(&platform->Poller);
+
+    if (platform->IsRecording) {
+        InputRecorderClose(&platform->Recorder, &platform->History);
+        Win32_PrintChecksum("Recording is over", &gGame);
+    }
+
+    if (platform->IsReplaying) {
+        InputPlaybackClose(&platform->Playback);
+    }
+
+    Win32_BMRWindowDeInit(&platform->Window);
+    BMR_DeInit(&platform->Platform.Renderer);
+
+    // NOTE(ilya.a): Audio thread reads music stream, so it goes down first. [2026/10/18]
+    AudioSystemDestroy(gAudio);
+    if (audioDevice == &soundDevice.Device) {
+        Win32_DSoundDeviceDeInit(&soundDevice);
+    }
+
+    if (musicMapping.Data != NULL) {
+        IOUnmapFile(&musicMapping);
+    } else if (isMusicPlaying) {
+        WaveStreamClose(&music);
+    }
+    IOQueueDestroy(ioQueue);
 
     return 0;
 }
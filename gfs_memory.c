@@ -7,6 +7,7 @@
 #include "gfs_memory.h"
 
 #include <Windows.h>
+#include <intrin.h>
 
 #include "gfs_types.h"
 #include "gfs_sys.h"
@@ -71,7 +72,7 @@ MemoryCopy(void *destination, const void *source, usize size) {
 void
 MemorySet(void *data, byte value, usize size) {
     if (size % 4 == 0) {
-        for (usize i = 0; i < size / 4; i += 4) {
+        for (usize i = 0; i < size; i += 4) {
             ((byte *)data)[i] = value;
             ((byte *)data)[i + 1] = value;
             ((byte *)data)[i + 2] = value;
@@ -180,3 +181,385 @@ BlockAllocatorFree(BlockAllocator *allocator) {
 
     allocator->Head = NULL;
 }
+
+/*
+ * TLSF Allocator.
+ */
+#define TLSF_BLOCK_FREE_BIT ((usize)1)
+#define TLSF_BLOCK_PREV_FREE_BIT ((usize)2)
+#define TLSF_BLOCK_FLAGS_MASK (TLSF_BLOCK_FREE_BIT | TLSF_BLOCK_PREV_FREE_BIT)
+
+#define TLSF_BLOCK_OVERHEAD (2 * sizeof(void *))                       // PrevPhysical + Size.
+#define TLSF_BLOCK_SIZE_MIN (sizeof(TLSFBlock) - TLSF_BLOCK_OVERHEAD) // Room for free list links.
+#define TLSF_BLOCK_SIZE_MAX ((usize)1 << TLSF_FL_INDEX_MAX)
+#define TLSF_SMALL_BLOCK_SIZE ((usize)1 << TLSF_FL_INDEX_SHIFT)
+
+GFS_STATIC_ASSERT(TLSF_BLOCK_OVERHEAD % TLSF_ALIGN_SIZE == 0);
+GFS_STATIC_ASSERT(TLSF_FL_INDEX_COUNT <= 64);
+GFS_STATIC_ASSERT(TLSF_SL_INDEX_COUNT <= 32);
+
+#define TLSF_ALIGN_UP(X) (((X) + (TLSF_ALIGN_SIZE - 1)) & ~((usize)TLSF_ALIGN_SIZE - 1))
+
+internal u32
+TLSF_FindLastSet(usize value) {
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return (u32)index;
+}
+
+internal u32
+TLSF_FindFirstSet(u64 value) {
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return (u32)index;
+}
+
+internal usize
+TLSF_BlockGetSize(const TLSFBlock *block) {
+    return block->Size & ~TLSF_BLOCK_FLAGS_MASK;
+}
+
+internal void
+TLSF_BlockSetSize(TLSFBlock *block, usize size) {
+    block->Size = size | (block->Size & TLSF_BLOCK_FLAGS_MASK);
+}
+
+internal bool
+TLSF_BlockIsFree(const TLSFBlock *block) {
+    return (block->Size & TLSF_BLOCK_FREE_BIT) != 0;
+}
+
+internal bool
+TLSF_BlockIsPrevFree(const TLSFBlock *block) {
+    return (block->Size & TLSF_BLOCK_PREV_FREE_BIT) != 0;
+}
+
+internal void *
+TLSF_BlockToPayload(TLSFBlock *block) {
+    return (byte *)block + TLSF_BLOCK_OVERHEAD;
+}
+
+internal TLSFBlock *
+TLSF_PayloadToBlock(void *data) {
+    return (TLSFBlock *)((byte *)data - TLSF_BLOCK_OVERHEAD);
+}
+
+internal TLSFBlock *
+TLSF_BlockGetNext(TLSFBlock *block) {
+    return (TLSFBlock *)((byte *)TLSF_BlockToPayload(block) + TLSF_BlockGetSize(block));
+}
+
+/*
+ * Marks `block` as free or used and updates flag of the next physical block accordingly.
+ */
+internal void
+TLSF_BlockMark(TLSFBlock *block, bool isFree) {
+    TLSFBlock *next = TLSF_BlockGetNext(block);
+
+    if (isFree) {
+        block->Size |= TLSF_BLOCK_FREE_BIT;
+        next->PrevPhysical = block;
+        next->Size |= TLSF_BLOCK_PREV_FREE_BIT;
+    } else {
+        block->Size &= ~TLSF_BLOCK_FREE_BIT;
+        next->Size &= ~TLSF_BLOCK_PREV_FREE_BIT;
+    }
+}
+
+internal void
+TLSF_MappingInsert(usize size, u32 *flOut, u32 *slOut) {
+    u32 fl, sl;
+
+    if (size < TLSF_SMALL_BLOCK_SIZE) {
+        fl = 0;
+        sl = (u32)(size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+    } else {
+        fl = TLSF_FindLastSet(size);
+        sl = (u32)(size >> (fl - TLSF_SL_INDEX_COUNT_LOG2)) ^ (1 << TLSF_SL_INDEX_COUNT_LOG2);
+        fl -= TLSF_FL_INDEX_SHIFT - 1;
+    }
+
+    *flOut = fl;
+    *slOut = sl;
+}
+
+/*
+ * Same as `TLSF_MappingInsert`, but rounds size up to the next list, so any block
+ * found in there is guaranteed to fit without walking the list.
+ */
+internal void
+TLSF_MappingSearch(usize size, u32 *flOut, u32 *slOut) {
+    if (size >= TLSF_SMALL_BLOCK_SIZE) {
+        size += ((usize)1 << (TLSF_FindLastSet(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    TLSF_MappingInsert(size, flOut, slOut);
+}
+
+internal void
+TLSF_InsertFreeBlock(TLSFControl *control, TLSFBlock *block) {
+    u32 fl, sl;
+    TLSF_MappingInsert(TLSF_BlockGetSize(block), &fl, &sl);
+
+    TLSFBlock *head = control->Blocks[fl][sl];
+    block->NextFree = head;
+    block->PrevFree = NULL;
+    if (head != NULL) {
+        head->PrevFree = block;
+    }
+
+    control->Blocks[fl][sl] = block;
+    control->FLBitmap |= (u64)1 << fl;
+    control->SLBitmap[fl] |= (u32)1 << sl;
+
+    control->FreeBytes += TLSF_BlockGetSize(block);
+    control->FreeBlockCount += 1;
+}
+
+internal void
+TLSF_RemoveFreeBlock(TLSFControl *control, TLSFBlock *block) {
+    u32 fl, sl;
+    TLSF_MappingInsert(TLSF_BlockGetSize(block), &fl, &sl);
+
+    if (block->PrevFree != NULL) {
+        block->PrevFree->NextFree = block->NextFree;
+    }
+
+    if (block->NextFree != NULL) {
+        block->NextFree->PrevFree = block->PrevFree;
+    }
+
+    if (control->Blocks[fl][sl] == block) {
+        control->Blocks[fl][sl] = block->NextFree;
+
+        if (block->NextFree == NULL) {
+            control->SLBitmap[fl] &= ~((u32)1 << sl);
+
+            if (control->SLBitmap[fl] == 0) {
+                control->FLBitmap &= ~((u64)1 << fl);
+            }
+        }
+    }
+
+    control->FreeBytes -= TLSF_BlockGetSize(block);
+    control->FreeBlockCount -= 1;
+}
+
+internal TLSFBlock *
+TLSF_FindSuitableBlock(TLSFControl *control, u32 fl, u32 sl) {
+    if (fl >= TLSF_FL_INDEX_COUNT) {
+        return NULL;
+    }
+
+    u32 slMap = control->SLBitmap[fl] & (~(u32)0 << sl);
+
+    if (slMap == 0) {
+        u64 flMap = fl + 1 < 64 ? control->FLBitmap & (~(u64)0 << (fl + 1)) : 0;
+
+        if (flMap == 0) {
+            return NULL;
+        }
+
+        fl = TLSF_FindFirstSet(flMap);
+        slMap = control->SLBitmap[fl];
+    }
+
+    sl = TLSF_FindFirstSet(slMap);
+    return control->Blocks[fl][sl];
+}
+
+/*
+ * Splits tail of the free `block` off, if it is big enough to hold another block.
+ * Returned remainder is already marked free and inserted into free lists.
+ */
+internal void
+TLSF_BlockTrim(TLSFControl *control, TLSFBlock *block, usize size) {
+    usize blockSize = TLSF_BlockGetSize(block);
+
+    if (blockSize < size + TLSF_BLOCK_OVERHEAD + TLSF_BLOCK_SIZE_MIN) {
+        return;
+    }
+
+    TLSF_BlockSetSize(block, size);
+
+    TLSFBlock *remainder = TLSF_BlockGetNext(block);
+    remainder->Size = blockSize - size - TLSF_BLOCK_OVERHEAD;
+
+    TLSF_BlockMark(remainder, true);
+    TLSF_InsertFreeBlock(control, remainder);
+}
+
+TLSFAllocator
+TLSFAllocatorMake(usize size) {
+    TLSFAllocator allocator = {0};
+
+    if (size == 0 || size >= TLSF_BLOCK_SIZE_MAX) {
+        return allocator;
+    }
+
+    usize poolOffset = TLSF_ALIGN_UP(sizeof(TLSFControl));
+    usize poolSize = TLSF_ALIGN_UP(size) + 2 * TLSF_BLOCK_OVERHEAD;
+    usize bytesAllocated = Align2PageSize(sizeof(TLSFControl) + poolSize);
+    usize poolCapacity = (bytesAllocated - poolOffset) & ~((usize)TLSF_ALIGN_SIZE - 1);
+
+    // NOTE(ilya.a): Page rounding makes the pool block bigger than asked, and block of
+    // `TLSF_BLOCK_SIZE_MAX` or more maps past the last first-level list. [2026/10/18]
+    if (poolCapacity - 2 * TLSF_BLOCK_OVERHEAD >= TLSF_BLOCK_SIZE_MAX) {
+        return allocator;
+    }
+
+    void *data = VirtualAlloc(NULL, bytesAllocated, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (data == NULL) {
+        return allocator;
+    }
+
+    // NOTE(ilya.a): VirtualAlloc gives zeroed pages, so control structure is already
+    // in the empty state. [2026/10/18]
+    TLSFControl *control = (TLSFControl *)data;
+    byte *pool = (byte *)data + poolOffset;
+
+    // NOTE(ilya.a): Pool is one big free block followed by zero-sized used sentinel,
+    // so `TLSF_BlockGetNext` never walks out of the region. [2026/10/18]
+    TLSFBlock *block = (TLSFBlock *)pool;
+    block->PrevPhysical = NULL;
+    block->Size = poolCapacity - 2 * TLSF_BLOCK_OVERHEAD;
+
+    TLSFBlock *sentinel = TLSF_BlockGetNext(block);
+    sentinel->Size = 0;
+
+    TLSF_BlockMark(block, true);
+    TLSF_InsertFreeBlock(control, block);
+
+    allocator.Data = data;
+    allocator.Capacity = TLSF_BlockGetSize(block);
+    allocator.Control = control;
+
+    return allocator;
+}
+
+void *
+TLSFAllocatorAlloc(TLSFAllocator *allocator, usize size) {
+    if (allocator == NULL || allocator->Control == NULL || size > allocator->Capacity) {
+        return NULL;
+    }
+
+    TLSFControl *control = allocator->Control;
+
+    // NOTE(ilya.a): Zero size gets the smallest block, so empty assets (e.g. wave with 0-byte
+    // `data` chunk) don't look like out of memory. [2026/10/18]
+    usize adjustedSize = TLSF_ALIGN_UP(size);
+    if (adjustedSize < TLSF_BLOCK_SIZE_MIN) {
+        adjustedSize = TLSF_BLOCK_SIZE_MIN;
+    }
+
+    u32 fl, sl;
+    TLSF_MappingSearch(adjustedSize, &fl, &sl);
+
+    TLSFBlock *block = TLSF_FindSuitableBlock(control, fl, sl);
+
+    if (block == NULL) {
+        return NULL;
+    }
+
+    TLSF_RemoveFreeBlock(control, block);
+    TLSF_BlockTrim(control, block, adjustedSize);
+    TLSF_BlockMark(block, false);
+
+    control->UsedBytes += TLSF_BlockGetSize(block);
+    control->UsedBlockCount += 1;
+
+    return TLSF_BlockToPayload(block);
+}
+
+void *
+TLSFAllocatorAllocZ(TLSFAllocator *allocator, usize size) {
+    void *data = TLSFAllocatorAlloc(allocator, size);
+
+    if (data != NULL) {
+        MemoryZero(data, size);
+    }
+
+    return data;
+}
+
+void
+TLSFAllocatorFree(TLSFAllocator *allocator, void *data) {
+    if (allocator == NULL || allocator->Control == NULL || data == NULL) {
+        return;
+    }
+
+    TLSFControl *control = allocator->Control;
+    TLSFBlock *block = TLSF_PayloadToBlock(data);
+
+    GFS_ASSERT(!TLSF_BlockIsFree(block));
+
+    control->UsedBytes -= TLSF_BlockGetSize(block);
+    control->UsedBlockCount -= 1;
+
+    if (TLSF_BlockIsPrevFree(block)) {
+        TLSFBlock *prev = block->PrevPhysical;
+        TLSF_RemoveFreeBlock(control, prev);
+        TLSF_BlockSetSize(prev, TLSF_BlockGetSize(prev) + TLSF_BLOCK_OVERHEAD + TLSF_BlockGetSize(block));
+        block = prev;
+    }
+
+    TLSFBlock *next = TLSF_BlockGetNext(block);
+
+    if (TLSF_BlockIsFree(next)) {
+        TLSF_RemoveFreeBlock(control, next);
+        TLSF_BlockSetSize(block, TLSF_BlockGetSize(block) + TLSF_BLOCK_OVERHEAD + TLSF_BlockGetSize(next));
+    }
+
+    TLSF_BlockMark(block, true);
+    TLSF_InsertFreeBlock(control, block);
+}
+
+TLSFAllocatorStats
+TLSFAllocatorGetStats(const TLSFAllocator *allocator) {
+    TLSFAllocatorStats stats = {0};
+
+    if (allocator == NULL || allocator->Control == NULL) {
+        return stats;
+    }
+
+    const TLSFControl *control = allocator->Control;
+
+    stats.Capacity = allocator->Capacity;
+    stats.UsedBytes = control->UsedBytes;
+    stats.FreeBytes = control->FreeBytes;
+    stats.UsedBlockCount = control->UsedBlockCount;
+    stats.FreeBlockCount = control->FreeBlockCount;
+
+    // NOTE(ilya.a): Largest free block lives in the highest non-empty list. Only that
+    // list is walked, not the whole heap. [2026/10/18]
+    if (control->FLBitmap != 0) {
+        u32 fl = TLSF_FindLastSet(control->FLBitmap);
+        u32 sl = TLSF_FindLastSet(control->SLBitmap[fl]);
+
+        for (const TLSFBlock *block = control->Blocks[fl][sl]; block != NULL; block = block->NextFree) {
+            usize blockSize = TLSF_BlockGetSize(block);
+            if (blockSize > stats.LargestFreeBlock) {
+                stats.LargestFreeBlock = blockSize;
+            }
+        }
+    }
+
+    if (stats.FreeBytes > 0) {
+        stats.Fragmentation = 1.0f - (f32)stats.LargestFreeBlock / (f32)stats.FreeBytes;
+    }
+
+    return stats;
+}
+
+void
+TLSFAllocatorDestroy(TLSFAllocator *allocator) {
+    if (allocator == NULL || allocator->Data == NULL) {
+        return;
+    }
+
+    VirtualFree(allocator->Data, 0, MEM_RELEASE);
+
+    allocator->Data = NULL;
+    allocator->Capacity = 0;
+    allocator->Control = NULL;
+}
@@ -58,4 +58,69 @@ void *BlockAllocatorAllocZ(BlockAllocator *allocator, usize size);
 
 void BlockAllocatorFree(BlockAllocator *allocator);
 
+/*
+ * TLSF Allocator.
+ *
+ * Two-Level Segregated Fit general purpose allocator, which runs over single reserved region.
+ * Allocation and free are O(1): free blocks are binned by size into `FL x SL` lists and
+ * non-empty lists are tracked in bitmaps. Neighbour free blocks are coalesced on free.
+ *
+ * Reference: M. Masmano et al. "TLSF: a New Dynamic Memory Allocator for Real-Time Systems".
+ */
+#define TLSF_ALIGN_SIZE_LOG2 4
+#define TLSF_ALIGN_SIZE (1 << TLSF_ALIGN_SIZE_LOG2)
+
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+
+#define TLSF_FL_INDEX_MAX 40 // NOTE(ilya.a): Up to 1 TiB per allocator, which is more than enough. [2026/10/18]
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+
+typedef struct TLSFBlock {
+    struct TLSFBlock *PrevPhysical; // Valid only if previous physical block is free.
+    usize Size;                     // Size of payload. Lower bits are used as flags.
+
+    // NOTE(ilya.a): Following fields are stored in payload, so only valid for free blocks. [2026/10/18]
+    struct TLSFBlock *NextFree;
+    struct TLSFBlock *PrevFree;
+} TLSFBlock;
+
+typedef struct {
+    u64 FLBitmap;
+    u32 SLBitmap[TLSF_FL_INDEX_COUNT];
+    TLSFBlock *Blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+    usize UsedBytes;
+    usize FreeBytes;
+    usize UsedBlockCount;
+    usize FreeBlockCount;
+} TLSFControl;
+
+typedef struct {
+    void *Data;
+    usize Capacity;
+    TLSFControl *Control;
+} TLSFAllocator;
+
+typedef struct {
+    usize Capacity;         // Bytes available for payloads (without bookkeeping).
+    usize UsedBytes;        // Bytes handed out to the user (including alignment padding).
+    usize FreeBytes;        // Bytes in free blocks.
+    usize LargestFreeBlock; // Biggest free block. Good-fit search rounds requests up, so not every size up to it fits.
+    usize UsedBlockCount;
+    usize FreeBlockCount;
+    f32 Fragmentation; // 1 - LargestFreeBlock / FreeBytes. Zero when all free memory is contiguous.
+} TLSFAllocatorStats;
+
+TLSFAllocator TLSFAllocatorMake(usize size);
+
+void *TLSFAllocatorAlloc(TLSFAllocator *allocator, usize size);
+void *TLSFAllocatorAllocZ(TLSFAllocator *allocator, usize size);
+void TLSFAllocatorFree(TLSFAllocator *allocator, void *data);
+
+TLSFAllocatorStats TLSFAllocatorGetStats(const TLSFAllocator *allocator);
+
+void TLSFAllocatorDestroy(TLSFAllocator *allocator);
+
 #endif // GFS_MEMORY_H_INCLUDED
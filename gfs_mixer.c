@@ -0,0 +1,744 @@
+/*
+ * FILE      gfs_mixer.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_mixer.h"
+
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_pcm.h"
+#include "gfs_dsp.h"
+#include "gfs_adpcm.h"
+
+#define MIXER_SAMPLE_MAX 32767.0f
+#define MIXER_SAMPLE_MIN -32768.0f
+#define MIXER_SILENCE_THRESHOLD 0.5f // Half of i16 LSB.
+
+#define MIXER_VOICE_ID_INDEX(ID) (((ID) & 0xFFFF) - 1)
+#define MIXER_VOICE_ID_GENERATION(ID) ((u16)((ID) >> 16))
+
+//
+// Accumulation kernels. Gains are applied per channel, so panning is free.
+//
+
+internal void
+Mixer_AccumulateStereoScalar(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        accumulator[frameIndex * 2 + 0] += (f32)source[frameIndex * 2 + 0] * gainL;
+        accumulator[frameIndex * 2 + 1] += (f32)source[frameIndex * 2 + 1] * gainR;
+    }
+}
+
+internal void
+Mixer_AccumulateMonoScalar(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        f32 sample = (f32)source[frameIndex];
+        accumulator[frameIndex * 2 + 0] += sample * gainL;
+        accumulator[frameIndex * 2 + 1] += sample * gainR;
+    }
+}
+
+internal void
+Mixer_AccumulateStereoSSE2(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 4 <= frameCount; frameIndex += 4) {
+        __m128i samples = _mm_loadu_si128((const __m128i *)(source + frameIndex * 2));
+        // NOTE(ilya.a): Sign extension without SSE4.1: put sample into high half, then shift it back. [2026/10/18]
+        __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+        __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+
+        f32 *output = accumulator + frameIndex * 2;
+        _mm_storeu_ps(output + 0, _mm_add_ps(_mm_loadu_ps(output + 0), _mm_mul_ps(low, gain)));
+        _mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(high, gain)));
+    }
+
+    Mixer_AccumulateStereoScalar(
+        accumulator + frameIndex * 2, source + frameIndex * 2, frameCount - frameIndex, gainL, gainR);
+}
+
+internal void
+Mixer_AccumulateMonoSSE2(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+        __m128i samples = _mm_loadu_si128((const __m128i *)(source + frameIndex));
+        __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+        __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+
+        f32 *output = accumulator + frameIndex * 2;
+        _mm_storeu_ps(output + 0, _mm_add_ps(_mm_loadu_ps(output + 0), _mm_mul_ps(_mm_unpacklo_ps(low, low), gain)));
+        _mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(_mm_unpackhi_ps(low, low), gain)));
+        _mm_storeu_ps(output + 8, _mm_add_ps(_mm_loadu_ps(output + 8), _mm_mul_ps(_mm_unpacklo_ps(high, high), gain)));
+        _mm_storeu_ps(
+            output + 12, _mm_add_ps(_mm_loadu_ps(output + 12), _mm_mul_ps(_mm_unpackhi_ps(high, high), gain)));
+    }
+
+    Mixer_AccumulateMonoScalar(
+        accumulator + frameIndex * 2, source + frameIndex, frameCount - frameIndex, gainL, gainR);
+}
+
+internal void
+Mixer_AccumulateStereoAVX2(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+        const i16 *input = source + frameIndex * 2;
+        __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(input + 0))));
+        __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(input + 8))));
+
+        f32 *output = accumulator + frameIndex * 2;
+        _mm256_storeu_ps(output + 0, _mm256_fmadd_ps(low, gain, _mm256_loadu_ps(output + 0)));
+        _mm256_storeu_ps(output + 8, _mm256_fmadd_ps(high, gain, _mm256_loadu_ps(output + 8)));
+    }
+
+    Mixer_AccumulateStereoScalar(
+        accumulator + frameIndex * 2, source + frameIndex * 2, frameCount - frameIndex, gainL, gainR);
+}
+
+internal void
+Mixer_AccumulateMonoAVX2(f32 *accumulator, const i16 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+        __m128i input = _mm_loadu_si128((const __m128i *)(source + frameIndex));
+        __m256 samples = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(input));
+
+        // NOTE(ilya.a): Unpacks work inside 128-bit lanes, so halves have to be put back in order. [2026/10/18]
+        __m256 low = _mm256_unpacklo_ps(samples, samples);  // 0 0 1 1 | 4 4 5 5
+        __m256 high = _mm256_unpackhi_ps(samples, samples); // 2 2 3 3 | 6 6 7 7
+
+        f32 *output = accumulator + frameIndex * 2;
+        _mm256_storeu_ps(
+            output + 0, _mm256_fmadd_ps(_mm256_permute2f128_ps(low, high, 0x20), gain, _mm256_loadu_ps(output + 0)));
+        _mm256_storeu_ps(
+            output + 8, _mm256_fmadd_ps(_mm256_permute2f128_ps(low, high, 0x31), gain, _mm256_loadu_ps(output + 8)));
+    }
+
+    Mixer_AccumulateMonoScalar(
+        accumulator + frameIndex * 2, source + frameIndex, frameCount - frameIndex, gainL, gainR);
+}
+
+/*
+ * Resampler output is already f32 stereo.
+ */
+internal void
+Mixer_AccumulateF32Scalar(f32 *accumulator, const f32 *source, usize frameCount, f32 gainL, f32 gainR) {
+    for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        accumulator[frameIndex * 2 + 0] += source[frameIndex * 2 + 0] * gainL;
+        accumulator[frameIndex * 2 + 1] += source[frameIndex * 2 + 1] * gainR;
+    }
+}
+
+internal void
+Mixer_AccumulateF32SSE2(f32 *accumulator, const f32 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 2 <= frameCount; frameIndex += 2) {
+        f32 *output = accumulator + frameIndex * 2;
+        __m128 samples = _mm_loadu_ps(source + frameIndex * 2);
+        _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(samples, gain)));
+    }
+
+    Mixer_AccumulateF32Scalar(
+        accumulator + frameIndex * 2, source + frameIndex * 2, frameCount - frameIndex, gainL, gainR);
+}
+
+internal void
+Mixer_AccumulateF32AVX2(f32 *accumulator, const f32 *source, usize frameCount, f32 gainL, f32 gainR) {
+    __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+    usize frameIndex = 0;
+
+    for (; frameIndex + 4 <= frameCount; frameIndex += 4) {
+        f32 *output = accumulator + frameIndex * 2;
+        _mm256_storeu_ps(
+            output, _mm256_fmadd_ps(_mm256_loadu_ps(source + frameIndex * 2), gain, _mm256_loadu_ps(output)));
+    }
+
+    Mixer_AccumulateF32Scalar(
+        accumulator + frameIndex * 2, source + frameIndex * 2, frameCount - frameIndex, gainL, gainR);
+}
+
+internal void
+Mixer_Accumulate(
+    const Mixer *mixer, f32 *accumulator, const i16 *source, u32 channelCount, usize frameCount, f32 gainL,
+    f32 gainR) {
+    if (mixer->IsAVX2Enabled) {
+        if (channelCount == 1) {
+            Mixer_AccumulateMonoAVX2(accumulator, source, frameCount, gainL, gainR);
+        } else {
+            Mixer_AccumulateStereoAVX2(accumulator, source, frameCount, gainL, gainR);
+        }
+    } else {
+        if (channelCount == 1) {
+            Mixer_AccumulateMonoSSE2(accumulator, source, frameCount, gainL, gainR);
+        } else {
+            Mixer_AccumulateStereoSSE2(accumulator, source, frameCount, gainL, gainR);
+        }
+    }
+}
+
+/*
+ * Resampler output is in i16 scale already, other f32 sources are normalized.
+ */
+internal void
+Mixer_AccumulateF32(const Mixer *mixer, f32 *accumulator, const f32 *source, usize frameCount, f32 gainL, f32 gainR) {
+    if (mixer->IsAVX2Enabled) {
+        Mixer_AccumulateF32AVX2(accumulator, source, frameCount, gainL, gainR);
+    } else {
+        Mixer_AccumulateF32SSE2(accumulator, source, frameCount, gainL, gainR);
+    }
+}
+
+/*
+ * Adds `frameCount` interleaved frames in any format. Everything, which isn't i16, is converted
+ * block by block into normalized f32 stereo.
+ */
+internal void
+Mixer_AccumulateSpan(
+    Mixer *mixer, f32 *accumulator, const void *source, PCMFormat format, u32 channelCount, usize frameCount,
+    f32 gainL, f32 gainR) {
+    if (format == PCM_FORMAT_I16) {
+        Mixer_Accumulate(mixer, accumulator, source, channelCount, frameCount, gainL, gainR);
+        return;
+    }
+
+    usize frameSize = channelCount * PCMFormatGetSize(format);
+
+    for (usize framesDone = 0; framesDone < frameCount;) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+        const f32 *stereo = mixer->ConvertBuffer;
+
+        PCMConvertToF32(
+            format, (const byte *)source + framesDone * frameSize, mixer->ConvertBuffer, framesToMix * channelCount);
+
+        if (channelCount == 1) {
+            PCMMonoToStereoF32(mixer->ConvertBuffer, mixer->StereoBuffer, framesToMix);
+            stereo = mixer->StereoBuffer;
+        }
+
+        Mixer_AccumulateF32(
+            mixer, accumulator + framesDone * MIXER_CHANNEL_COUNT, stereo, framesToMix, gainL * -MIXER_SAMPLE_MIN,
+            gainR * -MIXER_SAMPLE_MIN);
+
+        framesDone += framesToMix;
+    }
+}
+
+internal f32
+Mixer_ClampPan(f32 pan) {
+    return pan < -1.0f ? -1.0f : (pan > 1.0f ? 1.0f : pan);
+}
+
+internal MixerVoice *
+Mixer_GetVoice(Mixer *mixer, MixerVoiceID id) {
+    u32 voiceIndex = MIXER_VOICE_ID_INDEX(id);
+
+    if (id == MIXER_VOICE_INVALID || voiceIndex >= MIXER_VOICE_COUNT_MAX) {
+        return NULL;
+    }
+
+    MixerVoice *voice = &mixer->Voices[voiceIndex];
+
+    if (!voice->IsPlaying || voice->Generation != MIXER_VOICE_ID_GENERATION(id)) {
+        return NULL;
+    }
+
+    return voice;
+}
+
+Mixer
+MixerMake(u32 sampleRate, ResampleQuality quality) {
+    Mixer mixer = {0};
+    mixer.SampleRate = sampleRate;
+    mixer.MasterVolume = 1.0f;
+    mixer.IsAVX2Enabled = SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA);
+    mixer.Quality = quality;
+
+    usize filtersSize = MIXER_FILTER_COUNT_MAX * sizeof(ResampleFilter);
+    usize statesSize = MIXER_VOICE_COUNT_MAX * sizeof(ResampleState);
+
+    mixer.Arena = ScratchAllocatorMake(filtersSize + statesSize);
+    mixer.Filters = ScratchAllocatorAlloc(&mixer.Arena, filtersSize);
+    mixer.ResampleStates = ScratchAllocatorAlloc(&mixer.Arena, statesSize);
+
+    for (u32 busIndex = 0; busIndex < MIXER_BUS_COUNT; ++busIndex) {
+        DSPChainInit(&mixer.Buses[busIndex], sampleRate, MIXER_SILENCE_THRESHOLD);
+    }
+
+    return mixer;
+}
+
+void
+MixerDestroy(Mixer *mixer) {
+    if (mixer == NULL) {
+        return;
+    }
+
+    for (u32 busIndex = 0; busIndex < MIXER_BUS_COUNT; ++busIndex) {
+        DSPChainDestroy(&mixer->Buses[busIndex]);
+    }
+
+    ScratchAllocatorFree(&mixer->Arena);
+    MemoryZero(mixer, sizeof(*mixer));
+}
+
+/*
+ * Finds filter, which converts `sampleRate` into mixer's rate, or builds new one in place of
+ * filter, which no voice plays through. Returns index of filter or `MIXER_FILTER_COUNT_MAX`, if
+ * every filter is in use.
+ */
+internal u32
+Mixer_GetFilter(Mixer *mixer, u32 sampleRate) {
+    if (mixer->Filters == NULL) {
+        return MIXER_FILTER_COUNT_MAX;
+    }
+
+    u32 unusedIndex = MIXER_FILTER_COUNT_MAX;
+
+    // NOTE(ilya.a): Unused filters are kept as they are, until their slot is needed, so rate,
+    // which is played over and over, doesn't rebuild its tables every time. [2026/10/18]
+    for (u32 filterIndex = 0; filterIndex < mixer->FilterCount; ++filterIndex) {
+        if (mixer->Filters[filterIndex].InputRate == sampleRate) {
+            return filterIndex;
+        }
+
+        if (mixer->FilterVoiceCounts[filterIndex] == 0 && unusedIndex == MIXER_FILTER_COUNT_MAX) {
+            unusedIndex = filterIndex;
+        }
+    }
+
+    if (mixer->FilterCount < MIXER_FILTER_COUNT_MAX) {
+        unusedIndex = mixer->FilterCount++;
+    }
+
+    if (unusedIndex < MIXER_FILTER_COUNT_MAX) {
+        ResampleFilterInit(&mixer->Filters[unusedIndex], sampleRate, mixer->SampleRate, mixer->Quality);
+    }
+
+    return unusedIndex;
+}
+
+/*
+ * Every voice stops here, so filter it played through is released.
+ */
+internal void
+Mixer_StopVoice(Mixer *mixer, MixerVoice *voice) {
+    if (voice->Filter != NULL) {
+        --mixer->FilterVoiceCounts[voice->Filter - mixer->Filters];
+        voice->Filter = NULL;
+    }
+
+    voice->IsPlaying = false;
+}
+
+MixerVoiceID
+MixerPlay(Mixer *mixer, const MixerVoiceDesc *desc) {
+    if (mixer == NULL || desc == NULL || (desc->ChannelCount != 1 && desc->ChannelCount != 2)) {
+        return MIXER_VOICE_INVALID;
+    }
+
+    if (desc->Format >= PCM_FORMAT_COUNT || desc->Bus >= MIXER_BUS_COUNT) {
+        return MIXER_VOICE_INVALID;
+    }
+
+    if (desc->Read == NULL && desc->Samples == NULL) {
+        return MIXER_VOICE_INVALID;
+    }
+
+    ADPCMDecoder decoder = {0};
+
+    if (desc->ADPCMBlockSize != 0 &&
+        (desc->Read != NULL ||
+         !ADPCMDecoderInit(&decoder, desc->Samples, desc->FrameCount, desc->ADPCMBlockSize, desc->ChannelCount))) {
+        return MIXER_VOICE_INVALID;
+    }
+
+    ResampleFilter *filter = NULL;
+
+    if (desc->SampleRate != 0 && desc->SampleRate != mixer->SampleRate) {
+        if (desc->SampleRate > mixer->SampleRate * MIXER_RESAMPLE_RATIO_MAX) {
+            return MIXER_VOICE_INVALID;
+        }
+
+        u32 filterIndex = Mixer_GetFilter(mixer, desc->SampleRate);
+
+        if (filterIndex == MIXER_FILTER_COUNT_MAX) {
+            return MIXER_VOICE_INVALID;
+        }
+
+        filter = &mixer->Filters[filterIndex];
+    }
+
+    for (u32 voiceIndex = 0; voiceIndex < MIXER_VOICE_COUNT_MAX; ++voiceIndex) {
+        MixerVoice *voice = &mixer->Voices[voiceIndex];
+
+        if (voice->IsPlaying) {
+            continue;
+        }
+
+        voice->Desc = *desc;
+        voice->Desc.Pan = Mixer_ClampPan(desc->Pan);
+        voice->Position = 0;
+        voice->IsPlaying = true;
+        voice->Filter = filter;
+        voice->IsDraining = false;
+        voice->Decoder = decoder;
+        ++voice->Generation;
+
+        // NOTE(ilya.a): Decoded samples are i16. [2026/10/18]
+        if (desc->ADPCMBlockSize != 0) {
+            voice->Desc.Format = PCM_FORMAT_I16;
+        }
+
+        if (filter != NULL) {
+            ++mixer->FilterVoiceCounts[filter - mixer->Filters];
+            ResampleStateReset(&mixer->ResampleStates[voiceIndex], filter, desc->ChannelCount);
+        }
+
+        if (voice->Desc.LoopEnd == 0 || voice->Desc.LoopEnd > voice->Desc.FrameCount) {
+            voice->Desc.LoopEnd = voice->Desc.FrameCount;
+        }
+
+        return (MixerVoiceID)voice->Generation << 16 | (voiceIndex + 1);
+    }
+
+    return MIXER_VOICE_INVALID;
+}
+
+void
+MixerStop(Mixer *mixer, MixerVoiceID id) {
+    MixerVoice *voice = Mixer_GetVoice(mixer, id);
+
+    if (voice != NULL) {
+        Mixer_StopVoice(mixer, voice);
+    }
+}
+
+bool
+MixerIsPlaying(const Mixer *mixer, MixerVoiceID id) {
+    return Mixer_GetVoice((Mixer *)mixer, id) != NULL;
+}
+
+void
+MixerSetVolume(Mixer *mixer, MixerVoiceID id, f32 volume) {
+    MixerVoice *voice = Mixer_GetVoice(mixer, id);
+
+    if (voice != NULL) {
+        voice->Desc.Volume = volume;
+    }
+}
+
+void
+MixerSetPan(Mixer *mixer, MixerVoiceID id, f32 pan) {
+    MixerVoice *voice = Mixer_GetVoice(mixer, id);
+
+    if (voice != NULL) {
+        voice->Desc.Pan = Mixer_ClampPan(pan);
+    }
+}
+
+DSPChain *
+MixerGetBus(Mixer *mixer, u32 bus) {
+    if (mixer == NULL || bus == MIXER_BUS_MASTER || bus >= MIXER_BUS_COUNT) {
+        return NULL;
+    }
+
+    return &mixer->Buses[bus];
+}
+
+u32
+MixerGetPlayingCount(const Mixer *mixer) {
+    u32 count = 0;
+    for (u32 voiceIndex = 0; voiceIndex < MIXER_VOICE_COUNT_MAX; ++voiceIndex) {
+        count += mixer->Voices[voiceIndex].IsPlaying ? 1 : 0;
+    }
+    return count;
+}
+
+/*
+ * Points `spanOut` at up to `frameCount` next frames of in-memory voice, following its loop region.
+ * Compressed voice is decoded into mixer's read buffer, so at most `MIXER_BLOCK_FRAMES` are taken
+ * then. Returns zero, once voice is over.
+ */
+internal usize
+Mixer_NextMemorySpan(Mixer *mixer, MixerVoice *voice, usize frameCount, const void **spanOut) {
+    const MixerVoiceDesc *desc = &voice->Desc;
+
+    for (;;) {
+        u64 end = desc->IsLooping ? desc->LoopEnd : desc->FrameCount;
+
+        if (voice->Position < end) {
+            u64 framesAvailable = end - voice->Position;
+            usize framesToTake = (usize)(framesAvailable < frameCount ? framesAvailable : frameCount);
+
+            if (desc->ADPCMBlockSize != 0) {
+                framesToTake = framesToTake < MIXER_BLOCK_FRAMES ? framesToTake : MIXER_BLOCK_FRAMES;
+                framesToTake = ADPCMDecode(&voice->Decoder, voice->Position, (i16 *)mixer->ReadBuffer, framesToTake);
+                *spanOut = mixer->ReadBuffer;
+                voice->Position += framesToTake;
+                return framesToTake;
+            }
+
+            usize frameSize = desc->ChannelCount * PCMFormatGetSize(desc->Format);
+            *spanOut = (const byte *)desc->Samples + voice->Position * frameSize;
+            voice->Position += framesToTake;
+            return framesToTake;
+        }
+
+        if (!desc->IsLooping || desc->LoopStart >= desc->LoopEnd) {
+            return 0;
+        }
+
+        voice->Position = desc->LoopStart;
+    }
+}
+
+/*
+ * Adds up to `frameCount` frames of in-memory voice.
+ */
+internal void
+Mixer_MixMemoryVoice(Mixer *mixer, MixerVoice *voice, f32 *accumulator, usize frameCount, f32 gainL, f32 gainR) {
+    usize framesDone = 0;
+
+    while (framesDone < frameCount) {
+        const void *span = NULL;
+        usize framesToMix = Mixer_NextMemorySpan(mixer, voice, frameCount - framesDone, &span);
+
+        if (framesToMix == 0) {
+            Mixer_StopVoice(mixer, voice);
+            return;
+        }
+
+        Mixer_AccumulateSpan(
+            mixer, accumulator + framesDone * MIXER_CHANNEL_COUNT, span, voice->Desc.Format, voice->Desc.ChannelCount,
+            framesToMix, gainL, gainR);
+
+        framesDone += framesToMix;
+    }
+}
+
+/*
+ * Adds up to `frameCount` frames of voice, which plays at other rate. Source is pulled only as
+ * far, as the resampler needs it.
+ */
+internal void
+Mixer_MixResampledVoice(Mixer *mixer, u32 voiceIndex, f32 *accumulator, usize frameCount, f32 gainL, f32 gainR) {
+    MixerVoice *voice = &mixer->Voices[voiceIndex];
+    ResampleState *state = &mixer->ResampleStates[voiceIndex];
+    usize framesDone = 0;
+
+    while (framesDone < frameCount) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+        usize inputNeeded = ResampleGetInputNeeded(state, framesToMix);
+
+        while (inputNeeded > 0 && !voice->IsDraining) {
+            usize inputSpace = ResampleGetInputSpace(state);
+            usize framesToRead = inputNeeded < inputSpace ? inputNeeded : inputSpace;
+            framesToRead = framesToRead < MIXER_BLOCK_FRAMES ? framesToRead : MIXER_BLOCK_FRAMES;
+
+            if (framesToRead == 0) {
+                break;
+            }
+
+            const void *span = mixer->ReadBuffer;
+
+            if (voice->Desc.Read != NULL) {
+                voice->IsDraining = !voice->Desc.Read(voice->Desc.ReadData, mixer->ReadBuffer, framesToRead);
+                voice->Position += framesToRead;
+            } else {
+                framesToRead = Mixer_NextMemorySpan(mixer, voice, framesToRead, &span);
+                voice->IsDraining = framesToRead == 0;
+            }
+
+            if (voice->Desc.Format == PCM_FORMAT_I16) {
+                ResampleWriteI16(state, span, framesToRead);
+            } else {
+                usize samplesToRead = framesToRead * voice->Desc.ChannelCount;
+                PCMConvertToF32(voice->Desc.Format, span, mixer->ConvertBuffer, samplesToRead);
+                ResampleWriteF32(state, mixer->ConvertBuffer, framesToRead);
+            }
+
+            // NOTE(ilya.a): Flushing filter with silence, so the tail of the source is heard. [2026/10/18]
+            if (voice->IsDraining) {
+                ResampleWriteSilence(state, state->Filter->TapCount);
+            }
+
+            inputNeeded -= framesToRead < inputNeeded ? framesToRead : inputNeeded;
+        }
+
+        usize framesMixed = ResampleProcess(state, mixer->StereoBuffer, framesToMix);
+
+        Mixer_AccumulateF32(
+            mixer, accumulator + framesDone * MIXER_CHANNEL_COUNT, mixer->StereoBuffer, framesMixed, gainL, gainR);
+
+        framesDone += framesMixed;
+
+        if (framesMixed < framesToMix && (voice->IsDraining || framesMixed == 0)) {
+            if (voice->IsDraining) {
+                Mixer_StopVoice(mixer, voice);
+            }
+
+            return;
+        }
+    }
+}
+
+internal void
+Mixer_MixVoice(Mixer *mixer, u32 voiceIndex, f32 *accumulator, usize frameCount) {
+    MixerVoice *voice = &mixer->Voices[voiceIndex];
+
+    // NOTE(ilya.a): Balance law: center is full volume on both sides, panning only attenuates
+    // the other side. [2026/10/18]
+    f32 volume = voice->Desc.Volume * mixer->MasterVolume;
+    f32 gainL = volume * (voice->Desc.Pan > 0.0f ? 1.0f - voice->Desc.Pan : 1.0f);
+    f32 gainR = volume * (voice->Desc.Pan < 0.0f ? 1.0f + voice->Desc.Pan : 1.0f);
+
+    if (voice->Filter != NULL) {
+        Mixer_MixResampledVoice(mixer, voiceIndex, accumulator, frameCount, gainL, gainR);
+        return;
+    }
+
+    if (voice->Desc.Read == NULL) {
+        Mixer_MixMemoryVoice(mixer, voice, accumulator, frameCount, gainL, gainR);
+        return;
+    }
+
+    for (usize framesDone = 0; framesDone < frameCount && voice->IsPlaying;) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+
+        voice->IsPlaying = voice->Desc.Read(voice->Desc.ReadData, mixer->ReadBuffer, framesToMix);
+
+        Mixer_AccumulateSpan(
+            mixer, accumulator + framesDone * MIXER_CHANNEL_COUNT, mixer->ReadBuffer, voice->Desc.Format,
+            voice->Desc.ChannelCount, framesToMix, gainL, gainR);
+
+        voice->Position += framesToMix;
+        framesDone += framesToMix;
+    }
+}
+
+/*
+ * Mixes voices of the bus into `accumulator`. Returns false, if there were none.
+ */
+internal bool
+Mixer_MixBusVoices(Mixer *mixer, u32 bus, f32 *accumulator, usize frameCount) {
+    bool hasVoices = false;
+
+    for (u32 voiceIndex = 0; voiceIndex < MIXER_VOICE_COUNT_MAX; ++voiceIndex) {
+        MixerVoice *voice = &mixer->Voices[voiceIndex];
+
+        if (voice->IsPlaying && voice->Desc.Bus == bus) {
+            Mixer_MixVoice(mixer, voiceIndex, accumulator, frameCount);
+            hasVoices = true;
+        }
+    }
+
+    return hasVoices;
+}
+
+void
+MixerMix(Mixer *mixer, f32 *accumulator, usize frameCount) {
+    if (mixer == NULL || accumulator == NULL) {
+        return;
+    }
+
+    // NOTE(ilya.a): Bus without effects is just a group of voices, so it's mixed as master. [2026/10/18]
+    for (u32 busIndex = 0; busIndex < MIXER_BUS_COUNT; ++busIndex) {
+        if (busIndex == MIXER_BUS_MASTER || mixer->Buses[busIndex].NodeCount == 0) {
+            Mixer_MixBusVoices(mixer, busIndex, accumulator, frameCount);
+        }
+    }
+
+    for (usize framesDone = 0; framesDone < frameCount;) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+        f32 *output = accumulator + framesDone * MIXER_CHANNEL_COUNT;
+
+        for (u32 busIndex = 0; busIndex < MIXER_BUS_COUNT; ++busIndex) {
+            DSPChain *chain = &mixer->Buses[busIndex];
+
+            if (busIndex == MIXER_BUS_MASTER || chain->NodeCount == 0) {
+                continue;
+            }
+
+            MemoryZero(mixer->BusBuffer, framesToMix * MIXER_CHANNEL_COUNT * sizeof(f32));
+            bool isSilent = !Mixer_MixBusVoices(mixer, busIndex, mixer->BusBuffer, framesToMix);
+
+            if (!DSPChainProcess(chain, mixer->BusBuffer, framesToMix, isSilent)) {
+                Mixer_AccumulateF32(mixer, output, mixer->BusBuffer, framesToMix, 1.0f, 1.0f);
+            }
+        }
+
+        framesDone += framesToMix;
+    }
+}
+
+void
+MixerConvertToI16(const Mixer *mixer, const f32 *source, i16 *destination, usize sampleCount) {
+    usize sampleIndex = 0;
+
+    // NOTE(ilya.a): cvtps returns INT_MIN on overflow, which would wrap loud positive samples,
+    // so clamping before conversion. Packing saturates anyway. [2026/10/18]
+    if (mixer != NULL && mixer->IsAVX2Enabled) {
+        __m256 maximum = _mm256_set1_ps(MIXER_SAMPLE_MAX);
+        __m256 minimum = _mm256_set1_ps(MIXER_SAMPLE_MIN);
+
+        for (; sampleIndex + 16 <= sampleCount; sampleIndex += 16) {
+            __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + sampleIndex + 0), minimum), maximum);
+            __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + sampleIndex + 8), minimum), maximum);
+            __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            // NOTE(ilya.a): Pack interleaves 128-bit lanes: a0 b0 | a1 b1. [2026/10/18]
+            _mm256_storeu_si256((__m256i *)(destination + sampleIndex), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+    } else {
+        __m128 maximum = _mm_set1_ps(MIXER_SAMPLE_MAX);
+        __m128 minimum = _mm_set1_ps(MIXER_SAMPLE_MIN);
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + sampleIndex + 0), minimum), maximum);
+            __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + sampleIndex + 4), minimum), maximum);
+            __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128((__m128i *)(destination + sampleIndex), packed);
+        }
+    }
+
+    for (; sampleIndex < sampleCount; ++sampleIndex) {
+        f32 sample = source[sampleIndex];
+        sample = sample > MIXER_SAMPLE_MAX ? MIXER_SAMPLE_MAX : (sample < MIXER_SAMPLE_MIN ? MIXER_SAMPLE_MIN : sample);
+        destination[sampleIndex] = (i16)_mm_cvtss_si32(_mm_set_ss(sample));
+    }
+}
+
+void
+MixerRender(Mixer *mixer, i16 *destination, usize frameCount) {
+    if (mixer == NULL || destination == NULL) {
+        return;
+    }
+
+    for (usize framesDone = 0; framesDone < frameCount;) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToMix = framesLeft < MIXER_BLOCK_FRAMES ? framesLeft : MIXER_BLOCK_FRAMES;
+        usize samplesToMix = framesToMix * MIXER_CHANNEL_COUNT;
+
+        MemoryZero(mixer->Accumulator, samplesToMix * sizeof(f32));
+        MixerMix(mixer, mixer->Accumulator, framesToMix);
+        MixerConvertToI16(mixer, mixer->Accumulator, destination + framesDone * MIXER_CHANNEL_COUNT, samplesToMix);
+
+        framesDone += framesToMix;
+    }
+}
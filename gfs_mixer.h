@@ -0,0 +1,151 @@
+/*
+ * GFS. Software audio mixer.
+ *
+ * Mixes any number of voices into interleaved stereo. Voices are accumulated in f32 with SIMD
+ * (AVX2 if CPU has it, SSE2 otherwise), then accumulator is saturated into i16 output. Mixer
+ * doesn't know about platform audio: it just fills memory buffers, so it could run headless.
+ *
+ * Voice either plays samples, which are already in memory (with optional loop region), or
+ * pulls them block by block from `MixerVoiceReadProc` (e.g. wave stream). Voice with sample rate
+ * other than mixer's one is converted on the fly by polyphase resampler. Samples could be in any
+ * `PCMFormat`; i16 is accumulated directly, others are converted into f32 first. In-memory samples
+ * could also be IMA-ADPCM blocks, which are decoded block by block as voice plays.
+ *
+ * Every voice goes to a bus. Bus zero is mixed straight into the output, other buses are mixed
+ * separately, go through their DSP chain (see `gfs_dsp.h`) and are added to the output then.
+ *
+ * FILE      gfs_mixer.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_MIXER_H_INCLUDED
+#define GFS_MIXER_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_resample.h"
+#include "gfs_pcm.h"
+#include "gfs_dsp.h"
+#include "gfs_adpcm.h"
+
+#define MIXER_VOICE_COUNT_MAX 64
+#define MIXER_BLOCK_FRAMES 256 // Frames mixed at once. Read procs are never asked for more.
+#define MIXER_CHANNEL_COUNT 2
+#define MIXER_FILTER_COUNT_MAX 4   // Distinct voice sample rates, which could be resampled at once.
+#define MIXER_RESAMPLE_RATIO_MAX 4 // Voice rate could be at most this times higher than mixer's one.
+#define MIXER_BUS_COUNT 4
+#define MIXER_BUS_MASTER 0 // Has no effects.
+
+/*
+ * Fills `frameCount` frames of `channelCount` interleaved samples in voice's format. Should always
+ * fill the whole `destination` (silence if data is not there yet). Returns false once source is
+ * exhausted.
+ */
+typedef bool MixerVoiceReadProc(void *data, void *destination, usize frameCount);
+
+typedef struct {
+    const void *Samples; // Interleaved. Ignored, if `Read` is set.
+    u64 FrameCount;
+    PCMFormat Format;
+    u32 ADPCMBlockSize; // Non-zero, if `Samples` are IMA-ADPCM blocks of this size. `Format` is ignored then.
+    u32 ChannelCount;   // 1 or 2.
+    u32 SampleRate;     // Zero means mixer's rate.
+    u32 Bus;
+
+    MixerVoiceReadProc *Read;
+    void *ReadData;
+
+    bool IsLooping;
+    u64 LoopStart;
+    u64 LoopEnd; // Zero means end of samples.
+
+    f32 Volume;
+    f32 Pan; // From -1 (left) to 1 (right).
+} MixerVoiceDesc;
+
+/*
+ * Identifies playing voice. Zero is never a valid id. Id of finished voice stays invalid, even
+ * after its slot is reused.
+ */
+typedef u32 MixerVoiceID;
+
+#define MIXER_VOICE_INVALID 0
+
+typedef struct {
+    MixerVoiceDesc Desc;
+    u64 Position; // In source frames.
+    u16 Generation;
+    bool IsPlaying;
+
+    const ResampleFilter *Filter; // NULL, if voice plays at mixer's rate.
+    bool IsDraining;              // Source is over, resampler is flushing its history.
+
+    ADPCMDecoder Decoder; // Used, if samples are compressed.
+} MixerVoice;
+
+typedef struct {
+    u32 SampleRate;
+    f32 MasterVolume;
+    bool IsAVX2Enabled;
+    ResampleQuality Quality;
+
+    MixerVoice Voices[MIXER_VOICE_COUNT_MAX];
+
+    f32 Accumulator[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    byte ReadBuffer[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT * sizeof(f32)]; // Widest format.
+    f32 ConvertBuffer[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    f32 StereoBuffer[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+    f32 BusBuffer[MIXER_BLOCK_FRAMES * MIXER_CHANNEL_COUNT];
+
+    DSPChain Buses[MIXER_BUS_COUNT]; // Effects of master bus are never applied.
+
+    // NOTE(ilya.a): Resampler data is big, so it lives in the arena. State per voice, filter per
+    // distinct source rate. [2026/10/18]
+    ScratchAllocator Arena;
+    ResampleFilter *Filters;
+    u32 FilterCount;
+    u32 FilterVoiceCounts[MIXER_FILTER_COUNT_MAX]; // Playing voices, which use the filter.
+    ResampleState *ResampleStates;
+} Mixer;
+
+Mixer MixerMake(u32 sampleRate, ResampleQuality quality);
+void MixerDestroy(Mixer *mixer);
+
+/*
+ * Returns `MIXER_VOICE_INVALID` if every voice is busy, description is invalid or voices, which
+ * are playing, already resample `MIXER_FILTER_COUNT_MAX` other sample rates.
+ */
+MixerVoiceID MixerPlay(Mixer *mixer, const MixerVoiceDesc *desc);
+void MixerStop(Mixer *mixer, MixerVoiceID id);
+bool MixerIsPlaying(const Mixer *mixer, MixerVoiceID id);
+
+void MixerSetVolume(Mixer *mixer, MixerVoiceID id, f32 volume);
+void MixerSetPan(Mixer *mixer, MixerVoiceID id, f32 pan);
+
+u32 MixerGetPlayingCount(const Mixer *mixer);
+
+/*
+ * Effects chain of the bus, where nodes could be added. Returns NULL for master bus. Chains are
+ * processed by whoever calls `MixerMix`, so they should be changed only on that thread.
+ */
+DSPChain *MixerGetBus(Mixer *mixer, u32 bus);
+
+/*
+ * Adds every playing voice into `accumulator` of `frameCount` interleaved stereo frames. Samples
+ * are kept in i16 scale, so full scale is 32767.
+ */
+void MixerMix(Mixer *mixer, f32 *accumulator, usize frameCount);
+
+/*
+ * Rounds and saturates f32 samples into i16.
+ */
+void MixerConvertToI16(const Mixer *mixer, const f32 *source, i16 *destination, usize sampleCount);
+
+/*
+ * Mixes `frameCount` interleaved stereo frames into `destination`, overwriting it.
+ */
+void MixerRender(Mixer *mixer, i16 *destination, usize frameCount);
+
+#endif // GFS_MIXER_H_INCLUDED
@@ -0,0 +1,236 @@
+/*
+ * FILE      gfs_osc.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_osc.h"
+
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+
+#define OSC_PHASE_SCALE (1.0f / 4294967296.0f) // Turns per unit of phase.
+#define OSC_TWO_PI 6.28318530717958647692f
+
+// NOTE(ilya.a): Taylor series up to x^9. On [-pi/2, pi/2] its error is below `OSC_SINE_ERROR_MAX`
+// (4e-6, see `-bench osc` of headless driver), which is way under i16 quantization. [2026/10/18]
+#define OSC_SINE_C3 (-1.0f / 6.0f)
+#define OSC_SINE_C5 (1.0f / 120.0f)
+#define OSC_SINE_C7 (-1.0f / 5040.0f)
+#define OSC_SINE_C9 (1.0f / 362880.0f)
+
+internal u32
+Osc_GetIncrement(const OscBank *bank, f32 frequency) {
+    f64 increment = (f64)frequency / (f64)bank->SampleRate * 4294967296.0;
+
+    if (increment < 0.0) {
+        return 0;
+    }
+    if (increment >= 2147483648.0) { // Above Nyquist.
+        return 0x7FFFFFFF;
+    }
+    return (u32)(increment + 0.5);
+}
+
+/*
+ * Phase is interpreted as signed, so `t` is in [-0.5, 0.5) turns. Then folded into
+ * [-0.25, 0.25] (sin(pi - x) = sin(x)), where polynomial is accurate.
+ */
+f32
+OscSine(u32 phase) {
+    f32 t = (f32)(i32)phase * OSC_PHASE_SCALE;
+    f32 magnitude = t < 0.0f ? -t : t;
+    f32 distance = magnitude - 0.25f;
+    f32 folded = 0.25f - (distance < 0.0f ? -distance : distance);
+
+    f32 x = (t < 0.0f ? -folded : folded) * OSC_TWO_PI;
+    f32 x2 = x * x;
+    return x * (1.0f + x2 * (OSC_SINE_C3 + x2 * (OSC_SINE_C5 + x2 * (OSC_SINE_C7 + x2 * OSC_SINE_C9))));
+}
+
+internal __m128
+Osc_SineSSE2(__m128i phase) {
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 quarter = _mm_set1_ps(0.25f);
+
+    __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(phase), _mm_set1_ps(OSC_PHASE_SCALE));
+    __m128 sign = _mm_and_ps(t, signMask);
+    __m128 distance = _mm_sub_ps(_mm_andnot_ps(signMask, t), quarter);
+    __m128 folded = _mm_sub_ps(quarter, _mm_andnot_ps(signMask, distance));
+
+    __m128 x = _mm_mul_ps(_mm_or_ps(folded, sign), _mm_set1_ps(OSC_TWO_PI));
+    __m128 x2 = _mm_mul_ps(x, x);
+
+    __m128 result = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(OSC_SINE_C9)), _mm_set1_ps(OSC_SINE_C7));
+    result = _mm_add_ps(_mm_mul_ps(x2, result), _mm_set1_ps(OSC_SINE_C5));
+    result = _mm_add_ps(_mm_mul_ps(x2, result), _mm_set1_ps(OSC_SINE_C3));
+    result = _mm_add_ps(_mm_mul_ps(x2, result), _mm_set1_ps(1.0f));
+    return _mm_mul_ps(x, result);
+}
+
+internal __m256
+Osc_SineAVX2(__m256i phase) {
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 quarter = _mm256_set1_ps(0.25f);
+
+    __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(phase), _mm256_set1_ps(OSC_PHASE_SCALE));
+    __m256 sign = _mm256_and_ps(t, signMask);
+    __m256 distance = _mm256_sub_ps(_mm256_andnot_ps(signMask, t), quarter);
+    __m256 folded = _mm256_sub_ps(quarter, _mm256_andnot_ps(signMask, distance));
+
+    __m256 x = _mm256_mul_ps(_mm256_or_ps(folded, sign), _mm256_set1_ps(OSC_TWO_PI));
+    __m256 x2 = _mm256_mul_ps(x, x);
+
+    __m256 result = _mm256_fmadd_ps(x2, _mm256_set1_ps(OSC_SINE_C9), _mm256_set1_ps(OSC_SINE_C7));
+    result = _mm256_fmadd_ps(x2, result, _mm256_set1_ps(OSC_SINE_C5));
+    result = _mm256_fmadd_ps(x2, result, _mm256_set1_ps(OSC_SINE_C3));
+    result = _mm256_fmadd_ps(x2, result, _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(x, result);
+}
+
+OscBank
+OscBankMake(u32 sampleRate) {
+    OscBank bank = {0};
+    bank.SampleRate = sampleRate;
+    bank.IsAVX2Enabled = SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA);
+    return bank;
+}
+
+OscID
+OscBankAdd(OscBank *bank, f32 frequency, f32 amplitude) {
+    if (bank == NULL || bank->Count >= OSC_COUNT_MAX) {
+        return OSC_INVALID;
+    }
+
+    u32 index = bank->Count++;
+    bank->Phases[index] = 0;
+    bank->Increments[index] = Osc_GetIncrement(bank, frequency);
+    bank->Amplitudes[index] = amplitude;
+    bank->TargetAmplitudes[index] = amplitude;
+
+    return index + 1;
+}
+
+void
+OscBankSetFrequency(OscBank *bank, OscID id, f32 frequency) {
+    if (bank == NULL || id == OSC_INVALID || id > bank->Count) {
+        return;
+    }
+
+    bank->Increments[id - 1] = Osc_GetIncrement(bank, frequency);
+}
+
+void
+OscBankSetAmplitude(OscBank *bank, OscID id, f32 amplitude) {
+    if (bank == NULL || id == OSC_INVALID || id > bank->Count) {
+        return;
+    }
+
+    bank->TargetAmplitudes[id - 1] = amplitude;
+}
+
+/*
+ * Adds `frameCount` frames of one oscillator into mono `buffer`. Amplitude moves linearly from
+ * `amplitude` by `amplitudeStep` per frame.
+ */
+internal void
+Osc_Render(
+    const OscBank *bank, u32 *phase, u32 increment, f32 amplitude, f32 amplitudeStep, f32 *buffer,
+    usize frameCount) {
+    usize frameIndex = 0;
+
+    if (bank->IsAVX2Enabled) {
+        __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i offsets = _mm256_mullo_epi32(_mm256_set1_epi32((i32)increment), lanes);
+        __m256i phases = _mm256_add_epi32(_mm256_set1_epi32((i32)*phase), offsets);
+        __m256i phaseStep = _mm256_set1_epi32((i32)(increment * 8));
+
+        __m256 amplitudes =
+            _mm256_fmadd_ps(_mm256_set1_ps(amplitudeStep), _mm256_cvtepi32_ps(lanes), _mm256_set1_ps(amplitude));
+        __m256 amplitudesStep = _mm256_set1_ps(amplitudeStep * 8.0f);
+
+        for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+            __m256 samples = Osc_SineAVX2(phases);
+            _mm256_storeu_ps(
+                buffer + frameIndex, _mm256_fmadd_ps(samples, amplitudes, _mm256_loadu_ps(buffer + frameIndex)));
+            phases = _mm256_add_epi32(phases, phaseStep);
+            amplitudes = _mm256_add_ps(amplitudes, amplitudesStep);
+        }
+    } else {
+        // NOTE(ilya.a): SSE2 has no 32-bit multiply, so lane offsets are built with additions. [2026/10/18]
+        __m128i increments = _mm_set1_epi32((i32)increment);
+        __m128i offsets = _mm_setr_epi32(0, (i32)increment, (i32)(increment * 2), (i32)(increment * 3));
+        __m128i phasesLow = _mm_add_epi32(_mm_set1_epi32((i32)*phase), offsets);
+        __m128i phasesHigh = _mm_add_epi32(phasesLow, _mm_slli_epi32(increments, 2));
+        __m128i phaseStep = _mm_slli_epi32(increments, 3);
+
+        __m128 amplitudesLow = _mm_add_ps(
+            _mm_set1_ps(amplitude), _mm_mul_ps(_mm_set1_ps(amplitudeStep), _mm_setr_ps(0, 1, 2, 3)));
+        __m128 amplitudesHigh = _mm_add_ps(amplitudesLow, _mm_set1_ps(amplitudeStep * 4.0f));
+        __m128 amplitudesStep = _mm_set1_ps(amplitudeStep * 8.0f);
+
+        for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+            __m128 low = _mm_mul_ps(Osc_SineSSE2(phasesLow), amplitudesLow);
+            __m128 high = _mm_mul_ps(Osc_SineSSE2(phasesHigh), amplitudesHigh);
+            _mm_storeu_ps(buffer + frameIndex + 0, _mm_add_ps(_mm_loadu_ps(buffer + frameIndex + 0), low));
+            _mm_storeu_ps(buffer + frameIndex + 4, _mm_add_ps(_mm_loadu_ps(buffer + frameIndex + 4), high));
+
+            phasesLow = _mm_add_epi32(phasesLow, phaseStep);
+            phasesHigh = _mm_add_epi32(phasesHigh, phaseStep);
+            amplitudesLow = _mm_add_ps(amplitudesLow, amplitudesStep);
+            amplitudesHigh = _mm_add_ps(amplitudesHigh, amplitudesStep);
+        }
+    }
+
+    u32 phaseTail = *phase + increment * (u32)frameIndex;
+    for (; frameIndex < frameCount; ++frameIndex) {
+        buffer[frameIndex] += OscSine(phaseTail) * (amplitude + amplitudeStep * (f32)frameIndex);
+        phaseTail += increment;
+    }
+
+    *phase = phaseTail;
+}
+
+void
+OscBankRender(OscBank *bank, f32 *accumulator, usize frameCount) {
+    if (bank == NULL || accumulator == NULL || bank->Count == 0) {
+        return;
+    }
+
+    // NOTE(ilya.a): Amplitude change is spread over the whole render, so it doesn't click. [2026/10/18]
+    f32 amplitudeSteps[OSC_COUNT_MAX];
+    for (u32 index = 0; index < bank->Count; ++index) {
+        amplitudeSteps[index] =
+            frameCount > 0 ? (bank->TargetAmplitudes[index] - bank->Amplitudes[index]) / (f32)frameCount : 0.0f;
+    }
+
+    for (usize framesDone = 0; framesDone < frameCount;) {
+        usize framesLeft = frameCount - framesDone;
+        usize framesToRender = framesLeft < OSC_BLOCK_FRAMES ? framesLeft : OSC_BLOCK_FRAMES;
+
+        MemoryZero(bank->Buffer, framesToRender * sizeof(f32));
+
+        for (u32 index = 0; index < bank->Count; ++index) {
+            f32 amplitude = bank->Amplitudes[index] + amplitudeSteps[index] * (f32)framesDone;
+            Osc_Render(
+                bank, &bank->Phases[index], bank->Increments[index], amplitude, amplitudeSteps[index], bank->Buffer,
+                framesToRender);
+        }
+
+        for (usize frameIndex = 0; frameIndex < framesToRender; ++frameIndex) {
+            f32 sample = bank->Buffer[frameIndex];
+            accumulator[(framesDone + frameIndex) * 2 + 0] += sample;
+            accumulator[(framesDone + frameIndex) * 2 + 1] += sample;
+        }
+
+        framesDone += framesToRender;
+    }
+
+    for (u32 index = 0; index < bank->Count; ++index) {
+        bank->Amplitudes[index] = bank->TargetAmplitudes[index];
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * GFS. Sine oscillator bank.
+ *
+ * Every oscillator is a 32-bit phase accumulator: full range of `u32` is one period, so phase
+ * wraps for free and never loses precision, no matter how long it runs. Frequency is an
+ * increment of phase per frame, so changing it keeps phase continuous (no clicks). Sine is
+ * a polynomial, evaluated for 8 frames per SIMD step.
+ *
+ * FILE      gfs_osc.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_OSC_H_INCLUDED
+#define GFS_OSC_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define OSC_COUNT_MAX 16
+#define OSC_BLOCK_FRAMES 256
+#define OSC_SINE_ERROR_MAX 4e-6f // Of `OscSine` and SIMD paths against exact sine.
+
+/*
+ * Index of oscillator in the bank plus one. Zero is never valid.
+ */
+typedef u32 OscID;
+
+#define OSC_INVALID 0
+
+typedef struct {
+    u32 SampleRate;
+    bool IsAVX2Enabled;
+    u32 Count;
+
+    u32 Phases[OSC_COUNT_MAX];
+    u32 Increments[OSC_COUNT_MAX];
+    f32 Amplitudes[OSC_COUNT_MAX];
+    f32 TargetAmplitudes[OSC_COUNT_MAX]; // Amplitude is ramped towards it over next render.
+
+    f32 Buffer[OSC_BLOCK_FRAMES];
+} OscBank;
+
+OscBank OscBankMake(u32 sampleRate);
+
+/*
+ * Returns `OSC_INVALID` if bank is full.
+ */
+OscID OscBankAdd(OscBank *bank, f32 frequency, f32 amplitude);
+
+void OscBankSetFrequency(OscBank *bank, OscID id, f32 frequency);
+void OscBankSetAmplitude(OscBank *bank, OscID id, f32 amplitude);
+
+/*
+ * Adds sum of all oscillators to both channels of `frameCount` interleaved stereo frames.
+ */
+void OscBankRender(OscBank *bank, f32 *accumulator, usize frameCount);
+
+/*
+ * Sine of phase, where full range of `u32` is one period. Error is below `OSC_SINE_ERROR_MAX`.
+ */
+f32 OscSine(u32 phase);
+
+#endif // GFS_OSC_H_INCLUDED
@@ -0,0 +1,197 @@
+/*
+ * FILE      gfs_pack.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_pack.h"
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_string.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_lz.h"
+
+PackResult
+PackOpen(cstr8 archivePath, PackArchive *archiveOut) {
+    if (archivePath == NULL || archiveOut == NULL) {
+        return PACK_ERR_INVALID_ARGS;
+    }
+
+    IOFileMapping mapping;
+
+    if (IOMapFile(archivePath, &mapping, IO_ACCESS_RANDOM) != IO_OK) {
+        return PACK_ERR_FAILED_TO_MAP;
+    }
+
+    if (mapping.Size < sizeof(PackHeader)) {
+        IOUnmapFile(&mapping);
+        return PACK_ERR_CORRUPTED;
+    }
+
+    const PackHeader *header = (const PackHeader *)mapping.Data;
+
+    if (header->Magic != PACK_MAGIC) {
+        IOUnmapFile(&mapping);
+        return PACK_ERR_INVALID_MAGIC;
+    }
+
+    if (header->Version != PACK_VERSION) {
+        IOUnmapFile(&mapping);
+        return PACK_ERR_UNSUPPORTED_VERSION;
+    }
+
+    bool isSlotCountValid = header->SlotCount != 0 && (header->SlotCount & (header->SlotCount - 1)) == 0 &&
+                            header->EntryCount < header->SlotCount;
+    bool isTableInBounds = header->TableOffset <= mapping.Size &&
+                           (u64)header->SlotCount * sizeof(PackEntry) <= mapping.Size - header->TableOffset;
+
+    if (!isSlotCountValid || !isTableInBounds) {
+        IOUnmapFile(&mapping);
+        return PACK_ERR_CORRUPTED;
+    }
+
+    const PackEntry *entries = (const PackEntry *)((const byte *)mapping.Data + header->TableOffset);
+
+    u32 usedSlotCount = 0;
+
+    // NOTE(ilya.a): Validating bounds once here, so lookups could trust the table. [2026/10/18]
+    for (u32 slotIndex = 0; slotIndex < header->SlotCount; ++slotIndex) {
+        const PackEntry *entry = &entries[slotIndex];
+
+        if (entry->NameHash == 0) {
+            continue;
+        }
+
+        ++usedSlotCount;
+
+        bool isDataInBounds = entry->Offset <= mapping.Size && entry->Size <= mapping.Size - entry->Offset;
+        // NOTE(ilya.a): Compressed size is allocated by `PackLoadAsset` together with alignment
+        // padding. Cap keeps the sum far from overflow and bogus sizes out of the arena. [2026/10/18]
+        bool isSizeValid = HASANYBIT(entry->Flags, PACK_ENTRY_COMPRESSED)
+                               ? entry->UncompressedSize <= PACK_UNCOMPRESSED_SIZE_MAX
+                               : entry->Size == entry->UncompressedSize;
+        bool isAlignmentValid = entry->Alignment != 0 && (entry->Alignment & (entry->Alignment - 1)) == 0;
+
+        if (!isDataInBounds || !isSizeValid || !isAlignmentValid) {
+            IOUnmapFile(&mapping);
+            return PACK_ERR_CORRUPTED;
+        }
+    }
+
+    // NOTE(ilya.a): Header could lie about entry count. Table without empty slots would make
+    // probing of missing name endless. [2026/10/18]
+    if (usedSlotCount > header->EntryCount || usedSlotCount >= header->SlotCount) {
+        IOUnmapFile(&mapping);
+        return PACK_ERR_CORRUPTED;
+    }
+
+    archiveOut->Mapping = mapping;
+    archiveOut->Header = header;
+    archiveOut->Entries = entries;
+
+    return PACK_OK;
+}
+
+void
+PackClose(PackArchive *archive) {
+    if (archive == NULL) {
+        return;
+    }
+
+    IOUnmapFile(&archive->Mapping);
+    archive->Header = NULL;
+    archive->Entries = NULL;
+}
+
+const PackEntry *
+PackFind(const PackArchive *archive, u64 nameHash) {
+    if (archive == NULL || archive->Header == NULL || nameHash == 0) {
+        return NULL;
+    }
+
+    u32 mask = archive->Header->SlotCount - 1;
+    u32 slotIndex = (u32)nameHash & mask;
+
+    // NOTE(ilya.a): PackOpen made sure there is an empty slot, but probing is bounded anyway. [2026/10/18]
+    for (u32 probeIndex = 0; probeIndex < archive->Header->SlotCount; ++probeIndex) {
+        const PackEntry *entry = &archive->Entries[slotIndex];
+
+        if (entry->NameHash == nameHash) {
+            return entry;
+        }
+
+        if (entry->NameHash == 0) {
+            return NULL;
+        }
+
+        slotIndex = (slotIndex + 1) & mask;
+    }
+
+    return NULL;
+}
+
+const PackEntry *
+PackFindByName(const PackArchive *archive, cstr8 name) {
+    if (name == NULL) {
+        return NULL;
+    }
+    return PackFind(archive, CStr8Hash64(name));
+}
+
+const void *
+PackGetData(const PackArchive *archive, const PackEntry *entry) {
+    if (archive == NULL || entry == NULL) {
+        return NULL;
+    }
+    return (const byte *)archive->Mapping.Data + entry->Offset;
+}
+
+PackResult
+PackLoadAsset(const PackArchive *archive, const PackEntry *entry, ScratchAllocator *arena, const void **dataOut) {
+    if (archive == NULL || entry == NULL || dataOut == NULL) {
+        return PACK_ERR_INVALID_ARGS;
+    }
+
+    const void *data = PackGetData(archive, entry);
+
+    if (!HASANYBIT(entry->Flags, PACK_ENTRY_COMPRESSED)) {
+        *dataOut = data;
+        return PACK_OK;
+    }
+
+    if (arena == NULL) {
+        return PACK_ERR_INVALID_ARGS;
+    }
+
+    // NOTE(ilya.a): Scratch allocator doesn't align, so over-allocating and aligning by hand. [2026/10/18]
+    usize padding = entry->Alignment - 1;
+    byte *destination = ScratchAllocatorAlloc(arena, entry->UncompressedSize + padding);
+
+    if (destination == NULL) {
+        return PACK_ERR_OUT_OF_MEMORY;
+    }
+
+    destination = (byte *)(((usize)destination + padding) & ~padding);
+
+    LZFrameDecoder decoder;
+
+    if (LZFrameDecoderMake(data, entry->Size, &decoder) != LZ_OK ||
+        decoder.Header.ContentSize != entry->UncompressedSize ||
+        LZFrameDecompress(data, entry->Size, destination, entry->UncompressedSize) != LZ_OK) {
+        return PACK_ERR_CORRUPTED;
+    }
+
+    *dataOut = destination;
+    return PACK_OK;
+}
+
+u32
+PackGetSlotCount(u32 entryCount) {
+    u32 slotCount = 16;
+    while (slotCount < entryCount * 2 + 1) {
+        slotCount *= 2;
+    }
+    return slotCount;
+}
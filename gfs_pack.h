@@ -0,0 +1,111 @@
+/*
+ * GFS. Packed asset archive.
+ *
+ * Single file, which holds many assets. Layout:
+ *
+ *     PackHeader | PackEntry[SlotCount] | padding | asset data ...
+ *
+ * Table of contents is open-addressing hash table keyed by hash of asset name, so
+ * archive is mapped once and every lookup is O(1) without touching the filesystem.
+ * Archives are produced by `gfs_packer` tool.
+ *
+ * Entry payload might be stored as LZ frame (see gfs_lz.h). `PackLoadAsset` hides the
+ * difference: stored payloads are returned in place, compressed ones are decompressed
+ * into caller's arena.
+ *
+ * FILE      gfs_pack.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_PACK_H_INCLUDED
+#define GFS_PACK_H_INCLUDED
+
+#include "gfs_assert.h"
+#include "gfs_types.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+
+#define PACK_MAGIC 0x50534647 // "GFSP" in little endian.
+#define PACK_VERSION 2
+
+#define PACK_ALIGNMENT_DEFAULT 64
+#define PACK_UNCOMPRESSED_SIZE_MAX GIGABYTES(1) // Biggest compressed asset `PackOpen` accepts.
+
+typedef enum {
+    PACK_ASSET_TYPE_RAW = 0,
+    PACK_ASSET_TYPE_WAVE = 1,
+    PACK_ASSET_TYPE_BMP = 2,
+} PackAssetType;
+
+typedef struct {
+    u32 Magic;
+    u32 Version;
+    u32 EntryCount;
+    u32 SlotCount; // Size of hash table. Always power of two.
+    u64 TableOffset;
+    u64 DataOffset;
+} PackHeader;
+
+GFS_EXPECT_TYPE_SIZE(PackHeader, 32);
+
+typedef enum {
+    PACK_ENTRY_COMPRESSED = MKFLAG(0), // Payload is LZ frame.
+} PackEntryFlags;
+
+typedef struct {
+    u64 NameHash; // `CStr8Hash64` of asset name. Zero marks empty slot.
+    u64 Offset;   // From the beginning of archive.
+    u64 Size;     // Stored size.
+    u64 UncompressedSize;
+    u32 Type; // PackAssetType
+    u32 Alignment;
+    u32 Flags; // PackEntryFlags
+    u32 Reserved;
+} PackEntry;
+
+GFS_EXPECT_TYPE_SIZE(PackEntry, 48);
+
+typedef struct {
+    IOFileMapping Mapping;
+    const PackHeader *Header;
+    const PackEntry *Entries;
+} PackArchive;
+
+typedef enum {
+    PACK_OK,
+    PACK_ERR_INVALID_ARGS,
+    PACK_ERR_FAILED_TO_MAP,
+    PACK_ERR_INVALID_MAGIC,
+    PACK_ERR_UNSUPPORTED_VERSION,
+    PACK_ERR_CORRUPTED,
+    PACK_ERR_OUT_OF_MEMORY,
+} PackResult;
+
+PackResult PackOpen(cstr8 archivePath, PackArchive *archiveOut);
+void PackClose(PackArchive *archive);
+
+/*
+ * Returns NULL if there is no such asset.
+ */
+const PackEntry *PackFind(const PackArchive *archive, u64 nameHash);
+const PackEntry *PackFindByName(const PackArchive *archive, cstr8 name);
+
+/*
+ * Returns payload as it is stored in archive (might be compressed).
+ */
+const void *PackGetData(const PackArchive *archive, const PackEntry *entry);
+
+/*
+ * Returns uncompressed payload of `entry->UncompressedSize` bytes. Stored payload is returned
+ * without copy, compressed one is decompressed into `arena` with entry's alignment.
+ */
+PackResult PackLoadAsset(
+    const PackArchive *archive, const PackEntry *entry, ScratchAllocator *arena, const void **dataOut);
+
+/*
+ * Smallest power of two table size, which keeps load factor under 1/2.
+ */
+u32 PackGetSlotCount(u32 entryCount);
+
+#endif // GFS_PACK_H_INCLUDED
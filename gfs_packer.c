@@ -0,0 +1,264 @@
+/*
+ * GFS. Asset archive builder.
+ *
+ * Usage: gfs_packer [-c] <output.pack> <asset path>...
+ *
+ * With `-c` every asset is stored as LZ frame, unless it doesn't get smaller.
+ *
+ * Asset is stored under its path as it was typed, with backslashes replaced by forward
+ * slashes. Runtime looks it up with `PackFindByName`.
+ *
+ * FILE      gfs_packer.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_string.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_pack.h"
+#include "gfs_lz.h"
+#include "gfs_win32_misc.h"
+
+#define PACKER_NAME_CAPACITY MAX_PATH
+#define PACKER_WRITE_BUFFER_SIZE KILOBYTES(64)
+
+typedef struct {
+    cstr8 Path;
+    char8 Name[PACKER_NAME_CAPACITY];
+    IOFileMapping Mapping;
+    const void *StoredData; // Either mapped file or its compressed copy.
+    PackEntry *Entry;
+} PackerInput;
+
+internal u64
+Packer_AlignUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+internal PackAssetType
+Packer_GuessAssetType(cstr8 name) {
+    usize length = CStr8GetLength(name);
+    cstr8 extension = name + length;
+
+    while (extension > name && *extension != '.' && *extension != '/') {
+        --extension;
+    }
+
+    if (CStr8IsEqual(extension, ".wav") || CStr8IsEqual(extension, ".wave")) {
+        return PACK_ASSET_TYPE_WAVE;
+    }
+
+    if (CStr8IsEqual(extension, ".bmp")) {
+        return PACK_ASSET_TYPE_BMP;
+    }
+
+    return PACK_ASSET_TYPE_RAW;
+}
+
+internal bool
+Packer_NormalizeName(cstr8 path, char8 *nameOut) {
+    usize length = CStr8GetLength(path);
+
+    if (length == 0 || length >= PACKER_NAME_CAPACITY) {
+        return false;
+    }
+
+    for (usize i = 0; i <= length; ++i) {
+        nameOut[i] = path[i] == '\\' ? '/' : path[i];
+    }
+
+    return true;
+}
+
+/*
+ * Inserts entry into hash table. Returns NULL, if there is already entry with the same hash.
+ */
+internal PackEntry *
+Packer_InsertEntry(PackEntry *table, u32 slotCount, u64 nameHash) {
+    u32 mask = slotCount - 1;
+    u32 slotIndex = (u32)nameHash & mask;
+
+    while (table[slotIndex].NameHash != 0) {
+        if (table[slotIndex].NameHash == nameHash) {
+            return NULL;
+        }
+        slotIndex = (slotIndex + 1) & mask;
+    }
+
+    table[slotIndex].NameHash = nameHash;
+    return &table[slotIndex];
+}
+
+internal void
+Packer_PrintError(cstr8 message, cstr8 argument) {
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(printBuffer, "E: %s: '%s'\n", message, argument);
+    Win32_Print(printBuffer);
+}
+
+/*
+ * Stores input as LZ frame if it pays off. Compressed copy lives in `allocator`.
+ */
+internal bool
+Packer_CompressInput(BlockAllocator *allocator, PackerInput *input) {
+    // NOTE(ilya.a): `PackOpen` rejects compressed entries bigger than this, so those are stored.
+    // Empty input is stored too, frame of it would only be bigger. [2026/10/18]
+    if (input->Mapping.Size == 0 || input->Mapping.Size > PACK_UNCOMPRESSED_SIZE_MAX) {
+        return true;
+    }
+
+    usize capacity = LZFrameCompressBound(input->Mapping.Size, LZ_FRAME_BLOCK_SIZE_DEFAULT);
+    void *frame = BlockAllocatorAlloc(allocator, capacity);
+
+    if (frame == NULL) {
+        return false;
+    }
+
+    usize frameSize =
+        LZFrameCompress(input->Mapping.Data, input->Mapping.Size, frame, capacity, LZ_FRAME_BLOCK_SIZE_DEFAULT);
+
+    if (frameSize == 0) {
+        return false;
+    }
+
+    if (frameSize < input->Mapping.Size) {
+        input->StoredData = frame;
+        input->Entry->Size = frameSize;
+        input->Entry->Flags |= PACK_ENTRY_COMPRESSED;
+    }
+
+    return true;
+}
+
+internal int
+Packer_Run(BlockAllocator *allocator, cstr8 outputPath, cstr8 *inputPaths, u32 inputCount, bool isCompressing) {
+    PackerInput *inputs = BlockAllocatorAllocZ(allocator, sizeof(PackerInput) * inputCount);
+    u32 slotCount = PackGetSlotCount(inputCount);
+    PackEntry *table = BlockAllocatorAllocZ(allocator, sizeof(PackEntry) * slotCount);
+
+    if (inputs == NULL || table == NULL) {
+        Win32_Print("E: Out of memory!\n");
+        return 1;
+    }
+
+    u64 tableOffset = sizeof(PackHeader);
+    u64 dataOffset = Packer_AlignUp(tableOffset + (u64)slotCount * sizeof(PackEntry), PACK_ALIGNMENT_DEFAULT);
+    u64 offset = dataOffset;
+
+    for (u32 inputIndex = 0; inputIndex < inputCount; ++inputIndex) {
+        PackerInput *input = &inputs[inputIndex];
+        input->Path = inputPaths[inputIndex];
+
+        if (!Packer_NormalizeName(input->Path, input->Name)) {
+            Packer_PrintError("Invalid asset name", input->Path);
+            return 1;
+        }
+
+        if (IOMapFile(input->Path, &input->Mapping, IO_ACCESS_SEQUENTIAL) != IO_OK) {
+            Packer_PrintError("Failed to open asset", input->Path);
+            return 1;
+        }
+
+        u64 nameHash = CStr8Hash64(input->Name);
+        input->Entry = nameHash != 0 ? Packer_InsertEntry(table, slotCount, nameHash) : NULL;
+
+        if (input->Entry == NULL) {
+            Packer_PrintError("Duplicate asset name or hash collision", input->Name);
+            return 1;
+        }
+
+        offset = Packer_AlignUp(offset, PACK_ALIGNMENT_DEFAULT);
+
+        input->StoredData = input->Mapping.Data;
+        input->Entry->Offset = offset;
+        input->Entry->Size = input->Mapping.Size;
+        input->Entry->UncompressedSize = input->Mapping.Size;
+        input->Entry->Type = Packer_GuessAssetType(input->Name);
+        input->Entry->Alignment = PACK_ALIGNMENT_DEFAULT;
+
+        if (isCompressing && !Packer_CompressInput(allocator, input)) {
+            Packer_PrintError("Failed to compress asset", input->Path);
+            return 1;
+        }
+
+        offset += input->Entry->Size;
+    }
+
+    PackHeader header = {0};
+    header.Magic = PACK_MAGIC;
+    header.Version = PACK_VERSION;
+    header.EntryCount = inputCount;
+    header.SlotCount = slotCount;
+    header.TableOffset = tableOffset;
+    header.DataOffset = dataOffset;
+
+    FileHandle output;
+    void *outputBuffer = BlockAllocatorAlloc(allocator, PACKER_WRITE_BUFFER_SIZE);
+
+    if (outputBuffer == NULL) {
+        Win32_Print("E: Out of memory!\n");
+        return 1;
+    }
+
+    if (IOCreateFile(outputPath, &output) != IO_OK) {
+        Packer_PrintError("Failed to create archive", outputPath);
+        return 1;
+    }
+
+    // NOTE(ilya.a): Header, table and paddings are coalesced in the buffer, while big payloads
+    // go straight to the file. [2026/10/18]
+    IOWriter writer = IOWriterMake(output, outputBuffer, PACKER_WRITE_BUFFER_SIZE);
+
+    bool isWritten = IOWriterWrite(&writer, &header, sizeof(header)) == IO_OK &&
+                     IOWriterWrite(&writer, table, sizeof(PackEntry) * slotCount) == IO_OK;
+
+    for (u32 inputIndex = 0; isWritten && inputIndex < inputCount; ++inputIndex) {
+        PackerInput *input = &inputs[inputIndex];
+
+        isWritten = IOWriterWriteZeros(&writer, input->Entry->Offset - writer.BytesWritten) == IO_OK &&
+                    IOWriterWrite(&writer, input->StoredData, input->Entry->Size) == IO_OK;
+
+        IOUnmapFile(&input->Mapping);
+    }
+
+    u64 written = writer.BytesWritten;
+
+    if (IOWriterClose(&writer) != IO_OK) {
+        isWritten = false;
+    }
+
+    if (!isWritten) {
+        Packer_PrintError("Failed to write archive", outputPath);
+        return 1;
+    }
+
+    char8 printBuffer[KILOBYTES(1)];
+    wsprintfA(printBuffer, "I: Packed %u assets into '%s' (%u bytes)\n", inputCount, outputPath, (u32)written);
+    Win32_Print(printBuffer);
+
+    return 0;
+}
+
+int
+main(int argc, char **argv) {
+    bool isCompressing = argc > 1 && CStr8IsEqual(argv[1], "-c");
+    int argumentIndex = isCompressing ? 2 : 1;
+
+    if (argc - argumentIndex < 2) {
+        Win32_Print("Usage: gfs_packer [-c] <output.pack> <asset path>...\n");
+        return 1;
+    }
+
+    BlockAllocator allocator = BlockAllocatorMake();
+    int result = Packer_Run(
+        &allocator, argv[argumentIndex], (cstr8 *)(argv + argumentIndex + 1), (u32)(argc - argumentIndex - 1),
+        isCompressing);
+    BlockAllocatorFree(&allocator);
+
+    return result;
+}
@@ -0,0 +1,502 @@
+/*
+ * FILE      gfs_pcm.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_pcm.h"
+
+#include <immintrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+#include "gfs_wave.h"
+
+#define PCM_BLOCK_SIZE 256 // Samples quantized at once, before packing.
+
+#define PCM_SCALE_U8 128.0f
+#define PCM_SCALE_I16 32768.0f
+#define PCM_SCALE_I24 8388608.0f
+#define PCM_SCALE_I32 2147483648.0f
+
+// NOTE(ilya.a): 2^31 - 1 isn't representable in f32 and rounds up to 2^31, which overflows
+// conversion. This is the largest f32 below it. [2026/10/18]
+#define PCM_I32_MAX_F32 2147483520.0f
+
+bool
+PCMFormatFromWave(u16 audioFormat, u16 bitsPerSample, PCMFormat *formatOut) {
+    if (audioFormat == WAVEFILE_AUDIOFORMAT_IIEE_FLT && bitsPerSample == 32) {
+        *formatOut = PCM_FORMAT_F32;
+        return true;
+    }
+
+    if (audioFormat != WAVEFILE_AUDIOFORMAT_PCM) {
+        return false;
+    }
+
+    switch (bitsPerSample) {
+    case 8: {
+        *formatOut = PCM_FORMAT_U8;
+    } break;
+    case 16: {
+        *formatOut = PCM_FORMAT_I16;
+    } break;
+    case 24: {
+        *formatOut = PCM_FORMAT_I24;
+    } break;
+    case 32: {
+        *formatOut = PCM_FORMAT_I32;
+    } break;
+    default: {
+        return false;
+    } break;
+    }
+
+    return true;
+}
+
+u32
+PCMFormatGetSize(PCMFormat format) {
+    persist_var const u32 sizes[PCM_FORMAT_COUNT] = {2, 1, 3, 4, 4};
+    return format < PCM_FORMAT_COUNT ? sizes[format] : 0;
+}
+
+void
+PCMDitherInit(PCMDither *dither, u32 seed) {
+    // NOTE(ilya.a): Xorshift never leaves zero, so every lane gets distinct non-zero seed. [2026/10/18]
+    for (u32 laneIndex = 0; laneIndex < 8; ++laneIndex) {
+        u32 state = (seed + laneIndex + 1) * 0x9E3779B9u;
+        dither->State[laneIndex] = state != 0 ? state : 0x6D2B79F5u;
+    }
+}
+
+//
+// To f32.
+//
+
+internal i32
+PCM_ReadI24(const byte *sample) {
+    return (i32)((u32)sample[0] << 8 | (u32)sample[1] << 16 | (u32)sample[2] << 24) >> 8;
+}
+
+internal void
+PCM_ConvertToF32Scalar(PCMFormat format, const void *source, f32 *destination, usize sampleCount) {
+    const byte *input = (const byte *)source;
+
+    for (usize sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
+        switch (format) {
+        case PCM_FORMAT_U8: {
+            destination[sampleIndex] = ((f32)input[sampleIndex] - 128.0f) * (1.0f / PCM_SCALE_U8);
+        } break;
+        case PCM_FORMAT_I16: {
+            destination[sampleIndex] = (f32)((const i16 *)source)[sampleIndex] * (1.0f / PCM_SCALE_I16);
+        } break;
+        case PCM_FORMAT_I24: {
+            destination[sampleIndex] = (f32)PCM_ReadI24(input + sampleIndex * 3) * (1.0f / PCM_SCALE_I24);
+        } break;
+        case PCM_FORMAT_I32: {
+            destination[sampleIndex] = (f32)((const i32 *)source)[sampleIndex] * (1.0f / PCM_SCALE_I32);
+        } break;
+        default: {
+            destination[sampleIndex] = 0.0f;
+        } break;
+        }
+    }
+}
+
+internal usize
+PCM_ConvertToF32SSE2(PCMFormat format, const void *source, f32 *destination, usize sampleCount) {
+    usize sampleIndex = 0;
+
+    switch (format) {
+    case PCM_FORMAT_U8: {
+        __m128i zero = _mm_setzero_si128();
+        __m128i bias = _mm_set1_epi16(128);
+        __m128 scale = _mm_set1_ps(1.0f / PCM_SCALE_U8);
+
+        for (; sampleIndex + 16 <= sampleCount; sampleIndex += 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i *)((const u8 *)source + sampleIndex));
+            __m128i low = _mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), bias);
+            __m128i high = _mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), bias);
+
+            __m128i words[4] = {
+                _mm_unpacklo_epi16(low, low),
+                _mm_unpackhi_epi16(low, low),
+                _mm_unpacklo_epi16(high, high),
+                _mm_unpackhi_epi16(high, high),
+            };
+
+            for (u32 wordIndex = 0; wordIndex < 4; ++wordIndex) {
+                __m128 values = _mm_cvtepi32_ps(_mm_srai_epi32(words[wordIndex], 16));
+                _mm_storeu_ps(destination + sampleIndex + wordIndex * 4, _mm_mul_ps(values, scale));
+            }
+        }
+    } break;
+    case PCM_FORMAT_I16: {
+        __m128 scale = _mm_set1_ps(1.0f / PCM_SCALE_I16);
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m128i samples = _mm_loadu_si128((const __m128i *)((const i16 *)source + sampleIndex));
+            // NOTE(ilya.a): Sign extension without SSE4.1, same as in mixer. [2026/10/18]
+            __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+            __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+            _mm_storeu_ps(destination + sampleIndex + 0, _mm_mul_ps(low, scale));
+            _mm_storeu_ps(destination + sampleIndex + 4, _mm_mul_ps(high, scale));
+        }
+    } break;
+    case PCM_FORMAT_I32: {
+        __m128 scale = _mm_set1_ps(1.0f / PCM_SCALE_I32);
+
+        for (; sampleIndex + 4 <= sampleCount; sampleIndex += 4) {
+            __m128i samples = _mm_loadu_si128((const __m128i *)((const i32 *)source + sampleIndex));
+            _mm_storeu_ps(destination + sampleIndex, _mm_mul_ps(_mm_cvtepi32_ps(samples), scale));
+        }
+    } break;
+    default: {
+    } break;
+    }
+
+    return sampleIndex;
+}
+
+internal usize
+PCM_ConvertToF32AVX2(PCMFormat format, const void *source, f32 *destination, usize sampleCount) {
+    usize sampleIndex = 0;
+
+    switch (format) {
+    case PCM_FORMAT_U8: {
+        __m256i bias = _mm256_set1_epi32(128);
+        __m256 scale = _mm256_set1_ps(1.0f / PCM_SCALE_U8);
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m128i bytes = _mm_loadl_epi64((const __m128i *)((const u8 *)source + sampleIndex));
+            __m256i samples = _mm256_sub_epi32(_mm256_cvtepu8_epi32(bytes), bias);
+            _mm256_storeu_ps(destination + sampleIndex, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+    } break;
+    case PCM_FORMAT_I16: {
+        __m256 scale = _mm256_set1_ps(1.0f / PCM_SCALE_I16);
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m128i samples = _mm_loadu_si128((const __m128i *)((const i16 *)source + sampleIndex));
+            __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(samples));
+            _mm256_storeu_ps(destination + sampleIndex, _mm256_mul_ps(values, scale));
+        }
+    } break;
+    case PCM_FORMAT_I24: {
+        // NOTE(ilya.a): Every lane takes 12 bytes (4 samples) and puts each sample into the top
+        // three bytes of 32-bit integer, then arithmetic shift does sign extension. [2026/10/18]
+        __m256i shuffle = _mm256_setr_epi8(
+            -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10,
+            11);
+        __m256 scale = _mm256_set1_ps(1.0f / PCM_SCALE_I24);
+        const byte *input = (const byte *)source;
+
+        // NOTE(ilya.a): Second load reads 16 bytes from 12th, so 4 bytes past 8 samples. [2026/10/18]
+        for (; sampleIndex + 10 <= sampleCount; sampleIndex += 8) {
+            __m128i low = _mm_loadu_si128((const __m128i *)(input + sampleIndex * 3));
+            __m128i high = _mm_loadu_si128((const __m128i *)(input + sampleIndex * 3 + 12));
+            __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            __m256i samples = _mm256_srai_epi32(_mm256_shuffle_epi8(bytes, shuffle), 8);
+            _mm256_storeu_ps(destination + sampleIndex, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+    } break;
+    case PCM_FORMAT_I32: {
+        __m256 scale = _mm256_set1_ps(1.0f / PCM_SCALE_I32);
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m256i samples = _mm256_loadu_si256((const __m256i *)((const i32 *)source + sampleIndex));
+            _mm256_storeu_ps(destination + sampleIndex, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+    } break;
+    default: {
+    } break;
+    }
+
+    return sampleIndex;
+}
+
+void
+PCMConvertToF32(PCMFormat format, const void *source, f32 *destination, usize sampleCount) {
+    if (format == PCM_FORMAT_F32) {
+        MemoryCopy(destination, source, sampleCount * sizeof(f32));
+        return;
+    }
+
+    usize samplesDone = 0;
+
+    if (SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2)) {
+        samplesDone = PCM_ConvertToF32AVX2(format, source, destination, sampleCount);
+    } else {
+        samplesDone = PCM_ConvertToF32SSE2(format, source, destination, sampleCount);
+    }
+
+    PCM_ConvertToF32Scalar(
+        format, (const byte *)source + samplesDone * PCMFormatGetSize(format), destination + samplesDone,
+        sampleCount - samplesDone);
+}
+
+//
+// From f32.
+//
+
+/*
+ * Xorshift32 in every lane. Two draws make triangular noise in (-1, 1).
+ */
+internal __m128
+PCM_DitherSSE2(__m128i *state) {
+    __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+    __m128 noise[2];
+
+    for (u32 drawIndex = 0; drawIndex < 2; ++drawIndex) {
+        __m128i x = *state;
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+        *state = x;
+        noise[drawIndex] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), scale);
+    }
+
+    return _mm_sub_ps(noise[0], noise[1]);
+}
+
+internal __m256
+PCM_DitherAVX2(__m256i *state) {
+    __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+    __m256 noise[2];
+
+    for (u32 drawIndex = 0; drawIndex < 2; ++drawIndex) {
+        __m256i x = *state;
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+        *state = x;
+        noise[drawIndex] = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)), scale);
+    }
+
+    return _mm256_sub_ps(noise[0], noise[1]);
+}
+
+internal f32
+PCM_DitherScalar(u32 *state) {
+    f32 noise[2];
+
+    for (u32 drawIndex = 0; drawIndex < 2; ++drawIndex) {
+        u32 x = *state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        *state = x;
+        noise[drawIndex] = (f32)(x >> 8) * (1.0f / 16777216.0f);
+    }
+
+    return noise[0] - noise[1];
+}
+
+/*
+ * Scales, dithers, clamps and rounds (to nearest even) into 32-bit integers.
+ */
+internal void
+PCM_Quantize(
+    const f32 *source, i32 *destination, usize sampleCount, f32 scale, f32 minimum, f32 maximum,
+    PCMDither *dither) {
+    usize sampleIndex = 0;
+
+    if (SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2)) {
+        __m256 scales = _mm256_set1_ps(scale);
+        __m256 minimums = _mm256_set1_ps(minimum);
+        __m256 maximums = _mm256_set1_ps(maximum);
+        __m256i state = dither != NULL ? _mm256_loadu_si256((const __m256i *)dither->State) : _mm256_setzero_si256();
+
+        for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+            __m256 values = _mm256_mul_ps(_mm256_loadu_ps(source + sampleIndex), scales);
+            if (dither != NULL) {
+                values = _mm256_add_ps(values, PCM_DitherAVX2(&state));
+            }
+            values = _mm256_min_ps(_mm256_max_ps(values, minimums), maximums);
+            _mm256_storeu_si256((__m256i *)(destination + sampleIndex), _mm256_cvtps_epi32(values));
+        }
+
+        if (dither != NULL) {
+            _mm256_storeu_si256((__m256i *)dither->State, state);
+        }
+    } else {
+        __m128 scales = _mm_set1_ps(scale);
+        __m128 minimums = _mm_set1_ps(minimum);
+        __m128 maximums = _mm_set1_ps(maximum);
+        __m128i state = dither != NULL ? _mm_loadu_si128((const __m128i *)dither->State) : _mm_setzero_si128();
+
+        for (; sampleIndex + 4 <= sampleCount; sampleIndex += 4) {
+            __m128 values = _mm_mul_ps(_mm_loadu_ps(source + sampleIndex), scales);
+            if (dither != NULL) {
+                values = _mm_add_ps(values, PCM_DitherSSE2(&state));
+            }
+            values = _mm_min_ps(_mm_max_ps(values, minimums), maximums);
+            _mm_storeu_si128((__m128i *)(destination + sampleIndex), _mm_cvtps_epi32(values));
+        }
+
+        if (dither != NULL) {
+            _mm_storeu_si128((__m128i *)dither->State, state);
+        }
+    }
+
+    for (; sampleIndex < sampleCount; ++sampleIndex) {
+        f32 value = source[sampleIndex] * scale;
+        if (dither != NULL) {
+            value += PCM_DitherScalar(&dither->State[0]);
+        }
+        value = value < minimum ? minimum : (value > maximum ? maximum : value);
+        destination[sampleIndex] = _mm_cvtss_si32(_mm_set_ss(value));
+    }
+}
+
+void
+PCMConvertFromF32(PCMFormat format, const f32 *source, void *destination, usize sampleCount, PCMDither *dither) {
+    if (format == PCM_FORMAT_F32) {
+        MemoryCopy(destination, source, sampleCount * sizeof(f32));
+        return;
+    }
+
+    if (format == PCM_FORMAT_I32) {
+        PCM_Quantize(source, destination, sampleCount, PCM_SCALE_I32, -PCM_SCALE_I32, PCM_I32_MAX_F32, NULL);
+        return;
+    }
+
+    i32 block[PCM_BLOCK_SIZE];
+
+    for (usize samplesDone = 0; samplesDone < sampleCount;) {
+        usize samplesLeft = sampleCount - samplesDone;
+        usize samplesToConvert = samplesLeft < PCM_BLOCK_SIZE ? samplesLeft : PCM_BLOCK_SIZE;
+        usize sampleIndex = 0;
+
+        switch (format) {
+        case PCM_FORMAT_U8: {
+            PCM_Quantize(source + samplesDone, block, samplesToConvert, PCM_SCALE_U8, -128.0f, 127.0f, dither);
+            u8 *output = (u8 *)destination + samplesDone;
+            __m128i bias = _mm_set1_epi16(128);
+
+            for (; sampleIndex + 16 <= samplesToConvert; sampleIndex += 16) {
+                const __m128i *input = (const __m128i *)(block + sampleIndex);
+                __m128i low = _mm_packs_epi32(_mm_loadu_si128(input + 0), _mm_loadu_si128(input + 1));
+                __m128i high = _mm_packs_epi32(_mm_loadu_si128(input + 2), _mm_loadu_si128(input + 3));
+                __m128i bytes = _mm_packus_epi16(_mm_add_epi16(low, bias), _mm_add_epi16(high, bias));
+                _mm_storeu_si128((__m128i *)(output + sampleIndex), bytes);
+            }
+
+            for (; sampleIndex < samplesToConvert; ++sampleIndex) {
+                output[sampleIndex] = (u8)(block[sampleIndex] + 128);
+            }
+        } break;
+        case PCM_FORMAT_I16: {
+            PCM_Quantize(source + samplesDone, block, samplesToConvert, PCM_SCALE_I16, -32768.0f, 32767.0f, dither);
+            i16 *output = (i16 *)destination + samplesDone;
+
+            for (; sampleIndex + 8 <= samplesToConvert; sampleIndex += 8) {
+                const __m128i *input = (const __m128i *)(block + sampleIndex);
+                __m128i packed = _mm_packs_epi32(_mm_loadu_si128(input + 0), _mm_loadu_si128(input + 1));
+                _mm_storeu_si128((__m128i *)(output + sampleIndex), packed);
+            }
+
+            for (; sampleIndex < samplesToConvert; ++sampleIndex) {
+                output[sampleIndex] = (i16)block[sampleIndex];
+            }
+        } break;
+        case PCM_FORMAT_I24: {
+            PCM_Quantize(
+                source + samplesDone, block, samplesToConvert, PCM_SCALE_I24, -PCM_SCALE_I24, PCM_SCALE_I24 - 1.0f,
+                dither);
+            byte *output = (byte *)destination + samplesDone * 3;
+
+            for (; sampleIndex < samplesToConvert; ++sampleIndex) {
+                u32 value = (u32)block[sampleIndex];
+                output[sampleIndex * 3 + 0] = (byte)(value);
+                output[sampleIndex * 3 + 1] = (byte)(value >> 8);
+                output[sampleIndex * 3 + 2] = (byte)(value >> 16);
+            }
+        } break;
+        default: {
+            return;
+        } break;
+        }
+
+        samplesDone += samplesToConvert;
+    }
+}
+
+//
+// Layout.
+//
+
+void
+PCMInterleaveF32(const f32 *const *planes, u32 channelCount, f32 *destination, usize frameCount) {
+    usize frameIndex = 0;
+
+    if (channelCount == 2) {
+        for (; frameIndex + 4 <= frameCount; frameIndex += 4) {
+            __m128 left = _mm_loadu_ps(planes[0] + frameIndex);
+            __m128 right = _mm_loadu_ps(planes[1] + frameIndex);
+            _mm_storeu_ps(destination + frameIndex * 2 + 0, _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(destination + frameIndex * 2 + 4, _mm_unpackhi_ps(left, right));
+        }
+    }
+
+    for (; frameIndex < frameCount; ++frameIndex) {
+        for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+            destination[frameIndex * channelCount + channelIndex] = planes[channelIndex][frameIndex];
+        }
+    }
+}
+
+void
+PCMDeinterleaveF32(const f32 *source, u32 channelCount, f32 *const *planes, usize frameCount) {
+    usize frameIndex = 0;
+
+    if (channelCount == 2) {
+        for (; frameIndex + 4 <= frameCount; frameIndex += 4) {
+            __m128 a = _mm_loadu_ps(source + frameIndex * 2 + 0); // L0 R0 L1 R1
+            __m128 b = _mm_loadu_ps(source + frameIndex * 2 + 4); // L2 R2 L3 R3
+            _mm_storeu_ps(planes[0] + frameIndex, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(planes[1] + frameIndex, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+
+    for (; frameIndex < frameCount; ++frameIndex) {
+        for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+            planes[channelIndex][frameIndex] = source[frameIndex * channelCount + channelIndex];
+        }
+    }
+}
+
+void
+PCMMonoToStereoF32(const f32 *source, f32 *destination, usize frameCount) {
+    usize frameIndex = 0;
+
+    for (; frameIndex + 4 <= frameCount; frameIndex += 4) {
+        __m128 samples = _mm_loadu_ps(source + frameIndex);
+        _mm_storeu_ps(destination + frameIndex * 2 + 0, _mm_unpacklo_ps(samples, samples));
+        _mm_storeu_ps(destination + frameIndex * 2 + 4, _mm_unpackhi_ps(samples, samples));
+    }
+
+    for (; frameIndex < frameCount; ++frameIndex) {
+        destination[frameIndex * 2 + 0] = source[frameIndex];
+        destination[frameIndex * 2 + 1] = source[frameIndex];
+    }
+}
+
+void
+PCMMonoToStereoI16(const i16 *source, i16 *destination, usize frameCount) {
+    usize frameIndex = 0;
+
+    for (; frameIndex + 8 <= frameCount; frameIndex += 8) {
+        __m128i samples = _mm_loadu_si128((const __m128i *)(source + frameIndex));
+        _mm_storeu_si128((__m128i *)(destination + frameIndex * 2 + 0), _mm_unpacklo_epi16(samples, samples));
+        _mm_storeu_si128((__m128i *)(destination + frameIndex * 2 + 8), _mm_unpackhi_epi16(samples, samples));
+    }
+
+    for (; frameIndex < frameCount; ++frameIndex) {
+        destination[frameIndex * 2 + 0] = source[frameIndex];
+        destination[frameIndex * 2 + 1] = source[frameIndex];
+    }
+}
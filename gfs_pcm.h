@@ -0,0 +1,65 @@
+/*
+ * GFS. PCM sample format conversion.
+ *
+ * Kernels convert between every PCM variant wave files could have (unsigned 8-bit, signed
+ * 16, packed 24 and 32-bit, IEEE float) and normalized f32, where integer full scale maps to
+ * [-1, 1). Conversion from f32 clamps and optionally adds triangular dither of one LSB before
+ * rounding, so quantization error is noise instead of distortion. Integer round trips through
+ * f32 are bit-exact (except i32, which f32 can't hold).
+ *
+ * Kernels are AVX2 if CPU has it, SSE2 otherwise. Layout helpers are separate: interleaved to
+ * planar and back, mono to stereo.
+ *
+ * FILE      gfs_pcm.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_PCM_H_INCLUDED
+#define GFS_PCM_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+typedef enum {
+    PCM_FORMAT_I16, // First, so zeroed descriptions mean 16-bit.
+    PCM_FORMAT_U8,
+    PCM_FORMAT_I24, // Packed little-endian, 3 bytes per sample.
+    PCM_FORMAT_I32,
+    PCM_FORMAT_F32,
+    PCM_FORMAT_COUNT,
+} PCMFormat;
+
+/*
+ * Maps wave file's `AudioFormat` and `BitsPerSample`. Returns false, if they aren't supported.
+ */
+bool PCMFormatFromWave(u16 audioFormat, u16 bitsPerSample, PCMFormat *formatOut);
+
+u32 PCMFormatGetSize(PCMFormat format);
+
+/*
+ * State of dither noise generator. Per stream, so streams don't correlate.
+ */
+typedef struct {
+    u32 State[8];
+} PCMDither;
+
+void PCMDitherInit(PCMDither *dither, u32 seed);
+
+/*
+ * Layout doesn't matter: `sampleCount` is number of samples, not frames.
+ */
+void PCMConvertToF32(PCMFormat format, const void *source, f32 *destination, usize sampleCount);
+
+/*
+ * Clamps into destination range. If `dither` isn't NULL, dithers 8, 16 and 24-bit output.
+ */
+void PCMConvertFromF32(PCMFormat format, const f32 *source, void *destination, usize sampleCount, PCMDither *dither);
+
+void PCMInterleaveF32(const f32 *const *planes, u32 channelCount, f32 *destination, usize frameCount);
+void PCMDeinterleaveF32(const f32 *source, u32 channelCount, f32 *const *planes, usize frameCount);
+
+void PCMMonoToStereoF32(const f32 *source, f32 *destination, usize frameCount);
+void PCMMonoToStereoI16(const i16 *source, i16 *destination, usize frameCount);
+
+#endif // GFS_PCM_H_INCLUDED
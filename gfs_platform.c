@@ -0,0 +1,107 @@
+/*
+ * FILE      gfs_platform.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_platform.h"
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_input.h"
+#include "gfs_game.h"
+#include "gfs_bmr.h"
+#include "gfs_osc.h"
+#include "gfs_dsp.h"
+#include "gfs_mixer.h"
+#include "gfs_audio.h"
+
+void
+PlatformAudioInit(PlatformAudio *audio, AudioSystem *system) {
+    audio->System = system;
+    audio->Tone = OscBankAdd(&system->Tones, GAME_TONE_HZ, PLATFORM_AUDIO_TONE_VOLUME);
+
+    // NOTE(ilya.a): Triggers muffle the music and add echo to it. Both are off by default. [2026/10/18]
+    DSPChain *musicBus = MixerGetBus(&system->Mixer, PLATFORM_AUDIO_MUSIC_BUS);
+    audio->MusicFilter = DSPChainAddBiquad(musicBus, DSP_BIQUAD_LOWPASS, 2, PLATFORM_AUDIO_MUSIC_CUTOFF_HZ, 0.707f);
+    audio->MusicEcho =
+        DSPChainAddDelay(musicBus, 1.0f, PLATFORM_AUDIO_MUSIC_ECHO_SECONDS, PLATFORM_AUDIO_MUSIC_ECHO_FEEDBACK, 0.0f);
+}
+
+internal void
+Platform_SendAudio(PlatformAudio *audio, const GameState *game) {
+    f32 musicCutoff = PLATFORM_AUDIO_MUSIC_CUTOFF_HZ +
+                      (PLATFORM_AUDIO_MUSIC_MUFFLED_HZ - PLATFORM_AUDIO_MUSIC_CUTOFF_HZ) * game->MusicMuffle;
+    u32 bus = PLATFORM_AUDIO_MUSIC_BUS;
+
+    AudioSystemSetToneFrequency(audio->System, audio->Tone, game->ToneFrequency);
+    AudioSystemSetBusParameter(audio->System, bus, audio->MusicFilter, DSP_PARAM_FREQUENCY, musicCutoff);
+    AudioSystemSetBusParameter(audio->System, bus, audio->MusicEcho, DSP_PARAM_MIX, 0.5f * game->MusicEcho);
+}
+
+bool
+PlatformRunFrame(
+    Platform *platform, GameState *game, GameState *previousGame, u32 tickCount, f32 alpha,
+    PlatformFrameTimings *timingsOut) {
+    LARGE_INTEGER stageEnd[PLATFORM_STAGE_COUNT + 1];
+    u64 inputElapsed = 0;
+    u64 updateElapsed = 0;
+
+    for (u32 tickIndex = 0; tickIndex < tickCount; ++tickIndex) {
+        LARGE_INTEGER tickStart, inputEnd, updateEnd;
+        QueryPerformanceCounter(&tickStart);
+
+        InputSnapshot input = {0};
+
+        if (!platform->GetInput(platform, game->Frame, &input)) {
+            return false;
+        }
+
+        QueryPerformanceCounter(&inputEnd);
+
+        *previousGame = *game;
+        GameUpdate(game, &input);
+
+        QueryPerformanceCounter(&updateEnd);
+        inputElapsed += (u64)(inputEnd.QuadPart - tickStart.QuadPart);
+        updateElapsed += (u64)(updateEnd.QuadPart - inputEnd.QuadPart);
+    }
+
+    QueryPerformanceCounter(&stageEnd[PLATFORM_STAGE_RENDER]);
+
+    GameState view;
+    GameInterpolate(previousGame, game, alpha, &view);
+
+    BMR_BeginDrawing(&platform->Renderer);
+    GameRender(&view, &platform->Renderer);
+    BMR_EndDrawing(&platform->Renderer);
+
+    QueryPerformanceCounter(&stageEnd[PLATFORM_STAGE_RENDER + 1]);
+
+    if (platform->Present != NULL) {
+        platform->Present(platform);
+    }
+
+    QueryPerformanceCounter(&stageEnd[PLATFORM_STAGE_PRESENT + 1]);
+
+    if (platform->Audio.System != NULL) {
+        Platform_SendAudio(&platform->Audio, game);
+    }
+
+    if (platform->MixAudio != NULL) {
+        platform->MixAudio(platform);
+    }
+
+    QueryPerformanceCounter(&stageEnd[PLATFORM_STAGE_AUDIO + 1]);
+
+    timingsOut->Elapsed[PLATFORM_STAGE_INPUT] = inputElapsed;
+    timingsOut->Elapsed[PLATFORM_STAGE_UPDATE] = updateElapsed;
+
+    for (u32 stage = PLATFORM_STAGE_RENDER; stage < PLATFORM_STAGE_COUNT; ++stage) {
+        timingsOut->Elapsed[stage] = (u64)(stageEnd[stage + 1].QuadPart - stageEnd[stage].QuadPart);
+    }
+
+    return true;
+}
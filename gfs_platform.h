@@ -0,0 +1,95 @@
+/*
+ * GFS. Platform interface.
+ *
+ * Frame is the same everywhere: take input and update game for every tick due, rasterize picture
+ * interpolated between the last two ticks, present it and pass game's audio parameters on.
+ * Platform provides only input, presentation and audio device, so the same frame runs in a
+ * window (`gfs_main.c`) and headless against memory framebuffer (`gfs_headless.c`). Every stage
+ * of the frame is timed.
+ *
+ * FILE      gfs_platform.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_PLATFORM_H_INCLUDED
+#define GFS_PLATFORM_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_input.h"
+#include "gfs_game.h"
+#include "gfs_bmr.h"
+#include "gfs_osc.h"
+#include "gfs_dsp.h"
+#include "gfs_audio.h"
+
+#define PLATFORM_AUDIO_TONE_VOLUME 1000
+#define PLATFORM_AUDIO_MUSIC_BUS 1
+#define PLATFORM_AUDIO_MUSIC_CUTOFF_HZ 20000.0f
+#define PLATFORM_AUDIO_MUSIC_MUFFLED_HZ 600.0f
+#define PLATFORM_AUDIO_MUSIC_ECHO_SECONDS 0.25f
+#define PLATFORM_AUDIO_MUSIC_ECHO_FEEDBACK 0.35f
+
+typedef enum {
+    PLATFORM_STAGE_INPUT,
+    PLATFORM_STAGE_UPDATE,
+    PLATFORM_STAGE_RENDER,
+    PLATFORM_STAGE_PRESENT,
+    PLATFORM_STAGE_AUDIO,
+    PLATFORM_STAGE_COUNT,
+} PlatformStage;
+
+typedef struct Platform Platform;
+
+/*
+ * Fills snapshot of tick `frame`. Returns false, once input is over (e.g. replay has ended).
+ */
+typedef bool PlatformGetInputProc(Platform *platform, u64 frame, InputSnapshot *snapshotOut);
+
+/*
+ * Shows the picture, which was just rasterized. Could be NULL.
+ */
+typedef void PlatformPresentProc(Platform *platform);
+
+/*
+ * Called after audio commands of the frame are sent. Platform without audio thread renders audio
+ * here. Could be NULL.
+ */
+typedef void PlatformMixAudioProc(Platform *platform);
+
+typedef struct {
+    AudioSystem *System;
+    OscID Tone;
+    DSPNodeID MusicFilter;
+    DSPNodeID MusicEcho;
+} PlatformAudio;
+
+struct Platform {
+    PlatformGetInputProc *GetInput;
+    PlatformPresentProc *Present;
+    PlatformMixAudioProc *MixAudio;
+
+    BMR_Renderer Renderer;
+    PlatformAudio Audio;
+};
+
+typedef struct {
+    u64 Elapsed[PLATFORM_STAGE_COUNT]; // In `QueryPerformanceCounter` units. Input and update of all ticks together.
+} PlatformFrameTimings;
+
+/*
+ * Adds game's tone and music bus effects. Should be called before `AudioSystemStart`.
+ */
+void PlatformAudioInit(PlatformAudio *audio, AudioSystem *system);
+
+/*
+ * Runs `tickCount` ticks (could be none) and renders game `alpha` of the way from the previous
+ * tick to the last one. `previousGame` is kept by caller between frames. Returns false and
+ * renders nothing, if input ran out.
+ */
+bool PlatformRunFrame(
+    Platform *platform, GameState *game, GameState *previousGame, u32 tickCount, f32 alpha,
+    PlatformFrameTimings *timingsOut);
+
+#endif // GFS_PLATFORM_H_INCLUDED
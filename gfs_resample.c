@@ -0,0 +1,269 @@
+/*
+ * FILE      gfs_resample.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_resample.h"
+
+#include <immintrin.h>
+#include <math.h> // Only to build tables.
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_sys.h"
+
+#define RESAMPLE_PI 3.14159265358979323846
+
+/*
+ * Half of the taps are before the output position, half after it.
+ */
+#define RESAMPLE_GET_LATENCY(TAPCOUNT) ((TAPCOUNT) / 2 - 1)
+
+internal f64
+Resample_Sinc(f64 x) {
+    if (x > -1e-9 && x < 1e-9) {
+        return 1.0;
+    }
+    return sin(RESAMPLE_PI * x) / (RESAMPLE_PI * x);
+}
+
+/*
+ * Blackman window over [-halfWidth, halfWidth].
+ */
+internal f64
+Resample_Window(f64 x, f64 halfWidth) {
+    if (x <= -halfWidth || x >= halfWidth) {
+        return 0.0;
+    }
+    f64 t = x / halfWidth;
+    return 0.42 + 0.5 * cos(RESAMPLE_PI * t) + 0.08 * cos(2.0 * RESAMPLE_PI * t);
+}
+
+void
+ResampleFilterInit(ResampleFilter *filter, u32 inputRate, u32 outputRate, ResampleQuality quality) {
+    persist_var const u32 tapCounts[] = {8, 16, 32};
+    persist_var const f64 rolloffs[] = {0.85, 0.90, 0.95}; // Fraction of Nyquist, which is kept.
+
+    MemoryZero(filter, sizeof(*filter));
+
+    filter->InputRate = inputRate;
+    filter->OutputRate = outputRate;
+    filter->Quality = quality;
+    filter->TapCount = tapCounts[quality];
+    filter->Step = ((u64)inputRate << 32) / outputRate;
+    filter->IsAVX2Enabled = SYS_HAS_CPU_FEATURE(SYS_CPU_AVX2 | SYS_CPU_FMA);
+
+    // NOTE(ilya.a): When downsampling cutoff follows the output Nyquist, so filter is also anti-aliasing one.
+    // Cutoff is in cycles per input frame. [2026/10/18]
+    f64 cutoff = 0.5 * rolloffs[quality];
+    if (outputRate < inputRate) {
+        cutoff *= (f64)outputRate / (f64)inputRate;
+    }
+
+    f64 halfWidth = (f64)filter->TapCount / 2.0;
+    i32 latency = RESAMPLE_GET_LATENCY(filter->TapCount);
+
+    for (u32 phase = 0; phase <= RESAMPLE_PHASE_COUNT; ++phase) {
+        f64 fraction = (f64)phase / RESAMPLE_PHASE_COUNT;
+        f64 sum = 0.0;
+
+        for (u32 tap = 0; tap < filter->TapCount; ++tap) {
+            f64 x = (f64)((i32)tap - latency) - fraction;
+            f64 value = 2.0 * cutoff * Resample_Sinc(2.0 * cutoff * x) * Resample_Window(x, halfWidth);
+            filter->Coefficients[phase][tap] = (f32)value;
+            sum += value;
+        }
+
+        // NOTE(ilya.a): Normalizing every phase to unit DC gain, otherwise constant signal gets modulated. [2026/10/18]
+        for (u32 tap = 0; tap < filter->TapCount; ++tap) {
+            filter->Coefficients[phase][tap] = (f32)(filter->Coefficients[phase][tap] / sum);
+        }
+    }
+}
+
+void
+ResampleStateReset(ResampleState *state, const ResampleFilter *filter, u32 channelCount) {
+    state->Filter = filter;
+    state->ChannelCount = channelCount;
+    state->Position = 0;
+
+    // NOTE(ilya.a): Priming with silence, so the first output frame is centered on the first input frame. [2026/10/18]
+    state->InputCount = RESAMPLE_GET_LATENCY(filter->TapCount);
+    for (u32 channelIndex = 0; channelIndex < RESAMPLE_CHANNEL_COUNT_MAX; ++channelIndex) {
+        MemoryZero(state->Input[channelIndex], state->InputCount * sizeof(f32));
+    }
+}
+
+usize
+ResampleGetInputSpace(const ResampleState *state) {
+    return RESAMPLE_INPUT_CAPACITY - state->InputCount;
+}
+
+usize
+ResampleGetInputNeeded(const ResampleState *state, usize outputFrameCount) {
+    if (outputFrameCount == 0) {
+        return 0;
+    }
+
+    u64 lastPosition = state->Position + (u64)(outputFrameCount - 1) * state->Filter->Step;
+    u64 inputNeeded = (lastPosition >> 32) + state->Filter->TapCount;
+
+    return inputNeeded > state->InputCount ? (usize)(inputNeeded - state->InputCount) : 0;
+}
+
+void
+ResampleWriteI16(ResampleState *state, const i16 *source, usize frameCount) {
+    usize space = ResampleGetInputSpace(state);
+    frameCount = frameCount < space ? frameCount : space;
+
+    u32 channelCount = state->ChannelCount;
+
+    for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+        f32 *input = state->Input[channelIndex] + state->InputCount;
+
+        for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            input[frameIndex] = (f32)source[frameIndex * channelCount + channelIndex];
+        }
+    }
+
+    state->InputCount += (u32)frameCount;
+}
+
+void
+ResampleWriteF32(ResampleState *state, const f32 *source, usize frameCount) {
+    usize space = ResampleGetInputSpace(state);
+    frameCount = frameCount < space ? frameCount : space;
+
+    u32 channelCount = state->ChannelCount;
+
+    for (u32 channelIndex = 0; channelIndex < channelCount; ++channelIndex) {
+        f32 *input = state->Input[channelIndex] + state->InputCount;
+
+        for (usize frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+            input[frameIndex] = source[frameIndex * channelCount + channelIndex] * 32768.0f;
+        }
+    }
+
+    state->InputCount += (u32)frameCount;
+}
+
+void
+ResampleWriteSilence(ResampleState *state, usize frameCount) {
+    usize space = ResampleGetInputSpace(state);
+    frameCount = frameCount < space ? frameCount : space;
+
+    for (u32 channelIndex = 0; channelIndex < state->ChannelCount; ++channelIndex) {
+        MemoryZero(state->Input[channelIndex] + state->InputCount, frameCount * sizeof(f32));
+    }
+
+    state->InputCount += (u32)frameCount;
+}
+
+internal f32
+Resample_SumSSE(__m128 value) {
+    __m128 shuffled = _mm_movehl_ps(value, value);
+    __m128 sum = _mm_add_ps(value, shuffled);
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+internal f32
+Resample_SumAVX(__m256 value) {
+    return Resample_SumSSE(_mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)));
+}
+
+/*
+ * Dot product of `tapCount` input frames with coefficients, which are interpolated by `fraction`
+ * between two rows. Tap count is always a multiple of 8.
+ */
+internal f32
+Resample_DotAVX2(const f32 *input, const f32 *row0, const f32 *row1, f32 fraction, u32 tapCount) {
+    __m256 sum = _mm256_setzero_ps();
+    __m256 t = _mm256_set1_ps(fraction);
+
+    for (u32 tap = 0; tap < tapCount; tap += 8) {
+        __m256 c0 = _mm256_loadu_ps(row0 + tap);
+        __m256 c = _mm256_fmadd_ps(t, _mm256_sub_ps(_mm256_loadu_ps(row1 + tap), c0), c0);
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(input + tap), c, sum);
+    }
+
+    return Resample_SumAVX(sum);
+}
+
+internal f32
+Resample_DotSSE2(const f32 *input, const f32 *row0, const f32 *row1, f32 fraction, u32 tapCount) {
+    __m128 sum = _mm_setzero_ps();
+    __m128 t = _mm_set1_ps(fraction);
+
+    for (u32 tap = 0; tap < tapCount; tap += 4) {
+        __m128 c0 = _mm_loadu_ps(row0 + tap);
+        __m128 c = _mm_add_ps(c0, _mm_mul_ps(t, _mm_sub_ps(_mm_loadu_ps(row1 + tap), c0)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(input + tap), c));
+    }
+
+    return Resample_SumSSE(sum);
+}
+
+usize
+ResampleProcess(ResampleState *state, f32 *destination, usize frameCount) {
+    const ResampleFilter *filter = state->Filter;
+    u32 tapCount = filter->TapCount;
+    bool isInterpolating = filter->Quality == RESAMPLE_QUALITY_HIGH;
+    usize framesDone = 0;
+
+    for (; framesDone < frameCount; ++framesDone) {
+        u64 inputIndex = state->Position >> 32;
+
+        if (inputIndex + tapCount > state->InputCount) {
+            break;
+        }
+
+        u32 fractionBits = (u32)state->Position;
+        u32 phase = fractionBits >> (32 - RESAMPLE_PHASE_COUNT_LOG2);
+        f32 fraction = 0.0f;
+
+        if (isInterpolating) {
+            fraction = (f32)(fractionBits & ((1u << (32 - RESAMPLE_PHASE_COUNT_LOG2)) - 1)) /
+                       (f32)(1u << (32 - RESAMPLE_PHASE_COUNT_LOG2));
+        }
+
+        const f32 *row0 = filter->Coefficients[phase];
+        const f32 *row1 = filter->Coefficients[phase + 1];
+
+        f32 samples[RESAMPLE_CHANNEL_COUNT_MAX];
+        for (u32 channelIndex = 0; channelIndex < state->ChannelCount; ++channelIndex) {
+            const f32 *input = state->Input[channelIndex] + inputIndex;
+            samples[channelIndex] = filter->IsAVX2Enabled ? Resample_DotAVX2(input, row0, row1, fraction, tapCount)
+                                                          : Resample_DotSSE2(input, row0, row1, fraction, tapCount);
+        }
+
+        destination[framesDone * 2 + 0] = samples[0];
+        destination[framesDone * 2 + 1] = state->ChannelCount > 1 ? samples[1] : samples[0];
+
+        state->Position += filter->Step;
+    }
+
+    // NOTE(ilya.a): Dropping input, which no future output frame touches. [2026/10/18]
+    u32 inputConsumed = (u32)(state->Position >> 32);
+    if (inputConsumed > state->InputCount) {
+        inputConsumed = state->InputCount;
+    }
+
+    if (inputConsumed > 0) {
+        u32 inputLeft = state->InputCount - inputConsumed;
+
+        for (u32 channelIndex = 0; channelIndex < state->ChannelCount; ++channelIndex) {
+            f32 *input = state->Input[channelIndex];
+            for (u32 frameIndex = 0; frameIndex < inputLeft; ++frameIndex) {
+                input[frameIndex] = input[frameIndex + inputConsumed];
+            }
+        }
+
+        state->InputCount = inputLeft;
+        state->Position -= (u64)inputConsumed << 32;
+    }
+
+    return framesDone;
+}
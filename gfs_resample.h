@@ -0,0 +1,94 @@
+/*
+ * GFS. Polyphase sample-rate converter.
+ *
+ * Windowed-sinc filter is tabulated for `RESAMPLE_PHASE_COUNT` fractional positions between
+ * two input frames. Every output frame is a dot product of `TapCount` input frames with the
+ * table row, which is picked by fractional part of the input position (32.32 fixed point,
+ * so arbitrary ratios don't drift). Highest quality additionally interpolates between
+ * neighbour rows.
+ *
+ * Filter is immutable and could be shared by many voices with the same rates. Per-voice
+ * history lives in `ResampleState`, so conversion is streaming: input is written in pieces
+ * of any size and output is pulled in pieces of any size.
+ *
+ * FILE      gfs_resample.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_RESAMPLE_H_INCLUDED
+#define GFS_RESAMPLE_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define RESAMPLE_PHASE_COUNT_LOG2 8
+#define RESAMPLE_PHASE_COUNT (1 << RESAMPLE_PHASE_COUNT_LOG2)
+#define RESAMPLE_TAP_COUNT_MAX 32
+#define RESAMPLE_CHANNEL_COUNT_MAX 2
+#define RESAMPLE_INPUT_CAPACITY 2048 // Frames of input buffered per voice.
+
+typedef enum {
+    RESAMPLE_QUALITY_LOW,    // 8 taps. Cheap, audible aliasing on bright material.
+    RESAMPLE_QUALITY_MEDIUM, // 16 taps.
+    RESAMPLE_QUALITY_HIGH,   // 32 taps with interpolation between phases.
+} ResampleQuality;
+
+typedef struct {
+    u32 InputRate;
+    u32 OutputRate;
+    ResampleQuality Quality;
+    u32 TapCount;
+    u64 Step; // Input frames per output frame, 32.32 fixed point.
+    bool IsAVX2Enabled;
+
+    // NOTE(ilya.a): Extra row, so interpolation of the last phase doesn't need wrapping. [2026/10/18]
+    f32 Coefficients[RESAMPLE_PHASE_COUNT + 1][RESAMPLE_TAP_COUNT_MAX];
+} ResampleFilter;
+
+void ResampleFilterInit(ResampleFilter *filter, u32 inputRate, u32 outputRate, ResampleQuality quality);
+
+typedef struct {
+    const ResampleFilter *Filter;
+    u32 ChannelCount;
+
+    u64 Position; // Of the next output frame, relative to `Input`. 32.32 fixed point.
+    u32 InputCount;
+    f32 Input[RESAMPLE_CHANNEL_COUNT_MAX][RESAMPLE_INPUT_CAPACITY]; // Planar.
+} ResampleState;
+
+/*
+ * Clears history. Output is aligned with input: first output frame corresponds to the first
+ * input frame.
+ */
+void ResampleStateReset(ResampleState *state, const ResampleFilter *filter, u32 channelCount);
+
+/*
+ * Frames, which could be written right now.
+ */
+usize ResampleGetInputSpace(const ResampleState *state);
+
+/*
+ * Frames, which should be written yet, before `outputFrameCount` frames could be produced.
+ */
+usize ResampleGetInputNeeded(const ResampleState *state, usize outputFrameCount);
+
+/*
+ * Writes interleaved frames with state's channel count. Frames beyond `ResampleGetInputSpace` are dropped.
+ */
+void ResampleWriteI16(ResampleState *state, const i16 *source, usize frameCount);
+
+/*
+ * Same as `ResampleWriteI16`, but samples are normalized (see `PCMConvertToF32`). They are scaled
+ * into i16 range, so output doesn't depend on source format.
+ */
+void ResampleWriteF32(ResampleState *state, const f32 *source, usize frameCount);
+void ResampleWriteSilence(ResampleState *state, usize frameCount);
+
+/*
+ * Produces up to `frameCount` interleaved stereo frames (mono is duplicated into both channels),
+ * as much as written input allows. Returns number of frames produced.
+ */
+usize ResampleProcess(ResampleState *state, f32 *destination, usize frameCount);
+
+#endif // GFS_RESAMPLE_H_INCLUDED
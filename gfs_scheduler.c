@@ -0,0 +1,125 @@
+/*
+ * FILE      gfs_scheduler.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_scheduler.h"
+
+#include <Windows.h>
+#include <intrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+
+internal u64
+Scheduler_GetCounter(void) {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (u64)counter.QuadPart;
+}
+
+internal void
+Scheduler_Record(SchedulerTimingStats *stats, u64 value) {
+    ++stats->Count;
+    stats->Sum += value;
+    stats->Max = value > stats->Max ? value : stats->Max;
+}
+
+void
+SchedulerInit(Scheduler *scheduler, u32 ticksPerSecond, u32 framesPerSecond, u32 maxTicksPerFrame) {
+    MemoryZero(scheduler, sizeof(*scheduler));
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    scheduler->CounterFrequency = (u64)frequency.QuadPart;
+    scheduler->TickPeriod = scheduler->CounterFrequency / (ticksPerSecond > 0 ? ticksPerSecond : 1);
+    scheduler->FramePeriod = framesPerSecond > 0 ? scheduler->CounterFrequency / framesPerSecond : 0;
+    scheduler->SpinPeriod = scheduler->CounterFrequency * SCHEDULER_SPIN_MICROSECONDS / 1000000;
+    scheduler->MaxTicksPerFrame = maxTicksPerFrame > 0 ? maxTicksPerFrame : 1;
+
+    scheduler->LastCounter = Scheduler_GetCounter();
+    scheduler->LastFrameCounter = scheduler->LastCounter;
+    scheduler->NextFrameCounter = scheduler->LastCounter + scheduler->FramePeriod;
+
+    timeBeginPeriod(1);
+}
+
+void
+SchedulerDeInit(Scheduler *scheduler) {
+    UNUSED(scheduler);
+    timeEndPeriod(1);
+}
+
+u32
+SchedulerBeginFrame(Scheduler *scheduler) {
+    u64 now = Scheduler_GetCounter();
+    scheduler->Accumulator += now - scheduler->LastCounter;
+    scheduler->LastCounter = now;
+
+    u32 tickCount = 0;
+
+    while (scheduler->Accumulator >= scheduler->TickPeriod && tickCount < scheduler->MaxTicksPerFrame) {
+        scheduler->Accumulator -= scheduler->TickPeriod;
+        ++tickCount;
+
+        // NOTE(ilya.a): Time left after the tick is how long ago it became due. [2026/10/18]
+        Scheduler_Record(&scheduler->Stats.TickLateness, scheduler->Accumulator);
+    }
+
+    if (scheduler->Accumulator >= scheduler->TickPeriod) {
+        u64 droppedTicks = scheduler->Accumulator / scheduler->TickPeriod;
+        scheduler->Accumulator -= droppedTicks * scheduler->TickPeriod;
+        scheduler->Stats.DroppedTicks += droppedTicks;
+    }
+
+    return tickCount;
+}
+
+f32
+SchedulerGetAlpha(const Scheduler *scheduler) {
+    return (f32)scheduler->Accumulator / (f32)scheduler->TickPeriod;
+}
+
+void
+SchedulerWaitForFrame(Scheduler *scheduler) {
+    if (scheduler->FramePeriod == 0) {
+        return;
+    }
+
+    u64 deadline = scheduler->NextFrameCounter;
+    u64 now = Scheduler_GetCounter();
+
+    if (now + scheduler->SpinPeriod < deadline) {
+        u64 sleepMilliseconds = (deadline - now - scheduler->SpinPeriod) * 1000 / scheduler->CounterFrequency;
+
+        if (sleepMilliseconds > 0) {
+            Sleep((DWORD)sleepMilliseconds);
+        }
+    }
+
+    while ((now = Scheduler_GetCounter()) < deadline) {
+        _mm_pause();
+    }
+
+    u64 interval = now - scheduler->LastFrameCounter;
+    u64 period = scheduler->FramePeriod;
+    Scheduler_Record(&scheduler->Stats.FrameJitter, interval > period ? interval - period : period - interval);
+    scheduler->LastFrameCounter = now;
+
+    // NOTE(ilya.a): Missed frames are not caught up, the next one is just a period from now. [2026/10/18]
+    deadline += scheduler->FramePeriod;
+    scheduler->NextFrameCounter = now < deadline ? deadline : now + scheduler->FramePeriod;
+}
+
+u64
+SchedulerGetMicroseconds(const Scheduler *scheduler, u64 counter) {
+    return counter * 1000000 / scheduler->CounterFrequency;
+}
+
+void
+SchedulerResetStats(Scheduler *scheduler) {
+    MemoryZero(&scheduler->Stats, sizeof(scheduler->Stats));
+}
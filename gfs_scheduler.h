@@ -0,0 +1,79 @@
+/*
+ * GFS. Fixed-timestep frame scheduler.
+ *
+ * Game ticks at fixed rate, whatever frame rate is: every frame scheduler tells how many ticks
+ * are due for the time passed, and how far into the next tick it already is, so picture could be
+ * interpolated between the last two states. After long stall at most `MaxTicksPerFrame` ticks
+ * are run and the rest of the time is dropped: game slows down instead of spiralling.
+ *
+ * Frames are paced to target rate by `SchedulerWaitForFrame`: it sleeps, while deadline is
+ * further than sleep could overshoot, and spins on the counter for the rest.
+ *
+ * All times are in `QueryPerformanceCounter` units.
+ *
+ * FILE      gfs_scheduler.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_SCHEDULER_H_INCLUDED
+#define GFS_SCHEDULER_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define SCHEDULER_SPIN_MICROSECONDS 2000 // Sleep(1) wakes up to this late, even with 1ms timer period.
+
+typedef struct {
+    u64 Count;
+    u64 Sum;
+    u64 Max;
+} SchedulerTimingStats;
+
+typedef struct {
+    SchedulerTimingStats TickLateness; // How late ticks ran after they were due.
+    SchedulerTimingStats FrameJitter;  // How far frame intervals were from target one.
+    u64 DroppedTicks;
+} SchedulerStats;
+
+typedef struct {
+    u64 CounterFrequency;
+    u64 TickPeriod;
+    u64 FramePeriod; // Zero, if frames aren't paced.
+    u64 SpinPeriod;
+    u32 MaxTicksPerFrame;
+
+    u64 Accumulator; // Time not yet simulated.
+    u64 LastCounter;
+    u64 LastFrameCounter;
+    u64 NextFrameCounter;
+
+    SchedulerStats Stats;
+} Scheduler;
+
+/*
+ * Zero `framesPerSecond` leaves frames unpaced. Raises system timer resolution till
+ * `SchedulerDeInit`.
+ */
+void SchedulerInit(Scheduler *scheduler, u32 ticksPerSecond, u32 framesPerSecond, u32 maxTicksPerFrame);
+void SchedulerDeInit(Scheduler *scheduler);
+
+/*
+ * Takes the time passed since previous frame and returns number of ticks to run now.
+ */
+u32 SchedulerBeginFrame(Scheduler *scheduler);
+
+/*
+ * How far into the next tick the frame is, from 0 to 1.
+ */
+f32 SchedulerGetAlpha(const Scheduler *scheduler);
+
+/*
+ * Blocks until the next frame is due. Returns at once, if frames aren't paced.
+ */
+void SchedulerWaitForFrame(Scheduler *scheduler);
+
+u64 SchedulerGetMicroseconds(const Scheduler *scheduler, u64 counter);
+void SchedulerResetStats(Scheduler *scheduler);
+
+#endif // GFS_SCHEDULER_H_INCLUDED
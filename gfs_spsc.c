@@ -0,0 +1,76 @@
+/*
+ * FILE      gfs_spsc.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_spsc.h"
+
+#include <intrin.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+
+// NOTE(ilya.a): x86 doesn't reorder stores with stores and loads with loads, so only compiler has
+// to be stopped from doing that. Would need real fences on ARM. [2026/10/18]
+#define SPSC_BARRIER() _ReadWriteBarrier()
+
+void
+SPSCRingInit(SPSCRing *ring, void *storage, u32 capacity, u32 elementSize) {
+    MemoryZero(ring, sizeof(*ring));
+    ring->Data = storage;
+    ring->Capacity = capacity;
+    ring->ElementSize = elementSize;
+}
+
+usize
+SPSCRingPush(SPSCRing *ring, const void *elements, usize count) {
+    u64 writeIndex = ring->WriteIndex;
+    u64 readIndex = ring->ReadIndex;
+    SPSC_BARRIER(); // Slots are not touched before consumer is seen to release them.
+
+    usize space = ring->Capacity - (usize)(writeIndex - readIndex);
+    count = count < space ? count : space;
+
+    for (usize elementIndex = 0; elementIndex < count; ++elementIndex) {
+        u32 slot = (u32)((writeIndex + elementIndex) & (ring->Capacity - 1));
+        MemoryCopy(
+            ring->Data + (usize)slot * ring->ElementSize, (const byte *)elements + elementIndex * ring->ElementSize,
+            ring->ElementSize);
+    }
+
+    SPSC_BARRIER(); // Elements are written before they are published.
+    ring->WriteIndex = writeIndex + count;
+
+    return count;
+}
+
+usize
+SPSCRingPop(SPSCRing *ring, void *elements, usize count) {
+    u64 readIndex = ring->ReadIndex;
+    u64 writeIndex = ring->WriteIndex;
+    SPSC_BARRIER(); // Elements are not read before they are seen published.
+
+    usize available = (usize)(writeIndex - readIndex);
+    count = count < available ? count : available;
+
+    for (usize elementIndex = 0; elementIndex < count; ++elementIndex) {
+        u32 slot = (u32)((readIndex + elementIndex) & (ring->Capacity - 1));
+        MemoryCopy(
+            (byte *)elements + elementIndex * ring->ElementSize, ring->Data + (usize)slot * ring->ElementSize,
+            ring->ElementSize);
+    }
+
+    SPSC_BARRIER(); // Elements are read before slots are released.
+    ring->ReadIndex = readIndex + count;
+
+    return count;
+}
+
+usize
+SPSCRingGetCount(const SPSCRing *ring) {
+    u64 readIndex = ring->ReadIndex;
+    u64 writeIndex = ring->WriteIndex;
+    return (usize)(writeIndex - readIndex);
+}
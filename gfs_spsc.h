@@ -0,0 +1,55 @@
+/*
+ * GFS. Lock-free single-producer single-consumer ring.
+ *
+ * Exactly one thread pushes and exactly one thread pops, so indices are owned by one side
+ * each and no atomic read-modify-write is needed: publishing is just ordered stores. Indices
+ * grow forever and are masked on access, so full and empty rings are distinguishable without
+ * wasting a slot. Producer and consumer indices live on separate cache lines.
+ *
+ * FILE      gfs_spsc.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_SPSC_H_INCLUDED
+#define GFS_SPSC_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+
+#define SPSC_CACHE_LINE_SIZE 64
+
+typedef struct {
+    volatile u64 WriteIndex; // Written only by producer.
+    byte WritePadding[SPSC_CACHE_LINE_SIZE - sizeof(u64)];
+
+    volatile u64 ReadIndex; // Written only by consumer.
+    byte ReadPadding[SPSC_CACHE_LINE_SIZE - sizeof(u64)];
+
+    byte *Data;
+    u32 Capacity; // In elements. Power of two.
+    u32 ElementSize;
+} SPSCRing;
+
+/*
+ * `storage` should hold `capacity * elementSize` bytes and outlive the ring. Capacity should be
+ * power of two.
+ */
+void SPSCRingInit(SPSCRing *ring, void *storage, u32 capacity, u32 elementSize);
+
+/*
+ * Producer side. Pushes as many of `count` elements, as fit. Returns number of pushed ones.
+ */
+usize SPSCRingPush(SPSCRing *ring, const void *elements, usize count);
+
+/*
+ * Consumer side. Pops up to `count` elements. Returns number of popped ones.
+ */
+usize SPSCRingPop(SPSCRing *ring, void *elements, usize count);
+
+/*
+ * Could be called from any side, but the result is only a snapshot.
+ */
+usize SPSCRingGetCount(const SPSCRing *ring);
+
+#endif // GFS_SPSC_H_INCLUDED
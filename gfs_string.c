@@ -33,3 +33,26 @@ CStr8IsEqual(cstr8 s0, cstr8 s1) {
     }
     return *s0 == '\0' && *s1 == '\0';
 }
+
+#define FNV1A64_OFFSET_BASIS 0xCBF29CE484222325ull
+#define FNV1A64_PRIME 0x100000001B3ull
+
+u64
+CStr8Hash64(cstr8 s) {
+    u64 hash = FNV1A64_OFFSET_BASIS;
+    while (*s != '\0') {
+        hash ^= (u8)*s++;
+        hash *= FNV1A64_PRIME;
+    }
+    return hash;
+}
+
+u64
+BytesHash64(const void *data, usize size) {
+    u64 hash = FNV1A64_OFFSET_BASIS;
+    for (usize i = 0; i < size; ++i) {
+        hash ^= ((const u8 *)data)[i];
+        hash *= FNV1A64_PRIME;
+    }
+    return hash;
+}
@@ -13,4 +13,11 @@ usize CStr8GetLength(cstr8 s);
 bool CStr8IsEmpty(cstr8 s);
 bool CStr8IsEqual(cstr8 s0, cstr8 s1);
 
+/*
+ * 64-bit FNV-1a hash of the string. Never returns zero for non-empty strings in practice,
+ * but callers should not rely on that.
+ */
+u64 CStr8Hash64(cstr8 s);
+u64 BytesHash64(const void *data, usize size);
+
 #endif // GFS_STRING_H_INCLUDED
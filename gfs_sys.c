@@ -7,17 +7,235 @@
 #include "gfs_sys.h"
 
 #include <Windows.h>
+#include <intrin.h>
 
 #include "gfs_types.h"
+#include "gfs_macros.h"
 
-usize
-Sys_GetPageSize() {
-    usize pageSize;
+#define SYS_CACHE_LINE_SIZE_DEFAULT 64
+#define SYS_TSC_CALIBRATION_MS 10
+
+global_var SysInfo gSysInfo;
+global_var bool gSysInfoInitialized = false;
+
+#define CPUID_BIT(REG, BIT) (((u32)(REG) & (1u << (BIT))) != 0)
+
+internal SysCPUFeatures
+Sys_ProbeCPUFeatures(void) {
+    SysCPUFeatures features = 0;
+    i32 regs[4] = {0}; // EAX, EBX, ECX, EDX
+
+    __cpuid(regs, 0);
+    i32 maxLeaf = regs[0];
+
+    if (maxLeaf < 1) {
+        return features;
+    }
+
+    __cpuid(regs, 1);
+    u32 ecx1 = (u32)regs[2];
+    u32 edx1 = (u32)regs[3];
+
+    if (CPUID_BIT(edx1, 26)) {
+        features |= SYS_CPU_SSE2;
+    }
+    if (CPUID_BIT(ecx1, 0)) {
+        features |= SYS_CPU_SSE3;
+    }
+    if (CPUID_BIT(ecx1, 9)) {
+        features |= SYS_CPU_SSSE3;
+    }
+    if (CPUID_BIT(ecx1, 19)) {
+        features |= SYS_CPU_SSE41;
+    }
+    if (CPUID_BIT(ecx1, 20)) {
+        features |= SYS_CPU_SSE42;
+    }
+
+    // NOTE(ilya.a): AVX registers are usable only if OS saves them on context switch,
+    // which is reported through OSXSAVE and XCR0. [2026/10/18]
+    bool isOSXSaveEnabled = CPUID_BIT(ecx1, 27);
+    u64 xcr0 = isOSXSaveEnabled ? _xgetbv(0) : 0;
+    bool isAVXStateEnabled = (xcr0 & 0x06) == 0x06;    // XMM | YMM
+    bool isAVX512StateEnabled = (xcr0 & 0xE6) == 0xE6; // XMM | YMM | OPMASK | ZMM_Hi256 | Hi16_ZMM
+
+    if (isAVXStateEnabled && CPUID_BIT(ecx1, 28)) {
+        features |= SYS_CPU_AVX;
+
+        if (CPUID_BIT(ecx1, 12)) {
+            features |= SYS_CPU_FMA;
+        }
+    }
+
+    if (maxLeaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        u32 ebx7 = (u32)regs[1];
+
+        if (isAVXStateEnabled && CPUID_BIT(ebx7, 5)) {
+            features |= SYS_CPU_AVX2;
+        }
+
+        if (isAVX512StateEnabled && CPUID_BIT(ebx7, 16)) {
+            features |= SYS_CPU_AVX512F;
+
+            if (CPUID_BIT(ebx7, 30)) {
+                features |= SYS_CPU_AVX512BW;
+            }
+            if (CPUID_BIT(ebx7, 31)) {
+                features |= SYS_CPU_AVX512VL;
+            }
+        }
+    }
+
+    __cpuid(regs, 0x80000000);
+    if ((u32)regs[0] >= 0x80000007) {
+        __cpuid(regs, 0x80000007);
+        if (CPUID_BIT(regs[3], 8)) {
+            features |= SYS_CPU_INVARIANT_TSC;
+        }
+    }
+
+    return features;
+}
+
+internal u32
+Sys_CountBits(ULONG_PTR mask) {
+    u32 count = 0;
+    while (mask != 0) {
+        mask &= mask - 1;
+        ++count;
+    }
+    return count;
+}
+
+internal void
+Sys_ProbeTopology(SysInfo *info) {
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(NULL, &bufferSize);
+
+    if (bufferSize == 0) {
+        return;
+    }
+
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION *entries =
+        VirtualAlloc(NULL, bufferSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (entries == NULL) {
+        return;
+    }
+
+    if (GetLogicalProcessorInformation(entries, &bufferSize)) {
+        usize entryCount = bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+
+        for (usize entryIndex = 0; entryIndex < entryCount; ++entryIndex) {
+            SYSTEM_LOGICAL_PROCESSOR_INFORMATION *entry = &entries[entryIndex];
+
+            switch (entry->Relationship) {
+            case RelationProcessorCore: {
+                info->PhysicalCoreCount += 1;
+                info->LogicalCoreCount += Sys_CountBits(entry->ProcessorMask);
+            } break;
+            case RelationCache: {
+                CACHE_DESCRIPTOR *cache = &entry->Cache;
+
+                if (cache->Level == 1 && cache->Type == CacheData) {
+                    info->L1DataCacheSize = cache->Size;
+                    info->CacheLineSize = cache->LineSize;
+                } else if (cache->Level == 2) {
+                    info->L2CacheSize = cache->Size;
+                } else if (cache->Level == 3) {
+                    info->L3CacheSize = cache->Size;
+                }
+            } break;
+            default: {
+            } break;
+            }
+        }
+    }
+
+    VirtualFree(entries, 0, MEM_RELEASE);
+}
+
+/*
+ * Prefers frequency, reported by CPUID leaf 0x15. Otherwise measures TSC against QPC.
+ */
+internal u64
+Sys_ProbeTSCFrequency(void) {
+    i32 regs[4] = {0};
+
+    __cpuid(regs, 0);
+    if (regs[0] >= 0x15) {
+        __cpuid(regs, 0x15);
+        u32 denominator = (u32)regs[0];
+        u32 numerator = (u32)regs[1];
+        u32 crystalHZ = (u32)regs[2];
+
+        if (denominator != 0 && numerator != 0 && crystalHZ != 0) {
+            return (u64)crystalHZ * numerator / denominator;
+        }
+    }
+
+    LARGE_INTEGER counterFrequency, counterBegin, counterEnd;
+    QueryPerformanceFrequency(&counterFrequency);
+    QueryPerformanceCounter(&counterBegin);
+    u64 tscBegin = __rdtsc();
+
+    i64 counterTarget = counterBegin.QuadPart + counterFrequency.QuadPart * SYS_TSC_CALIBRATION_MS / 1000;
+    do {
+        QueryPerformanceCounter(&counterEnd);
+    } while (counterEnd.QuadPart < counterTarget);
+
+    u64 tscEnd = __rdtsc();
+    i64 counterElapsed = counterEnd.QuadPart - counterBegin.QuadPart;
+
+    return (tscEnd - tscBegin) * (u64)counterFrequency.QuadPart / (u64)counterElapsed;
+}
+
+void
+Sys_Init(void) {
+    if (gSysInfoInitialized) {
+        return;
+    }
+
+    SysInfo info = {0};
 
     SYSTEM_INFO systemInfo = {0};
     GetSystemInfo(&systemInfo);
 
-    pageSize = systemInfo.dwPageSize;
+    info.PageSize = systemInfo.dwPageSize;
+    info.AllocationGranularity = systemInfo.dwAllocationGranularity;
+    info.LargePageSize = GetLargePageMinimum();
+
+    info.CPUFeatures = Sys_ProbeCPUFeatures();
+    Sys_ProbeTopology(&info);
+
+    if (info.LogicalCoreCount == 0) {
+        info.LogicalCoreCount = systemInfo.dwNumberOfProcessors;
+    }
+
+    if (info.PhysicalCoreCount == 0) {
+        info.PhysicalCoreCount = info.LogicalCoreCount;
+    }
+
+    if (info.CacheLineSize == 0) {
+        info.CacheLineSize = SYS_CACHE_LINE_SIZE_DEFAULT;
+    }
+
+    info.TSCFrequency = Sys_ProbeTSCFrequency();
 
-    return pageSize;
+    gSysInfo = info;
+    gSysInfoInitialized = true;
+}
+
+const SysInfo *
+Sys_GetInfo(void) {
+    if (!gSysInfoInitialized) {
+        Sys_Init();
+    }
+    return &gSysInfo;
+}
+
+usize
+Sys_GetPageSize() {
+    return Sys_GetInfo()->PageSize;
 }
@@ -7,6 +7,56 @@
 #define GFS_SYS_H_INCLUDED
 
 #include "gfs_types.h"
+#include "gfs_macros.h"
+
+typedef u32 SysCPUFeatures;
+
+#define SYS_CPU_SSE2 MKFLAG(0)
+#define SYS_CPU_SSE3 MKFLAG(1)
+#define SYS_CPU_SSSE3 MKFLAG(2)
+#define SYS_CPU_SSE41 MKFLAG(3)
+#define SYS_CPU_SSE42 MKFLAG(4)
+#define SYS_CPU_AVX MKFLAG(5)
+#define SYS_CPU_AVX2 MKFLAG(6)
+#define SYS_CPU_FMA MKFLAG(7)
+#define SYS_CPU_AVX512F MKFLAG(8)
+#define SYS_CPU_AVX512BW MKFLAG(9)
+#define SYS_CPU_AVX512VL MKFLAG(10)
+#define SYS_CPU_INVARIANT_TSC MKFLAG(11)
+
+/*
+ * System information. Collected once by `Sys_Init` and never changes after that.
+ */
+typedef struct {
+    SysCPUFeatures CPUFeatures; // Only features, which are supported by both CPU and OS.
+
+    usize CacheLineSize;
+    usize L1DataCacheSize; // Per core.
+    usize L2CacheSize;     // Per cache instance (usually per core).
+    usize L3CacheSize;     // Per cache instance (usually per package).
+
+    u32 PhysicalCoreCount;
+    u32 LogicalCoreCount;
+
+    usize PageSize;
+    usize LargePageSize; // Zero, if large pages are not supported.
+    usize AllocationGranularity;
+
+    u64 TSCFrequency; // `__rdtsc` ticks per second.
+} SysInfo;
+
+#define SYS_HAS_CPU_FEATURE(FEATURES) ((Sys_GetInfo()->CPUFeatures & (FEATURES)) == (FEATURES))
+
+/*
+ * Probes CPU and memory topology. Should be called once at startup, before any
+ * other threads are spawned.
+ */
+void Sys_Init(void);
+
+/*
+ * Returns cached system information. Calls `Sys_Init` if it wasn't called yet.
+ */
+const SysInfo *Sys_GetInfo(void);
 
 usize Sys_GetPageSize();
 
@@ -10,10 +10,277 @@
 #include "gfs_string.h"
 #include "gfs_fs.h"
 #include "gfs_io.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_adpcm.h"
+
+#define WAVE_FORMAT_CHUNK_SIZE_MIN 16
+#define WAVE_FORMAT_CHUNK_SIZE_EXTENSIBLE 40
+#define WAVE_FORMAT_CHUNK_READ_SIZE_MAX 64 // Everything we care about is in the first 40 bytes.
+#define WAVE_READER_BUFFER_SIZE 512
+
+// NOTE(ilya.a): KSDATAFORMAT_SUBTYPE_* GUIDs differ only in the first two bytes, which hold format tag. [2026/10/18]
+global_var const byte gWaveSubFormatTail[14] = {
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71,
+};
+
+internal u16
+Wave_Read16(const byte *p) {
+    return (u16)(p[0] | p[1] << 8);
+}
+
+internal u32
+Wave_Read32(const byte *p) {
+    return (u32)p[0] | (u32)p[1] << 8 | (u32)p[2] << 16 | (u32)p[3] << 24;
+}
+
+internal bool
+Wave_IsChunkID(const byte *id, cstr8 expected) {
+    return id[0] == expected[0] && id[1] == expected[1] && id[2] == expected[2] && id[3] == expected[3];
+}
+
+internal bool
+Wave_IsRIFFHeaderValid(const byte *riff) {
+    return Wave_IsChunkID(riff, WAVEFILE_FILETYPE) && Wave_IsChunkID(riff + 8, WAVEFILE_FORMATID);
+}
+
+/*
+ * Parses body of `fmt ` chunk into `headerOut` and validates it.
+ */
+internal WaveAssetLoadResult
+Wave_ParseFormatChunk(const byte *chunk, u32 chunkSize, WaveFileHeader *headerOut) {
+    if (chunkSize < WAVE_FORMAT_CHUNK_SIZE_MIN) {
+        return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+    }
+
+    WaveFileAudioFormatTag audioFormat = Wave_Read16(chunk + 0);
+
+    if (audioFormat == WAVEFILE_AUDIOFORMAT_EXTENSIBLE) {
+        if (chunkSize < WAVE_FORMAT_CHUNK_SIZE_EXTENSIBLE || Wave_Read16(chunk + 16) < 22) {
+            return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+        }
+
+        const byte *subFormat = chunk + 24;
+
+        for (u32 i = 0; i < sizeof(gWaveSubFormatTail); ++i) {
+            if (subFormat[2 + i] != gWaveSubFormatTail[i]) {
+                return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+            }
+        }
+
+        audioFormat = Wave_Read16(subFormat);
+    }
+
+    headerOut->AudioFormat = audioFormat;
+    headerOut->NumberOfChannels = Wave_Read16(chunk + 2);
+    headerOut->FreqHZ = Wave_Read32(chunk + 4);
+    headerOut->BytePerSec = Wave_Read32(chunk + 8);
+    headerOut->BytePerBloc = Wave_Read16(chunk + 12);
+    headerOut->BitsPerSample = Wave_Read16(chunk + 14);
+
+    if (headerOut->NumberOfChannels == 0 || headerOut->FreqHZ == 0 || headerOut->BytePerBloc == 0) {
+        return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+    }
+
+    // NOTE(ilya.a): Compressed formats have their own block layout, so only checking the ones we know. [2026/10/18]
+    if (audioFormat == WAVEFILE_AUDIOFORMAT_PCM || audioFormat == WAVEFILE_AUDIOFORMAT_IIEE_FLT) {
+        u32 bytesPerSample = (headerOut->BitsPerSample + BYTE_BITS - 1) / BYTE_BITS;
+
+        if (headerOut->BitsPerSample == 0 || headerOut->BytePerBloc != bytesPerSample * headerOut->NumberOfChannels) {
+            return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+        }
+    } else if (audioFormat == WAVEFILE_AUDIOFORMAT_IMA_ADPCM) {
+        if (headerOut->BitsPerSample != 4 ||
+            ADPCMGetFramesPerBlock(headerOut->BytePerBloc, headerOut->NumberOfChannels) == 0) {
+            return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+        }
+    }
+
+    return WAVEASSET_LOAD_OK;
+}
+
+/*
+ * Fills ids and sizes of canonical header, once both chunks are found.
+ */
+internal void
+Wave_FinishHeader(WaveFileHeader *header, u32 dataSize) {
+    MemoryCopy(header->FileTypeBlocID, WAVEFILE_FILETYPE, 4);
+    MemoryCopy(header->FileFormatID, WAVEFILE_FORMATID, 4);
+    MemoryCopy(header->FormatBlocID, WAVEFILE_FORMATBLOCID, 4);
+    MemoryCopy(header->DataBlocID, WAVEFILE_DATABLOCID, 4);
+
+    header->BlockSize = WAVE_FORMAT_CHUNK_SIZE_MIN;
+    header->DataSize = dataSize;
+    header->FileSize = WAVEFILE_HEADER_SIZE - 8 + dataSize;
+}
+
+/*
+ * Cuts data chunk, which claims more than `bytesAvailable`, to whole blocks.
+ */
+internal u32
+Wave_ClampDataSize(const WaveFileHeader *header, u32 dataSize, u64 bytesAvailable) {
+    if (dataSize <= bytesAvailable) {
+        return dataSize;
+    }
+    return (u32)(bytesAvailable - bytesAvailable % header->BytePerBloc);
+}
 
 WaveAssetLoadResult
-WaveAssetLoadFromFile(ScratchAllocator *scratchAllocator, cstr8 assetPath, WaveAsset *waveAssetOut) {
-    if (scratchAllocator == NULL || assetPath == NULL || waveAssetOut == NULL || CStr8IsEmpty(assetPath)) {
+WaveFileParseHeader(const void *buffer, usize bufferSize, WaveFileHeader *headerOut, usize *dataOffsetOut) {
+    if (buffer == NULL || headerOut == NULL || dataOffsetOut == NULL) {
+        return WAVEASSET_LOAD_ERR_INVALID_ARGS;
+    }
+
+    const byte *bytes = (const byte *)buffer;
+
+    if (bufferSize < WAVEFILE_RIFF_HEADER_SIZE) {
+        return WAVEASSET_LOAD_ERR_TRUNCATED;
+    }
+
+    if (!Wave_IsRIFFHeaderValid(bytes)) {
+        return WAVEASSET_LOAD_ERR_INVALID_MAGIC;
+    }
+
+    WaveFileHeader header = {0};
+    bool isFormatFound = false;
+    bool isDataFound = false;
+    usize dataOffset = 0;
+    u32 dataSize = 0;
+
+    usize offset = WAVEFILE_RIFF_HEADER_SIZE;
+
+    while (!(isFormatFound && isDataFound) && bufferSize - offset >= WAVEFILE_CHUNK_HEADER_SIZE) {
+        const byte *chunkID = bytes + offset;
+        u32 chunkSize = Wave_Read32(bytes + offset + 4);
+        usize chunkOffset = offset + WAVEFILE_CHUNK_HEADER_SIZE;
+        usize bytesLeft = bufferSize - chunkOffset;
+
+        if (Wave_IsChunkID(chunkID, WAVEFILE_FORMATBLOCID) && !isFormatFound) {
+            if (chunkSize > bytesLeft) {
+                return WAVEASSET_LOAD_ERR_TRUNCATED;
+            }
+
+            WaveAssetLoadResult result = Wave_ParseFormatChunk(bytes + chunkOffset, chunkSize, &header);
+
+            if (result != WAVEASSET_LOAD_OK) {
+                return result;
+            }
+
+            isFormatFound = true;
+        } else if (Wave_IsChunkID(chunkID, WAVEFILE_DATABLOCID) && !isDataFound) {
+            dataOffset = chunkOffset;
+            dataSize = chunkSize;
+            isDataFound = true;
+        }
+
+        // NOTE(ilya.a): Chunks are padded to even size. [2026/10/18]
+        u64 paddedChunkSize = (u64)chunkSize + (chunkSize & 1);
+
+        if (paddedChunkSize >= bytesLeft) {
+            break;
+        }
+
+        offset = chunkOffset + (usize)paddedChunkSize;
+    }
+
+    if (!isFormatFound || !isDataFound) {
+        return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+    }
+
+    Wave_FinishHeader(&header, Wave_ClampDataSize(&header, dataSize, bufferSize - dataOffset));
+
+    *headerOut = header;
+    *dataOffsetOut = dataOffset;
+
+    return WAVEASSET_LOAD_OK;
+}
+
+WaveAssetLoadResult
+WaveFileParseHeaderFromFile(FileHandle file, WaveFileHeader *headerOut, u64 *dataOffsetOut) {
+    if (headerOut == NULL || dataOffsetOut == NULL) {
+        return WAVEASSET_LOAD_ERR_INVALID_ARGS;
+    }
+
+    usize fileSize = 0;
+
+    if (IOGetFileSize(&file, &fileSize) != IO_OK) {
+        return WAVEASSET_LOAD_ERR_FAILED_TO_READ;
+    }
+
+    byte readerBuffer[WAVE_READER_BUFFER_SIZE];
+    IOReader reader = IOReaderMake(file, 0, readerBuffer, sizeof(readerBuffer));
+
+    byte riff[WAVEFILE_RIFF_HEADER_SIZE];
+
+    if (IOReaderRead(&reader, riff, sizeof(riff)) != IO_OK) {
+        return WAVEASSET_LOAD_ERR_TRUNCATED;
+    }
+
+    if (!Wave_IsRIFFHeaderValid(riff)) {
+        return WAVEASSET_LOAD_ERR_INVALID_MAGIC;
+    }
+
+    WaveFileHeader header = {0};
+    bool isFormatFound = false;
+    bool isDataFound = false;
+    u64 dataOffset = 0;
+    u32 dataSize = 0;
+
+    while (!(isFormatFound && isDataFound)) {
+        byte chunkHeader[WAVEFILE_CHUNK_HEADER_SIZE];
+
+        if (IOReaderRead(&reader, chunkHeader, sizeof(chunkHeader)) != IO_OK) {
+            break;
+        }
+
+        u32 chunkSize = Wave_Read32(chunkHeader + 4);
+        u64 paddedChunkSize = (u64)chunkSize + (chunkSize & 1);
+
+        if (Wave_IsChunkID(chunkHeader, WAVEFILE_FORMATBLOCID) && !isFormatFound) {
+            byte chunk[WAVE_FORMAT_CHUNK_READ_SIZE_MAX];
+            u32 bytesToRead = chunkSize < sizeof(chunk) ? chunkSize : sizeof(chunk);
+
+            if (IOReaderRead(&reader, chunk, bytesToRead) != IO_OK) {
+                return WAVEASSET_LOAD_ERR_TRUNCATED;
+            }
+
+            WaveAssetLoadResult result = Wave_ParseFormatChunk(chunk, chunkSize, &header);
+
+            if (result != WAVEASSET_LOAD_OK) {
+                return result;
+            }
+
+            isFormatFound = true;
+            paddedChunkSize -= bytesToRead;
+        } else if (Wave_IsChunkID(chunkHeader, WAVEFILE_DATABLOCID) && !isDataFound) {
+            dataOffset = IOReaderTell(&reader);
+            dataSize = chunkSize;
+            isDataFound = true;
+        }
+
+        IOReaderSkip(&reader, paddedChunkSize);
+    }
+
+    if (!isFormatFound || !isDataFound) {
+        return WAVEASSET_LOAD_ERR_INVALID_FORMAT;
+    }
+
+    Wave_FinishHeader(&header, Wave_ClampDataSize(&header, dataSize, fileSize - dataOffset));
+
+    *headerOut = header;
+    *dataOffsetOut = dataOffset;
+
+    return WAVEASSET_LOAD_OK;
+}
+
+/*
+ * Loads asset data either into `scratchAllocator` or into `tlsfAllocator`, whichever is not NULL.
+ */
+internal WaveAssetLoadResult
+WaveAssetLoadFromFileInternal(
+    ScratchAllocator *scratchAllocator, TLSFAllocator *tlsfAllocator, cstr8 assetPath, WaveAsset *waveAssetOut) {
+    if ((scratchAllocator == NULL && tlsfAllocator == NULL) || assetPath == NULL || waveAssetOut == NULL ||
+        CStr8IsEmpty(assetPath)) {
         return WAVEASSET_LOAD_ERR_INVALID_ARGS;
     }
 
@@ -29,42 +296,86 @@ WaveAssetLoadFromFile(ScratchAllocator *scratchAllocator, cstr8 assetPath, WaveA
     }
 
     WaveFileHeader header;
+    u64 dataOffset = 0;
+    WaveAssetLoadResult parseResult = WaveFileParseHeaderFromFile(assetFileHandle, &header, &dataOffset);
 
-    IOResult loadFromAssetFile;
-
-    loadFromAssetFile = IOLoadBytesFromFile(&assetFileHandle, &header, sizeof(header));
-
-    if (loadFromAssetFile != IO_OK) {
-        return WAVEASSET_LOAD_ERR_FAILED_TO_READ;
+    if (parseResult != WAVEASSET_LOAD_OK) {
+        IOCloseFile(&assetFileHandle);
+        return parseResult;
     }
 
-    // TODO(ilya.a): Implement magic check [2024/06/08]
-    // if (!CStr8IsEqual(header.FileTypeBlocID, WAVEFILE_FILETYPE) ||
-    //     !CStr8IsEqual(header.FileFormatID,   WAVEFILE_FORMATID) ||
-    //     !CStr8IsEqual(header.FormatBlocID,   WAVEFILE_FORMATBLOCID) ||
-    //     !CStr8IsEqual(header.DataBlocID,     WAVEFILE_DATABLOCID))
-    // {
-    //     return WAVEASSET_LOAD_ERR_INVALID_MAGIC;
-    // }
-
-    void *data = ScratchAllocatorAlloc(scratchAllocator, header.DataSize);
+    void *data = scratchAllocator != NULL ? ScratchAllocatorAlloc(scratchAllocator, header.DataSize)
+                                          : TLSFAllocatorAlloc(tlsfAllocator, header.DataSize);
 
     if (data == NULL) {
+        IOCloseFile(&assetFileHandle);
         return WAVEASSET_LOAD_ERR_FAILED_TO_ALLOC;
     }
 
-    loadFromAssetFile = IOLoadBytesFromFileEx(&assetFileHandle, data, header.DataSize, sizeof(header));
+    IOResult loadFromAssetFile = IOReadAt(&assetFileHandle, data, header.DataSize, dataOffset, NULL);
+    IOCloseFile(&assetFileHandle);
 
     if (loadFromAssetFile != IO_OK) {
+        if (scratchAllocator == NULL) {
+            TLSFAllocatorFree(tlsfAllocator, data);
+        }
         return WAVEASSET_LOAD_ERR_FAILED_TO_READ;
     }
 
     waveAssetOut->Header = header;
     waveAssetOut->Data = data;
+    waveAssetOut->Allocator = scratchAllocator == NULL ? tlsfAllocator : NULL;
+
+    return WAVEASSET_LOAD_OK;
+}
+
+WaveAssetLoadResult
+WaveAssetLoadFromFile(ScratchAllocator *scratchAllocator, cstr8 assetPath, WaveAsset *waveAssetOut) {
+    if (scratchAllocator == NULL) {
+        return WAVEASSET_LOAD_ERR_INVALID_ARGS;
+    }
+    return WaveAssetLoadFromFileInternal(scratchAllocator, NULL, assetPath, waveAssetOut);
+}
+
+WaveAssetLoadResult
+WaveAssetLoadFromFileTLSF(TLSFAllocator *allocator, cstr8 assetPath, WaveAsset *waveAssetOut) {
+    if (allocator == NULL) {
+        return WAVEASSET_LOAD_ERR_INVALID_ARGS;
+    }
+    return WaveAssetLoadFromFileInternal(NULL, allocator, assetPath, waveAssetOut);
+}
+
+WaveAssetLoadResult
+WaveAssetLoadFromMemory(const void *buffer, usize bufferSize, WaveAsset *waveAssetOut) {
+    if (buffer == NULL || waveAssetOut == NULL) {
+        return WAVEASSET_LOAD_ERR_INVALID_ARGS;
+    }
+
+    WaveFileHeader header;
+    usize dataOffset = 0;
+    WaveAssetLoadResult result = WaveFileParseHeader(buffer, bufferSize, &header, &dataOffset);
+
+    if (result != WAVEASSET_LOAD_OK) {
+        return result;
+    }
+
+    waveAssetOut->Header = header;
+    waveAssetOut->Data = (byte *)buffer + dataOffset; // NOTE(ilya.a): Mapped data is read-only. [2026/10/18]
+    waveAssetOut->Allocator = NULL;
 
     return WAVEASSET_LOAD_OK;
 }
 
-WaveAssetLoadResult WaveAssetLoadFromMemory(ScratchAllocator *arena, const void *buffer, WaveAsset *waveAssetOut);
+void
+WaveAssetFree(WaveAsset *wa) {
+    if (wa == NULL || wa->Data == NULL) {
+        return;
+    }
+
+    if (wa->Allocator != NULL) {
+        TLSFAllocatorFree(wa->Allocator, wa->Data);
+        wa->Allocator = NULL;
+    }
 
-void WaveAssetFree(WaveAsset *wa);
+    wa->Data = NULL;
+}
@@ -10,15 +10,21 @@
 #include "gfs_assert.h"
 #include "gfs_types.h"
 #include "gfs_memory.h"
+#include "gfs_io.h"
 
 #define WAVEFILE_FILETYPE "RIFF"
 #define WAVEFILE_FORMATID "WAVE"
 #define WAVEFILE_FORMATBLOCID "fmt "
 #define WAVEFILE_DATABLOCID "data"
 
+#define WAVEFILE_CHUNK_HEADER_SIZE 8
+#define WAVEFILE_RIFF_HEADER_SIZE 12 // "RIFF", size, "WAVE".
+
 typedef enum {
     WAVEFILE_AUDIOFORMAT_PCM = 1,
     WAVEFILE_AUDIOFORMAT_IIEE_FLT = 3,
+    WAVEFILE_AUDIOFORMAT_IMA_ADPCM = 0x11,    // Blocks of `BytePerBloc` bytes, see `gfs_adpcm.h`.
+    WAVEFILE_AUDIOFORMAT_EXTENSIBLE = 0xFFFE, // Real format is in the first two bytes of SubFormat GUID.
 } WaveFileAudioFormat;
 
 /* NOTE(ilya.a): This piece of code just for the sake of the shame
@@ -33,6 +39,11 @@ typedef u16 WaveFileAudioFormatTag;
  * Wave file header.
  * Should be 44 bytes.
  *
+ * Canonical layout of the simplest wave file. Real files often have other chunks (LIST, fact, ...)
+ * between or around `fmt ` and `data`, so header is never read as is: parser walks the chunks and
+ * fills this struct in canonical form. For WAVE_FORMAT_EXTENSIBLE files `AudioFormat` is taken
+ * from SubFormat.
+ *
  * Using as a reference this page: https://en.wikipedia.org/wiki/WAV
  */
 typedef struct {
@@ -62,6 +73,10 @@ GFS_EXPECT_TYPE_SIZE(WaveFileHeader, WAVEFILE_HEADER_SIZE);
 typedef struct {
     WaveFileHeader Header;
     void *Data;
+
+    // NOTE(ilya.a): Set only if `Data` was allocated from general purpose allocator
+    // and could be released with `WaveAssetFree`. [2026/10/18]
+    TLSFAllocator *Allocator;
 } WaveAsset;
 
 typedef enum {
@@ -73,11 +88,35 @@ typedef enum {
     WAVEASSET_LOAD_ERR_FAILED_TO_READ,  // IO error. Opened the file, but failed to read it.
     WAVEASSET_LOAD_ERR_FAILED_TO_ALLOC, // Out of memory with Arena.
     WAVEASSET_LOAD_ERR_INVALID_MAGIC,   // Asset failed signature checks.
+    WAVEASSET_LOAD_ERR_TRUNCATED,       // Asset is smaller than its header says.
+    WAVEASSET_LOAD_ERR_INVALID_FORMAT,  // `fmt ` or `data` chunk is missing or malformed.
 } WaveAssetLoadResult;
 
+/*
+ * Walks RIFF chunks of wave file, which is already in memory, and locates `fmt ` and `data`
+ * wherever they are. Only chunk headers are touched, so it is O(number of chunks). Data chunk,
+ * which claims more bytes than there are (streamed recordings), is cut to whole blocks in buffer.
+ */
+WaveAssetLoadResult WaveFileParseHeader(
+    const void *buffer, usize bufferSize, WaveFileHeader *headerOut, usize *dataOffsetOut);
+
+/*
+ * Same as `WaveFileParseHeader`, but over opened file. Chunk headers are read through small
+ * buffered reader and chunk bodies are skipped, so only a couple of reads are issued.
+ */
+WaveAssetLoadResult WaveFileParseHeaderFromFile(FileHandle file, WaveFileHeader *headerOut, u64 *dataOffsetOut);
+
 WaveAssetLoadResult WaveAssetLoadFromFile(ScratchAllocator *arena, cstr8 assetPath, WaveAsset *waveAssetOut);
-WaveAssetLoadResult WaveAssetLoadFromMemory(ScratchAllocator *arena, const void *buffer, WaveAsset *waveAssetOut);
+WaveAssetLoadResult WaveAssetLoadFromFileTLSF(TLSFAllocator *allocator, cstr8 assetPath, WaveAsset *waveAssetOut);
+/*
+ * Parses wave file, which is already in memory (e.g. mapped with `IOMapFile`). Doesn't copy
+ * samples: `Data` of the asset points straight into `buffer`, so buffer should outlive the asset.
+ */
+WaveAssetLoadResult WaveAssetLoadFromMemory(const void *buffer, usize bufferSize, WaveAsset *waveAssetOut);
 
+/*
+ * Releases asset data back to its allocator. No-op for assets loaded into `ScratchAllocator`.
+ */
 void WaveAssetFree(WaveAsset *wa);
 
 #endif // GFS_WAVE_H_INCLUDED
@@ -0,0 +1,244 @@
+/*
+ * FILE      gfs_wave_stream.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_wave_stream.h"
+
+#include <Windows.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_io_queue.h"
+#include "gfs_wave.h"
+
+/*
+ * Requests next piece of `data` chunk into ring slot. Returns false if queue is full.
+ */
+internal bool
+WaveStream_RequestChunk(WaveStream *stream, u32 chunkIndex) {
+    WaveStreamChunk *chunk = &stream->Chunks[chunkIndex];
+
+    if (stream->NextDataChunk >= stream->DataChunkCount) {
+        if (!stream->IsLooping || stream->DataChunkCount == 0) {
+            chunk->State = WAVE_STREAM_CHUNK_END;
+            return true;
+        }
+        stream->NextDataChunk = 0;
+    }
+
+    u64 dataChunkOffset = stream->NextDataChunk * stream->ChunkSize;
+    u64 bytesLeft = stream->Header.DataSize - dataChunkOffset;
+
+    IORequest request = {0};
+    request.File = stream->File;
+    request.Offset = stream->DataOffset + dataChunkOffset;
+    request.Size = (usize)(bytesLeft < stream->ChunkSize ? bytesLeft : stream->ChunkSize);
+    request.Destination = stream->Ring + (usize)chunkIndex * stream->ChunkSize;
+
+    IOTicket ticket = IOQueueSubmit(stream->Queue, &request);
+
+    if (ticket == IO_TICKET_INVALID) {
+        return false;
+    }
+
+    chunk->State = WAVE_STREAM_CHUNK_PENDING;
+    chunk->Ticket = ticket;
+    chunk->Size = (u32)request.Size;
+    chunk->Position = 0;
+
+    ++stream->NextDataChunk;
+
+    return true;
+}
+
+/*
+ * Requests every empty slot in ring order. If queue is full, the rest is retried on the next read.
+ */
+internal void
+WaveStream_RequestChunks(WaveStream *stream) {
+    while (stream->Chunks[stream->NextRequestChunk].State == WAVE_STREAM_CHUNK_EMPTY) {
+        if (!WaveStream_RequestChunk(stream, stream->NextRequestChunk)) {
+            break;
+        }
+        stream->NextRequestChunk = (stream->NextRequestChunk + 1) % WAVE_STREAM_CHUNK_COUNT;
+    }
+}
+
+/*
+ * Moves pending chunk to ready, or ends the stream if its read failed.
+ */
+internal void
+WaveStream_CompleteChunk(WaveStream *stream, u32 chunkIndex, const IOCompletion *completion) {
+    WaveStreamChunk *chunk = &stream->Chunks[chunkIndex];
+    chunk->Ticket = IO_TICKET_INVALID;
+
+    if (completion->Result != IO_OK) {
+        chunk->State = WAVE_STREAM_CHUNK_END;
+        stream->IsFailed = true;
+        return;
+    }
+
+    chunk->State = WAVE_STREAM_CHUNK_READY;
+    ++stream->Stats.ChunksRead;
+}
+
+/*
+ * Returns true if chunk has data to read. Doesn't block.
+ */
+internal bool
+WaveStream_IsChunkReady(WaveStream *stream, u32 chunkIndex) {
+    WaveStreamChunk *chunk = &stream->Chunks[chunkIndex];
+
+    if (chunk->State == WAVE_STREAM_CHUNK_EMPTY) {
+        WaveStream_RequestChunks(stream);
+    }
+
+    // NOTE(ilya.a): Called from audio thread, so queue's lock is only taken to retire request,
+    // which is already done. [2026/10/18]
+    if (chunk->State == WAVE_STREAM_CHUNK_PENDING) {
+        if (!IOQueueIsDone(stream->Queue, chunk->Ticket)) {
+            return false;
+        }
+
+        IOCompletion completion = IOQueueWait(stream->Queue, chunk->Ticket);
+        WaveStream_CompleteChunk(stream, chunkIndex, &completion);
+    }
+
+    return chunk->State == WAVE_STREAM_CHUNK_READY;
+}
+
+WaveStreamResult
+WaveStreamOpen(IOQueue *queue, cstr8 assetPath, bool isLooping, WaveStream *streamOut) {
+    if (queue == NULL || assetPath == NULL || streamOut == NULL) {
+        return WAVE_STREAM_ERR_INVALID_ARGS;
+    }
+
+    WaveStream stream = {0};
+    stream.Queue = queue;
+    stream.IsLooping = isLooping;
+
+    // NOTE(ilya.a): Header is parsed before any chunk is requested, so its reads don't overlap
+    // with ones of queue's workers. [2026/10/18]
+    if (IOOpenFile(assetPath, &stream.File, IO_READ | IO_OVERLAPPED) != IO_OK) {
+        return WAVE_STREAM_ERR_FAILED_TO_OPEN;
+    }
+
+    if (WaveFileParseHeaderFromFile(stream.File, &stream.Header, &stream.DataOffset) != WAVEASSET_LOAD_OK) {
+        IOCloseFile(&stream.File);
+        return WAVE_STREAM_ERR_INVALID_FILE;
+    }
+
+    u32 frameSize = stream.Header.BytePerBloc;
+
+    if (frameSize > WAVE_STREAM_CHUNK_SIZE) {
+        IOCloseFile(&stream.File);
+        return WAVE_STREAM_ERR_INVALID_FILE;
+    }
+
+    stream.ChunkSize = WAVE_STREAM_CHUNK_SIZE - WAVE_STREAM_CHUNK_SIZE % frameSize;
+    stream.DataChunkCount = ((u64)stream.Header.DataSize + stream.ChunkSize - 1) / stream.ChunkSize;
+
+    stream.Ring = VirtualAlloc(
+        NULL, (usize)stream.ChunkSize * WAVE_STREAM_CHUNK_COUNT, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (stream.Ring == NULL) {
+        IOCloseFile(&stream.File);
+        return WAVE_STREAM_ERR_FAILED_TO_ALLOC;
+    }
+
+    *streamOut = stream;
+
+    // NOTE(ilya.a): Priming the whole ring and waiting for the first chunk, so first reads don't
+    // underrun, even if they come right after open. [2026/10/18]
+    WaveStream_RequestChunks(streamOut);
+
+    if (streamOut->Chunks[0].State == WAVE_STREAM_CHUNK_PENDING) {
+        IOCompletion completion = IOQueueWait(queue, streamOut->Chunks[0].Ticket);
+        WaveStream_CompleteChunk(streamOut, 0, &completion);
+    }
+
+    return WAVE_STREAM_OK;
+}
+
+void
+WaveStreamClose(WaveStream *stream) {
+    if (stream == NULL || stream->Ring == NULL) {
+        return;
+    }
+
+    // NOTE(ilya.a): Workers might be still writing into the ring. [2026/10/18]
+    for (u32 chunkIndex = 0; chunkIndex < WAVE_STREAM_CHUNK_COUNT; ++chunkIndex) {
+        WaveStreamChunk *chunk = &stream->Chunks[chunkIndex];
+
+        if (chunk->State == WAVE_STREAM_CHUNK_PENDING) {
+            IOQueueWait(stream->Queue, chunk->Ticket);
+            chunk->State = WAVE_STREAM_CHUNK_END;
+            chunk->Ticket = IO_TICKET_INVALID;
+        }
+    }
+
+    VirtualFree(stream->Ring, 0, MEM_RELEASE);
+    stream->Ring = NULL;
+
+    IOCloseFile(&stream->File);
+}
+
+usize
+WaveStreamRead(WaveStream *stream, void *destination, usize frameCount) {
+    if (stream == NULL || stream->Ring == NULL || destination == NULL) {
+        return 0;
+    }
+
+    u32 frameSize = stream->Header.BytePerBloc;
+    byte *output = (byte *)destination;
+    usize framesLeft = frameCount;
+
+    while (framesLeft > 0) {
+        u32 chunkIndex = stream->CurrentChunk;
+        WaveStreamChunk *chunk = &stream->Chunks[chunkIndex];
+
+        if (!WaveStream_IsChunkReady(stream, chunkIndex)) {
+            if (chunk->State == WAVE_STREAM_CHUNK_PENDING || chunk->State == WAVE_STREAM_CHUNK_EMPTY) {
+                ++stream->Stats.UnderrunCount;
+                stream->Stats.UnderrunFrames += framesLeft;
+            }
+            break;
+        }
+
+        usize chunkFramesLeft = (chunk->Size - chunk->Position) / frameSize;
+        usize framesToCopy = framesLeft < chunkFramesLeft ? framesLeft : chunkFramesLeft;
+        usize bytesToCopy = framesToCopy * frameSize;
+
+        CopyMemory(output, stream->Ring + (usize)chunkIndex * stream->ChunkSize + chunk->Position, bytesToCopy);
+
+        output += bytesToCopy;
+        framesLeft -= framesToCopy;
+        chunk->Position += (u32)bytesToCopy;
+
+        if (chunk->Position + frameSize > chunk->Size) {
+            chunk->State = WAVE_STREAM_CHUNK_EMPTY;
+            stream->CurrentChunk = (chunkIndex + 1) % WAVE_STREAM_CHUNK_COUNT;
+            WaveStream_RequestChunks(stream);
+        }
+    }
+
+    // NOTE(ilya.a): Unsigned 8-bit PCM is centered at 128, everything else at zero. [2026/10/18]
+    byte silence =
+        stream->Header.AudioFormat == WAVEFILE_AUDIOFORMAT_PCM && stream->Header.BitsPerSample == 8 ? 128 : 0;
+    MemorySet(output, silence, framesLeft * frameSize);
+
+    usize framesRead = frameCount - framesLeft;
+    stream->Stats.FramesRead += framesRead;
+
+    return framesRead;
+}
+
+bool
+WaveStreamIsFinished(const WaveStream *stream) {
+    return stream == NULL || stream->IsFailed ||
+           stream->Chunks[stream->CurrentChunk].State == WAVE_STREAM_CHUNK_END;
+}
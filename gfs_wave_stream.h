@@ -0,0 +1,105 @@
+/*
+ * GFS. Streaming wave playback.
+ *
+ * Wave stream keeps only small ring of fixed-size chunks in memory, instead of the whole
+ * `data` chunk. Chunks are read by `IOQueue` workers ahead of the read cursor: every time
+ * reader finishes a chunk, read of the next not yet requested chunk is submitted into the
+ * freed slot. So memory per voice is `WAVE_STREAM_CHUNK_COUNT * WAVE_STREAM_CHUNK_SIZE`
+ * regardless of the track length.
+ *
+ * If chunk is not read yet, when it is needed, silence is produced and underrun is counted.
+ *
+ * FILE      gfs_wave_stream.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_WAVE_STREAM_H_INCLUDED
+#define GFS_WAVE_STREAM_H_INCLUDED
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_io.h"
+#include "gfs_io_queue.h"
+#include "gfs_wave.h"
+
+#define WAVE_STREAM_CHUNK_SIZE KILOBYTES(32)
+#define WAVE_STREAM_CHUNK_COUNT 4
+
+typedef enum {
+    WAVE_STREAM_CHUNK_EMPTY,   // Should be requested.
+    WAVE_STREAM_CHUNK_PENDING, // Read is in flight.
+    WAVE_STREAM_CHUNK_READY,
+    WAVE_STREAM_CHUNK_END, // Nothing left to stream.
+} WaveStreamChunkState;
+
+typedef struct {
+    WaveStreamChunkState State;
+    IOTicket Ticket;
+    u32 Size;     // Valid bytes in chunk.
+    u32 Position; // Bytes already consumed.
+} WaveStreamChunk;
+
+typedef struct {
+    u64 FramesRead;
+    u64 UnderrunCount;  // Number of reads, which got cut short because data wasn't there yet.
+    u64 UnderrunFrames; // Frames of silence produced because of that.
+    u64 ChunksRead;
+} WaveStreamStats;
+
+typedef struct {
+    IOQueue *Queue;
+    FileHandle File;
+
+    WaveFileHeader Header;
+    u64 DataOffset;
+
+    byte *Ring; // WAVE_STREAM_CHUNK_COUNT chunks, `ChunkSize` bytes each.
+    u32 ChunkSize; // Multiple of frame size, so frames never straddle chunks.
+    WaveStreamChunk Chunks[WAVE_STREAM_CHUNK_COUNT];
+    u32 CurrentChunk;
+    u32 NextRequestChunk; // Slots are requested strictly in ring order.
+
+    u64 NextDataChunk; // Index of `data` chunk piece to request next. Wraps if looping.
+    u64 DataChunkCount;
+    bool IsLooping;
+    bool IsFailed;
+
+    WaveStreamStats Stats;
+} WaveStream;
+
+typedef enum {
+    WAVE_STREAM_OK,
+    WAVE_STREAM_ERR_INVALID_ARGS,
+    WAVE_STREAM_ERR_FAILED_TO_OPEN,
+    WAVE_STREAM_ERR_INVALID_FILE, // See `WaveFileParseHeaderFromFile`.
+    WAVE_STREAM_ERR_FAILED_TO_ALLOC,
+} WaveStreamResult;
+
+/*
+ * Opens wave file, submits reads of the first chunks and waits for the very first one. Queue
+ * should outlive the stream.
+ */
+WaveStreamResult WaveStreamOpen(IOQueue *queue, cstr8 assetPath, bool isLooping, WaveStream *streamOut);
+
+/*
+ * Waits for reads in flight, closes the file and releases the ring.
+ */
+void WaveStreamClose(WaveStream *stream);
+
+/*
+ * Copies up to `frameCount` frames in the file's sample format into `destination`. Frames,
+ * which are not available (underrun or end of stream), are filled with silence, so `destination`
+ * is always fully written. Returns number of frames, which came from the file.
+ *
+ * Should be called from single thread at a time.
+ */
+usize WaveStreamRead(WaveStream *stream, void *destination, usize frameCount);
+
+/*
+ * True once every frame of non-looping stream is read, or after IO error.
+ */
+bool WaveStreamIsFinished(const WaveStream *stream);
+
+#endif // GFS_WAVE_STREAM_H_INCLUDED
@@ -1,80 +1,43 @@
 /*
- * GFS. Bitmap renderer.
+ * GFS. Bitmap renderer's window.
  *
- * Keeps one global backbuffer.
+ * Stretches renderer's pixels over window's client area with GDI.
  *
  * FILE      gfs_win32_bmr.h
  * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
  * COPYRIGHT (c) 2024 Ilya Akkuzin
  * */
 
-#ifndef GFS_BMR_H_INCLUDED
-#define GFS_BMR_H_INCLUDED
+#ifndef GFS_WIN32_BMR_H_INCLUDED
+#define GFS_WIN32_BMR_H_INCLUDED
 
 #include <Windows.h>
 
 #include "gfs_types.h"
-#include "gfs_color.h"
-#include "gfs_linalg.h"
-#include "gfs_geometry.h"
+#include "gfs_bmr.h"
 
-// TODO(ilya.a): Parametrize it, if will be neccesery to change bytes per pixel
-#define BMR_BPP 4
-
-/*
- * Actuall BitMap Renderer Renderer.
- */
 typedef struct {
-    Color4 ClearColor;
-
-    struct {
-        u8 *Begin;
-        u8 *End;
-    } CommandQueue;
-
-    u64 CommandCount;
-
-    u8 BPP;
-    u64 XOffset;
-    u64 YOffset;
-
-    struct {
-        void *Buffer;
-        u64 Width;
-        u64 Height;
-    } Pixels;
-
     BITMAPINFO Info;
     HWND Window;
     HDC DC;
-} BMR_Renderer;
-
-typedef enum {
-    BMR_RENDER_COMMAND_TYPE_NOP = 00,
-    BMR_RENDER_COMMAND_TYPE_CLEAR = 01,
-    BMR_RENDER_COMMAND_TYPE_LINE = 10,
-    BMR_RENDER_COMMAND_TYPE_RECT = 11,
-    BMR_RENDER_COMMAND_TYPE_GRADIENT = 20,
-} BMR_RenderCommandType;
+} Win32_BMRWindow;
 
-BMR_Renderer BMR_Init(Color4 clearColor, HWND window);
-void BMR_DeInit(BMR_Renderer *renderer);
+Win32_BMRWindow Win32_BMRWindowInit(HWND window);
+void Win32_BMRWindowDeInit(Win32_BMRWindow *bmrWindow);
 
-void BMR_Update(BMR_Renderer *renderer, HWND window);
-void BMR_Resize(BMR_Renderer *renderer, i32 w, i32 h);
-
-void BMR_BeginDrawing(BMR_Renderer *renderer);
-void BMR_EndDrawing(BMR_Renderer *renderer);
-
-void BMR_Clear(BMR_Renderer *renderer);
-
-void BMR_DrawLine(BMR_Renderer *renderer, u32 x1, u32 y1, u32 x2, u32 y2);
-void BMR_DrawLineV(BMR_Renderer *renderer, v2u32 p1, v2u32 p2);
+/*
+ * Resizes renderer's pixel buffer and describes it to GDI.
+ */
+void Win32_BMRWindowResize(Win32_BMRWindow *bmrWindow, BMR_Renderer *renderer, i32 w, i32 h);
 
-void BMR_DrawRect(BMR_Renderer *renderer, u32 x, u32 y, u32 w, u32 h, Color4 c);
-void BMR_DrawRectR(BMR_Renderer *renderer, Rect r, Color4 c);
+/*
+ * Shows the last rasterized picture over whole client area.
+ */
+void Win32_BMRWindowPresent(Win32_BMRWindow *bmrWindow, const BMR_Renderer *renderer);
 
-void BMR_DrawGrad(BMR_Renderer *renderer, u32 xOffset, u32 yOffset);
-void BMR_DrawGradV(BMR_Renderer *renderer, v2u32 offset);
+/*
+ * Repaints invalidated part of window. Call it on `WM_PAINT`.
+ */
+void Win32_BMRWindowUpdate(Win32_BMRWindow *bmrWindow, const BMR_Renderer *renderer);
 
-#endif // GFS_BMR_H_INCLUDED
+#endif // GFS_WIN32_BMR_H_INCLUDED
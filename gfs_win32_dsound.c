@@ -0,0 +1,206 @@
+/*
+ * FILE      gfs_win32_dsound.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_win32_dsound.h"
+
+#include <Windows.h>
+#include <dsound.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_audio_device.h"
+#include "gfs_win32_misc.h"
+
+#define WIN32_DSOUND_DLL "dsound.dll"
+#define WIN32_DIRECTSOUNDCREATE_PROCNAME "DirectSoundCreate"
+
+#define WIN32_DSOUND_FRAME_SIZE AUDIO_DEVICE_FRAME_SIZE
+
+typedef HRESULT Win32_DirectSoundCreateType(LPCGUID pcGuidDevice, LPDIRECTSOUND *ppDS, LPUNKNOWN pUnkOuter);
+
+internal u32
+Win32_DSound_GetFramesToWrite(AudioDevice *device) {
+    Win32_DSoundDevice *dsound = (Win32_DSoundDevice *)device;
+
+    if (!dsound->IsPlaying) {
+        device->Position.MarginFrames = (i32)device->LatencyFrames;
+        return device->LatencyFrames;
+    }
+
+    DWORD playCursor;
+    DWORD writeCursor;
+
+    if (!SUCCEEDED(VCALL(dsound->Buffer, GetCurrentPosition, &playCursor, &writeCursor))) {
+        return 0;
+    }
+
+    u32 playFrame = playCursor / WIN32_DSOUND_FRAME_SIZE;
+    u32 safeFrame = writeCursor / WIN32_DSOUND_FRAME_SIZE;
+
+    // NOTE(ilya.a): Everything is measured from play cursor, so wrapping of the ring doesn't matter.
+    // Region between play and write cursors is already committed to hardware. [2026/10/18]
+    u32 safeAhead = (safeFrame + dsound->BufferFrames - playFrame) % dsound->BufferFrames;
+    u32 writeAhead = (dsound->WriteFrame + dsound->BufferFrames - playFrame) % dsound->BufferFrames;
+
+    // NOTE(ilya.a): Clock assumes, that queries are less than a buffer (one second) apart. [2026/10/18]
+    device->Position.Clock += (playFrame + dsound->BufferFrames - dsound->PlayFrame) % dsound->BufferFrames;
+    device->Position.PlayCursor = playCursor;
+    device->Position.WriteCursor = writeCursor;
+    device->Position.MarginFrames = (i32)writeAhead - (i32)safeAhead;
+    dsound->PlayFrame = playFrame;
+
+    // NOTE(ilya.a): Play cursor only moves towards write position, so distance between them can't
+    // grow. If it did, play cursor has run past write position (thread stalled) and wrapped around
+    // the ring: it played stale frames all the way since. [2026/10/18]
+    bool isLapped = writeAhead > dsound->QueuedFrames;
+
+    if (isLapped || writeAhead < safeAhead) {
+        u32 lateFrames = isLapped ? dsound->BufferFrames - writeAhead + safeAhead : safeAhead - writeAhead;
+
+        device->Stats.UnderrunCount += 1;
+        device->Stats.UnderrunFrames += lateFrames;
+        device->Position.MarginFrames = -(i32)lateFrames;
+
+        dsound->WriteFrame = safeFrame;
+        writeAhead = safeAhead;
+    }
+
+    dsound->QueuedFrames = writeAhead;
+
+    u32 targetAhead = safeAhead + device->LatencyFrames;
+    return writeAhead < targetAhead ? targetAhead - writeAhead : 0;
+}
+
+internal void
+Win32_DSound_Write(AudioDevice *device, const i16 *samples, u32 frameCount) {
+    Win32_DSoundDevice *dsound = (Win32_DSoundDevice *)device;
+
+    VOID *region1, *region2;
+    DWORD region1Size, region2Size;
+
+    HRESULT lockResult = VCALL(
+        dsound->Buffer, Lock, dsound->WriteFrame * WIN32_DSOUND_FRAME_SIZE, frameCount * WIN32_DSOUND_FRAME_SIZE,
+        &region1, &region1Size, &region2, &region2Size, 0);
+
+    if (!SUCCEEDED(lockResult)) {
+        return;
+    }
+
+    MemoryCopy(region1, samples, region1Size);
+    MemoryCopy(region2, (const byte *)samples + region1Size, region2Size);
+
+    VCALL(dsound->Buffer, Unlock, region1, region1Size, region2, region2Size);
+
+    dsound->WriteFrame = (dsound->WriteFrame + frameCount) % dsound->BufferFrames;
+    dsound->QueuedFrames += frameCount;
+    device->Stats.FramesWritten += frameCount;
+
+    if (!dsound->IsPlaying) {
+        dsound->IsPlaying = SUCCEEDED(VCALL(dsound->Buffer, Play, 0, 0, DSBPLAY_LOOPING));
+    }
+}
+
+internal void
+Win32_DSound_Wait(AudioDevice *device) {
+    UNUSED(device);
+    Sleep(1);
+}
+
+Win32_InitDSoundResult
+Win32_DSoundDeviceInit(Win32_DSoundDevice *device, HWND window, u32 samplesPerSecond, u32 latencyFrames) {
+    MemoryZero(device, sizeof(*device));
+
+    HMODULE library = LoadLibrary(WIN32_DSOUND_DLL);
+
+    if (library == NULL) {
+        return WIN32_INITDSOUND_DLL_LOAD;
+    }
+
+    Win32_DirectSoundCreateType *directSoundCreate =
+        (Win32_DirectSoundCreateType *)GetProcAddress(library, WIN32_DIRECTSOUNDCREATE_PROCNAME);
+
+    if (directSoundCreate == NULL) {
+        return WIN32_INITDSOUND_DLL_LOAD;
+    }
+
+    LPDIRECTSOUND directSound;
+    if (!SUCCEEDED(directSoundCreate(0, &directSound, NULL))) {
+        return WIN32_INITDSOUND_ERR;
+    }
+
+    if (!SUCCEEDED(VCALL(directSound, SetCooperativeLevel, window, DSSCL_PRIORITY))) {
+        return WIN32_INITDSOUND_ERR;
+    }
+
+    // NOTE(ilya.a): Primary buffer -- buffer which is only holds handle to
+    // sound card. Windows has strange API. [2024/05/25]
+    DSBUFFERDESC primaryBufferDesc;
+    MemoryZero(&primaryBufferDesc, sizeof(primaryBufferDesc)); // TODO(ilya.a): Checkout if we really need
+                                                               // to zero buffer description. [2024/05/25]
+
+    primaryBufferDesc.dwSize = sizeof(primaryBufferDesc);
+    primaryBufferDesc.dwFlags = DSBCAPS_PRIMARYBUFFER;
+    primaryBufferDesc.dwBufferBytes = 0;  // NOTE(ilya.a): Primary buffer size should be zero. [2024/05/25]
+    primaryBufferDesc.lpwfxFormat = NULL; // NOTE(ilya.a): Primary buffer wfx format should be NULL. [2024/05/25]
+
+    LPDIRECTSOUNDBUFFER primaryBuffer;
+    if (!SUCCEEDED(VCALL(directSound, CreateSoundBuffer, &primaryBufferDesc, &primaryBuffer, NULL))) {
+        return WIN32_INITDSOUND_ERR;
+    }
+
+    WAVEFORMATEX waveFormat;
+    waveFormat.wFormatTag = WAVE_FORMAT_PCM;
+    waveFormat.nChannels = 2;
+    waveFormat.nSamplesPerSec = samplesPerSecond;
+    waveFormat.wBitsPerSample = 16;
+    waveFormat.nBlockAlign = (waveFormat.nChannels * waveFormat.wBitsPerSample) / BYTE_BITS;
+    waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign; // NOTE(ilya.a): Redundant. Lol.
+    waveFormat.cbSize = 0;
+
+    if (!SUCCEEDED(VCALL(primaryBuffer, SetFormat, &waveFormat))) {
+        return WIN32_INITDSOUND_ERR;
+    }
+
+    // NOTE(ilya.a): Actual sound buffer in which we will write data. [2024/05/25]
+    DSBUFFERDESC secondaryBufferDesc;
+    MemoryZero(&secondaryBufferDesc, sizeof(secondaryBufferDesc)); // TODO(ilya.a): Checkout if we really need
+                                                                   // to zero buffer description. [2024/05/25]
+    secondaryBufferDesc.dwSize = sizeof(secondaryBufferDesc);
+    // NOTE(ilya.a): Without this, position reported by GetCurrentPosition is way too coarse. [2026/10/18]
+    secondaryBufferDesc.dwFlags = DSBCAPS_GETCURRENTPOSITION2;
+    secondaryBufferDesc.dwBufferBytes = samplesPerSecond * WIN32_DSOUND_FRAME_SIZE;
+    secondaryBufferDesc.lpwfxFormat = &waveFormat;
+
+    if (!SUCCEEDED(VCALL(directSound, CreateSoundBuffer, &secondaryBufferDesc, &device->Buffer, NULL))) {
+        return WIN32_INITDSOUND_ERR;
+    }
+
+    device->DirectSound = directSound;
+    device->BufferFrames = samplesPerSecond;
+
+    device->Device.SampleRate = samplesPerSecond;
+    device->Device.LatencyFrames = latencyFrames;
+    device->Device.GetFramesToWrite = Win32_DSound_GetFramesToWrite;
+    device->Device.Write = Win32_DSound_Write;
+    device->Device.Wait = Win32_DSound_Wait;
+
+    return WIN32_INITDSOUND_OK;
+}
+
+void
+Win32_DSoundDeviceDeInit(Win32_DSoundDevice *device) {
+    if (device->Buffer != NULL) {
+        device->Buffer->lpVtbl->Stop(device->Buffer);
+        device->Buffer->lpVtbl->Release(device->Buffer);
+    }
+
+    if (device->DirectSound != NULL) {
+        device->DirectSound->lpVtbl->Release(device->DirectSound);
+    }
+
+    MemoryZero(device, sizeof(*device));
+}
@@ -0,0 +1,47 @@
+/*
+ * GFS. DirectSound audio device.
+ *
+ * Looping secondary buffer is treated as a ring: audio thread writes just past DirectSound's
+ * safe write cursor, keeping only `LatencyFrames` ahead of it.
+ *
+ * FILE      gfs_win32_dsound.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_WIN32_DSOUND_H_INCLUDED
+#define GFS_WIN32_DSOUND_H_INCLUDED
+
+#include <Windows.h>
+#include <dsound.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_audio.h"
+
+typedef enum { WIN32_INITDSOUND_OK, WIN32_INITDSOUND_ERR, WIN32_INITDSOUND_DLL_LOAD } Win32_InitDSoundResult;
+
+typedef struct {
+    AudioDevice Device;
+
+    LPDIRECTSOUND DirectSound;
+    LPDIRECTSOUNDBUFFER Buffer;
+    u32 BufferFrames;
+    u32 WriteFrame;   // Where the next frame goes in the buffer.
+    u32 PlayFrame;    // Play cursor at the last query.
+    u32 QueuedFrames; // From play cursor to `WriteFrame` at the last query, plus frames written since.
+    bool IsPlaying;
+} Win32_DSoundDevice;
+
+/*
+ * Loads DirectSound library and creates stereo 16-bit buffer of one second. Playback starts
+ * with the first write.
+ *
+ * NOTE(ilya.a): They say, that DirectSound is superseeded by WASAPI. [2024/05/25]
+ * TODO(ilya.a): Check this out. [2024/05/25]
+ */
+Win32_InitDSoundResult Win32_DSoundDeviceInit(
+    Win32_DSoundDevice *device, HWND window, u32 samplesPerSecond, u32 latencyFrames);
+void Win32_DSoundDeviceDeInit(Win32_DSoundDevice *device);
+
+#endif // GFS_WIN32_DSOUND_H_INCLUDED
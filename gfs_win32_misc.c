@@ -11,3 +11,10 @@ Win32_GetRectSize(const RECT *r, i32 *w, i32 *h) {
     *w = r->right - r->left;
     *h = r->bottom - r->top;
 }
+
+void
+Win32_Print(cstr8 message) {
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD bytesWritten = 0;
+    WriteFile(output, message, (DWORD)CStr8GetLength(message), &bytesWritten, NULL);
+}
@@ -18,6 +18,16 @@
  */
 void Win32_GetRectSize(const RECT *r, i32 *w, i32 *h);
 
+/*
+ * Writes message to standard output. Used by console tools.
+ */
+void Win32_Print(cstr8 message);
+
+/*
+ * Calls method of COM object from C.
+ */
+#define VCALL(S, M, ...) (S)->lpVtbl->M((S), __VA_ARGS__)
+
 #define Win32_TextOutA_CString8(HDC, X, Y, MSG) TextOutA((HDC), (X), (Y), (MSG), CStr_GetLength((MSG)))
 
 #endif // GFS_WIN32_MISC_HPP_INCLUDED
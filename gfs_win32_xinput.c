@@ -0,0 +1,71 @@
+/*
+ * FILE      gfs_win32_xinput.c
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#include "gfs_win32_xinput.h"
+
+#include <Windows.h>
+#include <xinput.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_memory.h"
+#include "gfs_input.h"
+#include "gfs_input_poller.h"
+#include "gfs_assert.h"
+
+#define WIN32_XINPUT_DLL XINPUT_DLL
+#define WIN32_XINPUTGETSTATE_PROCNAME "XInputGetState"
+
+GFS_STATIC_ASSERT(INPUT_GAMEPAD_COUNT == XUSER_MAX_COUNT);
+
+internal bool
+Win32_XInput_Read(InputDevice *device, u32 gamepadIndex, InputGamepad *gamepadOut) {
+    Win32_XInputDevice *xinput = (Win32_XInputDevice *)device;
+
+    XINPUT_STATE xInputState = {0};
+
+    // NOTE(ilya.a): Any error is treated as missing controller, slot is probed again a bit
+    // later. [2026/10/18]
+    if (xinput->GetState(gamepadIndex, &xInputState) != ERROR_SUCCESS) {
+        return false;
+    }
+
+    XINPUT_GAMEPAD *pad = &xInputState.Gamepad;
+
+    // NOTE(ilya.a): `INPUT_BUTTON_*` have the same values as `XINPUT_GAMEPAD_*`. [2026/10/18]
+    gamepadOut->Buttons = pad->wButtons;
+    gamepadOut->LeftTrigger = pad->bLeftTrigger;
+    gamepadOut->RightTrigger = pad->bRightTrigger;
+    gamepadOut->LeftStickX = pad->sThumbLX;
+    gamepadOut->LeftStickY = pad->sThumbLY;
+    gamepadOut->RightStickX = pad->sThumbRX;
+    gamepadOut->RightStickY = pad->sThumbRY;
+
+    return true;
+}
+
+Win32_InitXInputResult
+Win32_XInputDeviceInit(Win32_XInputDevice *device) {
+    MemoryZero(device, sizeof(*device));
+
+    // TODO(ilya.a): Handle different versions of xinput. Check for newer. If
+    // fails, use older one. [2024/05/24]
+    HMODULE library = LoadLibrary(WIN32_XINPUT_DLL);
+
+    if (library == NULL) {
+        return WIN32_INITXINPUT_DLL_LOAD;
+    }
+
+    device->GetState = (Win32_XInputGetStateType *)GetProcAddress(library, WIN32_XINPUTGETSTATE_PROCNAME);
+
+    if (device->GetState == NULL) {
+        return WIN32_INITXINPUT_DLL_LOAD;
+    }
+
+    device->Device.Read = Win32_XInput_Read;
+
+    return WIN32_INITXINPUT_OK;
+}
@@ -0,0 +1,34 @@
+/*
+ * GFS. XInput controller device.
+ *
+ * FILE      gfs_win32_xinput.h
+ * AUTHOR    Ilya Akkuzin <gr3yknigh1@gmail.com>
+ * COPYRIGHT (c) 2024 Ilya Akkuzin
+ * */
+
+#ifndef GFS_WIN32_XINPUT_H_INCLUDED
+#define GFS_WIN32_XINPUT_H_INCLUDED
+
+#include <Windows.h>
+#include <xinput.h>
+
+#include "gfs_types.h"
+#include "gfs_macros.h"
+#include "gfs_input_poller.h"
+
+typedef enum { WIN32_INITXINPUT_OK, WIN32_INITXINPUT_DLL_LOAD } Win32_InitXInputResult;
+
+typedef DWORD Win32_XInputGetStateType(DWORD dwUserIndex, XINPUT_STATE *pState);
+
+typedef struct {
+    InputDevice Device;
+
+    Win32_XInputGetStateType *GetState;
+} Win32_XInputDevice;
+
+/*
+ * Loads XInput library. Slots are the same as XInput's user indices.
+ */
+Win32_InitXInputResult Win32_XInputDeviceInit(Win32_XInputDevice *device);
+
+#endif // GFS_WIN32_XINPUT_H_INCLUDED